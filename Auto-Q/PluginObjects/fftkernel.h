@@ -0,0 +1,744 @@
+// -----------------------------------------------------------------------------
+//    ASPiK FX Objects File:  fftkernel.h
+//
+//    Copyright (C) 2026 RackAFXProjects contributors
+//    Distributed under the GNU General Public License v3, see LICENSE in the
+//    root of this repository.
+//
+/**
+    \file   fftkernel.h
+    \date   18-Oct-2026
+    \brief  built-in complex and real FFTs for the FFT objects in fxobjects.h (FastFFT, PhaseVocoder,
+    		FastConvolver, PSMVocoder, Interpolator, Decimator) and for the SpectrumView
+
+    		- self contained, no external libraries
+    		- radix-4 Stockham passes on split real/imaginary arrays, with one radix-2
+    		  pass for odd powers of 2; the inner loops run over contiguous data so the
+    		  compiler can vectorize them for SSE2/AVX
+    		- real transforms run as a half-length complex FFT plus one split pass, and
+    		  produce or take the N/2 + 1 bin half spectrum
+    		- twiddle tables are built once per length and shared by every kernel
+    		- when HAVE_FFTW is not defined, the subset of the FFTW3 API that the
+    		  objects use is provided on top of FFTKernel, so the same code builds
+    		  with or without FFTW
+
+*/
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#ifndef __fftkernel_h__
+#define __fftkernel_h__
+
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const unsigned int FFT_KERNEL_MAX_LOG2 = 20;	///< largest power of 2 with a shared twiddle table (1M points)
+
+/**
+\class FFTTwiddleTable
+\ingroup FFTW-Objects
+\brief
+The FFTTwiddleTable object holds cos(2 pi k / N) and sin(2 pi k / N) for k = 0 ... N - 1 for one power-of-2 length N.
+Every pass of an N point transform reads its twiddles from this one table (sub-transform twiddles are every s-th entry).
+
+The tables are built once per length and shared; use getInstance( ) to access them.
+
+\version Revision : 1.0
+*/
+class FFTTwiddleTable
+{
+public:
+	/** the shared table for length 2^log2Length; built on first use under a lock, so create kernels before realtime processing */
+	static const FFTTwiddleTable* getInstance(unsigned int log2Length)
+	{
+		static std::mutex tableLock;
+		static std::unique_ptr<FFTTwiddleTable> tables[FFT_KERNEL_MAX_LOG2 + 1];
+
+		if (log2Length > FFT_KERNEL_MAX_LOG2)
+			return nullptr;
+
+		std::lock_guard<std::mutex> guard(tableLock);
+		if (!tables[log2Length])
+			tables[log2Length].reset(new FFTTwiddleTable(1u << log2Length));
+		return tables[log2Length].get();
+	}
+
+	/** cos(2 pi k / N) */
+	const double* getCos() const { return &cosTable[0]; }
+
+	/** sin(2 pi k / N) */
+	const double* getSin() const { return &sinTable[0]; }
+
+private:
+	explicit FFTTwiddleTable(unsigned int length)
+		: cosTable(length)
+		, sinTable(length)
+	{
+		const double pi = 3.14159265358979323846264338327950288;
+		for (unsigned int k = 0; k < length; k++)
+		{
+			double angle = 2.0*pi*k / length;
+			cosTable[k] = cos(angle);
+			sinTable[k] = sin(angle);
+		}
+	}
+
+	std::vector<double> cosTable;	///< cos(2 pi k / N)
+	std::vector<double> sinTable;	///< sin(2 pi k / N)
+};
+
+/**
+\class FFTKernel
+\ingroup FFTW-Objects
+\brief
+The FFTKernel object performs unscaled complex DFTs of one length, with the same sign convention as FFTW:
+direction -1 is the forward transform X[k] = sum x[n] e^(-2 pi i nk / N) and +1 the inverse (without the 1/N).
+
+Power-of-2 lengths use radix-4 Stockham passes (plus one radix-2 pass for odd powers of 2) and a shared FFTTwiddleTable;
+other lengths fall back to a direct DFT.
+
+Audio I/O:
+- processes split real/imaginary arrays or interleaved {re, im} pairs; the input and output may be the same arrays
+
+Control I/O:
+- initialize( ) sets the length and allocates the workspace; not realtime safe
+
+\version Revision : 1.0
+*/
+class FFTKernel
+{
+public:
+	FFTKernel() {}		/* C-TOR */
+	~FFTKernel() {}		/* D-TOR */
+
+	/** set the transform length and allocate the workspace */
+	void initialize(unsigned int _length)
+	{
+		length = _length;
+		log2Length = 0;
+		while ((1u << log2Length) < length)
+			log2Length++;
+
+		twiddles = nullptr;
+		dftCos.clear();
+		dftSin.clear();
+
+		if ((1u << log2Length) == length)
+			twiddles = FFTTwiddleTable::getInstance(log2Length);
+
+		// --- direct DFT for the rest
+		if (!twiddles && length > 0)
+		{
+			const double pi = 3.14159265358979323846264338327950288;
+			dftCos.resize(length);
+			dftSin.resize(length);
+			for (unsigned int k = 0; k < length; k++)
+			{
+				dftCos[k] = cos(2.0*pi*k / length);
+				dftSin[k] = sin(2.0*pi*k / length);
+			}
+		}
+
+		// --- two ping-pong buffers plus the interleaved staging buffer, split re/im
+		workspace.assign(6 * (size_t)length, 0.0);
+	}
+
+	/** transform length */
+	unsigned int getLength() const { return length; }
+
+	/** true when the fast (power-of-2) path is used */
+	bool isPowerOfTwo() const { return twiddles != nullptr; }
+
+	/** transform split arrays; direction = -1 forward, +1 inverse (unscaled) */
+	void transform(const double* inReal, const double* inImag, double* outReal, double* outImag, int direction)
+	{
+		if (length == 0)
+			return;
+
+		if (!twiddles)
+		{
+			directDFT(inReal, inImag, outReal, outImag, direction);
+			return;
+		}
+
+		if (length == 1)
+		{
+			outReal[0] = inReal[0];
+			outImag[0] = inImag[0];
+			return;
+		}
+
+		const double* cosT = twiddles->getCos();
+		const double* sinT = twiddles->getSin();
+		const double sign = direction < 0 ? -1.0 : 1.0;
+
+		// --- radix-4 passes, then one radix-2 pass if log2(N) is odd
+		unsigned int numPasses = log2Length / 2 + (log2Length & 1);
+		double* bufferReal[2] = { &workspace[0], &workspace[2 * (size_t)length] };
+		double* bufferImag[2] = { &workspace[(size_t)length], &workspace[3 * (size_t)length] };
+
+		const double* xr = inReal;
+		const double* xi = inImag;
+		unsigned int n = length;
+		unsigned int s = 1;
+		for (unsigned int pass = 0; pass < numPasses; pass++)
+		{
+			// --- last pass writes the output; the input is only read by the first pass, so they may alias
+			bool lastPass = pass == numPasses - 1;
+			double* yr = lastPass && numPasses > 1 ? outReal : bufferReal[pass & 1];
+			double* yi = lastPass && numPasses > 1 ? outImag : bufferImag[pass & 1];
+
+			if (n >= 4)
+			{
+				if (s == 1)
+					radix4FirstPass(xr, xi, yr, yi, n, cosT, sinT, sign);
+				else
+					radix4Pass(xr, xi, yr, yi, n, s, cosT, sinT, sign);
+				n /= 4;
+				s *= 4;
+			}
+			else
+				radix2LastPass(xr, xi, yr, yi, s);
+
+			xr = yr;
+			xi = yi;
+		}
+
+		if (numPasses == 1)
+		{
+			for (unsigned int k = 0; k < length; k++)
+			{
+				outReal[k] = xr[k];
+				outImag[k] = xi[k];
+			}
+		}
+	}
+
+	/** transform interleaved {re, im} pairs; direction = -1 forward, +1 inverse (unscaled) */
+	void transform(const double(*input)[2], double(*output)[2], int direction)
+	{
+		if (length == 0)
+			return;
+
+		double* stageReal = &workspace[4 * (size_t)length];
+		double* stageImag = &workspace[5 * (size_t)length];
+		for (unsigned int k = 0; k < length; k++)
+		{
+			stageReal[k] = input[k][0];
+			stageImag[k] = input[k][1];
+		}
+
+		transform(stageReal, stageImag, stageReal, stageImag, direction);
+
+		for (unsigned int k = 0; k < length; k++)
+		{
+			output[k][0] = stageReal[k];
+			output[k][1] = stageImag[k];
+		}
+	}
+
+private:
+	/** first radix-4 pass (stride 1): vectorizes across p */
+	static void radix4FirstPass(const double* xr, const double* xi, double* yr, double* yi, unsigned int n,
+								const double* cosT, const double* sinT, double sign)
+	{
+		const unsigned int m = n / 4;
+		for (unsigned int p = 0; p < m; p++)
+		{
+			double ar = xr[p], ai = xi[p];
+			double br = xr[p + m], bi = xi[p + m];
+			double cr = xr[p + 2 * m], ci = xi[p + 2 * m];
+			double dr = xr[p + 3 * m], di = xi[p + 3 * m];
+
+			double apcR = ar + cr, apcI = ai + ci;
+			double amcR = ar - cr, amcI = ai - ci;
+			double bpdR = br + dr, bpdI = bi + di;
+			double bmdR = br - dr, bmdI = bi - di;
+
+			// --- (a - c) +/- i(b - d), sign follows the direction
+			double t1R = amcR - sign*bmdI, t1I = amcI + sign*bmdR;
+			double t2R = apcR - bpdR, t2I = apcI - bpdI;
+			double t3R = amcR + sign*bmdI, t3I = amcI - sign*bmdR;
+
+			double c1 = cosT[p], s1 = sign*sinT[p];
+			double c2 = cosT[2 * p], s2 = sign*sinT[2 * p];
+			double c3 = cosT[3 * p], s3 = sign*sinT[3 * p];
+
+			yr[4 * p] = apcR + bpdR;
+			yi[4 * p] = apcI + bpdI;
+			yr[4 * p + 1] = t1R*c1 - t1I*s1;
+			yi[4 * p + 1] = t1R*s1 + t1I*c1;
+			yr[4 * p + 2] = t2R*c2 - t2I*s2;
+			yi[4 * p + 2] = t2R*s2 + t2I*c2;
+			yr[4 * p + 3] = t3R*c3 - t3I*s3;
+			yi[4 * p + 3] = t3R*s3 + t3I*c3;
+		}
+	}
+
+	/** radix-4 pass for sub-length n at stride s: inner loop runs over s contiguous samples with one set of twiddles */
+	static void radix4Pass(const double* xr, const double* xi, double* yr, double* yi, unsigned int n, unsigned int s,
+						   const double* cosT, const double* sinT, double sign)
+	{
+		const unsigned int m = n / 4;
+		for (unsigned int p = 0; p < m; p++)
+		{
+			// --- W_n^p = W_N^(ps)
+			const unsigned int k = p*s;
+			const double c1 = cosT[k], s1 = sign*sinT[k];
+			const double c2 = cosT[2 * k], s2 = sign*sinT[2 * k];
+			const double c3 = cosT[3 * k], s3 = sign*sinT[3 * k];
+
+			const double* aR = xr + s*p;			const double* aI = xi + s*p;
+			const double* bR = xr + s*(p + m);		const double* bI = xi + s*(p + m);
+			const double* cR = xr + s*(p + 2 * m);	const double* cI = xi + s*(p + 2 * m);
+			const double* dR = xr + s*(p + 3 * m);	const double* dI = xi + s*(p + 3 * m);
+			double* y0R = yr + s * 4 * p;	double* y0I = yi + s * 4 * p;
+			double* y1R = y0R + s;			double* y1I = y0I + s;
+			double* y2R = y1R + s;			double* y2I = y1I + s;
+			double* y3R = y2R + s;			double* y3I = y2I + s;
+
+			for (unsigned int q = 0; q < s; q++)
+			{
+				double apcR = aR[q] + cR[q], apcI = aI[q] + cI[q];
+				double amcR = aR[q] - cR[q], amcI = aI[q] - cI[q];
+				double bpdR = bR[q] + dR[q], bpdI = bI[q] + dI[q];
+				double bmdR = bR[q] - dR[q], bmdI = bI[q] - dI[q];
+
+				double t1R = amcR - sign*bmdI, t1I = amcI + sign*bmdR;
+				double t2R = apcR - bpdR, t2I = apcI - bpdI;
+				double t3R = amcR + sign*bmdI, t3I = amcI - sign*bmdR;
+
+				y0R[q] = apcR + bpdR;
+				y0I[q] = apcI + bpdI;
+				y1R[q] = t1R*c1 - t1I*s1;
+				y1I[q] = t1R*s1 + t1I*c1;
+				y2R[q] = t2R*c2 - t2I*s2;
+				y2I[q] = t2R*s2 + t2I*c2;
+				y3R[q] = t3R*c3 - t3I*s3;
+				y3I[q] = t3R*s3 + t3I*c3;
+			}
+		}
+	}
+
+	/** final radix-2 pass (sub-length 2, all twiddles are 1) */
+	static void radix2LastPass(const double* xr, const double* xi, double* yr, double* yi, unsigned int s)
+	{
+		for (unsigned int q = 0; q < s; q++)
+		{
+			double aR = xr[q], aI = xi[q];
+			double bR = xr[q + s], bI = xi[q + s];
+			yr[q] = aR + bR;
+			yi[q] = aI + bI;
+			yr[q + s] = aR - bR;
+			yi[q + s] = aI - bI;
+		}
+	}
+
+	/** O(N^2) fallback for lengths that are not powers of 2 */
+	void directDFT(const double* inReal, const double* inImag, double* outReal, double* outImag, int direction)
+	{
+		const double sign = direction < 0 ? -1.0 : 1.0;
+		double* sumReal = &workspace[0];
+		double* sumImag = &workspace[(size_t)length];
+		for (unsigned int k = 0; k < length; k++)
+		{
+			double re = 0.0;
+			double im = 0.0;
+			unsigned int index = 0;
+			for (unsigned int n = 0; n < length; n++)
+			{
+				double c = dftCos[index];
+				double s = sign*dftSin[index];
+				re += inReal[n] * c - inImag[n] * s;
+				im += inReal[n] * s + inImag[n] * c;
+
+				// --- nk mod N
+				index += k;
+				if (index >= length)
+					index -= length;
+			}
+			sumReal[k] = re;
+			sumImag[k] = im;
+		}
+
+		for (unsigned int k = 0; k < length; k++)
+		{
+			outReal[k] = sumReal[k];
+			outImag[k] = sumImag[k];
+		}
+	}
+
+	unsigned int length = 0;						///< transform length
+	unsigned int log2Length = 0;					///< ceil(log2(length))
+	const FFTTwiddleTable* twiddles = nullptr;		///< shared twiddles (power-of-2 lengths)
+	std::vector<double> dftCos;						///< direct DFT twiddles (other lengths)
+	std::vector<double> dftSin;						///< direct DFT twiddles (other lengths)
+	std::vector<double> workspace;					///< ping-pong and staging buffers
+};
+
+/**
+\class FFTRealKernel
+\ingroup FFTW-Objects
+\brief
+The FFTRealKernel object performs unscaled real-to-complex and complex-to-real DFTs of one length N, with the same
+conventions as FFTW's r2c and c2r transforms: the spectrum is the half spectrum, bins 0 ... N/2 (N/2 + 1 bins),
+and the inverse returns N times the signal. The imaginary parts of bin 0 and bin N/2 are ignored by the inverse.
+
+Even lengths pack the signal into an N/2 point complex FFT (even samples real, odd samples imaginary) and split
+the result with one pass of N twiddles, so a real transform costs about half of the complex one. Odd lengths
+use a full length complex transform.
+
+Audio I/O:
+- processes real arrays into split or interleaved half spectra and back
+
+Control I/O:
+- initialize( ) sets the length and allocates the workspace; not realtime safe
+
+\version Revision : 1.0
+*/
+class FFTRealKernel
+{
+public:
+	FFTRealKernel() {}		/* C-TOR */
+	~FFTRealKernel() {}		/* D-TOR */
+
+	/** set the transform length N and allocate the workspace */
+	void initialize(unsigned int _length)
+	{
+		length = _length;
+		half = length / 2;
+		packed = length > 1 && (length & 1) == 0;
+
+		cosT = nullptr;
+		sinT = nullptr;
+		splitCos.clear();
+		splitSin.clear();
+
+		if (packed)
+		{
+			kernel.initialize(half);
+
+			// --- W_N^k for k < N/2: the shared table for powers of 2, else our own
+			unsigned int log2Length = 0;
+			while ((1u << log2Length) < length)
+				log2Length++;
+
+			const FFTTwiddleTable* table = (1u << log2Length) == length ? FFTTwiddleTable::getInstance(log2Length) : nullptr;
+			if (table)
+			{
+				cosT = table->getCos();
+				sinT = table->getSin();
+			}
+			else
+			{
+				const double pi = 3.14159265358979323846264338327950288;
+				splitCos.resize(half);
+				splitSin.resize(half);
+				for (unsigned int k = 0; k < half; k++)
+				{
+					splitCos[k] = cos(2.0*pi*k / length);
+					splitSin[k] = sin(2.0*pi*k / length);
+				}
+				cosT = &splitCos[0];
+				sinT = &splitSin[0];
+			}
+			workspace.assign(4 * (size_t)(half + 1), 0.0);
+		}
+		else
+		{
+			kernel.initialize(length);
+			workspace.assign(4 * (size_t)length + 2, 0.0);
+		}
+	}
+
+	/** transform length N */
+	unsigned int getLength() const { return length; }
+
+	/** number of half spectrum bins, N/2 + 1 */
+	unsigned int getSpectrumLength() const { return length / 2 + 1; }
+
+	/** forward transform of N real samples into N/2 + 1 split bins */
+	void realForward(const double* input, double* outReal, double* outImag)
+	{
+		if (length == 0)
+			return;
+
+		if (!packed)
+		{
+			// --- full complex transform, keep the lower half
+			double* re = &workspace[0];
+			double* im = &workspace[(size_t)length];
+			for (unsigned int n = 0; n < length; n++)
+			{
+				re[n] = input[n];
+				im[n] = 0.0;
+			}
+			kernel.transform(re, im, re, im, -1);
+			for (unsigned int k = 0; k <= half; k++)
+			{
+				outReal[k] = re[k];
+				outImag[k] = im[k];
+			}
+			return;
+		}
+
+		// --- z[n] = x[2n] + i x[2n + 1]
+		double* zr = &workspace[0];
+		double* zi = &workspace[(size_t)half];
+		for (unsigned int n = 0; n < half; n++)
+		{
+			zr[n] = input[2 * n];
+			zi[n] = input[2 * n + 1];
+		}
+		kernel.transform(zr, zi, zr, zi, -1);
+
+		// --- X[k] = E + W^k O and X[M - k] = (E - W^k O)*, with E = (Z[k] + Z*[M - k])/2, O = -i(Z[k] - Z*[M - k])/2
+		double dcR = zr[0];
+		double dcI = zi[0];
+		for (unsigned int k = 1; k <= half / 2; k++)
+		{
+			unsigned int j = half - k;
+			double aR = zr[k], aI = zi[k];
+			double bR = zr[j], bI = -zi[j];
+			double eR = 0.5*(aR + bR), eI = 0.5*(aI + bI);
+			double oR = 0.5*(aI - bI), oI = -0.5*(aR - bR);
+			double c = cosT[k], s = sinT[k];
+			double woR = c*oR + s*oI;
+			double woI = c*oI - s*oR;
+			outReal[k] = eR + woR;
+			outImag[k] = eI + woI;
+			outReal[j] = eR - woR;
+			outImag[j] = woI - eI;
+		}
+		outReal[0] = dcR + dcI;
+		outImag[0] = 0.0;
+		outReal[half] = dcR - dcI;
+		outImag[half] = 0.0;
+	}
+
+	/** inverse transform of N/2 + 1 split bins into N real samples (unscaled, N times the signal) */
+	void realInverse(const double* inReal, const double* inImag, double* output)
+	{
+		if (length == 0)
+			return;
+
+		if (!packed)
+		{
+			// --- rebuild the full Hermitian spectrum
+			double* re = &workspace[0];
+			double* im = &workspace[(size_t)length];
+			re[0] = inReal[0];
+			im[0] = 0.0;
+			for (unsigned int k = 1; k <= half; k++)
+			{
+				re[k] = inReal[k];
+				im[k] = inImag[k];
+				re[length - k] = inReal[k];
+				im[length - k] = -inImag[k];
+			}
+			kernel.transform(re, im, re, im, +1);
+			for (unsigned int n = 0; n < length; n++)
+				output[n] = re[n];
+			return;
+		}
+
+		// --- Z[k] = E + i O and Z[M - k] = E* + i O*, with E = X[k] + X*[M - k], O = (X[k] - X*[M - k]) W^-k
+		double* zr = &workspace[0];
+		double* zi = &workspace[(size_t)half];
+		zr[0] = inReal[0] + inReal[half];
+		zi[0] = inReal[0] - inReal[half];
+		for (unsigned int k = 1; k <= half / 2; k++)
+		{
+			unsigned int j = half - k;
+			double aR = inReal[k], aI = inImag[k];
+			double bR = inReal[j], bI = -inImag[j];
+			double eR = aR + bR, eI = aI + bI;
+			double dR = aR - bR, dI = aI - bI;
+			double c = cosT[k], s = sinT[k];
+			double oR = dR*c - dI*s;
+			double oI = dR*s + dI*c;
+			zr[k] = eR - oI;
+			zi[k] = eI + oR;
+			zr[j] = eR + oI;
+			zi[j] = oR - eI;
+		}
+		kernel.transform(zr, zi, zr, zi, +1);
+
+		for (unsigned int n = 0; n < half; n++)
+		{
+			output[2 * n] = zr[n];
+			output[2 * n + 1] = zi[n];
+		}
+	}
+
+	/** forward transform into N/2 + 1 interleaved {re, im} bins */
+	void realForward(const double* input, double(*output)[2])
+	{
+		unsigned int bins = getSpectrumLength();
+		double* re = &workspace[workspace.size() - 2 * (size_t)bins];
+		double* im = re + bins;
+		realForward(input, re, im);
+		for (unsigned int k = 0; k < bins; k++)
+		{
+			output[k][0] = re[k];
+			output[k][1] = im[k];
+		}
+	}
+
+	/** inverse transform of N/2 + 1 interleaved {re, im} bins */
+	void realInverse(const double(*input)[2], double* output)
+	{
+		unsigned int bins = getSpectrumLength();
+		double* re = &workspace[workspace.size() - 2 * (size_t)bins];
+		double* im = re + bins;
+		for (unsigned int k = 0; k < bins; k++)
+		{
+			re[k] = input[k][0];
+			im[k] = input[k][1];
+		}
+		realInverse(re, im, output);
+	}
+
+private:
+	FFTKernel kernel;					///< N/2 point complex transform (N point for odd lengths)
+	unsigned int length = 0;			///< transform length N
+	unsigned int half = 0;				///< N/2
+	bool packed = false;				///< true for even lengths
+	const double* cosT = nullptr;		///< cos(2 pi k / N)
+	const double* sinT = nullptr;		///< sin(2 pi k / N)
+	std::vector<double> splitCos;		///< own twiddles for lengths that are not powers of 2
+	std::vector<double> splitSin;		///< own twiddles for lengths that are not powers of 2
+	std::vector<double> workspace;		///< packed transform and staging buffers
+};
+
+// --- FFTW3 API subset on top of FFTKernel; used when FFTW is not available
+#ifndef HAVE_FFTW
+
+typedef double fftw_complex[2];
+
+/**
+\enum fftKernelPlanType
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to tell the FFTKernelPlan which FFTW planner made it.
+
+- enum class fftKernelPlanType { kComplex, kRealToComplex, kComplexToReal };
+
+\version Revision : 1.0
+*/
+enum class fftKernelPlanType { kComplex, kRealToComplex, kComplexToReal };
+
+/**
+\struct FFTKernelPlan
+\ingroup FFTW-Objects
+\brief
+Stands in for an FFTW plan: the kernel plus the arrays and direction given to fftw_plan_dft_1d( ),
+fftw_plan_dft_r2c_1d( ) or fftw_plan_dft_c2r_1d( ).
+
+\version Revision : 1.0
+*/
+struct FFTKernelPlan
+{
+	fftKernelPlanType type = fftKernelPlanType::kComplex; ///< planner
+	FFTKernel kernel;				///< complex transform
+	FFTRealKernel realKernel;		///< real transforms
+	fftw_complex* input = nullptr;	///< complex input array
+	fftw_complex* output = nullptr;	///< complex output array (may be the input)
+	double* realInput = nullptr;	///< real input array (r2c)
+	double* realOutput = nullptr;	///< real output array (c2r)
+	int sign = -1;					///< FFTW_FORWARD or FFTW_BACKWARD
+};
+
+typedef FFTKernelPlan* fftw_plan;
+
+#define FFTW_FORWARD (-1)
+#define FFTW_BACKWARD (+1)
+#define FFTW_MEASURE (0U)
+#define FFTW_ESTIMATE (1U << 6)
+
+const unsigned int FFT_KERNEL_ALIGNMENT = 64;	///< alignment of fftw_malloc( ) blocks
+
+/** aligned allocation; the original pointer is stored just before the returned block */
+inline void* fftw_malloc(size_t n)
+{
+	void* allocation = malloc(n + FFT_KERNEL_ALIGNMENT + sizeof(void*));
+	if (!allocation)
+		return nullptr;
+
+	uintptr_t start = ((uintptr_t)allocation + sizeof(void*) + FFT_KERNEL_ALIGNMENT - 1) & ~((uintptr_t)FFT_KERNEL_ALIGNMENT - 1);
+	((void**)start)[-1] = allocation;
+	return (void*)start;
+}
+
+/** frees a block from fftw_malloc( ) */
+inline void fftw_free(void* p)
+{
+	if (p)
+		free(((void**)p)[-1]);
+}
+
+/** 1D complex plan; the flags are ignored */
+inline fftw_plan fftw_plan_dft_1d(int n, fftw_complex* in, fftw_complex* out, int sign, unsigned int flags)
+{
+	(void)flags;
+	fftw_plan plan = new FFTKernelPlan;
+	plan->kernel.initialize(n > 0 ? (unsigned int)n : 0);
+	plan->input = in;
+	plan->output = out;
+	plan->sign = sign;
+	return plan;
+}
+
+/** 1D real-to-complex plan: n real inputs, n/2 + 1 complex outputs; the flags are ignored */
+inline fftw_plan fftw_plan_dft_r2c_1d(int n, double* in, fftw_complex* out, unsigned int flags)
+{
+	(void)flags;
+	fftw_plan plan = new FFTKernelPlan;
+	plan->type = fftKernelPlanType::kRealToComplex;
+	plan->realKernel.initialize(n > 0 ? (unsigned int)n : 0);
+	plan->realInput = in;
+	plan->output = out;
+	return plan;
+}
+
+/** 1D complex-to-real plan: n/2 + 1 complex inputs, n real outputs (unscaled); the flags are ignored */
+inline fftw_plan fftw_plan_dft_c2r_1d(int n, fftw_complex* in, double* out, unsigned int flags)
+{
+	(void)flags;
+	fftw_plan plan = new FFTKernelPlan;
+	plan->type = fftKernelPlanType::kComplexToReal;
+	plan->realKernel.initialize(n > 0 ? (unsigned int)n : 0);
+	plan->input = in;
+	plan->realOutput = out;
+	plan->sign = FFTW_BACKWARD;
+	return plan;
+}
+
+/** run the plan on its arrays */
+inline void fftw_execute(const fftw_plan plan)
+{
+	if (!plan)
+		return;
+
+	if (plan->type == fftKernelPlanType::kRealToComplex)
+		plan->realKernel.realForward(plan->realInput, plan->output);
+	else if (plan->type == fftKernelPlanType::kComplexToReal)
+		plan->realKernel.realInverse(plan->input, plan->realOutput);
+	else
+		plan->kernel.transform(plan->input, plan->output, plan->sign);
+}
+
+/** destroy the plan */
+inline void fftw_destroy_plan(fftw_plan plan)
+{
+	delete plan;
+}
+
+#endif // HAVE_FFTW
+
+#endif // __fftkernel_h__
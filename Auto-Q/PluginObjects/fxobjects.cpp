@@ -17,8 +17,14 @@
 // -----------------------------------------------------------------------------
 #include <memory>
 #include <math.h>
+#include <stdlib.h>
+#include <chrono>
 #include "fxobjects.h"
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 /**
 \brief returns the storage component S(n) for delay-free loop solutions
 
@@ -1042,15 +1048,143 @@ const SignalGenData LFO::renderAudioOutput()
 	return output;
 }
 
+/**
+\brief renders a block of LFO output; the timebase runs first (it wraps, so it is serial) and the
+waveshaping runs over the whole block in plain loops that the compiler can vectorize
+
+\param normalOutput - array of numSamples normal outputs
+\param quadPhaseOutput - array of numSamples +90 degree outputs, or nullptr
+\param numSamples - block length
+*/
+void LFO::renderAudioBlock(double* normalOutput, double* quadPhaseOutput, unsigned int numSamples)
+{
+	// --- timebase: store the modulo counters
+	for (unsigned int i = 0; i < numSamples; i++)
+	{
+		checkAndWrapModulo(modCounter, phaseInc);
+		normalOutput[i] = modCounter;
+
+		if (quadPhaseOutput)
+		{
+			modCounterQP = modCounter;
+			advanceAndCheckWrapModulo(modCounterQP, 0.25);
+			quadPhaseOutput[i] = modCounterQP;
+		}
+
+		advanceModulo(modCounter, phaseInc);
+	}
+
+	// --- waveshaping, in place
+	unsigned int numOutputs = quadPhaseOutput ? 2 : 1;
+	for (unsigned int j = 0; j < numOutputs; j++)
+	{
+		double* output = j == 0 ? normalOutput : quadPhaseOutput;
+
+		if (lfoParameters.waveform == generatorWaveform::kSin)
+		{
+			for (unsigned int i = 0; i < numSamples; i++)
+				output[i] = parabolicSine(-(output[i] * 2.0*kPi - kPi));
+		}
+		else if (lfoParameters.waveform == generatorWaveform::kTriangle)
+		{
+			for (unsigned int i = 0; i < numSamples; i++)
+				output[i] = 2.0*fabs(unipolarToBipolar(output[i])) - 1.0;
+		}
+		else if (lfoParameters.waveform == generatorWaveform::kSaw)
+		{
+			for (unsigned int i = 0; i < numSamples; i++)
+				output[i] = unipolarToBipolar(output[i]);
+		}
+		else
+			memset(output, 0, numSamples * sizeof(double));
+	}
+}
+
+/**
+\brief creates the arena memory, or reuses the current allocation if it is big enough, and starts a new layout
+
+- NOTES:\n
+with useHugePages on Linux, arenas of 2MB or more are mmap'ed and advised for transparent huge pages; otherwise
+the memory is malloc'ed with room to align the start to DELAY_ARENA_ALIGNMENT
+
+\param numBytes - total bytes, see DelayMemoryArena::getAllocationSize( )
+\param useHugePages - request huge pages, if the system has them
+
+\returns true if the existing allocation was reused
+*/
+bool DelayMemoryArena::createArena(size_t numBytes, bool useHugePages)
+{
+	// --- new layout either way
+	layout++;
+	offset = 0;
+
+#if defined(__linux__)
+	const size_t hugePageSize = 2 * 1024 * 1024;
+	bool hugePages = useHugePages && numBytes >= hugePageSize;
+#else
+	bool hugePages = false;
+#endif
+
+	if (memory && numBytes <= capacity && (usesHugePages || !hugePages))
+		return true;
+
+	destroyArena();
+
+#if defined(__linux__)
+	if (hugePages)
+	{
+		size_t size = (numBytes + hugePageSize - 1) & ~(hugePageSize - 1);
+		void* block = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (block != MAP_FAILED)
+		{
+			madvise(block, size, MADV_HUGEPAGE);
+			allocation = block;
+			allocationSize = size;
+			memory = (char*)block;
+			capacity = size;
+			usesHugePages = true;
+			return false;
+		}
+	}
+#endif
+
+	// --- over-allocate and align the start
+	allocation = malloc(numBytes + DELAY_ARENA_ALIGNMENT);
+	if (!allocation)
+		return false;
+
+	allocationSize = numBytes + DELAY_ARENA_ALIGNMENT;
+	uintptr_t start = ((uintptr_t)allocation + DELAY_ARENA_ALIGNMENT - 1) & ~((uintptr_t)DELAY_ARENA_ALIGNMENT - 1);
+	memory = (char*)start;
+	capacity = numBytes;
+	return false;
+}
+
+/**
+\brief frees the arena memory
+*/
+void DelayMemoryArena::destroyArena()
+{
+#if defined(__linux__)
+	if (usesHugePages && allocation)
+		munmap(allocation, allocationSize);
+	else
+#endif
+	free(allocation);
+
+	allocation = nullptr;
+	allocationSize = 0;
+	memory = nullptr;
+	capacity = 0;
+	usesHugePages = false;
+}
 
-#ifdef HAVE_FFTW
 
 /**
 \brief destroys the FFTW arrays and plans.
 */
 void FastFFT::destroyFFTW()
 {
-#ifdef HAVE_FFTW
 	if (plan_forward)
 		fftw_destroy_plan(plan_forward);
 	if (plan_backward)
@@ -1065,7 +1199,33 @@ void FastFFT::destroyFFTW()
 		fftw_free(ifft_input);
 	if (ifft_result)
 		fftw_free(ifft_result);
-#endif
+
+	if (plan_real_forward)
+		fftw_destroy_plan(plan_real_forward);
+	if (plan_real_backward)
+		fftw_destroy_plan(plan_real_backward);
+
+	if (real_input)
+		fftw_free(real_input);
+	if (half_result)
+		fftw_free(half_result);
+	if (half_input)
+		fftw_free(half_input);
+	if (real_result)
+		fftw_free(real_result);
+
+	plan_forward = nullptr;
+	plan_backward = nullptr;
+	plan_real_forward = nullptr;
+	plan_real_backward = nullptr;
+	fft_input = nullptr;
+	fft_result = nullptr;
+	ifft_input = nullptr;
+	ifft_result = nullptr;
+	real_input = nullptr;
+	half_result = nullptr;
+	half_input = nullptr;
+	real_result = nullptr;
 }
 
 
@@ -1102,7 +1262,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	// --- WP: this is why denominators are (frameLength) rather than (frameLength - 1)
 	if (window == windowType::kRectWindow)
 	{
-		for (int n = 0; n < frameLength - 1; n++)
+		for (unsigned int n = 0; n < frameLength - 1; n++)
 		{
 			windowBuffer[n] = 1.0;
 			windowGainCorrection += windowBuffer[n];
@@ -1110,7 +1270,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	}
 	else if (window == windowType::kHammingWindow)
 	{
-		for (int n = 0; n < frameLength - 1; n++)
+		for (unsigned int n = 0; n < frameLength - 1; n++)
 		{
 			windowBuffer[n] = 0.54 - 0.46*cos((n*2.0*kPi) / (frameLength));
 			windowGainCorrection += windowBuffer[n];
@@ -1118,7 +1278,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	}
 	else if (window == windowType::kHannWindow)
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = 0.5 * (1 - cos((n*2.0*kPi) / (frameLength)));
 			windowGainCorrection += windowBuffer[n];
@@ -1126,7 +1286,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	}
 	else if (window == windowType::kBlackmanHarrisWindow)
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = (0.42323 - (0.49755*cos((n*2.0*kPi) / (frameLength))) + 0.07922*cos((2 * n*2.0*kPi) / (frameLength)));
 			windowGainCorrection += windowBuffer[n];
@@ -1134,7 +1294,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	}
 	else if (window == windowType::kNoWindow)
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = 1.0;
 			windowGainCorrection += windowBuffer[n];
@@ -1142,7 +1302,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	}
 	else // --- default to kNoWindow
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = 1.0;
 			windowGainCorrection += windowBuffer[n];
@@ -1161,6 +1321,15 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 
 	plan_forward = fftw_plan_dft_1d(frameLength, fft_input, fft_result, FFTW_FORWARD, FFTW_ESTIMATE);
 	plan_backward = fftw_plan_dft_1d(frameLength, ifft_input, ifft_result, FFTW_BACKWARD, FFTW_ESTIMATE);
+
+	// --- real transforms: N real points <-> N/2 + 1 bins
+	real_input = (double*)fftw_malloc(sizeof(double) * frameLength);
+	half_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * getSpectrumLength());
+	half_input = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * getSpectrumLength());
+	real_result = (double*)fftw_malloc(sizeof(double) * frameLength);
+
+	plan_real_forward = fftw_plan_dft_r2c_1d(frameLength, real_input, half_result, FFTW_ESTIMATE);
+	plan_real_backward = fftw_plan_dft_c2r_1d(frameLength, half_input, real_result, FFTW_ESTIMATE);
 }
 
 /**
@@ -1176,7 +1345,7 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 fftw_complex* FastFFT::doFFT(double* inputReal, double* inputImag)
 {
 	// ------ load up the FFT input array
-	for (int i = 0; i < frameLength; i++)
+	for (unsigned int i = 0; i < frameLength; i++)
 	{
 		fft_input[i][0] = inputReal[i];		// --- real
 		if (inputImag)
@@ -1204,7 +1373,7 @@ fftw_complex* FastFFT::doFFT(double* inputReal, double* inputImag)
 fftw_complex* FastFFT::doInverseFFT(double* inputReal, double* inputImag)
 {
 	// ------ load up the iFFT input array
-	for (int i = 0; i < frameLength; i++)
+	for (unsigned int i = 0; i < frameLength; i++)
 	{
 		ifft_input[i][0] = inputReal[i];		// --- real
 		if (inputImag)
@@ -1219,6 +1388,50 @@ fftw_complex* FastFFT::doInverseFFT(double* inputReal, double* inputImag)
 	return ifft_result;
 }
 
+/**
+\brief perform the FFT of a real input
+
+- NOTES:<br>
+A real signal has a conjugate-symmetric spectrum, so only bins 0 ... N/2 are computed;
+this takes about half the time of doFFT( ).<br>
+
+\param input an array of frameLength real valued points
+
+\returns a pointer to a fftw_complex array of getSpectrumLength( ) = N/2 + 1 bins
+*/
+fftw_complex* FastFFT::doRealFFT(double* input)
+{
+	// ------ load up the FFT input array
+	memcpy(&real_input[0], &input[0], frameLength * sizeof(double));
+
+	// --- do the FFT
+	fftw_execute(plan_real_forward);
+
+	return half_result;
+}
+
+/**
+\brief perform the IFFT of a half spectrum
+
+- NOTES:<br>
+The input is copied first, since FFTW's complex-to-real transforms overwrite their input.
+The imaginary parts of bin 0 and bin N/2 are ignored. Like doInverseFFT( ), the output is not scaled by 1/N.<br>
+
+\param halfSpectrum an array of getSpectrumLength( ) = N/2 + 1 bins
+
+\returns a pointer to an array of frameLength real valued points
+*/
+double* FastFFT::doRealInverseFFT(fftw_complex* halfSpectrum)
+{
+	// ------ load up the iFFT input array
+	memcpy(&half_input[0][0], &halfSpectrum[0][0], getSpectrumLength() * sizeof(fftw_complex));
+
+	// --- do the IFFT
+	fftw_execute(plan_real_backward);
+
+	return real_result;
+}
+
 /**
 \brief destroys the FFTW arrays and plans.
 */
@@ -1235,6 +1448,12 @@ void PhaseVocoder::destroyFFTW()
 		fftw_free(fft_result);
 	if (ifft_result)
 		fftw_free(ifft_result);
+
+	plan_forward = nullptr;
+	plan_backward = nullptr;
+	fft_input = nullptr;
+	fft_result = nullptr;
+	ifft_result = nullptr;
 }
 
 /**
@@ -1303,7 +1522,7 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	// --- WP: this is why denominators are (frameLength) rather than (frameLength - 1)
 	if (window == windowType::kRectWindow)
 	{
-		for (int n = 0; n < frameLength - 1; n++)
+		for (unsigned int n = 0; n < frameLength - 1; n++)
 		{
 			windowBuffer[n] = 1.0;
 			windowHopCorrection += windowBuffer[n];
@@ -1311,7 +1530,7 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	}
 	else if (window == windowType::kHammingWindow)
 	{
-		for (int n = 0; n < frameLength - 1; n++)
+		for (unsigned int n = 0; n < frameLength - 1; n++)
 		{
 			windowBuffer[n] = 0.54 - 0.46*cos((n*2.0*kPi) / (frameLength));
 			windowHopCorrection += windowBuffer[n];
@@ -1319,7 +1538,7 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	}
 	else if (window == windowType::kHannWindow)
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = 0.5 * (1 - cos((n*2.0*kPi) / (frameLength)));
 			windowHopCorrection += windowBuffer[n];
@@ -1327,7 +1546,7 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	}
 	else if (window == windowType::kBlackmanHarrisWindow)
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = (0.42323 - (0.49755*cos((n*2.0*kPi) / (frameLength))) + 0.07922*cos((2 * n*2.0*kPi) / (frameLength)));
 			windowHopCorrection += windowBuffer[n];
@@ -1335,7 +1554,7 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	}
 	else if (window == windowType::kNoWindow)
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = 1.0;
 			windowHopCorrection += windowBuffer[n];
@@ -1343,7 +1562,7 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	}
 	else // --- default to kNoWindow
 	{
-		for (int n = 0; n < frameLength; n++)
+		for (unsigned int n = 0; n < frameLength; n++)
 		{
 			windowBuffer[n] = 1.0;
 			windowHopCorrection += windowBuffer[n];
@@ -1369,15 +1588,14 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	needInverseFFT = false;
 	needOverlapAdd = false;
 
-#ifdef HAVE_FFTW
+	// --- real input and output: N real points <-> N/2 + 1 bins
 	destroyFFTW();
-	fft_input = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
-	fft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
-	ifft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
+	fft_input = (double*)fftw_malloc(sizeof(double) * frameLength);
+	fft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * getSpectrumLength());
+	ifft_result = (double*)fftw_malloc(sizeof(double) * frameLength);
 
-	plan_forward = fftw_plan_dft_1d(frameLength, fft_input, fft_result, FFTW_FORWARD, FFTW_ESTIMATE);
-	plan_backward = fftw_plan_dft_1d(frameLength, fft_result, ifft_result, FFTW_BACKWARD, FFTW_ESTIMATE);
-#endif
+	plan_forward = fftw_plan_dft_r2c_1d(frameLength, fft_input, fft_result, FFTW_ESTIMATE);
+	plan_backward = fftw_plan_dft_c2r_1d(frameLength, fft_result, ifft_result, FFTW_ESTIMATE);
 }
 
 /**
@@ -1429,10 +1647,9 @@ bool PhaseVocoder::advanceAndCheckFFT()
 
 	// --- we have a FFT ready
 	// --- load up the input to the FFT
-	for (int i = 0; i < frameLength; i++)
+	for (unsigned int i = 0; i < frameLength; i++)
 	{
-		fft_input[i][0] = inputBuffer[inputReadIndex++] * windowBuffer[i];
-		fft_input[i][1] = 0.0; // use this if your data is complex valued
+		fft_input[i] = inputBuffer[inputReadIndex++] * windowBuffer[i];
 
 		// --- wrap if index > bufferlength - 1
 		inputReadIndex &= wrapMask;
@@ -1510,7 +1727,8 @@ double PhaseVocoder::processAudioSample(double input, bool& fftReady)
 
 - NOTES:<br>
 This function is optional - if you need to sequence the output (synthesis) stage yourself <br>
-then you can call this function at the appropriate time - see the PSMVocoder object for an example
+then you can call this function at the appropriate time - see the PSMVocoder object for an example<br>
+The complex-to-real transform may overwrite the FFT data (FFTW does), so finish with it first.
 
 */
 void PhaseVocoder::doInverseFFT()
@@ -1552,10 +1770,10 @@ void PhaseVocoder::doOverlapAdd(double* outputData, int length)
 		return;
 	}
 
-	for (int i = 0; i < frameLength; i++)
+	for (unsigned int i = 0; i < frameLength; i++)
 	{
 		// --- accumulate
-		outputBuffer[outputWriteIndex++] += windowHopCorrection * ifft_result[i][0];
+		outputBuffer[outputWriteIndex++] += windowHopCorrection * ifft_result[i];
 
 		// --- wrap if index > bufferlength - 1
 		outputWriteIndex &= wrapMaskOut;
@@ -1565,5 +1783,484 @@ void PhaseVocoder::doOverlapAdd(double* outputData, int length)
 	needOverlapAdd = false;
 }
 
-#endif
+/**
+\brief destroys the FFTW arrays and plans.
+*/
+void PartitionedConvolver::destroyFFTW()
+{
+	if (plan_forward)
+		fftw_destroy_plan(plan_forward);
+	if (plan_backward)
+		fftw_destroy_plan(plan_backward);
+
+	if (fft_input)
+		fftw_free(fft_input);
+	if (fft_result)
+		fftw_free(fft_result);
+	if (ifft_input)
+		fftw_free(ifft_input);
+	if (ifft_result)
+		fftw_free(ifft_result);
+
+	plan_forward = nullptr;
+	plan_backward = nullptr;
+	fft_input = nullptr;
+	fft_result = nullptr;
+	ifft_input = nullptr;
+	ifft_result = nullptr;
+}
+
+/**
+\brief flush the signal history, the FDL and the pending output; the IR is kept
+
+\param _sampleRate the sample rate (not used)
+*/
+bool PartitionedConvolver::reset(double /*_sampleRate*/)
+{
+	if (numPartitions == 0)
+		return true;
+
+	memset(&fft_input[0], 0, 2 * partitionSize * sizeof(double));
+	memset(&fdlReal[0], 0, numPartitions * binStride * sizeof(double));
+	memset(&fdlImag[0], 0, numPartitions * binStride * sizeof(double));
+	memset(&outputBlock[0], 0, partitionSize * sizeof(double));
+	fdlIndex = 0;
+	inputCount = 0;
+
+	return true;
+}
+
+/**
+\brief set the partition size B, which is also the latency, and re-partition the current IR
+
+- NOTES:<br>
+allocates, so this is not realtime safe; the signal history is flushed<br>
+
+\param _partitionSize the partition size - MUST be a power of 2
+*/
+void PartitionedConvolver::setPartitionSize(unsigned int _partitionSize)
+{
+	if (_partitionSize == partitionSize || _partitionSize == 0)
+		return;
+
+	partitionSize = _partitionSize;
+	if (numPartitions == 0)
+		return;
+
+	// --- keep the IR across the re-init
+	std::unique_ptr<double[]> ir = std::move(impulseResponse);
+	init(irLength);
+	setImpulseResponse(&ir[0], irLength);
+}
+
+/**
+\brief create the buffers, FDL and plans for an IR length; the IR is cleared
+
+\param _irLength the IR length; any length, it is split into ceil(length / B) partitions
+*/
+void PartitionedConvolver::init(unsigned int _irLength)
+{
+	irLength = _irLength;
+	numPartitions = std::max(1u, (irLength + partitionSize - 1) / partitionSize);
+	binCount = partitionSize + 1;
+	binStride = (binCount + 3) & ~3u;
+
+	unsigned int spectrumSize = numPartitions * binStride;
+	irReal.reset(new double[spectrumSize]);
+	irImag.reset(new double[spectrumSize]);
+	fdlReal.reset(new double[spectrumSize]);
+	fdlImag.reset(new double[spectrumSize]);
+	accReal.reset(new double[binStride]);
+	accImag.reset(new double[binStride]);
+	outputBlock.reset(new double[partitionSize]);
+	impulseResponse.reset(new double[numPartitions * partitionSize]);
+
+	memset(&irReal[0], 0, spectrumSize * sizeof(double));
+	memset(&irImag[0], 0, spectrumSize * sizeof(double));
+	memset(&impulseResponse[0], 0, numPartitions * partitionSize * sizeof(double));
+
+	destroyFFTW();
+	fft_input = (double*)fftw_malloc(sizeof(double) * 2 * partitionSize);
+	fft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * binCount);
+	ifft_input = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * binCount);
+	ifft_result = (double*)fftw_malloc(sizeof(double) * 2 * partitionSize);
+
+	plan_forward = fftw_plan_dft_r2c_1d(2 * partitionSize, fft_input, fft_result, FFTW_ESTIMATE);
+	plan_backward = fftw_plan_dft_c2r_1d(2 * partitionSize, ifft_input, ifft_result, FFTW_ESTIMATE);
+
+	reset(0.0);
+}
+
+/**
+\brief set the impulse response and transform its partitions
+
+- NOTES:<br>
+re-creates the buffers (not realtime safe) only if the length changed; otherwise the signal history is kept
+and the new IR takes effect with the next output block<br>
+
+\param irArray the IR
+\param _irLength the IR length
+*/
+void PartitionedConvolver::setImpulseResponse(double* irArray, unsigned int _irLength)
+{
+	if (!irArray)
+		return;
+
+	if (_irLength != irLength || numPartitions == 0)
+		init(_irLength);
+
+	memcpy(&impulseResponse[0], &irArray[0], irLength * sizeof(double));
+	transformIR();
+}
+
+/**
+\brief transform each B sample partition of the IR, zero padded to 2B, into its spectrum;
+the 1/2B IFFT scaling is folded into the spectra
+*/
+void PartitionedConvolver::transformIR()
+{
+	// --- the input window holds the signal history; the IR is transformed through the same plan
+	std::unique_ptr<double[]> history(new double[2 * partitionSize]);
+	memcpy(&history[0], &fft_input[0], 2 * partitionSize * sizeof(double));
+
+	double scale = 1.0 / (2.0 * partitionSize);
+	for (unsigned int p = 0; p < numPartitions; p++)
+	{
+		memcpy(&fft_input[0], &impulseResponse[p * partitionSize], partitionSize * sizeof(double));
+		memset(&fft_input[partitionSize], 0, partitionSize * sizeof(double));
+		fftw_execute(plan_forward);
+
+		double* hR = &irReal[p * binStride];
+		double* hI = &irImag[p * binStride];
+		for (unsigned int k = 0; k < binCount; k++)
+		{
+			hR[k] = scale*fft_result[k][0];
+			hI[k] = scale*fft_result[k][1];
+		}
+	}
+
+	memcpy(&fft_input[0], &history[0], 2 * partitionSize * sizeof(double));
+}
+
+/**
+\brief process one partition: push the spectrum of the newest 2B inputs into the FDL, multiply-add it
+with the IR spectra and IFFT; the last B points of the IFFT are the next output block (overlap-save)
+*/
+void PartitionedConvolver::processPartition()
+{
+	// --- input spectrum into the next FDL row
+	fftw_execute(plan_forward);
+
+	fdlIndex = fdlIndex + 1 < numPartitions ? fdlIndex + 1 : 0;
+	double* xR = &fdlReal[fdlIndex * binStride];
+	double* xI = &fdlImag[fdlIndex * binStride];
+	for (unsigned int k = 0; k < binCount; k++)
+	{
+		xR[k] = fft_result[k][0];
+		xI[k] = fft_result[k][1];
+	}
+
+	// --- Y = sum of FDL[n - p] x H[p]
+	double* yR = &accReal[0];
+	double* yI = &accImag[0];
+	memset(yR, 0, binCount * sizeof(double));
+	memset(yI, 0, binCount * sizeof(double));
+
+	unsigned int row = fdlIndex;
+	for (unsigned int p = 0; p < numPartitions; p++)
+	{
+		const double* sR = &fdlReal[row * binStride];
+		const double* sI = &fdlImag[row * binStride];
+		const double* hR = &irReal[p * binStride];
+		const double* hI = &irImag[p * binStride];
+
+		for (unsigned int k = 0; k < binCount; k++)
+		{
+			yR[k] += sR[k] * hR[k] - sI[k] * hI[k];
+			yI[k] += sR[k] * hI[k] + sI[k] * hR[k];
+		}
+
+		row = row > 0 ? row - 1 : numPartitions - 1;
+	}
+
+	// --- back to time; the first B points are circular wrap-around and are discarded
+	for (unsigned int k = 0; k < binCount; k++)
+	{
+		ifft_input[k][0] = yR[k];
+		ifft_input[k][1] = yI[k];
+	}
+	fftw_execute(plan_backward);
+	memcpy(&outputBlock[0], &ifft_result[partitionSize], partitionSize * sizeof(double));
+
+	// --- slide the input window by one block
+	memcpy(&fft_input[0], &fft_input[partitionSize], partitionSize * sizeof(double));
+}
+
+/**
+\brief set up the segment; reset( ) MUST be called before processing, it also starts the worker
+
+\param _partitionSize the partition size B - MUST be a power of 2
+\param irArray the start of this segment's piece of the IR
+\param irLength the length of the piece
+\param _useWorker true: process on the worker thread, false: inline on the audio thread
+*/
+void ConvolverTailSegment::initialize(unsigned int _partitionSize, double* irArray, unsigned int irLength, bool _useWorker)
+{
+	stopWorker();
+
+	partitionSize = _partitionSize;
+	useWorker = _useWorker;
+	convolver.setPartitionSize(partitionSize);
+	convolver.setImpulseResponse(irArray, irLength);
+
+	inputSlots.reset(new double[CONVOLVER_SEGMENT_SLOTS * partitionSize]);
+	outputSlots.reset(new double[CONVOLVER_SEGMENT_SLOTS * partitionSize]);
+	zeroBlock.reset(new double[partitionSize]);
+	memset(&zeroBlock[0], 0, partitionSize * sizeof(double));
+}
+
+/**
+\brief flush the history and the hand-off counters and (re)start the worker
+
+\param _sampleRate the sample rate, for the deadline usage; 0 to skip the timing
+*/
+void ConvolverTailSegment::reset(double _sampleRate)
+{
+	stopWorker();
+	if (partitionSize == 0)
+		return;
+
+	blockPeriod = _sampleRate > 0.0 ? partitionSize / _sampleRate : 0.0;
+	pollPeriod = blockPeriod > 0.0 ? blockPeriod / CONVOLVER_WORKER_POLLS : 0.001;
+	convolver.reset(_sampleRate);
+	memset(&inputSlots[0], 0, CONVOLVER_SEGMENT_SLOTS * partitionSize * sizeof(double));
+	memset(&outputSlots[0], 0, CONVOLVER_SEGMENT_SLOTS * partitionSize * sizeof(double));
+
+	submittedBlocks.store(0);
+	completedBlocks.store(0);
+	missedDeadlines.store(0);
+	worstDeadlineUsage.store(0.0);
+
+	sampleCount = 0;
+	writeBlock = getInputSlot(0);
+	playBlock = &zeroBlock[0];
+
+	if (useWorker)
+		startWorker();
+}
+
+/**
+\brief start the worker thread
+*/
+void ConvolverTailSegment::startWorker()
+{
+	workerRunning.store(true);
+	worker = std::thread(&ConvolverTailSegment::workerLoop, this);
+}
+
+/**
+\brief stop and join the worker thread, which exits at its next poll; blocks still pending are left unprocessed
+*/
+void ConvolverTailSegment::stopWorker()
+{
+	if (!worker.joinable())
+		return;
+
+	workerRunning.store(false);
+	worker.join();
+}
+
+/**
+\brief called by the audio thread when a block is full: hand it to the worker (or process it inline)
+and play the previous block, if the worker finished it in time
+
+- NOTES:<br>
+never blocks; a late block is played as silence and counted as a missed deadline. If the worker is so far
+behind that the next input slot is still in use, the block is dropped (also counted) and its slot refilled.<br>
+*/
+void ConvolverTailSegment::submitBlock()
+{
+	sampleCount = 0;
+	unsigned int block = submittedBlocks.load(std::memory_order_relaxed);
+
+	if (useWorker)
+	{
+		if (block - completedBlocks.load(std::memory_order_acquire) >= CONVOLVER_SEGMENT_SLOTS - 1)
+		{
+			missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+			playBlock = &zeroBlock[0];
+			return;
+		}
+
+		// --- publish only; no signalling from the audio thread, the worker polls (see workerLoop( ))
+		submittedBlocks.store(block + 1, std::memory_order_release);
+	}
+	else
+	{
+		convolver.processPartitionBlock(getInputSlot(block), getOutputSlot(block));
+		submittedBlocks.store(block + 1, std::memory_order_relaxed);
+		completedBlocks.store(block + 1, std::memory_order_relaxed);
+	}
+
+	// --- the previous block had one block period to finish
+	if (block == 0)
+		playBlock = &zeroBlock[0];
+	else if (completedBlocks.load(std::memory_order_acquire) >= block)
+		playBlock = getOutputSlot(block - 1);
+	else
+	{
+		missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+		playBlock = &zeroBlock[0];
+	}
+
+	writeBlock = getInputSlot(block + 1);
+}
+
+/**
+\brief the worker thread: convolve the submitted blocks in order and time them against the block period
+
+- NOTES:<br>
+when idle it sleeps for pollPeriod (1/CONVOLVER_WORKER_POLLS of a block period), so a new block waits at most
+that long to start and the audio thread never has to wake the worker<br>
+*/
+void ConvolverTailSegment::workerLoop()
+{
+	while (workerRunning.load(std::memory_order_acquire))
+	{
+		unsigned int block = completedBlocks.load(std::memory_order_relaxed);
+		if (block == submittedBlocks.load(std::memory_order_acquire))
+		{
+			std::this_thread::sleep_for(std::chrono::duration<double>(pollPeriod));
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		convolver.processPartitionBlock(getInputSlot(block), getOutputSlot(block));
+		completedBlocks.store(block + 1, std::memory_order_release);
+
+		if (blockPeriod > 0.0)
+		{
+			double usage = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / blockPeriod;
+			if (usage > worstDeadlineUsage.load(std::memory_order_relaxed))
+				worstDeadlineUsage.store(usage, std::memory_order_relaxed);
+		}
+	}
+}
+
+/**
+\brief flush the head and all tail segments and restart the workers; the IR is kept
+
+\param _sampleRate the sample rate, for the deadline usage
+*/
+bool NonUniformConvolver::reset(double _sampleRate)
+{
+	sampleRate = _sampleRate;
+	headConvolver.reset(_sampleRate);
+	for (unsigned int i = 0; i < numTailSegments; i++)
+		tailSegments[i].reset(_sampleRate);
+
+	return true;
+}
+
+/**
+\brief set the IR and lay out the head and tail segments
+
+- NOTES:<br>
+stops and starts the worker threads and allocates; not realtime safe<br>
+
+\param irArray the IR
+\param _irLength the IR length
+*/
+void NonUniformConvolver::setImpulseResponse(double* irArray, unsigned int _irLength)
+{
+	if (!irArray)
+		return;
+
+	irLength = _irLength;
+	impulseResponse.reset(new double[irLength]);
+	memcpy(&impulseResponse[0], &irArray[0], irLength * sizeof(double));
+	partitionIR();
+}
+
+/**
+\brief set the head partition size B, which is also the latency, and re-partition the current IR
+
+\param _headPartitionSize the head partition size - MUST be a power of 2
+*/
+void NonUniformConvolver::setHeadPartitionSize(unsigned int _headPartitionSize)
+{
+	if (_headPartitionSize == headPartitionSize || _headPartitionSize == 0)
+		return;
+
+	headPartitionSize = _headPartitionSize;
+	if (impulseResponse)
+		partitionIR();
+}
+
+/**
+\brief set the largest host buffer, i.e. the most samples processed per callback, and re-partition the current IR;
+tail segments with a partition size below twice that run inline, see NonUniformConvolver
+
+\param _maxHostBlockSize the largest host buffer
+*/
+void NonUniformConvolver::setMaxHostBlockSize(unsigned int _maxHostBlockSize)
+{
+	if (_maxHostBlockSize == maxHostBlockSize || _maxHostBlockSize == 0)
+		return;
+
+	maxHostBlockSize = _maxHostBlockSize;
+	if (impulseResponse)
+		partitionIR();
+}
+
+/**
+\brief run the tail on worker threads or inline on the audio thread
+
+\param _useWorkerThreads true: worker threads (realtime), false: inline (offline rendering)
+*/
+void NonUniformConvolver::setUseWorkerThreads(bool _useWorkerThreads)
+{
+	if (_useWorkerThreads == useWorkerThreads)
+		return;
+
+	useWorkerThreads = _useWorkerThreads;
+	if (impulseResponse)
+		partitionIR();
+}
+
+/**
+\brief cut the IR into the head (3 partitions of B) and the tail segments: 2 partitions each of 2B, 4B, ...,
+with the last segment, at MAX_CONVOLVER_PARTITION, taking the rest. A segment of size Bk has a delay of 2Bk
+and starts at IR offset 2Bk - B, so all segments line up with the head latency of B. Segments with Bk below twice
+the max host block size run inline.
+*/
+void NonUniformConvolver::partitionIR()
+{
+	for (unsigned int i = 0; i < MAX_CONVOLVER_SEGMENTS; i++)
+		tailSegments[i].stopWorker();
+	numTailSegments = 0;
+
+	inputBlock.reset(new double[headPartitionSize]);
+
+	unsigned int headLength = irLength;
+	if (headPartitionSize < MAX_CONVOLVER_PARTITION)
+		headLength = std::min(irLength, 3 * headPartitionSize);
+
+	headConvolver.setPartitionSize(headPartitionSize);
+	headConvolver.setImpulseResponse(&impulseResponse[0], headLength);
+
+	unsigned int offset = headLength;
+	for (unsigned int size = 2 * headPartitionSize; offset < irLength && size <= MAX_CONVOLVER_PARTITION; size *= 2)
+	{
+		unsigned int length = irLength - offset;
+		if (size < MAX_CONVOLVER_PARTITION && numTailSegments + 1 < MAX_CONVOLVER_SEGMENTS)
+			length = std::min(length, 2 * size);
+
+		bool useWorker = useWorkerThreads && size >= 2 * maxHostBlockSize;
+		tailSegments[numTailSegments++].initialize(size, &impulseResponse[offset], length, useWorker);
+		offset += length;
+	}
+
+	reset(sampleRate);
+}
 
@@ -56,20 +56,14 @@ PluginCore::PluginCore()
 
 void PluginCore::updateParameters()
 {
-    AnalogToneParameters toneParams = analogToneControls[0].getParameters();
-    for (auto& analogToneControl : analogToneControls)
-    {
-        toneParams.tone = tone;
-        toneParams.level = level;
-        analogToneControl.setParameters(toneParams);
-    }
-
-    AnalogClipperParameters clipperParams = analogClippingStages[0].getParameters();
-    for (auto& analogClippingStage : analogClippingStages)
-    {
-        clipperParams.drive = drive;
-        analogClippingStage.setParameters(clipperParams);
-    }
+    AnalogToneParameters toneParams = analogToneControl.getParameters();
+    toneParams.tone = tone;
+    toneParams.level = level;
+    analogToneControl.setParameters(toneParams);
+
+    AnalogClipperParameters clipperParams = analogClippingStage.getParameters();
+    clipperParams.drive = drive;
+    analogClippingStage.setParameters(clipperParams);
 }
 
 /**
@@ -90,11 +84,8 @@ bool PluginCore::reset(ResetInfo& resetInfo)
     audioProcDescriptor.bitDepth = resetInfo.bitDepth;
 
     // --- other reset inits
-	for (unsigned int i = 0; i < NUM_CHANNELS; i++)
-    {
-    	analogToneControls[i].reset(resetInfo.sampleRate);
-	    analogClippingStages[i].reset(resetInfo.sampleRate);
-    }
+	analogToneControl.reset(resetInfo.sampleRate);
+	analogClippingStage.reset(resetInfo.sampleRate);
     return PluginBase::reset(resetInfo);
 }
 
@@ -204,14 +195,19 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 		return true;	/// processed
 	}
 
-    // --- FX Plugin:
+    // --- FX Plugin: the mono chain is run once on the left input and feeds every channel
+    double y = 0.0;
+    if (fx_On)
+    {
+        double x = processFrameInfo.audioInputFrame[0];
+        y = analogClippingStage.processAudioSample(x);
+        y = analogToneControl.processAudioSample(y);
+    }
+
 	for (unsigned int i = 0; i < NUM_CHANNELS; i++)
     {
 	    if (fx_On)
 	    {
-            double x = processFrameInfo.audioInputFrame[0];
-            double y = analogClippingStages[i].processAudioSample(x);
-            y = analogToneControls[i].processAudioSample(y);
             processFrameInfo.audioOutputFrame[i]  = y;
 	    }
 	    else
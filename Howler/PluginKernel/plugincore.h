@@ -128,8 +128,9 @@ public:
 	// --- END USER VARIABLES AND FUNCTIONS -------------------------------------- //
 
 protected:
-    AnalogTone analogToneControls[NUM_CHANNELS];
-    AnalogClipper analogClippingStages[NUM_CHANNELS];
+    // --- every channel is fed the left input, so one chain is processed and copied
+    AnalogTone analogToneControl;
+    AnalogClipper analogClippingStage;
     void updateParameters();
 
 private:
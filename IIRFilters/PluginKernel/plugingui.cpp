@@ -1828,12 +1828,8 @@ CView* PluginGUI::createUserCustomView(std::string viewname, const CRect rect, I
 
 	if (viewname.compare("CustomSpectrumView") == 0)
 	{
-#ifdef HAVE_FFTW
 		// --- create our custom view
 		return new SpectrumView(rect, listener, tag);
-#else
-		return new WaveView(rect, listener, tag);
-#endif
 	}
 
 	return nullptr;
@@ -21,9 +21,14 @@
 
 #include <memory>
 #include <algorithm>
+#include <string.h>	/* memset, memcpy */
+#include <atomic>
+#include <thread>
+#include <mutex>
 #include <math.h>
 #include "guiconstants.h"
 #include "filters.h"
+#include "fftkernel.h"	/* FFTRealKernel for FIR design */
 #include <time.h>       /* time */
 
 /** @file fxobjects.h
@@ -317,6 +322,51 @@ inline double dBPeakGainFor_Q(double Q)
 	return raw2dB(peakGainFor_Q(Q));
 }
 
+/**
+@fastTan
+\ingroup FX-Functions
+
+@brief calculates tan(x) with a (5,4) Pade approximant; relative error is about 0.01% at x = 1.5 (fc = 0.477*fs
+when used for bilinear prewarping) and the pole lands at ~pi/2 so the curve keeps its shape; x must be on [0, pi/2)
+
+\param x - the argument in radians
+\return the approximate tangent of x
+*/
+inline double fastTan(double x)
+{
+	double x2 = x*x;
+	return x*(945.0 - 105.0*x2 + x2*x2) / (945.0 - 420.0*x2 + 15.0*x2*x2);
+}
+
+/**
+@wrightOmega
+\ingroup FX-Functions
+
+@brief calculates the Wright omega function w(x), the solution of w + log(w) = x, with a piecewise
+cubic first guess and one fixed Newton correction (D'Angelo, Gabrielli, Turchet, "Fast Approximation of
+the Lambert W Function for Virtual Analog Modelling", DAFx 2019); used for closed form diode solutions in WDFs
+
+\param x - the argument
+\return the approximate w(x)
+*/
+inline double wrightOmega(double x)
+{
+	const double x1 = -3.341459552768620;
+	const double x2 = 8.0;
+	const double a = -1.314293149877800e-3;
+	const double b = 4.775931364975583e-2;
+	const double c = 3.631952663804445e-1;
+	const double d = 6.313183464296682e-1;
+
+	double y = 0.0;
+	if (x >= x2)
+		y = x - log(x);
+	else if (x >= x1)
+		y = d + x*(c + x*(b + x*a));
+
+	return y - (y - exp(x - y)) / (y + 1.0);
+}
+
 /**
 @doWhiteNoise
 \ingroup FX-Functions
@@ -988,6 +1038,85 @@ inline void freqSample(int N, double A[], double h[], int symm)
 	}
 }
 
+/**
+\class FastFreqSampler
+\ingroup FX-Objects
+\brief
+The FastFreqSampler object does the symmetric (POSITIVE) frequency sampling design of freqSample( ) with one real
+inverse FFT instead of N x N/2 cos( ) evaluations: the sample points get the linear phase of the centered filter,
+H(k) = A[k]e^(-j2(pi)kM/N) with M = (N-1)/2, and h(n) is the inverse DFT of H(k). The phase terms (with the 1/N
+scaling) are tabulated by initialize( ), so a design is N/2 complex multiplies plus the FFT.
+
+Control I/F:
+- initialize( ) allocates (not realtime safe); sampleSymmetric( ) does not.
+
+\version Revision : 1.0
+*/
+class FastFreqSampler
+{
+public:
+	FastFreqSampler() {}		/* C-TOR */
+	~FastFreqSampler() {}		/* D-TOR */
+
+	/** set the filter length N, create the FFT and the phase table */
+	/**
+	\param _length number of filter coefficients N
+	*/
+	void initialize(unsigned int _length)
+	{
+		length = _length;
+		fftKernel.initialize(length);
+
+		unsigned int bins = fftKernel.getSpectrumLength();
+		phaseReal.reset(new double[bins]);
+		phaseImag.reset(new double[bins]);
+		binReal.reset(new double[bins]);
+		binImag.reset(new double[bins]);
+
+		double M = (length - 1.0) / 2.0;
+		for (unsigned int k = 0; k < bins; k++)
+		{
+			phaseReal[k] = cos(kTwoPi*k*M / length) / length;
+			phaseImag[k] = -sin(kTwoPi*k*M / length) / length;
+		}
+
+		// --- even N leaves out the Nyquist point, as freqSample( ) does
+		binReal[bins - 1] = 0.0;
+		binImag[bins - 1] = 0.0;
+	}
+
+	/** same result as freqSample(N, A, h, POSITIVE) */
+	/**
+	\param A sample points of the desired magnitude response, at least (N + 1)/2 of them
+	\param h the output array of N coefficients
+	*/
+	void sampleSymmetric(const double* A, double* h)
+	{
+		if (length == 0)
+			return;
+
+		// --- (N + 1)/2 points; for even N the Nyquist bin stays 0
+		unsigned int points = (length + 1) / 2;
+		for (unsigned int k = 0; k < points; k++)
+		{
+			binReal[k] = A[k] * phaseReal[k];
+			binImag[k] = A[k] * phaseImag[k];
+		}
+		fftKernel.realInverse(&binReal[0], &binImag[0], h);
+	}
+
+	/** get the filter length N */
+	unsigned int getLength() { return length; }
+
+protected:
+	FFTRealKernel fftKernel;						///< N point real FFT
+	std::unique_ptr<double[]> phaseReal = nullptr;	///< linear phase terms / N, real
+	std::unique_ptr<double[]> phaseImag = nullptr;	///< linear phase terms / N, imag
+	std::unique_ptr<double[]> binReal = nullptr;	///< spectrum being transformed, real
+	std::unique_ptr<double[]> binImag = nullptr;	///< spectrum being transformed, imag
+	unsigned int length = 0;						///< N
+};
+
 /**
 @getMagnitude
 \ingroup FX-Functions
@@ -1908,6 +2037,9 @@ public:
 		return audioDetectorParameters;
 	}
 
+	/** get the detect mode (TLD_AUDIO_DETECT_MODE_PEAK, _MS or _RMS) */
+	unsigned int getDetectMode() { return audioDetectorParameters.detectMode; }
+
 	/** set parameters: note use of custom structure for passing param data */
 	/**
 	\param AudioDetectorParameters custom data structure
@@ -2274,6 +2406,245 @@ private:
 };
 
 
+/**
+\enum delayInterpolation
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to select the fractional-delay interpolator of a CircularBuffer
+
+- enum class delayInterpolation { kLinear, kHermite, kLagrange4, kThiran, kSinc };
+
+kThiran is a first order allpass and keeps state in the buffer, so use it only on buffers with a single
+read per sample (e.g. one modulated tap).
+
+\version Revision : 1.0
+*/
+enum class delayInterpolation { kLinear, kHermite, kLagrange4, kThiran, kSinc };
+
+/**
+@getHermiteWeights
+\ingroup FX-Functions
+
+@brief calculates the 4 tap weights of a cubic Hermite (Catmull-Rom) interpolator; the taps are the samples at
+delays D-1, D, D+1, D+2 and the result is the value at delay D + fraction
+
+\param fraction - fractional delay [0, 1)
+\param weights - array of 4 weights to fill
+*/
+inline void getHermiteWeights(double fraction, double* weights)
+{
+	weights[0] = fraction*(-0.5 + fraction*(1.0 - 0.5*fraction));
+	weights[1] = 1.0 + fraction*fraction*(-2.5 + 1.5*fraction);
+	weights[2] = fraction*(0.5 + fraction*(2.0 - 1.5*fraction));
+	weights[3] = fraction*fraction*(-0.5 + 0.5*fraction);
+}
+
+/**
+@getLagrange4Weights
+\ingroup FX-Functions
+
+@brief calculates the 4 tap weights of a 3rd order (4-point) Lagrange interpolator; the taps are the samples at
+delays D-1, D, D+1, D+2 and the result is the value at delay D + fraction
+
+\param fraction - fractional delay [0, 1)
+\param weights - array of 4 weights to fill
+*/
+inline void getLagrange4Weights(double fraction, double* weights)
+{
+	// --- evaluate at t = 1 + fraction on the grid 0, 1, 2, 3
+	double t = 1.0 + fraction;
+	double t0 = t;
+	double t1 = t - 1.0;
+	double t2 = t - 2.0;
+	double t3 = t - 3.0;
+	weights[0] = -t1*t2*t3 / 6.0;
+	weights[1] = t0*t2*t3 / 2.0;
+	weights[2] = -t0*t1*t3 / 2.0;
+	weights[3] = t0*t1*t2 / 6.0;
+}
+
+/**
+\class SincInterpolationTable
+\ingroup FX-Objects
+\brief
+The SincInterpolationTable object holds a polyphase table of Kaiser-windowed sinc interpolators for fractional delay reads.
+There are SINC_PHASES + 1 phases of SINC_TAPS taps; getWeights( ) interpolates linearly between adjacent phases. The taps are
+the samples at delays D - SINC_LEAD ... D - SINC_LEAD + SINC_TAPS - 1.
+
+The table is built once and shared; use getInstance( ) to access it.
+
+\version Revision : 1.0
+*/
+/**
+@besselI0
+\ingroup FX-Functions
+
+@brief zeroth order modified Bessel function of the first kind (power series), for Kaiser windows
+
+\param x - the argument
+\return I0(x)
+*/
+inline double besselI0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+	for (unsigned int k = 1; k < 32; k++)
+	{
+		term *= (x / (2.0*k))*(x / (2.0*k));
+		sum += term;
+	}
+	return sum;
+}
+
+const unsigned int SINC_TAPS = 8;		///< taps per phase
+const unsigned int SINC_LEAD = 3;		///< taps that are newer than the integer delay
+const unsigned int SINC_PHASES = 256;	///< table phases across one sample
+
+class SincInterpolationTable
+{
+public:
+	/** the shared table; built on first use, which CircularBuffer::createCircularBuffer( ) forces before realtime processing */
+	static const SincInterpolationTable& getInstance()
+	{
+		static const SincInterpolationTable table;
+		return table;
+	}
+
+	/** get the SINC_TAPS weights for a fractional delay [0, 1) */
+	void getWeights(double fraction, double* weights) const
+	{
+		double phase = fraction*SINC_PHASES;
+		unsigned int index = (unsigned int)phase;
+		double phaseFraction = phase - index;
+		const double* w0 = &table[index][0];
+		const double* w1 = &table[index + 1][0];
+		for (unsigned int k = 0; k < SINC_TAPS; k++)
+			weights[k] = w0[k] + phaseFraction*(w1[k] - w0[k]);
+	}
+
+private:
+	SincInterpolationTable()
+	{
+		const double beta = 5.0;
+		const double halfLength = SINC_TAPS / 2;
+		for (unsigned int p = 0; p <= SINC_PHASES; p++)
+		{
+			double fraction = (double)p / SINC_PHASES;
+			double sum = 0.0;
+			for (unsigned int k = 0; k < SINC_TAPS; k++)
+			{
+				// --- distance from this tap to the read position, in samples
+				double x = (double)k - (double)SINC_LEAD - fraction;
+				double sinc = fabs(x) < 1e-12 ? 1.0 : sin(kPi*x) / (kPi*x);
+				double r = x / halfLength;
+				double window = r*r < 1.0 ? besselI0(beta*sqrt(1.0 - r*r)) / besselI0(beta) : 0.0;
+				table[p][k] = sinc*window;
+				sum += table[p][k];
+			}
+
+			// --- unity gain at DC for every phase
+			for (unsigned int k = 0; k < SINC_TAPS; k++)
+				table[p][k] /= sum;
+		}
+	}
+
+	double table[SINC_PHASES + 1][SINC_TAPS];	///< polyphase weights
+};
+
+/** alignment of every DelayMemoryArena allocation, in bytes (one cache line, enough for any SIMD load) */
+const unsigned int DELAY_ARENA_ALIGNMENT = 64;
+
+/**
+\class DelayMemoryArena
+\ingroup FX-Objects
+\brief
+The DelayMemoryArena object holds all of a plugin instance's delay line memory in one contiguous, aligned allocation.
+Delay objects given an arena with setDelayMemoryArena( ) take their CircularBuffers from it instead of allocating
+them one by one; each block is aligned to DELAY_ARENA_ALIGNMENT.
+
+Use:
+- add up the delay objects' getDelayMemorySize( ) values for the new sample rate
+- call createArena( ) with the total; the existing allocation is reused when it is big enough
+- then reset (or create the buffers of) every object that uses the arena; createArena( ) starts a new layout,
+  so buffers from the previous layout must not be used again
+
+If an allocation does not fit, the buffer falls back to its own heap allocation. Huge pages are requested on Linux
+(transparent huge pages via madvise); elsewhere the flag is ignored. Do NOT call from the realtime audio thread.
+
+\version Revision : 1.0
+*/
+class DelayMemoryArena
+{
+public:
+	DelayMemoryArena() {}						/* C-TOR */
+	~DelayMemoryArena() { destroyArena(); }		/* D-TOR */
+
+	/** create (or reuse) the arena and start a new layout; returns true if the existing allocation was reused */
+	bool createArena(size_t numBytes, bool useHugePages = false);
+
+	/** take numBytes from the arena, aligned to DELAY_ARENA_ALIGNMENT; nullptr if the arena is full */
+	void* allocate(size_t numBytes)
+	{
+		size_t size = getAllocationSize(numBytes);
+		if (!memory || size > capacity - offset)
+			return nullptr;
+
+		void* block = memory + offset;
+		offset += size;
+		return block;
+	}
+
+	/** grow a block of the current layout; done in place when it is the last block, otherwise a new block
+	    is taken (contents are not copied); nullptr if the arena is full */
+	void* reallocate(void* block, size_t oldBytes, size_t newBytes)
+	{
+		size_t oldSize = getAllocationSize(oldBytes);
+		if (block && (char*)block + oldSize == memory + offset)
+		{
+			size_t newSize = getAllocationSize(newBytes);
+			if (newSize > capacity - offset + oldSize)
+				return nullptr;
+			offset += newSize - oldSize;
+			return block;
+		}
+		return allocate(newBytes);
+	}
+
+	/** size of an allocation, rounded up to the alignment; use this when adding up arena sizes */
+	static size_t getAllocationSize(size_t numBytes)
+	{
+		return (numBytes + DELAY_ARENA_ALIGNMENT - 1) & ~((size_t)DELAY_ARENA_ALIGNMENT - 1);
+	}
+
+	/** bytes in the arena */
+	size_t getCapacity() { return capacity; }
+
+	/** bytes handed out in the current layout */
+	size_t getBytesUsed() { return offset; }
+
+	/** incremented by every createArena( ) call; buffers from an older layout are stale */
+	unsigned int getLayout() { return layout; }
+
+	/** true if the memory is backed by huge pages (or the system was asked for them) */
+	bool getUsesHugePages() { return usesHugePages; }
+
+private:
+	/** free the memory */
+	void destroyArena();
+
+	DelayMemoryArena(const DelayMemoryArena&) = delete;				///< not copyable: buffers point into it
+	DelayMemoryArena& operator=(const DelayMemoryArena&) = delete;	///< not copyable: buffers point into it
+
+	char* memory = nullptr;			///< aligned start of the arena
+	void* allocation = nullptr;		///< the allocation itself (malloc or mmap)
+	size_t allocationSize = 0;		///< size of the allocation
+	size_t capacity = 0;			///< usable bytes from memory
+	size_t offset = 0;				///< next free byte
+	unsigned int layout = 0;		///< layout counter
+	bool usesHugePages = false;		///< allocation was mmap'ed for huge pages
+};
+
+
 /**
 \class CircularBuffer
 \ingroup FX-Objects
@@ -2296,20 +2667,23 @@ public:
 	~CircularBuffer() {}	/* D-TOR */
 
 							/** flush buffer by resetting all values to 0.0 */
-	void flushBuffer(){ memset(&buffer[0], 0, bufferLength * sizeof(T)); }
+	void flushBuffer(){ if (getStorage()) memset(getStorage(), 0, bufferLength * getSampleSize()); thiranState = 0.0; }
 
-	/** Create a buffer based on a target maximum in SAMPLES
+	/** Create a buffer based on a target maximum in SAMPLES; the memory comes from the arena if one is given
 	//	   do NOT call from realtime audio thread; do this prior to any processing */
-	void createCircularBuffer(unsigned int _bufferLength)
+	void createCircularBuffer(unsigned int _bufferLength, DelayMemoryArena* arena = nullptr)
 	{
 		// --- find nearest power of 2 for buffer, and create
-		createCircularBufferPowerOfTwo((unsigned int)(pow(2, ceil(log(_bufferLength) / log(2)))));
+		createCircularBufferPowerOfTwo(getPowerOfTwoLength(_bufferLength), arena);
 	}
 
 	/** Create a buffer based on a target maximum in SAMPLESwhere the size is
-	    pre-calculated as a power of two */
-	void createCircularBufferPowerOfTwo(unsigned int _bufferLengthPowerOfTwo)
+	    pre-calculated as a power of two; the memory comes from the arena if one is given */
+	void createCircularBufferPowerOfTwo(unsigned int _bufferLengthPowerOfTwo, DelayMemoryArena* arena = nullptr)
 	{
+		// --- build the shared sinc table here, not on the first kSinc read on the audio thread
+		SincInterpolationTable::getInstance();
+
 		// --- reset to top
 		writeIndex = 0;
 
@@ -2319,18 +2693,83 @@ public:
 		// --- save (bufferLength - 1) for use as wrapping mask
 		wrapMask = bufferLength - 1;
 
-		// --- create new buffer
-		buffer.reset(new T[bufferLength]);
+		// --- create new buffer; a block from the arena's current layout is kept if it is big enough,
+		//     so objects may create their buffers more than once per layout. Placeholder buffers (one
+		//     alignment block or less, e.g. from reset( ) before the real size is known) stay on the heap
+		size_t numBytes = bufferLength * (floatStorage ? sizeof(float) : sizeof(T));
+		if (numBytes <= DELAY_ARENA_ALIGNMENT)
+			arena = nullptr;
+
+		bool sameLayout = arena && arena == bufferArena && arenaLayout == arena->getLayout();
+		if (!sameLayout || numBytes > arenaBytes)
+		{
+			void* block = nullptr;
+			if (sameLayout)
+				block = arena->reallocate(getStorage(), arenaBytes, numBytes);
+			else if (arena)
+				block = arena->allocate(numBytes);
+
+			ownedBuffer.reset();
+			ownedFloatBuffer.reset();
+			if (block)
+			{
+				bufferArena = arena;
+				arenaLayout = arena->getLayout();
+				arenaBytes = numBytes;
+			}
+			else
+			{
+				if (floatStorage)
+					ownedFloatBuffer.reset(new float[bufferLength]);
+				else
+					ownedBuffer.reset(new T[bufferLength]);
+				block = floatStorage ? (void*)ownedFloatBuffer.get() : (void*)ownedBuffer.get();
+				bufferArena = nullptr;
+			}
+
+			buffer = floatStorage ? nullptr : (T*)block;
+			floatBuffer = floatStorage ? (float*)block : nullptr;
+		}
+		else if (floatStorage != (floatBuffer != nullptr))
+		{
+			// --- same arena block, other sample type
+			void* block = getStorage();
+			buffer = floatStorage ? nullptr : (T*)block;
+			floatBuffer = floatStorage ? (float*)block : nullptr;
+		}
 
 		// --- flush buffer
 		flushBuffer();
 	}
 
+	/** store the samples as float (the interface and all interpolation math stay T); takes effect at the next
+	    createCircularBuffer( ). Halves the memory and bandwidth of double buffers for ~-150dB of added noise */
+	void setFloatStorage(bool b) { floatStorage = b; }
+
+	/** true if float storage was requested */
+	bool getFloatStorage() { return floatStorage; }
+
+	/** arena bytes for a buffer of _bufferLength SAMPLES, see DelayMemoryArena */
+	static size_t getArenaSize(unsigned int _bufferLength, bool _floatStorage = false)
+	{
+		size_t numBytes = getPowerOfTwoLength(_bufferLength) * (_floatStorage ? sizeof(float) : sizeof(T));
+		return numBytes <= DELAY_ARENA_ALIGNMENT ? 0 : DelayMemoryArena::getAllocationSize(numBytes);
+	}
+
+	/** nearest power of 2 at or above _bufferLength */
+	static unsigned int getPowerOfTwoLength(unsigned int _bufferLength)
+	{
+		return (unsigned int)(pow(2, ceil(log(_bufferLength) / log(2))));
+	}
+
 	/** write a value into the buffer; this overwrites the previous oldest value in the buffer */
 	void writeBuffer(T input)
 	{
 		// --- write and increment index counter
-		buffer[writeIndex++] = input;
+		if (floatBuffer)
+			floatBuffer[writeIndex++] = (float)input;
+		else
+			buffer[writeIndex++] = input;
 
 		// --- wrap if index > bufferlength - 1
 		writeIndex &= wrapMask;
@@ -2348,1200 +2787,5636 @@ public:
 		readIndex &= wrapMask;
 
 		// --- read it
-		return buffer[readIndex];
+		return floatBuffer ? (T)floatBuffer[readIndex] : buffer[readIndex];
 	}
 
 	/** read an arbitrary location that includes a fractional sample */
 	T readBuffer(double delayInFractionalSamples)
 	{
-		// --- truncate delayInFractionalSamples and read the int part
-		T y1 = readBuffer((int)delayInFractionalSamples);
-
-		// --- if no interpolation, just return value
-		if (!interpolate) return y1;
+		// --- one storage type dispatch per read; the interpolators index the storage directly
+		if (floatBuffer)
+			return readBuffer(floatBuffer, delayInFractionalSamples);
+		return readBuffer(buffer, delayInFractionalSamples);
+	}
 
-		// --- else do interpolation
-		//
-		// --- read the sample at n+1 (one sample OLDER)
-		T y2 = readBuffer((int)delayInFractionalSamples + 1);
+	/** select the fractional delay interpolator; see delayInterpolation */
+	void setInterpolationType(delayInterpolation type)
+	{
+		interpolationType = type;
+		thiranState = 0.0;
+	}
 
-		// --- get fractional part
-		double fraction = delayInFractionalSamples - (int)delayInFractionalSamples;
+	/** get the fractional delay interpolator */
+	delayInterpolation getInterpolationType() { return interpolationType; }
 
-		// --- do the interpolation (you could try different types here)
-		return doLinearInterpolation(y1, y2, fraction);
+	/** number of samples NEWER than the integer delay that the current interpolator reads */
+	unsigned int getInterpolationLead()
+	{
+		switch (interpolationType)
+		{
+		case delayInterpolation::kHermite:
+		case delayInterpolation::kLagrange4:
+		case delayInterpolation::kThiran:
+			return 1;
+		case delayInterpolation::kSinc:
+			return SINC_LEAD;
+		default:
+			return 0;
+		}
 	}
 
 	/** enable or disable interpolation; usually used for diagnostics or in algorithms that require strict integer samples times */
 	void setInterpolate(bool b) { interpolate = b; }
 
-private:
-	std::unique_ptr<T[]> buffer = nullptr;	///< smart pointer will auto-delete
-	unsigned int writeIndex = 0;		///> write index
-	unsigned int bufferLength = 1024;	///< must be nearest power of 2
-	unsigned int wrapMask = 1023;		///< must be (bufferLength - 1)
-	bool interpolate = true;			///< interpolation (default is ON)
-};
-
-
-/**
-\class ImpulseConvolver
-\ingroup FX-Objects
-\brief
-The ImpulseConvolver object implements a linear conovlver. NOTE: compile in Release mode or you may experice stuttering,
-glitching or other sample-drop activity.
-
-Audio I/O:
-- Processes mono input to mono output.
+	// --- BLOCK ACCESS
+	//
+	//     A block of reads at a fixed delay followed by a block of writes gives the same result as
+	//     read-before-write per sample as long as no read needs a sample written in the same block,
+	//     i.e. numSamples <= delayInSamples + 1. The spans below are plain arrays, so block loops can
+	//     use memcpy and vectorize.
 
-Control I/F:
-- none.
+	/** one or two contiguous regions of the buffer; the second is empty unless the access wraps */
+	template <typename S>
+	struct StorageSpans
+	{
+		S* data[2] = { nullptr, nullptr };	///< start of each region
+		unsigned int length[2] = { 0, 0 };	///< samples in each region
+	};
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class ImpulseConvolver : public IAudioSignalProcessor
-{
-public:
-	ImpulseConvolver() {
-		init(512);
-	}		/* C-TOR */
-	~ImpulseConvolver() {}		/* D-TOR */
+	typedef StorageSpans<T> Spans;	///< spans of T samples
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** true if numSamples reads at delayInSamples can be done as a block before the block is written */
+	bool canReadBlock(unsigned int delayInSamples, unsigned int numSamples)
 	{
-		// --- flush signal buffer; IR buffer is static
-		signalBuffer.flushBuffer();
-		return true;
+		return numSamples <= delayInSamples + 1 && numSamples <= bufferLength;
 	}
 
-	/** process one input - note this is CPU intensive as it performs simple linear convolution */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** longest block readBlock( ) can read at this delay with the current interpolator */
+	unsigned int getMaxBlockRead(double delayInFractionalSamples)
 	{
-		double output = 0.0;
+		unsigned int delayInSamples = (unsigned int)delayInFractionalSamples;
+		unsigned int lead = getInterpolationLead();
+		if (!interpolate || delayInSamples < lead)
+			lead = 0;
 
-		// --- write buffer; x(n) overwrites oldest value
-		//     this is the only time we do not read before write!
-		signalBuffer.writeBuffer(xn);
+		unsigned int length = delayInSamples + 1 - lead;
+		return length < bufferLength ? length : bufferLength;
+	}
 
-		// --- do the convolution
-		for (unsigned int i = 0; i < length; i++)
-		{
-			// --- y(n) += x(n)h(n)
-			//     for signalBuffer.readBuffer(0) -> x(n)
-			//		   signalBuffer.readBuffer(n-D)-> x(n-D)
-			double signal = signalBuffer.readBuffer((int)i);
-			double irrrrr = irBuffer.readBuffer((int)i);
-			output += signal*irrrrr;
+	/** spans for the next numSamples writes; fill them, then call advanceWriteIndex(numSamples).
+	    The spans are empty with float storage; use writeBlock( ) */
+	Spans getWriteSpans(unsigned int numSamples) { return makeSpans(buffer, writeIndex, numSamples); }
 
-			//output += signalBuffer.readBuffer((int)i) * irBuffer.readBuffer((int)i);
-		}
+	/** move the write index past a block filled through getWriteSpans( ) */
+	void advanceWriteIndex(unsigned int numSamples) { writeIndex = (writeIndex + numSamples) & wrapMask; }
 
-		return output;
+	/** spans holding what readBuffer(delayInSamples) returns for each of the next numSamples samples;
+	    only valid when canReadBlock(delayInSamples, numSamples). The spans are empty with float storage;
+		use readBlock( ) */
+	Spans getReadSpans(unsigned int delayInSamples, unsigned int numSamples)
+	{
+		return getReadSpans(buffer, delayInSamples, numSamples);
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** write a block of samples; same as calling writeBuffer( ) for each one */
+	void writeBlock(const T* input, unsigned int numSamples)
+	{
+		if (floatBuffer)
+			writeBlock(floatBuffer, input, numSamples);
+		else
+			writeBlock(buffer, input, numSamples);
+	}
 
-	/** create the buffer based on the exact power of 2 */
-	void init(unsigned int lengthPowerOfTwo)
+	/** read a block at a fixed delay; same as calling readBuffer(delayInFractionalSamples) once per sample
+	    with a write between reads. Only valid when numSamples <= getMaxBlockRead(delayInFractionalSamples) */
+	void readBlock(double delayInFractionalSamples, T* output, unsigned int numSamples)
 	{
-		length = lengthPowerOfTwo;
-		// --- create (and clear out) the buffers
-		signalBuffer.createCircularBufferPowerOfTwo(lengthPowerOfTwo);
-		irBuffer.createLinearBuffer(lengthPowerOfTwo);
+		if (floatBuffer)
+			readBlock(floatBuffer, delayInFractionalSamples, output, numSamples);
+		else
+			readBlock(buffer, delayInFractionalSamples, output, numSamples);
 	}
 
-	/** set the impulse response */
-	void setImpulseResponse(double* irArray, unsigned int lengthPowerOfTwo)
+	/** read a block with a different delay for each sample; same as calling readBuffer(delaysInFractionalSamples[i])
+	    before the i-th write of the block. Only valid when every read is of samples written before the block:
+		(unsigned int)delaysInFractionalSamples[i] >= i + getInterpolationLead( ) */
+	void readBlock(const double* delaysInFractionalSamples, T* output, unsigned int numSamples)
 	{
-		if (lengthPowerOfTwo != length)
-		{
-			length = lengthPowerOfTwo;
-			// --- create (and clear out) the buffers
-			signalBuffer.createCircularBufferPowerOfTwo(lengthPowerOfTwo);
-			irBuffer.createLinearBuffer(lengthPowerOfTwo);
-		}
+		if (floatBuffer)
+			readBlock(floatBuffer, delaysInFractionalSamples, output, numSamples);
+		else
+			readBlock(buffer, delaysInFractionalSamples, output, numSamples);
+	}
 
-		// --- load up the IR buffer
-		for (unsigned int i = 0; i < length; i++)
-		{
-			irBuffer.writeBuffer(i, irArray[i]);
-		}
+private:
+	/** read the sample that is delayInSamples old from storage S */
+	template <typename S>
+	T readStorage(const S* storage, int delayInSamples)
+	{
+		return (T)storage[((writeIndex - 1) - delayInSamples) & wrapMask];
 	}
 
-protected:
-	// --- delay buffer of doubles
-	CircularBuffer<double> signalBuffer; ///< circulat buffer for the signal
-	LinearBuffer<double> irBuffer;	///< linear buffer for the IR
-
-	unsigned int length = 0;	///< length of convolution (buffer)
-
-};
-
-const unsigned int IR_LEN = 512;
-/**
-\struct AnalogFIRFilterParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the AnalogFIRFilter object. This is a somewhat silly object that implaments an analog
-magnitude response as a FIR filter. NOT DESIGNED to replace virtual analog; rather it is intended to show the
-frequency sampling method in an easy (and fun) way.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct AnalogFIRFilterParameters
-{
-	AnalogFIRFilterParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	AnalogFIRFilterParameters& operator=(const AnalogFIRFilterParameters& params)	// need this override for collections to work
+	/** see readBuffer(double) */
+	template <typename S>
+	T readBuffer(const S* storage, double delayInFractionalSamples)
 	{
-		if (this == &params)
-			return *this;
+		// --- truncate delayInFractionalSamples and read the int part
+		int delayInSamples = (int)delayInFractionalSamples;
+		T y1 = readStorage(storage, delayInSamples);
 
-		filterType = params.filterType;
-		fc = params.fc;
-		Q = params.Q;
+		// --- if no interpolation, just return value
+		if (!interpolate) return y1;
 
-		return *this;
-	}
+		// --- else do interpolation
+		//
+		// --- get fractional part
+		double fraction = delayInFractionalSamples - delayInSamples;
 
-	// --- individual parameters
-	analogFilter filterType = analogFilter::kLPF1; ///< filter type
-	double fc = 0.0;	///< filter fc
-	double Q = 0.0;		///< filter Q
-};
+		// --- higher order interpolators need samples newer than the integer delay;
+		//     fall back to linear when there are not enough of them
+		if (interpolationType != delayInterpolation::kLinear && delayInSamples >= (int)getInterpolationLead())
+		{
+			if (interpolationType == delayInterpolation::kThiran)
+				return readThiran(storage, delayInSamples, fraction);
 
-/**
-\class AnalogFIRFilter
-\ingroup FX-Objects
-\brief
-The AnalogFIRFilter object implements a somewhat silly algorithm that implaments an analog
-magnitude response as a FIR filter. NOT DESIGNED to replace virtual analog; rather it is intended to show the
-frequency sampling method in an easy (and fun) way.
+			if (fraction == 0.0)
+				return y1;
 
-Audio I/O:
-- Processes mono input to mono output.
+			return readFIR(storage, delayInSamples, fraction);
+		}
 
-Control I/F:
-- Use AnalogFIRFilterParameters structure to get/set object params.
+		// --- read the sample at n+1 (one sample OLDER)
+		T y2 = readStorage(storage, delayInSamples + 1);
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class AnalogFIRFilter : public IAudioSignalProcessor
-{
-public:
-	AnalogFIRFilter() {}	/* C-TOR */
-	~AnalogFIRFilter() {}	/* D-TOR */
+		// --- do the interpolation
+		return doLinearInterpolation(y1, y2, fraction);
+	}
 
-public:
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		convolver.reset(_sampleRate);
-		convolver.init(IR_LEN);
+	// --- block access for either storage type
 
-		memset(&analogMagArray[0], 0, sizeof(double) * IR_LEN);	///< clear
-		memset(&irArray[0], 0, sizeof(double) * IR_LEN);	///< clear
+	/** spans of storage S, see getReadSpans( ) */
+	template <typename S>
+	StorageSpans<S> getReadSpans(S* storage, unsigned int delayInSamples, unsigned int numSamples)
+	{
+		return makeSpans(storage, (writeIndex - 1 - delayInSamples) & wrapMask, numSamples);
+	}
 
-		return true;
+	/** copy samples, converting to the destination type */
+	template <typename D, typename S>
+	static void copySamples(D* destination, const S* source, unsigned int numSamples)
+	{
+		for (unsigned int i = 0; i < numSamples; i++)
+			destination[i] = (D)source[i];
 	}
 
-	/** pefrorm the convolution */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** copy samples of the same type */
+	static void copySamples(T* destination, const T* source, unsigned int numSamples)
 	{
-		// --- do the linear convolution
-		return convolver.processAudioSample(xn);
+		memcpy(destination, source, numSamples * sizeof(T));
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** see writeBlock( ) */
+	template <typename S>
+	void writeBlock(S* storage, const T* input, unsigned int numSamples)
+	{
+		StorageSpans<S> spans = makeSpans(storage, writeIndex, numSamples);
+		copySamples(spans.data[0], input, spans.length[0]);
+		if (spans.length[1] > 0)
+			copySamples(spans.data[1], input + spans.length[0], spans.length[1]);
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return AnalogFIRFilterParameters custom data structure
-	*/
-	AnalogFIRFilterParameters getParameters() { return parameters; }
+		advanceWriteIndex(numSamples);
+	}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param AnalogFIRFilterParameters custom data structure
-	*/
-	void setParameters(AnalogFIRFilterParameters _parameters)
+	/** see readBlock( ) */
+	template <typename S>
+	void readBlock(const S* storage, double delayInFractionalSamples, T* output, unsigned int numSamples)
 	{
-		if (_parameters.fc != parameters.fc ||
-			_parameters.Q != parameters.Q ||
-			_parameters.filterType != parameters.filterType)
+		unsigned int delayInSamples = (unsigned int)delayInFractionalSamples;
+		double fraction = delayInFractionalSamples - delayInSamples;
+		bool highOrder = interpolate && interpolationType != delayInterpolation::kLinear &&
+			delayInSamples >= getInterpolationLead();
+
+		// --- Thiran is recursive: one serial pass over the two taps
+		if (highOrder && interpolationType == delayInterpolation::kThiran)
 		{
-			// --- set the filter IR for the convolver
-			AnalogMagData analogFilterData;
-			analogFilterData.sampleRate = sampleRate;
-			analogFilterData.magArray = &analogMagArray[0];
-			analogFilterData.dftArrayLen = IR_LEN;
-			analogFilterData.mirrorMag = false;
+			double a = -fraction / (2.0 + fraction);
+			StorageSpans<const S> newer = getReadSpans(storage, delayInSamples - 1, numSamples);
+			StorageSpans<const S> older = getReadSpans(storage, delayInSamples, numSamples);
+			for (unsigned int i = 0; i < numSamples; i++)
+			{
+				T x0 = i < newer.length[0] ? newer.data[0][i] : newer.data[1][i - newer.length[0]];
+				T x1 = i < older.length[0] ? older.data[0][i] : older.data[1][i - older.length[0]];
+				double yn = a*x0 + x1 - a*thiranState;
+				thiranState = yn;
+				output[i] = yn;
+			}
+			return;
+		}
 
-			analogFilterData.filterType = _parameters.filterType;
-			analogFilterData.fc = _parameters.fc; // 1000.0;
-			analogFilterData.Q = _parameters.Q;
+		// --- FIR interpolators: the weights are fixed for the block, so accumulate one tap at a time
+		if (highOrder && fraction != 0.0)
+		{
+			double weights[SINC_TAPS];
+			unsigned int numTaps = getInterpolationWeights(fraction, weights);
+			unsigned int firstDelay = delayInSamples - getInterpolationLead();
+			for (unsigned int k = 0; k < numTaps; k++)
+			{
+				StorageSpans<const S> spans = getReadSpans(storage, firstDelay + k, numSamples);
+				double weight = weights[k];
+				T* yn = output;
+				for (unsigned int s = 0; s < 2; s++)
+				{
+					const S* x = spans.data[s];
+					if (k == 0)
+					{
+						for (unsigned int i = 0; i < spans.length[s]; i++)
+							yn[i] = weight*x[i];
+					}
+					else
+					{
+						for (unsigned int i = 0; i < spans.length[s]; i++)
+							yn[i] += weight*x[i];
+					}
+					yn += spans.length[s];
+				}
+			}
+			return;
+		}
 
-			// --- calculate the analog mag array
-			calculateAnalogMagArray(analogFilterData);
+		// --- integer part
+		StorageSpans<const S> spans = getReadSpans(storage, delayInSamples, numSamples);
+		copySamples(output, spans.data[0], spans.length[0]);
+		if (spans.length[1] > 0)
+			copySamples(output + spans.length[0], spans.data[1], spans.length[1]);
 
-			// --- frequency sample the mag array
-			freqSample(IR_LEN, analogMagArray, irArray, POSITIVE);
+		if (!interpolate || fraction == 0.0)
+			return;
 
-			// --- update new frequency response
-			convolver.setImpulseResponse(irArray, IR_LEN);
+		// --- linear: blend with the sample at n+1 (one sample OLDER)
+		spans = getReadSpans(storage, delayInSamples + 1, numSamples);
+		T* y1 = output;
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			const S* y2 = spans.data[s];
+			for (unsigned int i = 0; i < spans.length[s]; i++)
+				y1[i] = fraction*y2[i] + (1.0 - fraction)*y1[i];
+			y1 += spans.length[s];
 		}
-
-		parameters = _parameters;
 	}
 
-private:
-	AnalogFIRFilterParameters parameters; ///< object parameters
-	ImpulseConvolver convolver; ///< convolver object to perform FIR convolution
-	double analogMagArray[IR_LEN]; ///< array for analog magnitude response
-	double irArray[IR_LEN]; ///< array to hold calcualted IR
-	double sampleRate = 0.0; ///< storage for sample rate
-};
+	/** see readBlock( ) */
+	template <typename S>
+	void readBlock(const S* storage, const double* delaysInFractionalSamples, T* output, unsigned int numSamples)
+	{
+		const unsigned int chunk = 64;
+		unsigned int readIndex[chunk];
+		double fraction[chunk];
+		double weights[SINC_TAPS][chunk];
 
-/**
-\enum delayAlgorithm
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the delay algorithm
+		for (unsigned int n = 0; n < numSamples; n += chunk)
+		{
+			unsigned int length = numSamples - n < chunk ? numSamples - n : chunk;
+			const double* delays = delaysInFractionalSamples + n;
+			T* yn = output + n;
 
-- enum class delayAlgorithm { kNormal, kPingPong };
+			// --- split delays and find the read index for each sample (as if written up to sample n + i)
+			for (unsigned int i = 0; i < length; i++)
+			{
+				unsigned int delayInSamples = (unsigned int)delays[i];
+				fraction[i] = delays[i] - delayInSamples;
+				readIndex[i] = writeIndex - 1 - delayInSamples + n + i;
+			}
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class delayAlgorithm { kNormal, kPingPong };
+			if (!interpolate)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					yn[i] = storage[readIndex[i] & wrapMask];
+				continue;
+			}
 
-/**
-\enum delayUpdateType
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the delay update type; this varies depending on the designer's choice
-of GUI controls. See the book reference for more details.
+			if (interpolationType == delayInterpolation::kLinear)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					yn[i] = doLinearInterpolation(storage[readIndex[i] & wrapMask], storage[(readIndex[i] - 1) & wrapMask], fraction[i]);
+				continue;
+			}
 
-- enum class delayUpdateType { kLeftAndRight, kLeftPlusRatio };
+			if (interpolationType == delayInterpolation::kThiran)
+			{
+				for (unsigned int i = 0; i < length; i++)
+				{
+					double a = -fraction[i] / (2.0 + fraction[i]);
+					double y = a*storage[(readIndex[i] + 1) & wrapMask] + storage[readIndex[i] & wrapMask] - a*thiranState;
+					thiranState = y;
+					yn[i] = y;
+				}
+				continue;
+			}
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class delayUpdateType { kLeftAndRight, kLeftPlusRatio };
+			// --- FIR interpolators: weights for the whole chunk first, then gather and sum
+			unsigned int numTaps = 4;
+			if (interpolationType == delayInterpolation::kSinc)
+			{
+				numTaps = SINC_TAPS;
+				const SincInterpolationTable& table = SincInterpolationTable::getInstance();
+				double w[SINC_TAPS];
+				for (unsigned int i = 0; i < length; i++)
+				{
+					table.getWeights(fraction[i], w);
+					for (unsigned int k = 0; k < SINC_TAPS; k++)
+						weights[k][i] = w[k];
+				}
+			}
+			else if (interpolationType == delayInterpolation::kHermite)
+			{
+				for (unsigned int i = 0; i < length; i++)
+				{
+					double f = fraction[i];
+					weights[0][i] = f*(-0.5 + f*(1.0 - 0.5*f));
+					weights[1][i] = 1.0 + f*f*(-2.5 + 1.5*f);
+					weights[2][i] = f*(0.5 + f*(2.0 - 1.5*f));
+					weights[3][i] = f*f*(-0.5 + 0.5*f);
+				}
+			}
+			else
+			{
+				for (unsigned int i = 0; i < length; i++)
+				{
+					double t = 1.0 + fraction[i];
+					double t1 = t - 1.0;
+					double t2 = t - 2.0;
+					double t3 = t - 3.0;
+					weights[0][i] = -t1*t2*t3 / 6.0;
+					weights[1][i] = t*t2*t3 / 2.0;
+					weights[2][i] = -t*t1*t3 / 2.0;
+					weights[3][i] = t*t1*t2 / 6.0;
+				}
+			}
 
+			unsigned int lead = getInterpolationLead();
+			for (unsigned int i = 0; i < length; i++)
+			{
+				unsigned int firstIndex = readIndex[i] + lead;
+				double y = weights[0][i] * storage[firstIndex & wrapMask];
+				for (unsigned int k = 1; k < numTaps; k++)
+					y += weights[k][i] * storage[(firstIndex - k) & wrapMask];
 
-/**
-\struct AudioDelayParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the AudioDelay object.
+				// --- an integer delay reads the sample itself, as readBuffer( ) does
+				yn[i] = fraction[i] == 0.0 ? storage[readIndex[i] & wrapMask] : y;
+			}
+		}
+	}
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct AudioDelayParameters
-{
-	AudioDelayParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	AudioDelayParameters& operator=(const AudioDelayParameters& params)	// need this override for collections to work
+	/** fill the FIR interpolator weights for the current type; returns the number of taps */
+	unsigned int getInterpolationWeights(double fraction, double* weights)
 	{
-		if (this == &params)
-			return *this;
+		if (interpolationType == delayInterpolation::kSinc)
+		{
+			SincInterpolationTable::getInstance().getWeights(fraction, weights);
+			return SINC_TAPS;
+		}
 
-		algorithm = params.algorithm;
-		wetLevel_dB = params.wetLevel_dB;
-		dryLevel_dB = params.dryLevel_dB;
-		feedback_Pct = params.feedback_Pct;
+		if (interpolationType == delayInterpolation::kHermite)
+			getHermiteWeights(fraction, weights);
+		else
+			getLagrange4Weights(fraction, weights);
+		return 4;
+	}
 
-		updateType = params.updateType;
-		leftDelay_mSec = params.leftDelay_mSec;
-		rightDelay_mSec = params.rightDelay_mSec;
-		delayRatio_Pct = params.delayRatio_Pct;
+	/** FIR interpolated read; needs delayInSamples >= getInterpolationLead( ) */
+	template <typename S>
+	T readFIR(const S* storage, int delayInSamples, double fraction)
+	{
+		double weights[SINC_TAPS];
+		unsigned int numTaps = getInterpolationWeights(fraction, weights);
+		int firstDelay = delayInSamples - (int)getInterpolationLead();
 
-		return *this;
+		double yn = weights[0] * readStorage(storage, firstDelay);
+		for (unsigned int k = 1; k < numTaps; k++)
+			yn += weights[k] * readStorage(storage, firstDelay + (int)k);
+		return yn;
 	}
 
-	// --- individual parameters
-	delayAlgorithm algorithm = delayAlgorithm::kNormal; ///< delay algorithm
-	double wetLevel_dB = -3.0;	///< wet output level in dB
-	double dryLevel_dB = -3.0;	///< dry output level in dB
-	double feedback_Pct = 0.0;	///< feedback as a % value
+	/** first order Thiran allpass read, tuned for a delay of 1 + fraction past delayInSamples - 1 */
+	template <typename S>
+	T readThiran(const S* storage, int delayInSamples, double fraction)
+	{
+		double a = -fraction / (2.0 + fraction);
+		double yn = a*readStorage(storage, delayInSamples - 1) + readStorage(storage, delayInSamples) - a*thiranState;
+		thiranState = yn;
+		return yn;
+	}
 
-	delayUpdateType updateType = delayUpdateType::kLeftAndRight;///< update algorithm
-	double leftDelay_mSec = 0.0;	///< left delay time
-	double rightDelay_mSec = 0.0;	///< right delay time
-	double delayRatio_Pct = 100.0;	///< dela ratio: right length = (delayRatio)*(left length)
+	/** split numSamples from startIndex at the wrap point */
+	template <typename S>
+	StorageSpans<S> makeSpans(S* storage, unsigned int startIndex, unsigned int numSamples)
+	{
+		StorageSpans<S> spans;
+		if (!storage)
+			return spans;
+
+		spans.data[0] = storage + startIndex;
+		spans.length[0] = numSamples < bufferLength - startIndex ? numSamples : bufferLength - startIndex;
+		spans.data[1] = storage;
+		spans.length[1] = numSamples - spans.length[0];
+		return spans;
+	}
+
+	/** the buffer memory, whichever the sample type */
+	void* getStorage() { return floatBuffer ? (void*)floatBuffer : (void*)buffer; }
+
+	/** bytes per stored sample */
+	size_t getSampleSize() { return floatBuffer ? sizeof(float) : sizeof(T); }
+
+	std::unique_ptr<T[]> ownedBuffer = nullptr;	///< smart pointer will auto-delete; empty when the buffer is in an arena
+	std::unique_ptr<float[]> ownedFloatBuffer = nullptr;	///< float storage version of ownedBuffer
+	T* buffer = nullptr;				///< the buffer: ownedBuffer or a block of bufferArena; nullptr with float storage
+	float* floatBuffer = nullptr;		///< the buffer with float storage, else nullptr
+	bool floatStorage = false;			///< float storage for the next createCircularBuffer( )
+	DelayMemoryArena* bufferArena = nullptr;	///< arena holding the buffer, if any
+	unsigned int arenaLayout = 0;		///< arena layout the block belongs to
+	size_t arenaBytes = 0;				///< size of the arena block
+	unsigned int writeIndex = 0;		///> write index
+	unsigned int bufferLength = 1024;	///< must be nearest power of 2
+	unsigned int wrapMask = 1023;		///< must be (bufferLength - 1)
+	bool interpolate = true;			///< interpolation (default is ON)
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< fractional delay interpolator
+	double thiranState = 0.0;			///< Thiran allpass output state
 };
 
+/** maximum chunk length for the delay objects' block processing (stack scratch buffers) */
+const unsigned int MAX_DELAY_BLOCK = 64;
+
+
+/** alignment of the FIRKernel coefficient and history arrays, in bytes; also the width of one kernel step */
+const unsigned int FIR_KERNEL_ALIGNMENT = 64;
+
 /**
-\class AudioDelay
+\class FIRKernel
 \ingroup FX-Objects
 \brief
-The AudioDelay object implements a stereo audio delay with multiple delay algorithms.
+The FIRKernel object implements a direct form FIR filter (linear convolution) as one contiguous dot product per sample.
+
+- the signal history is stored twice (mirrored): each input is written at index w and w + N, so the last N inputs
+  are always the contiguous run history[w]...history[w + N - 1] and no wrap or mask is needed in the dot product
+- taps are padded with zeros to a multiple of one cache line (FIR_KERNEL_ALIGNMENT bytes: 8 double or 16 float) and
+  summed into that many independent partial sums, which the compiler turns into SIMD multiply-adds without fast-math
+  flags; the independent sums also hide the add latency
+- the coefficient array is aligned to FIR_KERNEL_ALIGNMENT
+
+T is the type of the coefficients, the history and the partial sums: double, or float for twice the SIMD width and
+half the memory. Only the final sum of the lanes is done in double, so a float kernel accumulates with float
+rounding (24 bit mantissa), on the order of the rounding of its float coefficients.
 
 Audio I/O:
-- Processes mono input to mono output OR stereo output.
+- Processes mono input to mono output, per sample or in blocks.
 
 Control I/F:
-- Use AudioDelayParameters structure to get/set object params.
+- createKernel( ) allocates (not realtime safe); setCoefficients( ) does not.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class AudioDelay : public IAudioSignalProcessor
+template <typename T>
+class FIRKernel
 {
 public:
-	AudioDelay() {}		/* C-TOR */
-	~AudioDelay() {}	/* D-TOR */
+	FIRKernel() {}		/* C-TOR */
+	~FIRKernel() {}		/* D-TOR */
 
-public:
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** create the coefficient and history arrays for any number of taps; both are cleared */
+	/**
+	\param _length the number of taps
+	*/
+	void createKernel(unsigned int _length)
+	{
+		length = _length;
+		paddedLength = length > lanes ? ((length + lanes - 1) / lanes) * lanes : lanes;
+
+		const unsigned int alignPad = FIR_KERNEL_ALIGNMENT / sizeof(T);
+		coefficientMemory.reset(new T[paddedLength + alignPad]);
+		nextCoefficientMemory.reset(new T[paddedLength + alignPad]);
+		historyMemory.reset(new T[2 * paddedLength + alignPad]);
+		coefficients = alignPointer(coefficientMemory.get());
+		nextCoefficients = alignPointer(nextCoefficientMemory.get());
+		history = alignPointer(historyMemory.get());
+
+		memset(coefficients, 0, paddedLength * sizeof(T));
+		memset(nextCoefficients, 0, paddedLength * sizeof(T));
+		flushHistory();
+	}
+
+	/** release the arrays */
+	void destroyKernel()
+	{
+		coefficientMemory.reset();
+		nextCoefficientMemory.reset();
+		historyMemory.reset();
+		coefficients = nullptr;
+		nextCoefficients = nullptr;
+		history = nullptr;
+		length = 0;
+		paddedLength = 0;
+		writeIndex = 0;
+	}
+
+	/** load the coefficients h(0)...h(N-1); the history is kept */
+	/**
+	\param h array of getLength( ) coefficients
+	*/
+	void setCoefficients(const double* h)
 	{
-		// --- if sample rate did not change
-		if (sampleRate == _sampleRate)
-		{
-			// --- just flush buffer and return
-			delayBuffer_L.flushBuffer();
-			delayBuffer_R.flushBuffer();
-			return true;
-		}
+		for (unsigned int i = 0; i < length; i++)
+			coefficients[i] = (T)h[i];
+	}
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffers(_sampleRate, bufferLength_mSec);
+	/** load a second coefficient set, run alongside the current one for crossfades; see swapCoefficients( ) */
+	/**
+	\param h array of getLength( ) coefficients
+	*/
+	void setNextCoefficients(const double* h)
+	{
+		for (unsigned int i = 0; i < length; i++)
+			nextCoefficients[i] = (T)h[i];
+	}
 
-		return true;
+	/** make the next coefficient set the current one */
+	void swapCoefficients()
+	{
+		std::swap(coefficientMemory, nextCoefficientMemory);
+		std::swap(coefficients, nextCoefficients);
 	}
 
-	/** process MONO audio delay */
+	/** clear the signal history */
+	void flushHistory()
+	{
+		memset(history, 0, 2 * paddedLength * sizeof(T));
+		writeIndex = 0;
+	}
+
+	/** process one input: y(n) = sum of x(n - k)h(k) */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
-	virtual double processAudioSample(double xn)
+	double processAudioSample(double xn)
 	{
-		// --- read delay
-		double yn = delayBuffer_L.readBuffer(delayInSamples_L);
+		// --- mirrored write; x(n - k) = x[k] for k = 0...N-1
+		history[writeIndex] = (T)xn;
+		history[writeIndex + paddedLength] = (T)xn;
+		const T* x = &history[writeIndex];
+		const T* h = coefficients;
 
-		// --- create input for delay buffer
-		double dn = xn + (parameters.feedback_Pct / 100.0) * yn;
-
-		// --- write to delay buffer
-		delayBuffer_L.writeBuffer(dn);
+		// --- step by pointer so every step is one contiguous run of lanes
+		T sum[lanes] = {};
+		for (unsigned int i = 0; i < paddedLength; i += lanes, x += lanes, h += lanes)
+		{
+			for (unsigned int j = 0; j < lanes; j++)
+				sum[j] += x[j] * h[j];
+		}
 
-		// --- form mixture out = dry*xn + wet*yn
-		double output = dryMix*xn + wetMix*yn;
+		writeIndex = writeIndex > 0 ? writeIndex - 1 : paddedLength - 1;
 
-		return output;
+		double yn = 0.0;
+		for (unsigned int j = 0; j < lanes; j++)
+			yn += sum[j];
+		return yn;
 	}
 
-	/** return true: this object can also process frames */
-	virtual bool canProcessAudioFrame() { return true; }
-
-	/** process STEREO audio delay in frames */
-	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
-		float* outputFrame,
-		uint32_t inputChannels,
-		uint32_t outputChannels)
+	/** process one input through the current and the next coefficient set; one history write and shared
+	    history loads, for crossfading between two IRs */
+	/**
+	\param xn input
+	\param ynNext output with the next coefficients
+	\return the output with the current coefficients
+	*/
+	double processAudioSample(double xn, double& ynNext)
 	{
-		// --- make sure we have input and outputs
-		if (inputChannels == 0 || outputChannels == 0)
-			return false;
-
-		// --- make sure we support this delay algorithm
-		if (parameters.algorithm != delayAlgorithm::kNormal &&
-			parameters.algorithm != delayAlgorithm::kPingPong)
-			return false;
+		history[writeIndex] = (T)xn;
+		history[writeIndex + paddedLength] = (T)xn;
+		const T* x = &history[writeIndex];
+		const T* h = coefficients;
+		const T* g = nextCoefficients;
 
-		// --- if only one output channel, revert to mono operation
-		if (outputChannels == 1)
+		T sum[lanes] = {};
+		T sumNext[lanes] = {};
+		for (unsigned int i = 0; i < paddedLength; i += lanes, x += lanes, h += lanes, g += lanes)
 		{
-			// --- process left channel only
-			outputFrame[0] = (float)processAudioSample(inputFrame[0]);
-			return true;
+			for (unsigned int j = 0; j < lanes; j++)
+			{
+				sum[j] += x[j] * h[j];
+				sumNext[j] += x[j] * g[j];
+			}
 		}
 
-		// --- if we get here we know we have 2 output channels
-		//
-		// --- pick up inputs
-		//
-		// --- LEFT channel
-		double xnL = inputFrame[0];
-
-		// --- RIGHT channel (duplicate left input if mono-in)
-		double xnR = inputChannels > 1 ? inputFrame[1] : xnL;
-
-		// --- read delay LEFT
-		double ynL = delayBuffer_L.readBuffer(delayInSamples_L);
-
-		// --- read delay RIGHT
-		double ynR = delayBuffer_R.readBuffer(delayInSamples_R);
-
-		// --- create input for delay buffer with LEFT channel info
-		double dnL = xnL + (parameters.feedback_Pct / 100.0) * ynL;
-
-		// --- create input for delay buffer with RIGHT channel info
-		double dnR = xnR + (parameters.feedback_Pct / 100.0) * ynR;
-
-		// --- decode
-		if (parameters.algorithm == delayAlgorithm::kNormal)
-		{
-			// --- write to LEFT delay buffer with LEFT channel info
-			delayBuffer_L.writeBuffer(dnL);
+		writeIndex = writeIndex > 0 ? writeIndex - 1 : paddedLength - 1;
 
-			// --- write to RIGHT delay buffer with RIGHT channel info
-			delayBuffer_R.writeBuffer(dnR);
-		}
-		else if (parameters.algorithm == delayAlgorithm::kPingPong)
+		double yn = 0.0;
+		ynNext = 0.0;
+		for (unsigned int j = 0; j < lanes; j++)
 		{
-			// --- write to LEFT delay buffer with RIGHT channel info
-			delayBuffer_L.writeBuffer(dnR);
-
-			// --- write to RIGHT delay buffer with LEFT channel info
-			delayBuffer_R.writeBuffer(dnL);
+			yn += sum[j];
+			ynNext += sumNext[j];
 		}
-
-		// --- form mixture out = dry*xn + wet*yn
-		double outputL = dryMix*xnL + wetMix*ynL;
-
-		// --- form mixture out = dry*xn + wet*yn
-		double outputR = dryMix*xnR + wetMix*ynR;
-
-		// --- set left channel
-		outputFrame[0] = (float)outputL;
-
-		// --- set right channel
-		outputFrame[1] = (float)outputR;
-
-		return true;
+		return yn;
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
+	/** process a block; input and output may be the same buffer */
 	/**
-	\return AudioDelayParameters custom data structure
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
 	*/
-	AudioDelayParameters getParameters() { return parameters; }
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		for (unsigned int n = 0; n < blockSize; n++)
+			output[n] = processAudioSample(input[n]);
+	}
 
-	/** set parameters: note use of custom structure for passing param data */
+	/** write one input without computing an output (decimators only need every Mth output) */
 	/**
-	\param AudioDelayParameters custom data structure
+	\param xn input
 	*/
-	void setParameters(AudioDelayParameters _parameters)
+	void pushSample(double xn)
 	{
-		// --- check mix in dB for calc
-		if (_parameters.dryLevel_dB != parameters.dryLevel_dB)
-			dryMix = pow(10.0, _parameters.dryLevel_dB / 20.0);
-		if (_parameters.wetLevel_dB != parameters.wetLevel_dB)
-			wetMix = pow(10.0, _parameters.wetLevel_dB / 20.0);
-
-		// --- save; rest of updates are cheap on CPU
-		parameters = _parameters;
-
-		// --- check update type first:
-		if (parameters.updateType == delayUpdateType::kLeftAndRight)
-		{
-			// --- set left and right delay times
-			// --- calculate total delay time in samples + fraction
-			double newDelayInSamples_L = parameters.leftDelay_mSec*(samplesPerMSec);
-			double newDelayInSamples_R = parameters.rightDelay_mSec*(samplesPerMSec);
-
-			// --- new delay time with fraction
-			delayInSamples_L = newDelayInSamples_L;
-			delayInSamples_R = newDelayInSamples_R;
-		}
-		else if (parameters.updateType == delayUpdateType::kLeftPlusRatio)
-		{
-			// --- get and validate ratio
-			double delayRatio = parameters.delayRatio_Pct / 100.0;
-			boundValue(delayRatio, 0.0, 1.0);
-
-			// --- calculate total delay time in samples + fraction
-			double newDelayInSamples = parameters.leftDelay_mSec*(samplesPerMSec);
-
-			// --- new delay time with fraction
-			delayInSamples_L = newDelayInSamples;
-			delayInSamples_R = delayInSamples_L*delayRatio;
-		}
+		history[writeIndex] = (T)xn;
+		history[writeIndex + paddedLength] = (T)xn;
+		writeIndex = writeIndex > 0 ? writeIndex - 1 : paddedLength - 1;
 	}
 
-	/** creation function */
-	void createDelayBuffers(double _sampleRate, double _bufferLength_mSec)
+	/** the output for the inputs pushed so far, as processAudioSample( ) would have returned for the last one */
+	double getOutput()
 	{
-		// --- store for math
-		bufferLength_mSec = _bufferLength_mSec;
-		sampleRate = _sampleRate;
-		samplesPerMSec = sampleRate / 1000.0;
+		const T* x = &history[writeIndex + 1];
+		const T* h = coefficients;
 
-		// --- total buffer length including fractional part
-		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
+		T sum[lanes] = {};
+		for (unsigned int i = 0; i < paddedLength; i += lanes, x += lanes, h += lanes)
+		{
+			for (unsigned int j = 0; j < lanes; j++)
+				sum[j] += x[j] * h[j];
+		}
 
-																			   // --- create new buffer
-		delayBuffer_L.createCircularBuffer(bufferLength);
-		delayBuffer_R.createCircularBuffer(bufferLength);
+		double yn = 0.0;
+		for (unsigned int j = 0; j < lanes; j++)
+			yn += sum[j];
+		return yn;
 	}
 
-private:
-	AudioDelayParameters parameters; ///< object parameters
-
-	double sampleRate = 0.0;		///< current sample rate
-	double samplesPerMSec = 0.0;	///< samples per millisecond, for easy access calculation
-	double delayInSamples_L = 0.0;	///< double includes fractional part
-	double delayInSamples_R = 0.0;	///< double includes fractional part
-	double bufferLength_mSec = 0.0;	///< buffer length in mSec
-	unsigned int bufferLength = 0;	///< buffer length in samples
-	double wetMix = 0.707; ///< wet output default = -3dB
-	double dryMix = 0.707; ///< dry output default = -3dB
-
-	// --- delay buffer of doubles
-	CircularBuffer<double> delayBuffer_L;	///< LEFT delay buffer of doubles
-	CircularBuffer<double> delayBuffer_R;	///< RIGHT delay buffer of doubles
-};
-
-
-/**
-\enum generatorWaveform
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the oscillator waveform
-
-- enum  generatorWaveform { kTriangle, kSin, kSaw };
+	/** get the number of taps */
+	unsigned int getLength() { return length; }
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class generatorWaveform { kTriangle, kSin, kSaw };
+	/** get the coefficient array (getLength( ) taps, zero padded) */
+	const T* getCoefficients() { return coefficients; }
 
-/**
-\struct OscillatorParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the LFO and DFOscillator objects.
+protected:
+	static const unsigned int lanes = FIR_KERNEL_ALIGNMENT / sizeof(T);	///< partial sums, one cache line of T
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct OscillatorParameters
-{
-	OscillatorParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	OscillatorParameters& operator=(const OscillatorParameters& params)	// need this override for collections to work
+	/** round a pointer up to FIR_KERNEL_ALIGNMENT */
+	static T* alignPointer(T* p)
 	{
-		if (this == &params)
-			return *this;
-
-		waveform = params.waveform;
-		frequency_Hz = params.frequency_Hz;
-		return *this;
+		return (T*)(((size_t)p + FIR_KERNEL_ALIGNMENT - 1) & ~((size_t)FIR_KERNEL_ALIGNMENT - 1));
 	}
 
-	// --- individual parameters
-	generatorWaveform waveform = generatorWaveform::kTriangle; ///< the current waveform
-	double frequency_Hz = 0.0;	///< oscillator frequency
+	std::unique_ptr<T[]> coefficientMemory = nullptr;	///< coefficient allocation
+	std::unique_ptr<T[]> nextCoefficientMemory = nullptr;	///< next coefficient allocation
+	std::unique_ptr<T[]> historyMemory = nullptr;		///< history allocation
+	T* coefficients = nullptr;		///< aligned coefficients h(0)...h(N-1), zero padded
+	T* nextCoefficients = nullptr;	///< aligned next coefficients, for crossfades
+	T* history = nullptr;			///< aligned mirrored history, 2 x paddedLength
+	unsigned int length = 0;		///< number of taps N
+	unsigned int paddedLength = 0;	///< N padded to a multiple of lanes
+	unsigned int writeIndex = 0;	///< history write index, runs backwards
 };
 
+
 /**
-\class LFO
+\class ImpulseConvolver
 \ingroup FX-Objects
 \brief
-The LFO object implements a mathematically perfect LFO generator for modulation uses only. It should not be used for
-audio frequencies except for the sinusoidal output which, though an approximation, has very low TDH.
+The ImpulseConvolver object implements a linear conovlver. The convolution runs in a FIRKernel: one contiguous,
+vectorizable dot product per sample over a mirrored signal history, with double or float coefficients.
 
 Audio I/O:
-- Output only object: low frequency generator.
+- Processes mono input to mono output, per sample or in blocks.
 
 Control I/F:
-- Use OscillatorParameters structure to get/set object params.
+- setFloatCoefficients( ) to run the kernel in float (twice the SIMD width) instead of double.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class LFO : public IAudioSignalGenerator
+class ImpulseConvolver : public IAudioSignalProcessor
 {
 public:
-	LFO() {	srand((uint32_t)time(NULL)); }	/* C-TOR */
-	virtual ~LFO() {}				/* D-TOR */
+	ImpulseConvolver() {
+		init(512);
+	}		/* C-TOR */
+	~ImpulseConvolver() {}		/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		sampleRate = _sampleRate;
-		phaseInc = lfoParameters.frequency_Hz / sampleRate;
-
-		// --- timebase variables
-		modCounter = 0.0;			///< modulo counter [0.0, +1.0]
-		modCounterQP = 0.25;		///<Quad Phase modulo counter [0.0, +1.0]
+		// --- flush signal history; IR is static (a crossfade jumps to its end)
+		if (crossfadeCount > 0)
+			finishCrossfade();
 
+		if (floatCoefficients)
+			floatKernel.flushHistory();
+		else
+			doubleKernel.flushHistory();
 		return true;
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
+	/** process one input - note this is CPU intensive as it performs simple linear convolution */
 	/**
-	\return OscillatorParameters custom data structure
+	\param xn input
+	\return the processed sample
 	*/
-	OscillatorParameters getParameters(){ return lfoParameters; }
+	virtual double processAudioSample(double xn)
+	{
+		if (crossfadeCount > 0)
+			return processCrossfade(xn);
 
-	/** set parameters: note use of custom structure for passing param data */
+		// --- y(n) = sum of x(n-k)h(k)
+		if (floatCoefficients)
+			return floatKernel.processAudioSample(xn);
+		return doubleKernel.processAudioSample(xn);
+	}
+
+	/** process a block of MONO audio; input and output may be the same buffer */
 	/**
-	\param OscillatorParameters custom data structure
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
 	*/
-	void setParameters(const OscillatorParameters& params)
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
 	{
-		if(params.frequency_Hz != lfoParameters.frequency_Hz)
-			// --- update phase inc based on osc freq and fs
-			phaseInc = params.frequency_Hz / sampleRate;
+		unsigned int n = 0;
+		for (; n < blockSize && crossfadeCount > 0; n++)
+			output[n] = processCrossfade(input[n]);
 
-		lfoParameters = params;
+		if (floatCoefficients)
+			floatKernel.processAudioBlock(&input[n], &output[n], blockSize - n);
+		else
+			doubleKernel.processAudioBlock(&input[n], &output[n], blockSize - n);
 	}
 
-	/** render a new audio output structure */
-	virtual const SignalGenData renderAudioOutput();
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-protected:
-	// --- parameters
-	OscillatorParameters lfoParameters; ///< obejcgt parameters
+	/** create the buffers; any length works, powers of 2 are no longer required */
+	void init(unsigned int lengthPowerOfTwo)
+	{
+		length = lengthPowerOfTwo;
+		crossfadeCount = 0;
 
-	// --- sample rate
-	double sampleRate = 0.0;			///< sample rate
+		// --- create (and clear out) the buffers
+		impulseResponse.reset(new double[length]);
+		nextImpulseResponse.reset(new double[length]);
+		memset(&impulseResponse[0], 0, length * sizeof(double));
+		memset(&nextImpulseResponse[0], 0, length * sizeof(double));
+		createKernel();
+	}
 
-	// --- timebase variables
-	double modCounter = 0.0;			///< modulo counter [0.0, +1.0]
-	double phaseInc = 0.0;				///< phase inc = fo/fs
-	double modCounterQP = 0.25;			///<Quad Phase modulo counter [0.0, +1.0]
+	/** set the impulse response; takes effect at once (see crossfadeToImpulseResponse( )) */
+	void setImpulseResponse(double* irArray, unsigned int lengthPowerOfTwo)
+	{
+		crossfadeCount = 0;
+		if (lengthPowerOfTwo != length)
+			init(lengthPowerOfTwo);
 
-	/** check the modulo counter and wrap if needed */
-	inline bool checkAndWrapModulo(double& moduloCounter, double phaseInc)
+		// --- load up the IR
+		memcpy(&impulseResponse[0], &irArray[0], length * sizeof(double));
+		if (floatCoefficients)
+			floatKernel.setCoefficients(&impulseResponse[0]);
+		else
+			doubleKernel.setCoefficients(&impulseResponse[0]);
+	}
+
+	/** glide from the current IR to a new one of the same length over crossfadeLength samples; both run on the
+	    same history during the fade, so it costs a second dot product. A fade in progress is first frozen into
+	    the current IR, so back to back updates (e.g. automation) stay continuous. */
+	/**
+	\param irArray the new IR, getLength( ) long
+	\param crossfadeLength fade length in samples; 0 swaps at once
+	*/
+	void crossfadeToImpulseResponse(double* irArray, unsigned int crossfadeLength)
 	{
-		// --- for positive frequencies
-		if (phaseInc > 0 && moduloCounter >= 1.0)
+		if (crossfadeLength == 0)
 		{
-			moduloCounter -= 1.0;
-			return true;
+			setImpulseResponse(irArray, length);
+			return;
 		}
 
-		// --- for negative frequencies
-		if (phaseInc < 0 && moduloCounter <= 0.0)
+		if (crossfadeCount > 0)
 		{
-			moduloCounter += 1.0;
-			return true;
+			// --- freeze the fade where it is: h = h + g(hNext - h)
+			for (unsigned int i = 0; i < length; i++)
+				impulseResponse[i] += crossfadeGain*(nextImpulseResponse[i] - impulseResponse[i]);
+			loadCoefficients(false);
 		}
 
-		return false;
+		memcpy(&nextImpulseResponse[0], &irArray[0], length * sizeof(double));
+		loadCoefficients(true);
+
+		crossfadeGain = 0.0;
+		crossfadeInc = 1.0 / crossfadeLength;
+		crossfadeCount = crossfadeLength;
 	}
 
-	/** advanvce the modulo counter, then check the modulo counter and wrap if needed */
-	inline bool advanceAndCheckWrapModulo(double& moduloCounter, double phaseInc)
+	/** true while a crossfade is running */
+	bool isCrossfading() { return crossfadeCount > 0; }
+
+	/** run the convolution with float (true) or double (false, default) coefficients and history; flushes the history */
+	void setFloatCoefficients(bool b)
 	{
-		// --- advance counter
-		moduloCounter += phaseInc;
+		if (b == floatCoefficients)
+			return;
 
-		// --- for positive frequencies
-		if (phaseInc > 0 && moduloCounter >= 1.0)
+		if (crossfadeCount > 0)
+			finishCrossfade();
+
+		floatCoefficients = b;
+		createKernel();
+	}
+
+	/** get the coefficient type */
+	bool getFloatCoefficients() { return floatCoefficients; }
+
+	/** get the IR length */
+	unsigned int getLength() { return length; }
+
+protected:
+	/** create the active kernel and load the IR; the other kernel is released */
+	void createKernel()
+	{
+		if (floatCoefficients)
 		{
-			moduloCounter -= 1.0;
-			return true;
+			floatKernel.createKernel(length);
+			floatKernel.setCoefficients(&impulseResponse[0]);
+			doubleKernel.destroyKernel();
 		}
-
-		// --- for negative frequencies
-		if (phaseInc < 0 && moduloCounter <= 0.0)
+		else
 		{
-			moduloCounter += 1.0;
-			return true;
+			doubleKernel.createKernel(length);
+			doubleKernel.setCoefficients(&impulseResponse[0]);
+			floatKernel.destroyKernel();
 		}
+	}
 
-		return false;
+	/** load the current (next = false) or next IR into the active kernel */
+	void loadCoefficients(bool next)
+	{
+		if (floatCoefficients)
+		{
+			if (next)
+				floatKernel.setNextCoefficients(&nextImpulseResponse[0]);
+			else
+				floatKernel.setCoefficients(&impulseResponse[0]);
+		}
+		else
+		{
+			if (next)
+				doubleKernel.setNextCoefficients(&nextImpulseResponse[0]);
+			else
+				doubleKernel.setCoefficients(&impulseResponse[0]);
+		}
 	}
 
-	/** advanvce the modulo counter */
-	inline void advanceModulo(double& moduloCounter, double phaseInc) { moduloCounter += phaseInc; }
+	/** one crossfade sample: y = y0 + g(y1 - y0) with g ramping to 1 */
+	double processCrossfade(double xn)
+	{
+		double ynNext = 0.0;
+		double yn = floatCoefficients ? floatKernel.processAudioSample(xn, ynNext) : doubleKernel.processAudioSample(xn, ynNext);
 
-	const double B = 4.0 / kPi;
-	const double C = -4.0 / (kPi* kPi);
-	const double P = 0.225;
-	/** parabolic sinusoidal calcualtion; NOTE: input is -pi to +pi http://devmaster.net/posts/9648/fast-and-accurate-sine-cosine */
-	inline double parabolicSine(double angle)
+		crossfadeGain += crossfadeInc;
+		yn += crossfadeGain*(ynNext - yn);
+
+		if (--crossfadeCount == 0)
+			finishCrossfade();
+		return yn;
+	}
+
+	/** end the crossfade: the next IR becomes the current one */
+	void finishCrossfade()
 	{
-		double y = B * angle + C * angle * fabs(angle);
-		y = P * (y * fabs(y) - y) + y;
-		return y;
+		crossfadeCount = 0;
+		crossfadeGain = 0.0;
+		impulseResponse.swap(nextImpulseResponse);
+		if (floatCoefficients)
+			floatKernel.swapCoefficients();
+		else
+			doubleKernel.swapCoefficients();
 	}
-};
 
-/**
-\enum DFOscillatorCoeffs
-\ingroup Constants-Enums
-\brief
-Use this non-typed enum to easily access the direct form oscillator coefficients
+	FIRKernel<double> doubleKernel;	///< kernel with double coefficients
+	FIRKernel<float> floatKernel;	///< kernel with float coefficients
+	std::unique_ptr<double[]> impulseResponse = nullptr;	///< copy of the IR, to reload the kernel
+	std::unique_ptr<double[]> nextImpulseResponse = nullptr;///< IR being faded in
+	bool floatCoefficients = false;	///< run the float kernel
 
-- enum DFOscillatorCoeffs { df_b1, df_b2, numDFOCoeffs };
+	// --- IR crossfade
+	unsigned int crossfadeCount = 0;	///< samples left in the fade
+	double crossfadeGain = 0.0;			///< gain of the next IR
+	double crossfadeInc = 0.0;			///< gain step per sample
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum DFOscillatorCoeffs { df_b1, df_b2, numDFOCoeffs };
+	unsigned int length = 0;	///< length of convolution (buffer)
+
+};
 
+const unsigned int IR_LEN = 512;
+const unsigned int IR_CROSSFADE_LEN = 256;	///< AnalogFIRFilter IR crossfade, samples
+const unsigned int ANALOG_FIR_CACHE_SIZE = 4;	///< AnalogFIRFilter designs kept per object
 /**
-\enum DFOscillatorStates
-\ingroup Constants-Enums
+\struct AnalogFIRFilterParameters
+\ingroup FX-Objects
 \brief
-Use this non-typed enum to easily access the direct form oscillator state registers
-
-- DFOscillatorStates { df_yz1, df_yz2, numDFOStates };
+Custom parameter structure for the AnalogFIRFilter object. This is a somewhat silly object that implaments an analog
+magnitude response as a FIR filter. NOT DESIGNED to replace virtual analog; rather it is intended to show the
+frequency sampling method in an easy (and fun) way.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-enum DFOscillatorStates { df_yz1, df_yz2, numDFOStates };
+struct AnalogFIRFilterParameters
+{
+	AnalogFIRFilterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	AnalogFIRFilterParameters& operator=(const AnalogFIRFilterParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		filterType = params.filterType;
+		fc = params.fc;
+		Q = params.Q;
+
+		return *this;
+	}
 
+	// --- individual parameters
+	analogFilter filterType = analogFilter::kLPF1; ///< filter type
+	double fc = 0.0;	///< filter fc
+	double Q = 0.0;		///< filter Q
+};
 
 /**
-\class DFOscillator
+\class AnalogFIRFilter
 \ingroup FX-Objects
 \brief
-The DFOscillator object implements generates a very pure sinusoidal oscillator by placing poles direclty on the unit circle.
-Accuracy is excellent even at low frequencies.
+The AnalogFIRFilter object implements a somewhat silly algorithm that implaments an analog
+magnitude response as a FIR filter. NOT DESIGNED to replace virtual analog; rather it is intended to show the
+frequency sampling method in an easy (and fun) way.
+
+The IR is designed with FastFreqSampler (one real IFFT, no allocation), the last ANALOG_FIR_CACHE_SIZE designs are
+cached, and a new IR is crossfaded in over IR_CROSSFADE_LEN samples, so fc, Q and type can be automated.
 
 Audio I/O:
-- Output only object: pitched audio sinusoidal generator.
+- Processes mono input to mono output, per sample or in blocks.
 
 Control I/F:
-- Use OscillatorParameters structure to get/set object params.
+- Use AnalogFIRFilterParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class DFOscillator : public IAudioSignalGenerator
+class AnalogFIRFilter : public IAudioSignalProcessor
 {
 public:
-	DFOscillator() { }	/* C-TOR */
-	virtual ~DFOscillator() {}				/* D-TOR */
+	AnalogFIRFilter() {
+		freqSampler.initialize(IR_LEN);
+	}	/* C-TOR */
+	~AnalogFIRFilter() {}	/* D-TOR */
 
+public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
-		memset(&stateArray[0], 0, sizeof(double)*numDFOStates);
-		updateDFO();
+		convolver.reset(_sampleRate);
+		convolver.init(IR_LEN);
+
+		memset(&analogMagArray[0], 0, sizeof(double) * IR_LEN);	///< clear
+		memset(&irArray[0], 0, sizeof(double) * IR_LEN);	///< clear
+
+		// --- the designs depend on the sample rate
+		for (unsigned int i = 0; i < ANALOG_FIR_CACHE_SIZE; i++)
+			cacheValid[i] = false;
+
+		// --- re-design the current filter, else it stays silent until a parameter changes
+		if (parameters.fc > 0.0)
+		{
+			designIR(parameters);
+			convolver.setImpulseResponse(irArray, IR_LEN);
+		}
+
 		return true;
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
+	/** pefrorm the convolution */
 	/**
-	\return OscillatorParameters custom data structure
+	\param xn input
+	\return the processed sample
 	*/
-	OscillatorParameters getParameters()
+	virtual double processAudioSample(double xn)
 	{
-		return parameters;
+		// --- do the linear convolution
+		return convolver.processAudioSample(xn);
 	}
 
+	/** process a block of MONO audio; input and output may be the same buffer */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		convolver.processAudioBlock(input, output, blockSize);
+	}
+
+	/** run the convolution with float (true) or double (false, default) coefficients, see ImpulseConvolver */
+	void setFloatCoefficients(bool b) { convolver.setFloatCoefficients(b); }
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return AnalogFIRFilterParameters custom data structure
+	*/
+	AnalogFIRFilterParameters getParameters() { return parameters; }
+
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param OscillatorParameters custom data structure
+	\param AnalogFIRFilterParameters custom data structure
 	*/
-	void setParameters(const OscillatorParameters& params)
+	void setParameters(AnalogFIRFilterParameters _parameters)
 	{
-		if (parameters.frequency_Hz != params.frequency_Hz)
+		if (_parameters.fc != parameters.fc ||
+			_parameters.Q != parameters.Q ||
+			_parameters.filterType != parameters.filterType)
 		{
-			parameters = params;
-			updateDFO();
+			// --- set the filter IR for the convolver
+			designIR(_parameters);
+
+			// --- glide to the new frequency response
+			convolver.crossfadeToImpulseResponse(irArray, IR_CROSSFADE_LEN);
 		}
+
+		parameters = _parameters;
 	}
 
-	/** render the audio signal (pure sinusoid) */
-	virtual const SignalGenData renderAudioOutput()
+private:
+	/** fill irArray for a parameter set: from the cache, or designed and cached */
+	void designIR(const AnalogFIRFilterParameters& designParameters)
 	{
-		// --- calculates normal and inverted outputs; quadphase are not used
-		SignalGenData output;
+		for (unsigned int i = 0; i < ANALOG_FIR_CACHE_SIZE; i++)
+		{
+			if (cacheValid[i] &&
+				cacheParameters[i].fc == designParameters.fc &&
+				cacheParameters[i].Q == designParameters.Q &&
+				cacheParameters[i].filterType == designParameters.filterType)
+			{
+				memcpy(&irArray[0], &irCache[i][0], sizeof(double) * IR_LEN);
+				return;
+			}
+		}
 
-		// -- do difference equation y(n) = -b1y(n-2) - b2y(n-2)
-		output.normalOutput = (-coeffArray[df_b1]*stateArray[df_yz1] - coeffArray[df_b2]*stateArray[df_yz2]);
-		output.invertedOutput = -output.normalOutput;
+		AnalogMagData analogFilterData;
+		analogFilterData.sampleRate = sampleRate;
+		analogFilterData.magArray = &analogMagArray[0];
+		analogFilterData.dftArrayLen = IR_LEN;
+		analogFilterData.mirrorMag = false;
 
-		// --- update states
-		stateArray[df_yz2] = stateArray[df_yz1];
-		stateArray[df_yz1] = output.normalOutput;
+		analogFilterData.filterType = designParameters.filterType;
+		analogFilterData.fc = designParameters.fc;
+		analogFilterData.Q = designParameters.Q;
 
-		return output;
-	}
+		// --- calculate the analog mag array
+		calculateAnalogMagArray(analogFilterData);
 
-	/** Update the object */
-	void updateDFO()
-	{
-		// --- Oscillation Rate = theta = wT = w/fs
-		double wT = (kTwoPi*parameters.frequency_Hz) / sampleRate;
+		// --- frequency sample the mag array: same IR as freqSample(IR_LEN, analogMagArray, irArray, POSITIVE)
+		freqSampler.sampleSymmetric(analogMagArray, irArray);
 
-		// --- coefficients to place poles right on unit circle
-		coeffArray[df_b1] = -2.0*cos(wT);	// <--- set angle a = -2Rcod(theta)
-		coeffArray[df_b2] = 1.0;			// <--- R^2 = 1, so R = 1
-
-		// --- now update states to reflect the new frequency
-		//	   re calculate the new initial conditions
-		//	   arcsine of y(n-1) gives us wnT
-		double wnT1 = asin(stateArray[df_yz1]);
-
-		// find n by dividing wnT by wT
-		double n = wnT1 / wT;
-
-		// --- re calculate the new initial conditions
-		//	   asin returns values from -pi/2 to +pi/2 where the sinusoid
-		//     moves from -1 to +1 -- the leading (rising) edge of the
-		//     sinewave. If we are on that leading edge (increasing)
-		//     then we use the value 1T behind.
-		//
-		//     If we are on the falling edge, we use the value 1T ahead
-		//     because it mimics the value that would be 1T behind
-		if (stateArray[df_yz1] > stateArray[df_yz2])
-			n -= 1;
-		else
-			n += 1;
-
-		// ---  calculate the new (old) sample
-		stateArray[df_yz2] = sin((n)*wT);
-	}
+		// --- cache it, replacing the oldest design
+		cacheParameters[cacheNext] = designParameters;
+		memcpy(&irCache[cacheNext][0], &irArray[0], sizeof(double) * IR_LEN);
+		cacheValid[cacheNext] = true;
+		cacheNext = (cacheNext + 1) % ANALOG_FIR_CACHE_SIZE;
+	}
 
+	AnalogFIRFilterParameters parameters; ///< object parameters
+	ImpulseConvolver convolver; ///< convolver object to perform FIR convolution
+	FastFreqSampler freqSampler; ///< FFT frequency sampling design
+	double analogMagArray[IR_LEN]; ///< array for analog magnitude response
+	double irArray[IR_LEN]; ///< array to hold calcualted IR
+	double sampleRate = 0.0; ///< storage for sample rate
 
-protected:
-	// --- parameters
-	OscillatorParameters parameters; ///< object parameters
+	// --- recent designs
+	AnalogFIRFilterParameters cacheParameters[ANALOG_FIR_CACHE_SIZE]; ///< parameters of the cached IRs
+	double irCache[ANALOG_FIR_CACHE_SIZE][IR_LEN]; ///< cached IRs
+	bool cacheValid[ANALOG_FIR_CACHE_SIZE] = { false }; ///< cache entry in use
+	unsigned int cacheNext = 0; ///< next cache entry to replace
+};
 
-	// --- implementation of half a biquad - this object is extremely specific
-	double stateArray[numDFOStates] = { 0.0, 0.0 };///< array of state registers
-	double coeffArray[numDFOCoeffs] = { 0.0, 0.0 };///< array of coefficients
+/**
+\enum delayAlgorithm
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the delay algorithm
 
-	// --- sample rate
-	double sampleRate = 0.0;			///< sample rate
-};
+- enum class delayAlgorithm { kNormal, kPingPong };
 
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class delayAlgorithm { kNormal, kPingPong };
 
 /**
-\enum modDelaylgorithm
+\enum delayUpdateType
 \ingroup Constants-Enums
 \brief
-Use this strongly typed enum to easily set modulated delay algorithm.
+Use this strongly typed enum to easily set the delay update type; this varies depending on the designer's choice
+of GUI controls. See the book reference for more details.
 
-- enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+- enum class delayUpdateType { kLeftAndRight, kLeftPlusRatio };
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+enum class delayUpdateType { kLeftAndRight, kLeftPlusRatio };
 
 
 /**
-\struct ModulatedDelayParameters
+\struct AudioDelayParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the ModulatedDelay object.
+Custom parameter structure for the AudioDelay object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct ModulatedDelayParameters
+struct AudioDelayParameters
 {
-	ModulatedDelayParameters() {}
+	AudioDelayParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ModulatedDelayParameters& operator=(const ModulatedDelayParameters& params)	// need this override for collections to work
+	AudioDelayParameters& operator=(const AudioDelayParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
 		algorithm = params.algorithm;
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth_Pct = params.lfoDepth_Pct;
+		wetLevel_dB = params.wetLevel_dB;
+		dryLevel_dB = params.dryLevel_dB;
 		feedback_Pct = params.feedback_Pct;
+
+		updateType = params.updateType;
+		leftDelay_mSec = params.leftDelay_mSec;
+		rightDelay_mSec = params.rightDelay_mSec;
+		delayRatio_Pct = params.delayRatio_Pct;
+		interpolation = params.interpolation;
+
 		return *this;
 	}
 
 	// --- individual parameters
-	modDelaylgorithm algorithm = modDelaylgorithm::kFlanger; ///< mod delay algorithm
-	double lfoRate_Hz = 0.0;	///< mod delay LFO rate in Hz
-	double lfoDepth_Pct = 0.0;	///< mod delay LFO depth in %
-	double feedback_Pct = 0.0;	///< feedback in %
+	delayAlgorithm algorithm = delayAlgorithm::kNormal; ///< delay algorithm
+	double wetLevel_dB = -3.0;	///< wet output level in dB
+	double dryLevel_dB = -3.0;	///< dry output level in dB
+	double feedback_Pct = 0.0;	///< feedback as a % value
+
+	delayUpdateType updateType = delayUpdateType::kLeftAndRight;///< update algorithm
+	double leftDelay_mSec = 0.0;	///< left delay time
+	double rightDelay_mSec = 0.0;	///< right delay time
+	double delayRatio_Pct = 100.0;	///< dela ratio: right length = (delayRatio)*(left length)
+	delayInterpolation interpolation = delayInterpolation::kLinear; ///< fractional delay interpolator
 };
 
 /**
-\class ModulatedDelay
+\class AudioDelay
 \ingroup FX-Objects
 \brief
-The ModulatedDelay object implements the three basic algorithms: flanger, chorus, vibrato.
+The AudioDelay object implements a stereo audio delay with multiple delay algorithms.
 
-Audio I / O :
-	-Processes mono input to mono OR stereo output.
+Audio I/O:
+- Processes mono input to mono output OR stereo output.
 
-Control I / F :
-	-Use ModulatedDelayParameters structure to get / set object params.
+Control I/F:
+- Use AudioDelayParameters structure to get/set object params.
 
-\author Will Pirkle http ://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed.by Will Pirkle
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ModulatedDelay : public IAudioSignalProcessor
+class AudioDelay : public IAudioSignalProcessor
 {
 public:
-	ModulatedDelay() {
-	}		/* C-TOR */
-	~ModulatedDelay() {}	/* D-TOR */
+	AudioDelay() {}		/* C-TOR */
+	~AudioDelay() {}	/* D-TOR */
 
 public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- create new buffer, 100mSec long
-		delay.reset(_sampleRate);
-		delay.createDelayBuffers(_sampleRate, 100.0);
+		// --- if sample rate did not change (arena buffers are always re-created, see DelayMemoryArena)
+		if (sampleRate == _sampleRate && !delayMemoryArena)
+		{
+			// --- just flush buffer and return
+			delayBuffer_L.flushBuffer();
+			delayBuffer_R.flushBuffer();
+			return true;
+		}
 
-		// --- lfo
-		lfo.reset(_sampleRate);
-		OscillatorParameters params = lfo.getParameters();
-		params.waveform = generatorWaveform::kTriangle;
-		lfo.setParameters(params);
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffers(_sampleRate, bufferLength_mSec);
 
 		return true;
 	}
 
-	/** process input sample */
+	/** process MONO audio delay */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		float input = (float)xn;
-		float output = 0.0;
-		processAudioFrame(&input, &output, 1, 1);
+		// --- read delay
+		double yn = delayBuffer_L.readBuffer(delayInSamples_L);
+
+		// --- create input for delay buffer
+		double dn = xn + (parameters.feedback_Pct / 100.0) * yn;
+
+		// --- write to delay buffer
+		delayBuffer_L.writeBuffer(dn);
+
+		// --- form mixture out = dry*xn + wet*yn
+		double output = dryMix*xn + wetMix*yn;
+
 		return output;
 	}
 
-	/** return true: this object can process frames */
-	virtual bool canProcessAudioFrame() { return true; }
-
-	/** process STEREO audio delay of frames */
-	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
-		float* outputFrame,
-		uint32_t inputChannels,
-		uint32_t outputChannels)
+	/** process MONO audio delay in blocks; same output as processAudioSample( ) per sample, with the delay line
+	    read and written in chunks of up to delay + 1 samples. input and output may be the same buffer. */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
 	{
-		// --- make sure we have input and outputs
-		if (inputChannels == 0 || outputChannels == 0)
-			return false;
+		double yn[MAX_DELAY_BLOCK];
+		double dn[MAX_DELAY_BLOCK];
+		double feedback = parameters.feedback_Pct / 100.0;
+		double dry = dryMix;
+		double wet = wetMix;
+		unsigned int chunk = getMaxBlockLength(delayBuffer_L, delayInSamples_L);
 
-		// --- render LFO
-		SignalGenData lfoOutput = lfo.renderAudioOutput();
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+			delayBuffer_L.readBlock(delayInSamples_L, yn, length);
 
-		// --- setup delay modulation
-		AudioDelayParameters params = delay.getParameters();
-		double minDelay_mSec = 0.0;
-		double maxDepth_mSec = 0.0;
+			// --- no recursion inside a chunk: these loops vectorize
+			for (unsigned int i = 0; i < length; i++)
+				dn[i] = input[n + i] + feedback * yn[i];
+			delayBuffer_L.writeBlock(dn, length);
 
-		// --- set delay times, wet/dry and feedback
-		if (parameters.algorithm == modDelaylgorithm::kFlanger)
-		{
-			minDelay_mSec = 0.1;
-			maxDepth_mSec = 7.0;
-			params.wetLevel_dB = -3.0;
-			params.dryLevel_dB = -3.0;
-		}
-		if (parameters.algorithm == modDelaylgorithm::kChorus)
-		{
-			minDelay_mSec = 10.0;
-			maxDepth_mSec = 30.0;
-			params.wetLevel_dB = -3.0;
-			params.dryLevel_dB = -0.0;
-			params.feedback_Pct = 0.0;
-		}
-		if (parameters.algorithm == modDelaylgorithm::kVibrato)
-		{
-			minDelay_mSec = 0.0;
-			maxDepth_mSec = 7.0;
-			params.wetLevel_dB = 0.0;
-			params.dryLevel_dB = -96.0;
-			params.feedback_Pct = 0.0;
+			for (unsigned int i = 0; i < length; i++)
+				output[n + i] = dry*input[n + i] + wet*yn[i];
 		}
+	}
 
-		// --- calc modulated delay times
-		double depth = parameters.lfoDepth_Pct / 100.0;
-		double modulationMin = minDelay_mSec;
-		double modulationMax = minDelay_mSec + maxDepth_mSec;
-
-		// --- flanger - unipolar
-		if (parameters.algorithm == modDelaylgorithm::kFlanger)
-			params.leftDelay_mSec = doUnipolarModulationFromMin(bipolarToUnipolar(depth * lfoOutput.normalOutput),
-															     modulationMin, modulationMax);
-		else
-			params.leftDelay_mSec = doBipolarModulation(depth * lfoOutput.normalOutput, modulationMin, modulationMax);
+	/** process STEREO audio delay in blocks; same output as processAudioFrame( ) per frame, for the normal and
+	    ping-pong algorithms. inputs and outputs may be the same buffers. */
+	/**
+	\param inputL LEFT input block
+	\param inputR RIGHT input block
+	\param outputL LEFT output block
+	\param outputR RIGHT output block
+	\param blockSize number of samples
+	\return true if the algorithm is supported
+	*/
+	bool processAudioBlocks(const double* inputL, const double* inputR, double* outputL, double* outputR, unsigned int blockSize)
+	{
+		// --- make sure we support this delay algorithm
+		if (parameters.algorithm != delayAlgorithm::kNormal &&
+			parameters.algorithm != delayAlgorithm::kPingPong)
+			return false;
 
+		double ynL[MAX_DELAY_BLOCK];
+		double ynR[MAX_DELAY_BLOCK];
+		double dnL[MAX_DELAY_BLOCK];
+		double dnR[MAX_DELAY_BLOCK];
+		double feedback = parameters.feedback_Pct / 100.0;
+		double dry = dryMix;
+		double wet = wetMix;
+		bool pingPong = parameters.algorithm == delayAlgorithm::kPingPong;
+
+		// --- both lines advance together, so the shorter delay sets the chunk
+		unsigned int chunk = getMaxBlockLength(delayBuffer_L, delayInSamples_L);
+		unsigned int chunkR = getMaxBlockLength(delayBuffer_R, delayInSamples_R);
+		if (chunkR < chunk) chunk = chunkR;
+
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+			delayBuffer_L.readBlock(delayInSamples_L, ynL, length);
+			delayBuffer_R.readBlock(delayInSamples_R, ynR, length);
 
-		// --- set right delay to match (*Hint Homework!)
-		params.rightDelay_mSec = params.leftDelay_mSec;
+			for (unsigned int i = 0; i < length; i++)
+			{
+				dnL[i] = inputL[n + i] + feedback * ynL[i];
+				dnR[i] = inputR[n + i] + feedback * ynR[i];
+			}
 
-		// --- modulate the delay
-		delay.setParameters(params);
+			// --- decode
+			delayBuffer_L.writeBlock(pingPong ? dnR : dnL, length);
+			delayBuffer_R.writeBlock(pingPong ? dnL : dnR, length);
 
-		// --- just call the function and pass our info in/out
-		return delay.processAudioFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+			for (unsigned int i = 0; i < length; i++)
+			{
+				outputL[n + i] = dry*inputL[n + i] + wet*ynL[i];
+				outputR[n + i] = dry*inputR[n + i] + wet*ynR[i];
+			}
+		}
+		return true;
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ModulatedDelayParameters custom data structure
-	*/
-	ModulatedDelayParameters getParameters() { return parameters; }
-
-	/** set parameters: note use of custom structure for passing param data */
+	/** process MONO audio in blocks with one LEFT delay time per sample, as when the delay is modulated; same output
+	    as setting leftDelay_mSec and calling processAudioSample( ) per sample. input and output may be the same buffer. */
 	/**
-	\param ModulatedDelayParameters custom data structure
+	\param input input block
+	\param output output block
+	\param delay_mSec delay time for each sample
+	\param blockSize number of samples
 	*/
-	void setParameters(ModulatedDelayParameters _parameters)
+	void processModulatedBlock(const double* input, double* output, const double* delay_mSec, unsigned int blockSize)
 	{
-		// --- bulk copy
-		parameters = _parameters;
-
-		OscillatorParameters lfoParams = lfo.getParameters();
-		lfoParams.frequency_Hz = parameters.lfoRate_Hz;
-		if (parameters.algorithm == modDelaylgorithm::kVibrato)
-			lfoParams.waveform = generatorWaveform::kSin;
-		else
-			lfoParams.waveform = generatorWaveform::kTriangle;
+		double delays[MAX_DELAY_BLOCK];
+		double yn[MAX_DELAY_BLOCK];
+		double dn[MAX_DELAY_BLOCK];
+		double feedback = parameters.feedback_Pct / 100.0;
+		double dry = dryMix;
+		double wet = wetMix;
 
-		lfo.setParameters(lfoParams);
+		for (unsigned int n = 0; n < blockSize; )
+		{
+			unsigned int length = blockSize - n < MAX_DELAY_BLOCK ? blockSize - n : MAX_DELAY_BLOCK;
+			for (unsigned int i = 0; i < length; i++)
+				delays[i] = delay_mSec[n + i] * samplesPerMSec;
 
-		AudioDelayParameters adParams = delay.getParameters();
-		adParams.feedback_Pct = parameters.feedback_Pct;
-		delay.setParameters(adParams);
-	}
+			length = getModulatedBlockLength(delayBuffer_L, delays, length);
+			if (length == 0)
+			{
+				// --- too close to the write position for a block read
+				yn[0] = delayBuffer_L.readBuffer(delays[0]);
+				length = 1;
+			}
+			else
+				delayBuffer_L.readBlock(delays, yn, length);
 
-private:
-	ModulatedDelayParameters parameters; ///< object parameters
-	AudioDelay delay;	///< the delay to modulate
-	LFO lfo;			///< the modulator
-};
+			for (unsigned int i = 0; i < length; i++)
+				dn[i] = input[n + i] + feedback * yn[i];
+			delayBuffer_L.writeBlock(dn, length);
 
-/**
-\struct PhaseShifterParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the PhaseShifter object.
+			for (unsigned int i = 0; i < length; i++)
+				output[n + i] = dry*input[n + i] + wet*yn[i];
+
+			delayInSamples_L = delays[length - 1];
+			n += length;
+		}
+	}
+
+	/** process STEREO audio in blocks with one delay time per sample and channel, as when the delay is modulated;
+	    same output as setting the delay times and calling processAudioFrame( ) per frame. inputs and outputs may be
+		the same buffers, and delayR_mSec may be delayL_mSec */
+	/**
+	\param inputL LEFT input block
+	\param inputR RIGHT input block
+	\param outputL LEFT output block
+	\param outputR RIGHT output block
+	\param delayL_mSec LEFT delay time for each sample
+	\param delayR_mSec RIGHT delay time for each sample
+	\param blockSize number of samples
+	\return true if the algorithm is supported
+	*/
+	bool processModulatedBlocks(const double* inputL, const double* inputR, double* outputL, double* outputR,
+		const double* delayL_mSec, const double* delayR_mSec, unsigned int blockSize)
+	{
+		// --- make sure we support this delay algorithm
+		if (parameters.algorithm != delayAlgorithm::kNormal &&
+			parameters.algorithm != delayAlgorithm::kPingPong)
+			return false;
+
+		double delaysL[MAX_DELAY_BLOCK];
+		double delaysR[MAX_DELAY_BLOCK];
+		double ynL[MAX_DELAY_BLOCK];
+		double ynR[MAX_DELAY_BLOCK];
+		double dnL[MAX_DELAY_BLOCK];
+		double dnR[MAX_DELAY_BLOCK];
+		double feedback = parameters.feedback_Pct / 100.0;
+		double dry = dryMix;
+		double wet = wetMix;
+		bool pingPong = parameters.algorithm == delayAlgorithm::kPingPong;
+
+		for (unsigned int n = 0; n < blockSize; )
+		{
+			unsigned int length = blockSize - n < MAX_DELAY_BLOCK ? blockSize - n : MAX_DELAY_BLOCK;
+			for (unsigned int i = 0; i < length; i++)
+			{
+				delaysL[i] = delayL_mSec[n + i] * samplesPerMSec;
+				delaysR[i] = delayR_mSec[n + i] * samplesPerMSec;
+			}
+
+			length = getModulatedBlockLength(delayBuffer_L, delaysL, length);
+			length = getModulatedBlockLength(delayBuffer_R, delaysR, length);
+			if (length == 0)
+			{
+				// --- too close to the write position for a block read
+				ynL[0] = delayBuffer_L.readBuffer(delaysL[0]);
+				ynR[0] = delayBuffer_R.readBuffer(delaysR[0]);
+				length = 1;
+			}
+			else
+			{
+				delayBuffer_L.readBlock(delaysL, ynL, length);
+				delayBuffer_R.readBlock(delaysR, ynR, length);
+			}
+
+			for (unsigned int i = 0; i < length; i++)
+			{
+				dnL[i] = inputL[n + i] + feedback * ynL[i];
+				dnR[i] = inputR[n + i] + feedback * ynR[i];
+			}
+
+			// --- decode
+			delayBuffer_L.writeBlock(pingPong ? dnR : dnL, length);
+			delayBuffer_R.writeBlock(pingPong ? dnL : dnR, length);
+
+			for (unsigned int i = 0; i < length; i++)
+			{
+				outputL[n + i] = dry*inputL[n + i] + wet*ynL[i];
+				outputR[n + i] = dry*inputR[n + i] + wet*ynR[i];
+			}
+
+			delayInSamples_L = delaysL[length - 1];
+			delayInSamples_R = delaysR[length - 1];
+			n += length;
+		}
+		return true;
+	}
+
+	/** return true: this object can also process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process STEREO audio delay in frames */
+	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		// --- make sure we support this delay algorithm
+		if (parameters.algorithm != delayAlgorithm::kNormal &&
+			parameters.algorithm != delayAlgorithm::kPingPong)
+			return false;
+
+		// --- if only one output channel, revert to mono operation
+		if (outputChannels == 1)
+		{
+			// --- process left channel only
+			outputFrame[0] = (float)processAudioSample(inputFrame[0]);
+			return true;
+		}
+
+		// --- if we get here we know we have 2 output channels
+		//
+		// --- pick up inputs
+		//
+		// --- LEFT channel
+		double xnL = inputFrame[0];
+
+		// --- RIGHT channel (duplicate left input if mono-in)
+		double xnR = inputChannels > 1 ? inputFrame[1] : xnL;
+
+		// --- read delay LEFT
+		double ynL = delayBuffer_L.readBuffer(delayInSamples_L);
+
+		// --- read delay RIGHT
+		double ynR = delayBuffer_R.readBuffer(delayInSamples_R);
+
+		// --- create input for delay buffer with LEFT channel info
+		double dnL = xnL + (parameters.feedback_Pct / 100.0) * ynL;
+
+		// --- create input for delay buffer with RIGHT channel info
+		double dnR = xnR + (parameters.feedback_Pct / 100.0) * ynR;
+
+		// --- decode
+		if (parameters.algorithm == delayAlgorithm::kNormal)
+		{
+			// --- write to LEFT delay buffer with LEFT channel info
+			delayBuffer_L.writeBuffer(dnL);
+
+			// --- write to RIGHT delay buffer with RIGHT channel info
+			delayBuffer_R.writeBuffer(dnR);
+		}
+		else if (parameters.algorithm == delayAlgorithm::kPingPong)
+		{
+			// --- write to LEFT delay buffer with RIGHT channel info
+			delayBuffer_L.writeBuffer(dnR);
+
+			// --- write to RIGHT delay buffer with LEFT channel info
+			delayBuffer_R.writeBuffer(dnL);
+		}
+
+		// --- form mixture out = dry*xn + wet*yn
+		double outputL = dryMix*xnL + wetMix*ynL;
+
+		// --- form mixture out = dry*xn + wet*yn
+		double outputR = dryMix*xnR + wetMix*ynR;
+
+		// --- set left channel
+		outputFrame[0] = (float)outputL;
+
+		// --- set right channel
+		outputFrame[1] = (float)outputR;
+
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return AudioDelayParameters custom data structure
+	*/
+	AudioDelayParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param AudioDelayParameters custom data structure
+	*/
+	void setParameters(AudioDelayParameters _parameters)
+	{
+		// --- check mix in dB for calc
+		if (_parameters.dryLevel_dB != parameters.dryLevel_dB)
+			dryMix = pow(10.0, _parameters.dryLevel_dB / 20.0);
+		if (_parameters.wetLevel_dB != parameters.wetLevel_dB)
+			wetMix = pow(10.0, _parameters.wetLevel_dB / 20.0);
+
+		// --- only on change: this also clears the Thiran interpolator state
+		if (_parameters.interpolation != parameters.interpolation)
+		{
+			delayBuffer_L.setInterpolationType(_parameters.interpolation);
+			delayBuffer_R.setInterpolationType(_parameters.interpolation);
+		}
+
+		// --- save; rest of updates are cheap on CPU
+		parameters = _parameters;
+
+		// --- check update type first:
+		if (parameters.updateType == delayUpdateType::kLeftAndRight)
+		{
+			// --- set left and right delay times
+			// --- calculate total delay time in samples + fraction
+			double newDelayInSamples_L = parameters.leftDelay_mSec*(samplesPerMSec);
+			double newDelayInSamples_R = parameters.rightDelay_mSec*(samplesPerMSec);
+
+			// --- new delay time with fraction
+			delayInSamples_L = newDelayInSamples_L;
+			delayInSamples_R = newDelayInSamples_R;
+		}
+		else if (parameters.updateType == delayUpdateType::kLeftPlusRatio)
+		{
+			// --- get and validate ratio
+			double delayRatio = parameters.delayRatio_Pct / 100.0;
+			boundValue(delayRatio, 0.0, 1.0);
+
+			// --- calculate total delay time in samples + fraction
+			double newDelayInSamples = parameters.leftDelay_mSec*(samplesPerMSec);
+
+			// --- new delay time with fraction
+			delayInSamples_L = newDelayInSamples;
+			delayInSamples_R = delayInSamples_L*delayRatio;
+		}
+	}
+
+	/** creation function */
+	void createDelayBuffers(double _sampleRate, double _bufferLength_mSec)
+	{
+		// --- store for math
+		bufferLength_mSec = _bufferLength_mSec;
+		sampleRate = _sampleRate;
+		samplesPerMSec = sampleRate / 1000.0;
+
+		// --- total buffer length including fractional part
+		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
+
+																			   // --- create new buffer
+		delayBuffer_L.createCircularBuffer(bufferLength, delayMemoryArena);
+		delayBuffer_R.createCircularBuffer(bufferLength, delayMemoryArena);
+	}
+
+	/** take the delay buffers from an arena (nullptr for the heap) at the next reset( ) or createDelayBuffers( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena) { delayMemoryArena = arena; }
+
+	/** store the delays as float, with double feedback math; takes effect when the buffers are next created
+	    (createDelayBuffers( ) or a sample rate change), see CircularBuffer::setFloatStorage( ) */
+	void setFloatStorage(bool b)
+	{
+		delayBuffer_L.setFloatStorage(b);
+		delayBuffer_R.setFloatStorage(b);
+	}
+
+	/** arena bytes for createDelayBuffers(_sampleRate, _bufferLength_mSec) */
+	static size_t getDelayMemorySize(double _sampleRate, double _bufferLength_mSec, bool floatStorage = false)
+	{
+		return 2 * CircularBuffer<double>::getArenaSize((unsigned int)(_bufferLength_mSec*(_sampleRate / 1000.0)) + 1, floatStorage);
+	}
+
+private:
+	/** longest block that can be read before it is written at this delay */
+	unsigned int getMaxBlockLength(CircularBuffer<double>& delayBuffer, double delayInSamples)
+	{
+		unsigned int length = delayBuffer.getMaxBlockRead(delayInSamples);
+		return length < MAX_DELAY_BLOCK ? length : MAX_DELAY_BLOCK;
+	}
+
+	/** number of leading samples of a modulated block that only read samples written before the block */
+	unsigned int getModulatedBlockLength(CircularBuffer<double>& delayBuffer, const double* delaysInSamples, unsigned int length)
+	{
+		unsigned int lead = delayBuffer.getInterpolationLead();
+		for (unsigned int i = 0; i < length; i++)
+		{
+			if ((unsigned int)delaysInSamples[i] < i + lead)
+				return i;
+		}
+		return length;
+	}
+
+	AudioDelayParameters parameters; ///< object parameters
+
+	double sampleRate = 0.0;		///< current sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond, for easy access calculation
+	double delayInSamples_L = 0.0;	///< double includes fractional part
+	double delayInSamples_R = 0.0;	///< double includes fractional part
+	double bufferLength_mSec = 0.0;	///< buffer length in mSec
+	unsigned int bufferLength = 0;	///< buffer length in samples
+	double wetMix = 0.707; ///< wet output default = -3dB
+	double dryMix = 0.707; ///< dry output default = -3dB
+
+	// --- delay buffer of doubles
+	CircularBuffer<double> delayBuffer_L;	///< LEFT delay buffer of doubles
+	CircularBuffer<double> delayBuffer_R;	///< RIGHT delay buffer of doubles
+	DelayMemoryArena* delayMemoryArena = nullptr;	///< optional arena for the delay buffers
+};
+
+/** maximum number of taps in a MultiTapDelay */
+const unsigned int MAX_DELAY_TAPS = 8;
+
+/**
+\struct MultiTapDelayParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the MultiTapDelay object. Only the first numTaps entries of the tap arrays are used.
+
+\version Revision : 1.0
+*/
+struct MultiTapDelayParameters
+{
+	MultiTapDelayParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	MultiTapDelayParameters& operator=(const MultiTapDelayParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		numTaps = params.numTaps;
+		for (unsigned int i = 0; i < MAX_DELAY_TAPS; i++)
+		{
+			tapDelay_mSec[i] = params.tapDelay_mSec[i];
+			tapLevel_dB[i] = params.tapLevel_dB[i];
+			tapPan[i] = params.tapPan[i];
+			tapFilterFc_Hz[i] = params.tapFilterFc_Hz[i];
+		}
+		feedbackTap = params.feedbackTap;
+		feedback_Pct = params.feedback_Pct;
+		wetLevel_dB = params.wetLevel_dB;
+		dryLevel_dB = params.dryLevel_dB;
+		interpolation = params.interpolation;
+
+		return *this;
+	}
+
+	// --- individual parameters
+	unsigned int numTaps = 1;						///< number of active taps [1, MAX_DELAY_TAPS]
+	double tapDelay_mSec[MAX_DELAY_TAPS] = { 0.0 };	///< tap delay times
+	double tapLevel_dB[MAX_DELAY_TAPS] = { 0.0 };	///< tap output levels
+	double tapPan[MAX_DELAY_TAPS] = { 0.0 };		///< tap pan, -1.0 (LEFT) to +1.0 (RIGHT), constant power
+	double tapFilterFc_Hz[MAX_DELAY_TAPS] = { 0.0 };	///< tap one-pole LPF cutoff; 0.0 = no filter
+	unsigned int feedbackTap = 0;					///< the (filtered) tap that feeds back into the delay line
+	double feedback_Pct = 0.0;						///< feedback as a % value
+	double wetLevel_dB = -3.0;						///< wet output level in dB
+	double dryLevel_dB = -3.0;						///< dry output level in dB
+	delayInterpolation interpolation = delayInterpolation::kLinear; ///< fractional delay interpolator (kThiran runs as kLagrange4)
+};
+
+/**
+\class MultiTapDelay
+\ingroup FX-Objects
+\brief
+The MultiTapDelay object implements a multi-tap delay: up to MAX_DELAY_TAPS taps, each with its own time, level, pan
+and one-pole LPF, read from a single delay buffer per channel. One (filtered) tap feeds back into the delay line.
+
+Taps are processed tap by tap over a block: each tap is a fixed-delay block read from the shared buffer followed
+by plain loops that scale and accumulate it, so tap times can change without reallocating and the memory traffic
+does not grow with the number of taps.
+
+Audio I/O:
+- Processes mono input to mono output OR stereo input to stereo output; in mono, pan is ignored.
+
+Control I/F:
+- Use MultiTapDelayParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class MultiTapDelay : public IAudioSignalProcessor
+{
+public:
+	MultiTapDelay() {}		/* C-TOR */
+	~MultiTapDelay() {}		/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		memset(&filterState_L[0], 0, sizeof(double)*MAX_DELAY_TAPS);
+		memset(&filterState_R[0], 0, sizeof(double)*MAX_DELAY_TAPS);
+
+		// --- if sample rate did not change (arena buffers are always re-created, see DelayMemoryArena)
+		if (sampleRate == _sampleRate && !delayMemoryArena)
+		{
+			// --- just flush buffer and return
+			delayBuffer_L.flushBuffer();
+			delayBuffer_R.flushBuffer();
+			return true;
+		}
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffers(_sampleRate, bufferLength_mSec);
+
+		return true;
+	}
+
+	/** process MONO audio delay */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double yn = 0.0;
+		processAudioBlocks(&xn, nullptr, &yn, nullptr, 1);
+		return yn;
+	}
+
+	/** return true: this object can also process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process STEREO audio delay in frames */
+	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		// --- if only one output channel, revert to mono operation
+		if (outputChannels == 1)
+		{
+			outputFrame[0] = (float)processAudioSample(inputFrame[0]);
+			return true;
+		}
+
+		// --- RIGHT channel (duplicate left input if mono-in)
+		double xnL = inputFrame[0];
+		double xnR = inputChannels > 1 ? inputFrame[1] : xnL;
+		double ynL = 0.0;
+		double ynR = 0.0;
+		processAudioBlocks(&xnL, &xnR, &ynL, &ynR, 1);
+
+		outputFrame[0] = (float)ynL;
+		outputFrame[1] = (float)ynR;
+		return true;
+	}
+
+	/** process MONO audio in blocks; see processAudioBlocks( ) */
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		processAudioBlocks(input, nullptr, output, nullptr, blockSize);
+	}
+
+	/** process audio in blocks. inputR may be nullptr for mono-in; outputR may be nullptr for MONO operation
+	    (LEFT buffer only, pan ignored). Inputs and outputs may be the same buffers. */
+	/**
+	\param inputL LEFT input block
+	\param inputR RIGHT input block or nullptr
+	\param outputL LEFT output block
+	\param outputR RIGHT output block or nullptr
+	\param blockSize number of samples
+	*/
+	void processAudioBlocks(const double* inputL, const double* inputR, double* outputL, double* outputR, unsigned int blockSize)
+	{
+		// --- the shortest tap sets the chunk: no tap may read a sample written in the same chunk
+		unsigned int chunk = MAX_DELAY_BLOCK;
+		for (unsigned int k = 0; k < parameters.numTaps; k++)
+		{
+			unsigned int length = delayBuffer_L.getMaxBlockRead(tapDelayInSamples[k]);
+			if (length < chunk) chunk = length;
+		}
+
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+			// --- RIGHT first: with mono-in it reads inputL, which may be processed in place
+			if (outputR)
+				processChunk(delayBuffer_R, inputR ? inputR + n : inputL + n, outputR + n, filterState_R, tapGain_R, length);
+			processChunk(delayBuffer_L, inputL + n, outputL + n, filterState_L, outputR ? tapGain_L : tapGain_M, length);
+		}
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return MultiTapDelayParameters custom data structure
+	*/
+	MultiTapDelayParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data; tap times may change at any time, the
+	    buffers are not reallocated (times are limited to the buffer length) */
+	/**
+	\param MultiTapDelayParameters custom data structure
+	*/
+	void setParameters(const MultiTapDelayParameters& _parameters)
+	{
+		if (_parameters.interpolation != parameters.interpolation)
+		{
+			// --- the Thiran allpass keeps one state per buffer, which the taps would share
+			delayInterpolation type = _parameters.interpolation == delayInterpolation::kThiran ?
+				delayInterpolation::kLagrange4 : _parameters.interpolation;
+			delayBuffer_L.setInterpolationType(type);
+			delayBuffer_R.setInterpolationType(type);
+		}
+
+		parameters = _parameters;
+		if (parameters.numTaps < 1) parameters.numTaps = 1;
+		if (parameters.numTaps > MAX_DELAY_TAPS) parameters.numTaps = MAX_DELAY_TAPS;
+		if (parameters.feedbackTap >= parameters.numTaps)
+			parameters.feedbackTap = parameters.numTaps - 1;
+
+		dryMix = pow(10.0, parameters.dryLevel_dB / 20.0);
+		wetMix = pow(10.0, parameters.wetLevel_dB / 20.0);
+
+		// --- longest usable delay leaves room for the interpolator's older taps
+		double maxDelay = bufferLength > 4 ? bufferLength - 4.0 : 0.0;
+		for (unsigned int k = 0; k < MAX_DELAY_TAPS; k++)
+		{
+			double delayInSamples = parameters.tapDelay_mSec[k] * samplesPerMSec;
+			boundValue(delayInSamples, 0.0, maxDelay);
+			tapDelayInSamples[k] = delayInSamples;
+
+			// --- constant power pan, with the wet level folded in
+			double pan = parameters.tapPan[k];
+			boundValue(pan, -1.0, 1.0);
+			double gain = wetMix*pow(10.0, parameters.tapLevel_dB[k] / 20.0);
+			tapGain_L[k] = gain*cos((pan + 1.0)*kPi / 4.0);
+			tapGain_R[k] = gain*sin((pan + 1.0)*kPi / 4.0);
+			tapGain_M[k] = gain;
+
+			// --- one-pole LPF, same form as SimpleLPF
+			tapFilter_g[k] = parameters.tapFilterFc_Hz[k] > 0.0 && sampleRate > 0.0 ?
+				exp(-kTwoPi*parameters.tapFilterFc_Hz[k] / sampleRate) : 0.0;
+		}
+	}
+
+	/** creation function */
+	void createDelayBuffers(double _sampleRate, double _bufferLength_mSec)
+	{
+		// --- store for math
+		bufferLength_mSec = _bufferLength_mSec;
+		sampleRate = _sampleRate;
+		samplesPerMSec = sampleRate / 1000.0;
+
+		// --- total buffer length including fractional part
+		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
+
+		// --- create new buffer
+		delayBuffer_L.createCircularBuffer(bufferLength, delayMemoryArena);
+		delayBuffer_R.createCircularBuffer(bufferLength, delayMemoryArena);
+
+		// --- update tap times and filters for the new rate
+		setParameters(parameters);
+	}
+
+	/** take the delay buffers from an arena (nullptr for the heap) at the next reset( ) or createDelayBuffers( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena) { delayMemoryArena = arena; }
+
+	/** store the delays as float, with double feedback math; takes effect when the buffers are next created
+	    (createDelayBuffers( ) or a sample rate change), see CircularBuffer::setFloatStorage( ) */
+	void setFloatStorage(bool b)
+	{
+		delayBuffer_L.setFloatStorage(b);
+		delayBuffer_R.setFloatStorage(b);
+	}
+
+	/** arena bytes for createDelayBuffers(_sampleRate, _bufferLength_mSec) */
+	static size_t getDelayMemorySize(double _sampleRate, double _bufferLength_mSec, bool floatStorage = false)
+	{
+		return 2 * CircularBuffer<double>::getArenaSize((unsigned int)(_bufferLength_mSec*(_sampleRate / 1000.0)) + 1, floatStorage);
+	}
+
+private:
+	/** one channel, one chunk: taps are read and accumulated tap by tap; numSamples must be within every tap's
+	    block read limit */
+	void processChunk(CircularBuffer<double>& delayBuffer, const double* input, double* output, double* filterState,
+		const double* tapGain, unsigned int numSamples)
+	{
+		double tap[MAX_DELAY_BLOCK];
+		double wet[MAX_DELAY_BLOCK];
+		double dn[MAX_DELAY_BLOCK];
+		double feedback = parameters.feedback_Pct / 100.0;
+		double dry = dryMix;
+
+		memset(wet, 0, numSamples * sizeof(double));
+		for (unsigned int k = 0; k < parameters.numTaps; k++)
+		{
+			// --- frame-by-frame callers skip the span setup
+			if (numSamples == 1)
+				tap[0] = delayBuffer.readBuffer(tapDelayInSamples[k]);
+			else
+				delayBuffer.readBlock(tapDelayInSamples[k], tap, numSamples);
+
+			// --- the one-pole LPF is recursive in time, so it only runs when enabled
+			double g = tapFilter_g[k];
+			if (g > 0.0)
+			{
+				double state = filterState[k];
+				for (unsigned int i = 0; i < numSamples; i++)
+				{
+					state = (1.0 - g)*tap[i] + g*state;
+					tap[i] = state;
+				}
+				filterState[k] = state;
+			}
+
+			if (k == parameters.feedbackTap)
+			{
+				for (unsigned int i = 0; i < numSamples; i++)
+					dn[i] = input[i] + feedback*tap[i];
+			}
+
+			double gain = tapGain[k];
+			for (unsigned int i = 0; i < numSamples; i++)
+				wet[i] += gain*tap[i];
+		}
+
+		if (numSamples == 1)
+			delayBuffer.writeBuffer(dn[0]);
+		else
+			delayBuffer.writeBlock(dn, numSamples);
+
+		for (unsigned int i = 0; i < numSamples; i++)
+			output[i] = dry*input[i] + wet[i];
+	}
+
+	MultiTapDelayParameters parameters; ///< object parameters
+
+	double sampleRate = 0.0;		///< current sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond, for easy access calculation
+	double bufferLength_mSec = 0.0;	///< buffer length in mSec
+	unsigned int bufferLength = 0;	///< buffer length in samples
+	double wetMix = 0.707; ///< wet output default = -3dB
+	double dryMix = 0.707; ///< dry output default = -3dB
+
+	// --- per-tap data, structure-of-arrays
+	double tapDelayInSamples[MAX_DELAY_TAPS] = { 0.0 };	///< tap delays, with fractional part
+	double tapGain_L[MAX_DELAY_TAPS] = { 0.0 };		///< LEFT tap gains (level, pan and wet mix)
+	double tapGain_R[MAX_DELAY_TAPS] = { 0.0 };		///< RIGHT tap gains (level, pan and wet mix)
+	double tapGain_M[MAX_DELAY_TAPS] = { 0.0 };		///< MONO tap gains (level and wet mix)
+	double tapFilter_g[MAX_DELAY_TAPS] = { 0.0 };	///< tap LPF coefficients
+	double filterState_L[MAX_DELAY_TAPS] = { 0.0 };	///< LEFT tap LPF states
+	double filterState_R[MAX_DELAY_TAPS] = { 0.0 };	///< RIGHT tap LPF states
+
+	// --- delay buffer of doubles
+	CircularBuffer<double> delayBuffer_L;	///< LEFT delay buffer of doubles
+	CircularBuffer<double> delayBuffer_R;	///< RIGHT delay buffer of doubles
+	DelayMemoryArena* delayMemoryArena = nullptr;	///< optional arena for the delay buffers
+};
+
+
+/**
+\enum generatorWaveform
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the oscillator waveform
+
+- enum  generatorWaveform { kTriangle, kSin, kSaw };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class generatorWaveform { kTriangle, kSin, kSaw };
+
+/**
+\struct OscillatorParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the LFO and DFOscillator objects.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct OscillatorParameters
+{
+	OscillatorParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	OscillatorParameters& operator=(const OscillatorParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		waveform = params.waveform;
+		frequency_Hz = params.frequency_Hz;
+		return *this;
+	}
+
+	// --- individual parameters
+	generatorWaveform waveform = generatorWaveform::kTriangle; ///< the current waveform
+	double frequency_Hz = 0.0;	///< oscillator frequency
+};
+
+/**
+\class LFO
+\ingroup FX-Objects
+\brief
+The LFO object implements a mathematically perfect LFO generator for modulation uses only. It should not be used for
+audio frequencies except for the sinusoidal output which, though an approximation, has very low TDH.
+
+Audio I/O:
+- Output only object: low frequency generator.
+
+Control I/F:
+- Use OscillatorParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class LFO : public IAudioSignalGenerator
+{
+public:
+	LFO() {	srand((uint32_t)time(NULL)); }	/* C-TOR */
+	virtual ~LFO() {}				/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		phaseInc = lfoParameters.frequency_Hz / sampleRate;
+
+		// --- timebase variables
+		modCounter = 0.0;			///< modulo counter [0.0, +1.0]
+		modCounterQP = 0.25;		///<Quad Phase modulo counter [0.0, +1.0]
+
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return OscillatorParameters custom data structure
+	*/
+	OscillatorParameters getParameters(){ return lfoParameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param OscillatorParameters custom data structure
+	*/
+	void setParameters(const OscillatorParameters& params)
+	{
+		if(params.frequency_Hz != lfoParameters.frequency_Hz)
+			// --- update phase inc based on osc freq and fs
+			phaseInc = params.frequency_Hz / sampleRate;
+
+		lfoParameters = params;
+	}
+
+	/** render a new audio output structure */
+	virtual const SignalGenData renderAudioOutput();
+
+	/** render a block of outputs; same values as calling renderAudioOutput( ) once per sample.
+	    quadPhaseOutput (the +90 degree output) may be nullptr; negate the outputs for the inverted versions */
+	void renderAudioBlock(double* normalOutput, double* quadPhaseOutput, unsigned int numSamples);
+
+protected:
+	// --- parameters
+	OscillatorParameters lfoParameters; ///< obejcgt parameters
+
+	// --- sample rate
+	double sampleRate = 0.0;			///< sample rate
+
+	// --- timebase variables
+	double modCounter = 0.0;			///< modulo counter [0.0, +1.0]
+	double phaseInc = 0.0;				///< phase inc = fo/fs
+	double modCounterQP = 0.25;			///<Quad Phase modulo counter [0.0, +1.0]
+
+	/** check the modulo counter and wrap if needed */
+	inline bool checkAndWrapModulo(double& moduloCounter, double phaseInc)
+	{
+		// --- for positive frequencies
+		if (phaseInc > 0 && moduloCounter >= 1.0)
+		{
+			moduloCounter -= 1.0;
+			return true;
+		}
+
+		// --- for negative frequencies
+		if (phaseInc < 0 && moduloCounter <= 0.0)
+		{
+			moduloCounter += 1.0;
+			return true;
+		}
+
+		return false;
+	}
+
+	/** advanvce the modulo counter, then check the modulo counter and wrap if needed */
+	inline bool advanceAndCheckWrapModulo(double& moduloCounter, double phaseInc)
+	{
+		// --- advance counter
+		moduloCounter += phaseInc;
+
+		// --- for positive frequencies
+		if (phaseInc > 0 && moduloCounter >= 1.0)
+		{
+			moduloCounter -= 1.0;
+			return true;
+		}
+
+		// --- for negative frequencies
+		if (phaseInc < 0 && moduloCounter <= 0.0)
+		{
+			moduloCounter += 1.0;
+			return true;
+		}
+
+		return false;
+	}
+
+	/** advanvce the modulo counter */
+	inline void advanceModulo(double& moduloCounter, double phaseInc) { moduloCounter += phaseInc; }
+
+	const double B = 4.0 / kPi;
+	const double C = -4.0 / (kPi* kPi);
+	const double P = 0.225;
+	/** parabolic sinusoidal calcualtion; NOTE: input is -pi to +pi http://devmaster.net/posts/9648/fast-and-accurate-sine-cosine */
+	inline double parabolicSine(double angle)
+	{
+		double y = B * angle + C * angle * fabs(angle);
+		y = P * (y * fabs(y) - y) + y;
+		return y;
+	}
+};
+
+/**
+\enum DFOscillatorCoeffs
+\ingroup Constants-Enums
+\brief
+Use this non-typed enum to easily access the direct form oscillator coefficients
+
+- enum DFOscillatorCoeffs { df_b1, df_b2, numDFOCoeffs };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum DFOscillatorCoeffs { df_b1, df_b2, numDFOCoeffs };
+
+/**
+\enum DFOscillatorStates
+\ingroup Constants-Enums
+\brief
+Use this non-typed enum to easily access the direct form oscillator state registers
+
+- DFOscillatorStates { df_yz1, df_yz2, numDFOStates };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum DFOscillatorStates { df_yz1, df_yz2, numDFOStates };
+
+
+/**
+\class DFOscillator
+\ingroup FX-Objects
+\brief
+The DFOscillator object implements generates a very pure sinusoidal oscillator by placing poles direclty on the unit circle.
+Accuracy is excellent even at low frequencies.
+
+Audio I/O:
+- Output only object: pitched audio sinusoidal generator.
+
+Control I/F:
+- Use OscillatorParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class DFOscillator : public IAudioSignalGenerator
+{
+public:
+	DFOscillator() { }	/* C-TOR */
+	virtual ~DFOscillator() {}				/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		memset(&stateArray[0], 0, sizeof(double)*numDFOStates);
+		updateDFO();
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return OscillatorParameters custom data structure
+	*/
+	OscillatorParameters getParameters()
+	{
+		return parameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param OscillatorParameters custom data structure
+	*/
+	void setParameters(const OscillatorParameters& params)
+	{
+		if (parameters.frequency_Hz != params.frequency_Hz)
+		{
+			parameters = params;
+			updateDFO();
+		}
+	}
+
+	/** render the audio signal (pure sinusoid) */
+	virtual const SignalGenData renderAudioOutput()
+	{
+		// --- calculates normal and inverted outputs; quadphase are not used
+		SignalGenData output;
+
+		// -- do difference equation y(n) = -b1y(n-2) - b2y(n-2)
+		output.normalOutput = (-coeffArray[df_b1]*stateArray[df_yz1] - coeffArray[df_b2]*stateArray[df_yz2]);
+		output.invertedOutput = -output.normalOutput;
+
+		// --- update states
+		stateArray[df_yz2] = stateArray[df_yz1];
+		stateArray[df_yz1] = output.normalOutput;
+
+		return output;
+	}
+
+	/** Update the object */
+	void updateDFO()
+	{
+		// --- Oscillation Rate = theta = wT = w/fs
+		double wT = (kTwoPi*parameters.frequency_Hz) / sampleRate;
+
+		// --- coefficients to place poles right on unit circle
+		coeffArray[df_b1] = -2.0*cos(wT);	// <--- set angle a = -2Rcod(theta)
+		coeffArray[df_b2] = 1.0;			// <--- R^2 = 1, so R = 1
+
+		// --- now update states to reflect the new frequency
+		//	   re calculate the new initial conditions
+		//	   arcsine of y(n-1) gives us wnT
+		double wnT1 = asin(stateArray[df_yz1]);
+
+		// find n by dividing wnT by wT
+		double n = wnT1 / wT;
+
+		// --- re calculate the new initial conditions
+		//	   asin returns values from -pi/2 to +pi/2 where the sinusoid
+		//     moves from -1 to +1 -- the leading (rising) edge of the
+		//     sinewave. If we are on that leading edge (increasing)
+		//     then we use the value 1T behind.
+		//
+		//     If we are on the falling edge, we use the value 1T ahead
+		//     because it mimics the value that would be 1T behind
+		if (stateArray[df_yz1] > stateArray[df_yz2])
+			n -= 1;
+		else
+			n += 1;
+
+		// ---  calculate the new (old) sample
+		stateArray[df_yz2] = sin((n)*wT);
+	}
+
+
+protected:
+	// --- parameters
+	OscillatorParameters parameters; ///< object parameters
+
+	// --- implementation of half a biquad - this object is extremely specific
+	double stateArray[numDFOStates] = { 0.0, 0.0 };///< array of state registers
+	double coeffArray[numDFOCoeffs] = { 0.0, 0.0 };///< array of coefficients
+
+	// --- sample rate
+	double sampleRate = 0.0;			///< sample rate
+};
+
+
+/**
+\enum modDelaylgorithm
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set modulated delay algorithm.
+
+- enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+
+
+/**
+\struct ModulatedDelayParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the ModulatedDelay object.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct ModulatedDelayParameters
+{
+	ModulatedDelayParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	ModulatedDelayParameters& operator=(const ModulatedDelayParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		algorithm = params.algorithm;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth_Pct = params.lfoDepth_Pct;
+		feedback_Pct = params.feedback_Pct;
+		interpolation = params.interpolation;
+		return *this;
+	}
+
+	// --- individual parameters
+	modDelaylgorithm algorithm = modDelaylgorithm::kFlanger; ///< mod delay algorithm
+	double lfoRate_Hz = 0.0;	///< mod delay LFO rate in Hz
+	double lfoDepth_Pct = 0.0;	///< mod delay LFO depth in %
+	double feedback_Pct = 0.0;	///< feedback in %
+	delayInterpolation interpolation = delayInterpolation::kLinear; ///< interpolator for the modulated reads
+};
+
+/**
+\class ModulatedDelay
+\ingroup FX-Objects
+\brief
+The ModulatedDelay object implements the three basic algorithms: flanger, chorus, vibrato.
+
+Audio I / O :
+	-Processes mono input to mono OR stereo output.
+
+Control I / F :
+	-Use ModulatedDelayParameters structure to get / set object params.
+
+\author Will Pirkle http ://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed.by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class ModulatedDelay : public IAudioSignalProcessor
+{
+public:
+	ModulatedDelay() {
+	}		/* C-TOR */
+	~ModulatedDelay() {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- create new buffer, 100mSec long
+		delay.reset(_sampleRate);
+		delay.createDelayBuffers(_sampleRate, 100.0);
+
+		// --- lfo
+		lfo.reset(_sampleRate);
+		OscillatorParameters params = lfo.getParameters();
+		params.waveform = generatorWaveform::kTriangle;
+		lfo.setParameters(params);
+
+		return true;
+	}
+
+	/** take the delay buffers from an arena (nullptr for the heap) at the next reset( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena) { delay.setDelayMemoryArena(arena); }
+
+	/** store the delays as float at the next reset( ), see AudioDelay::setFloatStorage( ) */
+	void setFloatStorage(bool b) { delay.setFloatStorage(b); }
+
+	/** arena bytes for reset(_sampleRate) */
+	static size_t getDelayMemorySize(double _sampleRate, bool floatStorage = false)
+	{
+		return AudioDelay::getDelayMemorySize(_sampleRate, 100.0, floatStorage);
+	}
+
+	/** process input sample */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		float input = (float)xn;
+		float output = 0.0;
+		processAudioFrame(&input, &output, 1, 1);
+		return output;
+	}
+
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process STEREO audio delay of frames */
+	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		// --- render LFO
+		SignalGenData lfoOutput = lfo.renderAudioOutput();
+
+		// --- setup delay modulation
+		AudioDelayParameters params = delay.getParameters();
+		double modulationMin = 0.0;
+		double modulationMax = 0.0;
+		setupAlgorithm(params, modulationMin, modulationMax);
+
+		// --- calc modulated delay times
+		params.leftDelay_mSec = calculateDelay_mSec(lfoOutput.normalOutput, modulationMin, modulationMax);
+
+		// --- set right delay to match (*Hint Homework!)
+		params.rightDelay_mSec = params.leftDelay_mSec;
+
+		// --- modulate the delay
+		delay.setParameters(params);
+
+		// --- just call the function and pass our info in/out
+		return delay.processAudioFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+	}
+
+	/** process MONO audio in blocks; see processAudioBlocks( ) */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		processAudioBlocks(input, nullptr, output, nullptr, blockSize);
+	}
+
+	/** process audio in blocks: the LFO is rendered into a buffer once per chunk, the delay times are mapped
+	    over the chunk and the modulated delay reads are done as block reads. Same output as processAudioFrame( )
+		per frame (apart from its float conversion). inputR may be nullptr for mono-in; outputR may be nullptr for mono-out. */
+	/**
+	\param inputL LEFT input block
+	\param inputR RIGHT input block or nullptr
+	\param outputL LEFT output block
+	\param outputR RIGHT output block or nullptr
+	\param blockSize number of samples
+	*/
+	void processAudioBlocks(const double* inputL, const double* inputR, double* outputL, double* outputR, unsigned int blockSize)
+	{
+		double delay_mSec[MAX_DELAY_BLOCK];
+
+		// --- setup delay modulation; wet/dry and feedback are fixed for the block
+		AudioDelayParameters params = delay.getParameters();
+		double modulationMin = 0.0;
+		double modulationMax = 0.0;
+		setupAlgorithm(params, modulationMin, modulationMax);
+		delay.setParameters(params);
+
+		for (unsigned int n = 0; n < blockSize; n += MAX_DELAY_BLOCK)
+		{
+			unsigned int length = blockSize - n < MAX_DELAY_BLOCK ? blockSize - n : MAX_DELAY_BLOCK;
+
+			// --- render LFO, then map to delay times
+			lfo.renderAudioBlock(delay_mSec, nullptr, length);
+			for (unsigned int i = 0; i < length; i++)
+				delay_mSec[i] = calculateDelay_mSec(delay_mSec[i], modulationMin, modulationMax);
+
+			if (outputR)
+				delay.processModulatedBlocks(inputL + n, inputR ? inputR + n : inputL + n, outputL + n, outputR + n,
+					delay_mSec, delay_mSec, length);
+			else
+				delay.processModulatedBlock(inputL + n, outputL + n, delay_mSec, length);
+
+			params.leftDelay_mSec = delay_mSec[length - 1];
+		}
+
+		// --- leave the delay where the block ended
+		params.rightDelay_mSec = params.leftDelay_mSec;
+		delay.setParameters(params);
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ModulatedDelayParameters custom data structure
+	*/
+	ModulatedDelayParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ModulatedDelayParameters custom data structure
+	*/
+	void setParameters(ModulatedDelayParameters _parameters)
+	{
+		// --- bulk copy
+		parameters = _parameters;
+
+		OscillatorParameters lfoParams = lfo.getParameters();
+		lfoParams.frequency_Hz = parameters.lfoRate_Hz;
+		if (parameters.algorithm == modDelaylgorithm::kVibrato)
+			lfoParams.waveform = generatorWaveform::kSin;
+		else
+			lfoParams.waveform = generatorWaveform::kTriangle;
+
+		lfo.setParameters(lfoParams);
+
+		AudioDelayParameters adParams = delay.getParameters();
+		adParams.feedback_Pct = parameters.feedback_Pct;
+		adParams.interpolation = parameters.interpolation;
+		delay.setParameters(adParams);
+	}
+
+private:
+	/** set the wet/dry mix and feedback for the algorithm and get its modulation range in mSec */
+	void setupAlgorithm(AudioDelayParameters& params, double& modulationMin, double& modulationMax)
+	{
+		double minDelay_mSec = 0.0;
+		double maxDepth_mSec = 0.0;
+
+		// --- set delay times, wet/dry and feedback
+		if (parameters.algorithm == modDelaylgorithm::kFlanger)
+		{
+			minDelay_mSec = 0.1;
+			maxDepth_mSec = 7.0;
+			params.wetLevel_dB = -3.0;
+			params.dryLevel_dB = -3.0;
+		}
+		if (parameters.algorithm == modDelaylgorithm::kChorus)
+		{
+			minDelay_mSec = 10.0;
+			maxDepth_mSec = 30.0;
+			params.wetLevel_dB = -3.0;
+			params.dryLevel_dB = -0.0;
+			params.feedback_Pct = 0.0;
+		}
+		if (parameters.algorithm == modDelaylgorithm::kVibrato)
+		{
+			minDelay_mSec = 0.0;
+			maxDepth_mSec = 7.0;
+			params.wetLevel_dB = 0.0;
+			params.dryLevel_dB = -96.0;
+			params.feedback_Pct = 0.0;
+		}
+
+		modulationMin = minDelay_mSec;
+		modulationMax = minDelay_mSec + maxDepth_mSec;
+	}
+
+	/** map an LFO output to the modulated delay time */
+	double calculateDelay_mSec(double lfoOutput, double modulationMin, double modulationMax)
+	{
+		double depth = parameters.lfoDepth_Pct / 100.0;
+
+		// --- flanger - unipolar
+		if (parameters.algorithm == modDelaylgorithm::kFlanger)
+			return doUnipolarModulationFromMin(bipolarToUnipolar(depth * lfoOutput), modulationMin, modulationMax);
+
+		return doBipolarModulation(depth * lfoOutput, modulationMin, modulationMax);
+	}
+
+	ModulatedDelayParameters parameters; ///< object parameters
+	AudioDelay delay;	///< the delay to modulate
+	LFO lfo;			///< the modulator
+};
+
+/**
+\struct PhaseShifterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the PhaseShifter object.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct PhaseShifterParameters
+{
+	PhaseShifterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	PhaseShifterParameters& operator=(const PhaseShifterParameters& params)
+	{
+		if (this == &params)
+			return *this;
+
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth_Pct = params.lfoDepth_Pct;
+		intensity_Pct = params.intensity_Pct;
+		quadPhaseLFO = params.quadPhaseLFO;
+		lfoWaveform = params.lfoWaveform;
+		controlRateDivisor = params.controlRateDivisor;
+		return *this;
+	}
+
+	// --- individual parameters
+	double lfoRate_Hz = 0.0;	///< phaser LFO rate in Hz
+	double lfoDepth_Pct = 0.0;	///< phaser LFO depth in %
+	double intensity_Pct = 0.0;	///< phaser feedback in %
+	bool quadPhaseLFO = false;	///< quad phase LFO flag (StereoPhaseShifter: right channel only)
+	generatorWaveform lfoWaveform = generatorWaveform::kTriangle; ///< phaser LFO waveform
+	unsigned int controlRateDivisor = 1; ///< StereoPhaseShifter: recalculate the APF coefficients every Nth sample (1 = every sample)
+};
+
+// --- constants for Phaser
+const unsigned int PHASER_STAGES = 6;
+
+// --- these are the ideal band definitions
+//const double apf0_minF = 16.0;
+//const double apf0_maxF = 1600.0;
+//
+//const double apf1_minF = 33.0;
+//const double apf1_maxF = 3300.0;
+//
+//const double apf2_minF = 48.0;
+//const double apf2_maxF = 4800.0;
+//
+//const double apf3_minF = 98.0;
+//const double apf3_maxF = 9800.0;
+//
+//const double apf4_minF = 160.0;
+//const double apf4_maxF = 16000.0;
+//
+//const double apf5_minF = 260.0;
+//const double apf5_maxF = 20480.0;
+
+// --- these are the exact values from the National Semiconductor Phaser design
+const double apf0_minF = 32.0;
+const double apf0_maxF = 1500.0;
+
+const double apf1_minF = 68.0;
+const double apf1_maxF = 3400.0;
+
+const double apf2_minF = 96.0;
+const double apf2_maxF = 4800.0;
+
+const double apf3_minF = 212.0;
+const double apf3_maxF = 10000.0;
+
+const double apf4_minF = 320.0;
+const double apf4_maxF = 16000.0;
+
+const double apf5_minF = 636.0;
+const double apf5_maxF = 20480.0;
+
+// --- the same bands as arrays, for the stage loops in StereoPhaseShifter
+const double apfMinF[PHASER_STAGES] = { apf0_minF, apf1_minF, apf2_minF, apf3_minF, apf4_minF, apf5_minF };
+const double apfMaxF[PHASER_STAGES] = { apf0_maxF, apf1_maxF, apf2_maxF, apf3_maxF, apf4_maxF, apf5_maxF };
+
+/**
+\class PhaseShifter
+\ingroup FX-Objects
+\brief
+The PhaseShifter object implements a six-stage phaser.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use BiquadParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class PhaseShifter : public IAudioSignalProcessor
+{
+public:
+	PhaseShifter(void) {
+		OscillatorParameters lfoparams = lfo.getParameters();
+		lfoparams.waveform = generatorWaveform::kTriangle;	// kTriangle LFO for phaser
+	//	lfoparams.waveform = generatorWaveform::kSin;		// kTriangle LFO for phaser
+		lfo.setParameters(lfoparams);
+
+		AudioFilterParameters params = apf[0].getParameters();
+		params.algorithm = filterAlgorithm::kAPF1; // can also use 2nd order
+		// params.Q = 0.001; use low Q if using 2nd order APFs
+
+		for (uint32_t i = 0; i < PHASER_STAGES; i++)
+		{
+			apf[i].setParameters(params);
+		}
+	}	/* C-TOR */
+
+	~PhaseShifter(void) {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- reset LFO
+		lfo.reset(_sampleRate);
+
+		// --- reset APFs
+		for (uint32_t i = 0; i < PHASER_STAGES; i++){
+			apf[i].reset(_sampleRate);
+		}
+
+		return true;
+	}
+
+	/** process autio through phaser */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		SignalGenData lfoData = lfo.renderAudioOutput();
+
+		// --- create the bipolar modulator value
+		double lfoValue = lfoData.normalOutput;
+		if (parameters.quadPhaseLFO)
+			lfoValue = lfoData.quadPhaseOutput_pos;
+
+		double depth = parameters.lfoDepth_Pct / 100.0;
+		double modulatorValue = lfoValue*depth;
+
+		// --- calculate modulated values for each APF; note they have different ranges
+		AudioFilterParameters params = apf[0].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf0_minF, apf0_maxF);
+		apf[0].setParameters(params);
+
+		params = apf[1].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf1_minF, apf1_maxF);
+		apf[1].setParameters(params);
+
+		params = apf[2].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf2_minF, apf2_maxF);
+		apf[2].setParameters(params);
+
+		params = apf[3].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf3_minF, apf3_maxF);
+		apf[3].setParameters(params);
+
+		params = apf[4].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf4_minF, apf4_maxF);
+		apf[4].setParameters(params);
+
+		params = apf[5].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf5_minF, apf5_maxF);
+		apf[5].setParameters(params);
+
+		// --- calculate gamma values
+		double gamma1 = apf[5].getG_value();
+		double gamma2 = apf[4].getG_value() * gamma1;
+		double gamma3 = apf[3].getG_value() * gamma2;
+		double gamma4 = apf[2].getG_value() * gamma3;
+		double gamma5 = apf[1].getG_value() * gamma4;
+		double gamma6 = apf[0].getG_value() * gamma5;
+
+		// --- set the alpha0 value
+		double K = parameters.intensity_Pct / 100.0;
+		double alpha0 = 1.0 / (1.0 + K*gamma6);
+
+		// --- create combined feedback
+		double Sn = gamma5*apf[0].getS_value() + gamma4*apf[1].getS_value() + gamma3*apf[2].getS_value() + gamma2*apf[3].getS_value() + gamma1*apf[4].getS_value() + apf[5].getS_value();
+
+		// --- form input to first APF
+		double u = alpha0*(xn + K*Sn);
+
+		// --- cascade of APFs (could also nest these in one massive line of code)
+		double APF1 = apf[0].processAudioSample(u);
+		double APF2 = apf[1].processAudioSample(APF1);
+		double APF3 = apf[2].processAudioSample(APF2);
+		double APF4 = apf[3].processAudioSample(APF3);
+		double APF5 = apf[4].processAudioSample(APF4);
+		double APF6 = apf[5].processAudioSample(APF5);
+
+		// --- sum with -3dB coefficients
+		//	double output = 0.707*xn + 0.707*APF6;
+
+		// --- sum with National Semiconductor design ratio:
+		//	   dry = 0.5, wet = 5.0
+		// double output = 0.5*xn + 5.0*APF6;
+		// double output = 0.25*xn + 2.5*APF6;
+		double output = 0.125*xn + 1.25*APF6;
+
+		return output;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return PhaseShifterParameters custom data structure
+	*/
+	PhaseShifterParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param PhaseShifterParameters custom data structure
+	*/
+	void setParameters(const PhaseShifterParameters& params)
+	{
+		// --- update LFO rate and waveform
+		if (params.lfoRate_Hz != parameters.lfoRate_Hz ||
+			params.lfoWaveform != parameters.lfoWaveform)
+		{
+			OscillatorParameters lfoparams = lfo.getParameters();
+			lfoparams.frequency_Hz = params.lfoRate_Hz;
+			lfoparams.waveform = params.lfoWaveform;
+			lfo.setParameters(lfoparams);
+		}
+
+		// --- save new
+		parameters = params;
+	}
+protected:
+	PhaseShifterParameters parameters;  ///< the object parameters
+	AudioFilter apf[PHASER_STAGES];		///< six APF objects
+	LFO lfo;							///< the one and only LFO
+};
+
+// --- lanes for StereoPhaseShifter: left and right
+const unsigned int PHASER_LANES = 2;
+
+/**
+\class StereoPhaseShifter
+\ingroup FX-Objects
+\brief
+The StereoPhaseShifter object implements the six-stage PhaseShifter for two channels at once.
+
+The APF coefficients are calculated from one shared LFO (the right channel uses the quad phase
+output when quadPhaseLFO is set) and stored with the APF states as contiguous [stage][lane] arrays,
+so the per-sample work is a set of short lane loops that the compiler can turn into SIMD operations.
+With controlRateDivisor = 1 the output matches two PhaseShifter objects; with N > 1 the coefficients
+are recalculated every Nth sample and ramped in between.
+
+Audio I/O:
+- Processes stereo input to stereo output (mono input is copied to both lanes).
+
+Control I/F:
+- Use PhaseShifterParameters structure to get/set object params.
+*/
+class StereoPhaseShifter : public IAudioSignalProcessor
+{
+public:
+	StereoPhaseShifter(void) {
+		OscillatorParameters lfoparams = lfo.getParameters();
+		lfoparams.waveform = parameters.lfoWaveform;
+		lfo.setParameters(lfoparams);
+	}	/* C-TOR */
+
+	~StereoPhaseShifter(void) {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		lfo.reset(_sampleRate);
+
+		memset(&G[0][0], 0, sizeof(double)*PHASER_STAGES*PHASER_LANES);
+		memset(&GInc[0][0], 0, sizeof(double)*PHASER_STAGES*PHASER_LANES);
+		memset(&S[0][0], 0, sizeof(double)*PHASER_STAGES*PHASER_LANES);
+
+		controlCounter = 0;
+		coeffsValid = false;
+		return true;
+	}
+
+	/** process mono audio through the phaser; both lanes run, the left lane is returned */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double input[PHASER_LANES];
+		double output[PHASER_LANES];
+		for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+			input[lane] = xn;
+
+		processLanes(input, output);
+		return output[0];
+	}
+
+	/** return true: this object processes frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process a stereo frame; a mono input is copied to both lanes */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		double input[PHASER_LANES];
+		double output[PHASER_LANES];
+		input[0] = inputFrame[0];
+		input[1] = inputChannels > 1 ? inputFrame[1] : inputFrame[0];
+
+		processLanes(input, output);
+
+		outputFrame[0] = (float)output[0];
+		if (outputChannels > 1)
+			outputFrame[1] = (float)output[1];
+
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return PhaseShifterParameters custom data structure
+	*/
+	PhaseShifterParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param PhaseShifterParameters custom data structure
+	*/
+	void setParameters(const PhaseShifterParameters& params)
+	{
+		// --- update LFO rate and waveform
+		if (params.lfoRate_Hz != parameters.lfoRate_Hz ||
+			params.lfoWaveform != parameters.lfoWaveform)
+		{
+			OscillatorParameters lfoparams = lfo.getParameters();
+			lfoparams.frequency_Hz = params.lfoRate_Hz;
+			lfoparams.waveform = params.lfoWaveform;
+			lfo.setParameters(lfoparams);
+		}
+
+		// --- cook
+		depth = params.lfoDepth_Pct / 100.0;
+		K = params.intensity_Pct / 100.0;
+
+		if (params.controlRateDivisor != parameters.controlRateDivisor)
+			controlCounter = 0;
+
+		// --- save new
+		parameters = params;
+	}
+
+protected:
+	PhaseShifterParameters parameters;  ///< the object parameters
+	LFO lfo;							///< one LFO for both lanes
+	double sampleRate = 44100.0;		///< current sample rate
+	double depth = 0.0;					///< cooked lfoDepth_Pct
+	double K = 0.0;						///< cooked intensity_Pct (feedback)
+
+	// --- APF structure: G = a0 = b1 = alpha and S = x_z1 of the transposed canonical 1st order APF
+	double G[PHASER_STAGES][PHASER_LANES] = { { 0.0 } };		///< APF G values
+	double GInc[PHASER_STAGES][PHASER_LANES] = { { 0.0 } };		///< G ramp increments (control rate only)
+	double S[PHASER_STAGES][PHASER_LANES] = { { 0.0 } };		///< APF state (S values)
+
+	unsigned int controlCounter = 0;	///< samples since the last coefficient update
+	bool coeffsValid = false;			///< false after reset: first update jumps to the target
+
+	/** safe control rate divisor */
+	unsigned int getControlRateDivisor() { return parameters.controlRateDivisor > 1 ? parameters.controlRateDivisor : 1; }
+
+	/** calculate the APF G values for the current LFO output; jumps to the new values for
+	    per-sample updates, otherwise sets up ramps across the control period */
+	void calculateCoefficients(const SignalGenData& lfoData, unsigned int divisor)
+	{
+		double modulatorValue[PHASER_LANES];
+		modulatorValue[0] = lfoData.normalOutput*depth;
+		modulatorValue[1] = (parameters.quadPhaseLFO ? lfoData.quadPhaseOutput_pos : lfoData.normalOutput)*depth;
+
+		bool jump = divisor == 1 || !coeffsValid;
+		for (unsigned int stage = 0; stage < PHASER_STAGES; stage++)
+		{
+			for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+			{
+				// --- same formula as AudioFilter kAPF1
+				double fc = doBipolarModulation(modulatorValue[lane], apfMinF[stage], apfMaxF[stage]);
+				double tanArg = tan((kPi*fc) / sampleRate);
+				double alpha = (tanArg - 1.0) / (tanArg + 1.0);
+
+				if (jump)
+				{
+					G[stage][lane] = alpha;
+					GInc[stage][lane] = 0.0;
+				}
+				else
+					GInc[stage][lane] = (alpha - G[stage][lane]) / divisor;
+			}
+		}
+		coeffsValid = true;
+	}
+
+	/** process one frame of PHASER_LANES samples */
+	void processLanes(const double* xn, double* yn)
+	{
+		SignalGenData lfoData = lfo.renderAudioOutput();
+
+		// --- control rate coefficient update
+		unsigned int divisor = getControlRateDivisor();
+		if (controlCounter == 0 || !coeffsValid)
+			calculateCoefficients(lfoData, divisor);
+
+		if (++controlCounter >= divisor)
+			controlCounter = 0;
+
+		if (divisor > 1)
+		{
+			for (unsigned int stage = 0; stage < PHASER_STAGES; stage++)
+				for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+					G[stage][lane] += GInc[stage][lane];
+		}
+
+		// --- gamma values: gamma[5] = 1, gamma[4] = G5, gamma[3] = G4*G5 ... gamma6 = G0*gamma[0]
+		double gamma[PHASER_STAGES][PHASER_LANES];
+		for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+			gamma[PHASER_STAGES - 1][lane] = 1.0;
+
+		for (int stage = PHASER_STAGES - 2; stage >= 0; stage--)
+			for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+				gamma[stage][lane] = G[stage + 1][lane] * gamma[stage + 1][lane];
+
+		// --- combined feedback and input to first APF
+		double u[PHASER_LANES];
+		for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+		{
+			double Sn = 0.0;
+			for (unsigned int stage = 0; stage < PHASER_STAGES; stage++)
+				Sn += gamma[stage][lane] * S[stage][lane];
+
+			double gamma6 = G[0][lane] * gamma[0][lane];
+			double alpha0 = 1.0 / (1.0 + K*gamma6);
+			u[lane] = alpha0*(xn[lane] + K*Sn);
+		}
+
+		// --- cascade of APFs
+		for (unsigned int stage = 0; stage < PHASER_STAGES; stage++)
+		{
+			for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+			{
+				double y = G[stage][lane] * u[lane] + S[stage][lane];
+
+				// --- underflow check, as in Biquad
+				y = fabs(y) < kSmallestPositiveFloatValue ? 0.0 : y;
+
+				S[stage][lane] = u[lane] - G[stage][lane] * y;
+				u[lane] = y;
+			}
+		}
+
+		// --- sum with National Semiconductor design ratio (see PhaseShifter)
+		for (unsigned int lane = 0; lane < PHASER_LANES; lane++)
+			yn[lane] = 0.125*xn[lane] + 1.25*u[lane];
+	}
+};
+
+/**
+\struct SimpleLPFParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the SimpleLPFP object. Used for reverb algorithms in book.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct SimpleLPFParameters
+{
+	SimpleLPFParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	SimpleLPFParameters& operator=(const SimpleLPFParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		g = params.g;
+		return *this;
+	}
+
+	// --- individual parameters
+	double g = 0.0; ///< simple LPF g value
+};
+
+/**
+\class SimpleLPF
+\ingroup FX-Objects
+\brief
+The SimpleLPF object implements a first order one-pole LPF using one coefficient "g" value.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use SimpleLPFParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class SimpleLPF : public IAudioSignalProcessor
+{
+public:
+	SimpleLPF(void) {}	/* C-TOR */
+	~SimpleLPF(void) {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		state = 0.0;
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return SimpleLPFParameters custom data structure
+	*/
+	SimpleLPFParameters getParameters()
+	{
+		return simpleLPFParameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param SimpleLPFParameters custom data structure
+	*/
+	void setParameters(const SimpleLPFParameters& params)
+	{
+		simpleLPFParameters = params;
+	}
+
+	/** process simple one pole FB back filter */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double g = simpleLPFParameters.g;
+		double yn = (1.0 - g)*xn + g*state;
+		state = yn;
+		return yn;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+private:
+	SimpleLPFParameters simpleLPFParameters;	///< object parameters
+	double state = 0.0;							///< single state (z^-1) register
+};
+
+/**
+\struct SimpleDelayParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the SimpleDelay object. Used for reverb algorithms in book.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct SimpleDelayParameters
+{
+	SimpleDelayParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	SimpleDelayParameters& operator=(const SimpleDelayParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		delayTime_mSec = params.delayTime_mSec;
+		interpolate = params.interpolate;
+		delay_Samples = params.delay_Samples;
+		return *this;
+	}
+
+	// --- individual parameters
+	double delayTime_mSec = 0.0;	///< delay tine in mSec
+	bool interpolate = false;		///< interpolation flag (diagnostics usually)
+
+	// --- outbound parameters
+	double delay_Samples = 0.0;		///< current delay in samples; other objects may need to access this information
+};
+
+/**
+\class SimpleDelay
+\ingroup FX-Objects
+\brief
+The SimpleDelay object implements a basic delay line without feedback.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use SimpleDelayParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class SimpleDelay : public IAudioSignalProcessor
+{
+public:
+	SimpleDelay(void) {}	/* C-TOR */
+	~SimpleDelay(void) {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- if sample rate did not change (arena buffers are always re-created, see DelayMemoryArena)
+		if (sampleRate == _sampleRate && !delayMemoryArena)
+		{
+			// --- just flush buffer and return
+			delayBuffer.flushBuffer();
+			return true;
+		}
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffer(_sampleRate, bufferLength_mSec);
+
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return SimpleDelayParameters custom data structure
+	*/
+	SimpleDelayParameters getParameters()
+	{
+		return simpleDelayParameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param SimpleDelayParameters custom data structure
+	*/
+	void setParameters(const SimpleDelayParameters& params)
+	{
+		simpleDelayParameters = params;
+		simpleDelayParameters.delay_Samples = simpleDelayParameters.delayTime_mSec*(samplesPerMSec);
+		delayBuffer.setInterpolate(simpleDelayParameters.interpolate);
+	}
+
+	/** process MONO audio delay */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- read delay
+		if (simpleDelayParameters.delay_Samples == 0)
+			return xn;
+
+		double yn = delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
+
+		// --- write to delay buffer
+		delayBuffer.writeBuffer(xn);
+
+		// --- done
+		return yn;
+	}
+
+	/** process a block of MONO audio; same output as processAudioSample( ) per sample, but the delay line
+	    is read and written in chunks with memcpy. input and output may be the same buffer. */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		if (simpleDelayParameters.delay_Samples == 0)
+		{
+			if (output != input)
+				memcpy(output, input, blockSize * sizeof(double));
+			return;
+		}
+
+		double yn[MAX_DELAY_BLOCK];
+		unsigned int chunk = getMaxBlockLength();
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+			delayBuffer.readBlock(simpleDelayParameters.delay_Samples, yn, length);
+			delayBuffer.writeBlock(input + n, length);
+			memcpy(output + n, yn, length * sizeof(double));
+		}
+	}
+
+	/** reset members to initialized state */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** create a new delay buffer */
+	void createDelayBuffer(double _sampleRate, double _bufferLength_mSec)
+	{
+		// --- store for math
+		bufferLength_mSec = _bufferLength_mSec;
+		sampleRate = _sampleRate;
+		samplesPerMSec = sampleRate / 1000.0;
+
+		// --- total buffer length including fractional part
+		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
+
+		// --- create new buffer
+		delayBuffer.createCircularBuffer(bufferLength, delayMemoryArena);
+	}
+
+	/** take the delay buffer from an arena (nullptr for the heap) at the next reset( ) or createDelayBuffer( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena) { delayMemoryArena = arena; }
+
+	/** store the delay as float, with double math; takes effect when the buffer is next created
+	    (createDelayBuffer( ) or a sample rate change), see CircularBuffer::setFloatStorage( ) */
+	void setFloatStorage(bool b) { delayBuffer.setFloatStorage(b); }
+
+	/** arena bytes for createDelayBuffer(_sampleRate, _bufferLength_mSec) */
+	static size_t getDelayMemorySize(double _sampleRate, double _bufferLength_mSec, bool floatStorage = false)
+	{
+		return CircularBuffer<double>::getArenaSize((unsigned int)(_bufferLength_mSec*(_sampleRate / 1000.0)) + 1, floatStorage);
+	}
+
+	/** read delay at current location */
+	double readDelay()
+	{
+		// --- simple read
+		return delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
+	}
+
+	/** read delay at current location */
+	double readDelayAtTime_mSec(double _delay_mSec)
+	{
+		// --- calculate total delay time in samples + fraction
+		double _delay_Samples = _delay_mSec*(samplesPerMSec);
+
+		// --- simple read
+		return delayBuffer.readBuffer(_delay_Samples);
+	}
+
+	/** read delay at a percentage of total length */
+	double readDelayAtPercentage(double delayPercent)
+	{
+		// --- simple read
+		return delayBuffer.readBuffer((delayPercent / 100.0)*simpleDelayParameters.delay_Samples);
+	}
+
+	/** write a new value into the delay */
+	void writeDelay(double xn)
+	{
+		// --- simple write
+		delayBuffer.writeBuffer(xn);
+	}
+
+	/** longest block that can be read with readDelayBlock( ) before it is written: no read may need a sample
+	    from the same block, so this is delay_Samples + 1, less the interpolator lead (limited to MAX_DELAY_BLOCK) */
+	unsigned int getMaxBlockLength()
+	{
+		unsigned int length = delayBuffer.getMaxBlockRead(simpleDelayParameters.delay_Samples);
+		return length < MAX_DELAY_BLOCK ? length : MAX_DELAY_BLOCK;
+	}
+
+	/** read a block at the current delay; numSamples must be <= getMaxBlockLength( ) */
+	void readDelayBlock(double* output, unsigned int numSamples)
+	{
+		delayBuffer.readBlock(simpleDelayParameters.delay_Samples, output, numSamples);
+	}
+
+	/** write a block of new values into the delay */
+	void writeDelayBlock(const double* input, unsigned int numSamples)
+	{
+		delayBuffer.writeBlock(input, numSamples);
+	}
+
+private:
+	SimpleDelayParameters simpleDelayParameters; ///< object parameters
+
+	double sampleRate = 0.0;		///< sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond (for arbitrary access)
+	double bufferLength_mSec = 0.0; ///< total buffer lenth in mSec
+	unsigned int bufferLength = 0;	///< buffer length in samples
+
+	// --- delay buffer of doubles
+	CircularBuffer<double> delayBuffer; ///< circular buffer for delay
+	DelayMemoryArena* delayMemoryArena = nullptr; ///< optional arena for the delay buffer
+};
+
+
+/**
+\struct CombFilterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the CombFilter object. Used for reverb algorithms in book.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct CombFilterParameters
+{
+	CombFilterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	CombFilterParameters& operator=(const CombFilterParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		delayTime_mSec = params.delayTime_mSec;
+		RT60Time_mSec = params.RT60Time_mSec;
+		enableLPF = params.enableLPF;
+		lpf_g = params.lpf_g;
+		interpolate = params.interpolate;
+		return *this;
+	}
+
+	// --- individual parameters
+	double delayTime_mSec = 0.0;	///< delay time in mSec
+	double RT60Time_mSec = 0.0;		///< RT 60 time ini mSec
+	bool enableLPF = false;			///< enable LPF flag
+	double lpf_g = 0.0;				///< gain value for LPF (if enabled)
+	bool interpolate = false;		///< interpolation flag (diagnostics)
+};
+
+
+/**
+\class CombFilter
+\ingroup FX-Objects
+\brief
+The CombFilter object implements a comb filter with optional LPF in feedback loop. Used for reverb algorithms in book.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use CombFilterParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class CombFilter : public IAudioSignalProcessor
+{
+public:
+	CombFilter(void) {}		/* C-TOR */
+	~CombFilter(void) {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- flush
+		lpf_state = 0.0;
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffer(_sampleRate, bufferLength_mSec);
+
+		return true;
+	}
+
+	/** process CombFilter */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double yn = delay.readDelay();
+		double input = 0.0;
+
+		// --- form input & write
+		if (combFilterParameters.enableLPF)
+		{
+			// --- apply simple 1st order pole LPF
+			double g2 = lpf_g*(1.0 - comb_g); // see book for equation 11.27 (old book)
+			double filteredSignal = yn + g2*lpf_state;
+			input = xn + comb_g*(filteredSignal);
+			lpf_state = filteredSignal;
+		}
+		else
+		{
+			input = xn + comb_g*yn;
+		}
+
+		delay.writeDelay(input);
+
+		// --- done
+		return yn;
+	}
+
+	/** process a block of MONO audio; same output as processAudioSample( ) per sample, with the delay line
+	    read and written in chunks of up to delay + 1 samples. input and output may be the same buffer. */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		double yn[MAX_DELAY_BLOCK];
+		double wn[MAX_DELAY_BLOCK];
+		unsigned int chunk = delay.getMaxBlockLength();
+
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+			delay.readDelayBlock(yn, length);
+
+			// --- form input
+			if (combFilterParameters.enableLPF)
+			{
+				// --- the LPF state is recursive, so this loop stays serial
+				double g2 = lpf_g*(1.0 - comb_g);
+				for (unsigned int i = 0; i < length; i++)
+				{
+					double filteredSignal = yn[i] + g2*lpf_state;
+					wn[i] = input[n + i] + comb_g*(filteredSignal);
+					lpf_state = filteredSignal;
+				}
+			}
+			else
+			{
+				for (unsigned int i = 0; i < length; i++)
+					wn[i] = input[n + i] + comb_g*yn[i];
+			}
+
+			delay.writeDelayBlock(wn, length);
+			memcpy(output + n, yn, length * sizeof(double));
+		}
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return CombFilterParameters custom data structure
+	*/
+	CombFilterParameters getParameters()
+	{
+		return combFilterParameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param CombFilterParameters custom data structure
+	*/
+	void setParameters(const CombFilterParameters& params)
+	{
+		combFilterParameters = params;
+
+		// --- update the delay line parameters first
+		SimpleDelayParameters delayParams = delay.getParameters();
+		delayParams.delayTime_mSec = combFilterParameters.delayTime_mSec;
+		delayParams.interpolate = combFilterParameters.interpolate;
+		delay.setParameters(delayParams); // this will set the delay time in samples
+
+										  // --- calculate g with RT60 time (requires updated delay above^^)
+		double exponent = -3.0*delayParams.delay_Samples*(1.0 / sampleRate);
+		double rt60_mSec = combFilterParameters.RT60Time_mSec / 1000.0; // RT is in mSec!
+		comb_g = pow(10.0, exponent / rt60_mSec);
+
+		// --- set LPF g
+		lpf_g = combFilterParameters.lpf_g;
+	}
+
+	/** create new buffers */
+	void createDelayBuffer(double _sampleRate, double delay_mSec)
+	{
+		sampleRate = _sampleRate;
+		bufferLength_mSec = delay_mSec;
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		delay.createDelayBuffer(_sampleRate, delay_mSec);
+	}
+
+	/** take the delay buffer from an arena (nullptr for the heap), see SimpleDelay::setDelayMemoryArena( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena) { delay.setDelayMemoryArena(arena); }
+
+	/** store the delay as float, see SimpleDelay::setFloatStorage( ) */
+	void setFloatStorage(bool b) { delay.setFloatStorage(b); }
+
+	/** arena bytes for createDelayBuffer(_sampleRate, delay_mSec) */
+	static size_t getDelayMemorySize(double _sampleRate, double delay_mSec, bool floatStorage = false)
+	{
+		return SimpleDelay::getDelayMemorySize(_sampleRate, delay_mSec, floatStorage);
+	}
+
+private:
+	CombFilterParameters combFilterParameters; ///< object parameters
+	double sampleRate = 0.0;	///< sample rate
+	double comb_g = 0.0;		///< g value for comb filter (feedback, not %)
+	double bufferLength_mSec = 0.0; ///< total buffer length
+
+	// --- LPF support
+	double lpf_g = 0.0;		///< LPF g value
+	double lpf_state = 0.0; ///< state register for LPF (z^-1)
+
+	// --- delay buffer of doubles
+	SimpleDelay delay;		///< delay for comb filter
+};
+
+/**
+\struct DelayAPFParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the DelayAPF object. Used for reverb algorithms in book.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct DelayAPFParameters
+{
+	DelayAPFParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	DelayAPFParameters& operator=(const DelayAPFParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		delayTime_mSec = params.delayTime_mSec;
+		apf_g = params.apf_g;
+		enableLPF = params.enableLPF;
+		lpf_g = params.lpf_g;
+		interpolate = params.interpolate;
+		enableLFO = params.enableLFO;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth = params.lfoDepth;
+		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+		return *this;
+	}
+
+	// --- individual parameters
+	double delayTime_mSec = 0.0;	///< APF delay time
+	double apf_g = 0.0;				///< APF g coefficient
+	bool enableLPF = false;			///< flag to enable LPF in structure
+	double lpf_g = 0.0;				///< LPF g coefficient (if enabled)
+	bool interpolate = false;		///< interpolate flag (diagnostics)
+	bool enableLFO = false;			///< flag to enable LFO
+	double lfoRate_Hz = 0.0;		///< LFO rate in Hz, if enabled
+	double lfoDepth = 0.0;			///< LFO deoth (not in %) if enabled
+	double lfoMaxModulation_mSec = 0.0;	///< LFO maximum modulation time in mSec
+
+};
+
+/**
+\class DelayAPF
+\ingroup FX-Objects
+\brief
+The DelayAPF object implements a delaying APF with optional LPF and optional modulated delay time with LFO.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use DelayAPFParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class DelayAPF : public IAudioSignalProcessor
+{
+public:
+	DelayAPF(void) {}	/* C-TOR */
+	~DelayAPF(void) {}	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- reset children
+		modLFO.reset(_sampleRate);
+
+		// --- flush
+		lpf_state = 0.0;
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffer(_sampleRate, bufferLength_mSec);
+
+		return true;
+	}
+
+	/** process one input sample through object */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		SimpleDelayParameters delayParams = delay.getParameters();
+		if (delayParams.delay_Samples == 0)
+			return xn;
+
+		// --- delay line output
+		double wnD = 0.0;
+		double apf_g = delayAPFParameters.apf_g;
+		double lpf_g = delayAPFParameters.lpf_g;
+		double lfoDepth = delayAPFParameters.lfoDepth;
+
+		// --- for modulated APFs
+		if (delayAPFParameters.enableLFO)
+		{
+			SignalGenData lfoOutput = modLFO.renderAudioOutput();
+			double maxDelay = delayParams.delayTime_mSec;
+			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
+			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
+
+			// --- calc max-down modulated value with unipolar converted LFO output
+			//     NOTE: LFO output is scaled by lfoDepth
+			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
+				minDelay, maxDelay);
+
+			// --- read modulated value to get w(n-D);
+			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
+		}
+		else
+			// --- read the delay line to get w(n-D)
+			wnD = delay.readDelay();
+
+		if (delayAPFParameters.enableLPF)
+		{
+			// --- apply simple 1st order pole LPF, overwrite wnD
+			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
+			lpf_state = wnD;
+		}
+
+		// form w(n) = x(n) + gw(n-D)
+		double wn = xn + apf_g*wnD;
+
+		// form y(n) = -gw(n) + w(n-D)
+		double yn = -apf_g*wn + wnD;
+
+		// underflow check
+		checkFloatUnderflow(yn);
+
+		// write delay line
+		delay.writeDelay(wn);
+
+		return yn;
+	}
+
+	/** process a block of MONO audio; same output as processAudioSample( ) per sample. With a fixed delay
+	    (LFO off) the delay line is read and written in chunks of up to delay + 1 samples.
+		input and output may be the same buffer. */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	virtual void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		SimpleDelayParameters delayParams = delay.getParameters();
+		if (delayAPFParameters.enableLFO || delayParams.delay_Samples == 0)
+		{
+			for (unsigned int n = 0; n < blockSize; n++)
+				output[n] = processAudioSample(input[n]);
+			return;
+		}
+
+		double apf_g = delayAPFParameters.apf_g;
+		double lpf_g = delayAPFParameters.lpf_g;
+		double wnD[MAX_DELAY_BLOCK];
+		double wn[MAX_DELAY_BLOCK];
+		unsigned int chunk = delay.getMaxBlockLength();
+
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+			delay.readDelayBlock(wnD, length);
+
+			for (unsigned int i = 0; i < length; i++)
+			{
+				double wnDi = wnD[i];
+				if (delayAPFParameters.enableLPF)
+				{
+					// --- apply simple 1st order pole LPF, overwrite wnD
+					wnDi = wnDi*(1.0 - lpf_g) + lpf_g*lpf_state;
+					lpf_state = wnDi;
+				}
+
+				// form w(n) = x(n) + gw(n-D)
+				wn[i] = input[n + i] + apf_g*wnDi;
+
+				// form y(n) = -gw(n) + w(n-D)
+				double yn = -apf_g*wn[i] + wnDi;
+
+				// underflow check
+				checkFloatUnderflow(yn);
+				output[n + i] = yn;
+			}
+
+			delay.writeDelayBlock(wn, length);
+		}
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return DelayAPFParameters custom data structure
+	*/
+	DelayAPFParameters getParameters()
+	{
+		return delayAPFParameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param DelayAPFParameters custom data structure
+	*/
+	void setParameters(const DelayAPFParameters& params)
+	{
+		delayAPFParameters = params;
+
+		// --- update delay line
+		SimpleDelayParameters delayParams = delay.getParameters();
+		delayParams.delayTime_mSec = delayAPFParameters.delayTime_mSec;
+		delay.setParameters(delayParams);
+	}
+
+	/** create the delay buffer in mSec */
+	void createDelayBuffer(double _sampleRate, double delay_mSec)
+	{
+		sampleRate = _sampleRate;
+		bufferLength_mSec = delay_mSec;
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		delay.createDelayBuffer(_sampleRate, delay_mSec);
+	}
+
+	/** take the delay buffer from an arena (nullptr for the heap), see SimpleDelay::setDelayMemoryArena( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena) { delay.setDelayMemoryArena(arena); }
+
+	/** store the delay as float, see SimpleDelay::setFloatStorage( ) */
+	void setFloatStorage(bool b) { delay.setFloatStorage(b); }
+
+	/** arena bytes for createDelayBuffer(_sampleRate, delay_mSec) */
+	static size_t getDelayMemorySize(double _sampleRate, double delay_mSec, bool floatStorage = false)
+	{
+		return SimpleDelay::getDelayMemorySize(_sampleRate, delay_mSec, floatStorage);
+	}
+
+protected:
+	// --- component parameters
+	DelayAPFParameters delayAPFParameters;	///< obeject parameters
+	double sampleRate = 0.0;				///< current sample rate
+	double bufferLength_mSec = 0.0;			///< total buffer length in mSec
+
+	// --- delay buffer of doubles
+	SimpleDelay delay;						///< delay
+
+	// --- optional LFO
+	LFO modLFO;								///< LFO
+
+	// --- LPF support
+	double lpf_state = 0.0;					///< LPF state register (z^-1)
+};
+
+
+/**
+\struct NestedDelayAPFParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the NestedDelayAPF object. Used for reverb algorithms in book.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct NestedDelayAPFParameters
+{
+	NestedDelayAPFParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	NestedDelayAPFParameters& operator=(const NestedDelayAPFParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		outerAPFdelayTime_mSec = params.outerAPFdelayTime_mSec;
+		innerAPFdelayTime_mSec = params.innerAPFdelayTime_mSec;
+		outerAPF_g = params.outerAPF_g;
+		innerAPF_g = params.innerAPF_g;
+
+		// --- outer LFO
+		enableLFO = params.enableLFO;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth = params.lfoDepth;
+		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+
+		return *this;
+	}
+
+	// --- individual parameters
+	double outerAPFdelayTime_mSec = 0.0;	///< delay time for outer APF
+	double innerAPFdelayTime_mSec = 0.0;	///< delay time for inner APF
+	double outerAPF_g = 0.0;				///< g coefficient for outer APF
+	double innerAPF_g = 0.0;				///< g coefficient for inner APF
+
+	// --- this LFO belongs to the outer APF only
+	bool enableLFO = false;					///< flag to enable the modulated delay
+	double lfoRate_Hz = 0.0;				///< LFO rate in Hz (if enabled)
+	double lfoDepth = 1.0;					///< LFO depth (not in %) (if enabled)
+	double lfoMaxModulation_mSec = 0.0;		///< max modulation time if LFO is enabled
+
+};
+
+/**
+\class NestedDelayAPF
+\ingroup FX-Objects
+\brief
+The NestedDelayAPF object implements a pair of nested Delaying APF structures. These are labled the
+outer and inner APFs. The outer APF's LPF and LFO may be optionally enabled. You might want
+to extend this object to enable and use the inner LPF and LFO as well.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use BiquadParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class NestedDelayAPF : public DelayAPF
+{
+public:
+	NestedDelayAPF(void) { }	/* C-TOR */
+	~NestedDelayAPF(void) { }	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- call base class reset first
+		DelayAPF::reset(_sampleRate);
+
+		// --- then do our stuff
+		nestedAPF.reset(_sampleRate);
+
+		return true;
+	}
+
+	/** process mono audio input */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- delay line output
+		double wnD = 0.0;
+
+		SimpleDelayParameters delayParams = delay.getParameters();
+		if (delayParams.delay_Samples == 0)
+			return xn;
+
+		double apf_g = delayAPFParameters.apf_g;
+		double lpf_g = delayAPFParameters.lpf_g;
+
+		// --- for modulated APFs
+		if (delayAPFParameters.enableLFO)
+		{
+			SignalGenData lfoOutput = modLFO.renderAudioOutput();
+			double maxDelay = delayParams.delayTime_mSec;
+			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
+			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
+			double lfoDepth = delayAPFParameters.lfoDepth;
+
+			// --- calc max-down modulated value with unipolar converted LFO output
+			//     NOTE: LFO output is scaled by lfoDepth
+			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
+				minDelay, maxDelay);
+
+			// --- read modulated value to get w(n-D);
+			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
+		}
+		else
+			// --- read the delay line to get w(n-D)
+			wnD = delay.readDelay();
+
+		if (delayAPFParameters.enableLPF)
+		{
+			// --- apply simple 1st order pole LPF, overwrite wnD
+			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
+			lpf_state = wnD;
+		}
+
+		// --- form w(n) = x(n) + gw(n-D)
+		double wn = xn + apf_g*wnD;
+
+		// --- process wn through inner APF
+		double ynInner = nestedAPF.processAudioSample(wn);
+
+		// --- form y(n) = -gw(n) + w(n-D)
+		double yn = -apf_g*wn + wnD;
+
+		// --- underflow check
+		checkFloatUnderflow(yn);
+
+		// --- write delay line
+		delay.writeDelay(ynInner);
+
+		return yn;
+	}
+
+	/** process a block of MONO audio; the inner APF writes the outer delay line, so the nested
+	    structure runs sample by sample */
+	virtual void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		for (unsigned int n = 0; n < blockSize; n++)
+			output[n] = processAudioSample(input[n]);
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return BiquadParameters custom data structure
+	*/
+	NestedDelayAPFParameters getParameters() { return nestedAPFParameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param BiquadParameters custom data structure
+	*/
+	void setParameters(const NestedDelayAPFParameters& params)
+	{
+		nestedAPFParameters = params;
+
+		DelayAPFParameters outerAPFParameters = DelayAPF::getParameters();
+		DelayAPFParameters innerAPFParameters = nestedAPF.getParameters();
+
+		// --- outer APF
+		outerAPFParameters.apf_g = nestedAPFParameters.outerAPF_g;
+		outerAPFParameters.delayTime_mSec = nestedAPFParameters.outerAPFdelayTime_mSec;
+
+		// --- LFO support
+		outerAPFParameters.enableLFO = nestedAPFParameters.enableLFO;
+		outerAPFParameters.lfoDepth = nestedAPFParameters.lfoDepth;
+		outerAPFParameters.lfoRate_Hz = nestedAPFParameters.lfoRate_Hz;
+		outerAPFParameters.lfoMaxModulation_mSec = nestedAPFParameters.lfoMaxModulation_mSec;
+
+		// --- inner APF
+		innerAPFParameters.apf_g = nestedAPFParameters.innerAPF_g;
+		innerAPFParameters.delayTime_mSec = nestedAPFParameters.innerAPFdelayTime_mSec;
+
+		DelayAPF::setParameters(outerAPFParameters);
+		nestedAPF.setParameters(innerAPFParameters);
+	}
+
+	/** createDelayBuffers -- note there are two delay times here for inner and outer APFs*/
+	void createDelayBuffers(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec)
+	{
+		// --- base class
+		DelayAPF::createDelayBuffer(_sampleRate, delay_mSec);
+
+		// --- then our stuff
+		nestedAPF.createDelayBuffer(_sampleRate, nestedAPFDelay_mSec);
+	}
+
+	/** take both delay buffers from an arena (nullptr for the heap) */
+	void setDelayMemoryArena(DelayMemoryArena* arena)
+	{
+		DelayAPF::setDelayMemoryArena(arena);
+		nestedAPF.setDelayMemoryArena(arena);
+	}
+
+	/** store both delays as float, see SimpleDelay::setFloatStorage( ) */
+	void setFloatStorage(bool b)
+	{
+		DelayAPF::setFloatStorage(b);
+		nestedAPF.setFloatStorage(b);
+	}
+
+	/** arena bytes for createDelayBuffers(_sampleRate, delay_mSec, nestedAPFDelay_mSec) */
+	static size_t getDelayMemorySize(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec, bool floatStorage = false)
+	{
+		return SimpleDelay::getDelayMemorySize(_sampleRate, delay_mSec, floatStorage) + SimpleDelay::getDelayMemorySize(_sampleRate, nestedAPFDelay_mSec, floatStorage);
+	}
+
+private:
+	NestedDelayAPFParameters nestedAPFParameters; ///< object parameters
+	DelayAPF nestedAPF;	///< nested APF object
+};
+
+/**
+\struct TwoBandShelvingFilterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the TwoBandShelvingFilter object. Used for reverb algorithms in book.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct TwoBandShelvingFilterParameters
+{
+	TwoBandShelvingFilterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	TwoBandShelvingFilterParameters& operator=(const TwoBandShelvingFilterParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+		return *this;
+	}
+
+	// --- individual parameters
+	double lowShelf_fc = 0.0;			///< fc for low shelf
+	double lowShelfBoostCut_dB = 0.0;	///< low shelf gain
+	double highShelf_fc = 0.0;			///< fc for high shelf
+	double highShelfBoostCut_dB = 0.0;	///< high shelf gain
+};
+
+/**
+\class TwoBandShelvingFilter
+\ingroup FX-Objects
+\brief
+The TwoBandShelvingFilter object implements two shelving filters in series in the standard "Bass and Treble" configuration.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use TwoBandShelvingFilterParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class TwoBandShelvingFilter : public IAudioSignalProcessor
+{
+public:
+	TwoBandShelvingFilter()
+	{
+		AudioFilterParameters params = lowShelfFilter.getParameters();
+		params.algorithm = filterAlgorithm::kLowShelf;
+		lowShelfFilter.setParameters(params);
+
+		params = highShelfFilter.getParameters();
+		params.algorithm = filterAlgorithm::kHiShelf;
+		highShelfFilter.setParameters(params);
+	}		/* C-TOR */
+
+	~TwoBandShelvingFilter() {}		/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		lowShelfFilter.reset(_sampleRate);
+		highShelfFilter.reset(_sampleRate);
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process a single input through the two filters in series */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- all modes do Full Wave Rectification
+		double filteredSignal = lowShelfFilter.processAudioSample(xn);
+		filteredSignal = highShelfFilter.processAudioSample(filteredSignal);
+
+		return filteredSignal;
+	}
+
+	/** process a block through the two filters in series, one filter at a time; input and output may be the same buffer */
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		for (unsigned int i = 0; i < blockSize; i++)
+			output[i] = lowShelfFilter.processAudioSample(input[i]);
+		for (unsigned int i = 0; i < blockSize; i++)
+			output[i] = highShelfFilter.processAudioSample(output[i]);
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return TwoBandShelvingFilterParameters custom data structure
+	*/
+	TwoBandShelvingFilterParameters getParameters()
+	{
+		return parameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param TwoBandShelvingFilterParameters custom data structure
+	*/
+	void setParameters(const TwoBandShelvingFilterParameters& params)
+	{
+		parameters = params;
+		AudioFilterParameters filterParams = lowShelfFilter.getParameters();
+		filterParams.fc = parameters.lowShelf_fc;
+		filterParams.boostCut_dB = parameters.lowShelfBoostCut_dB;
+		lowShelfFilter.setParameters(filterParams);
+
+		filterParams = highShelfFilter.getParameters();
+		filterParams.fc = parameters.highShelf_fc;
+		filterParams.boostCut_dB = parameters.highShelfBoostCut_dB;
+		highShelfFilter.setParameters(filterParams);
+	}
+
+private:
+	TwoBandShelvingFilterParameters parameters; ///< object parameters
+	AudioFilter lowShelfFilter;					///< filter for low shelf
+	AudioFilter highShelfFilter;				///< filter for high shelf
+};
+
+/**
+\enum reverbDensity
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the density in the reverb object.
+
+- enum class reverbDensity { kThick, kSparse };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class reverbDensity { kThick, kSparse };
+
+/**
+\struct ReverbTankParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the ReverbTank object.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct ReverbTankParameters
+{
+	ReverbTankParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	ReverbTankParameters& operator=(const ReverbTankParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		density = params.density;
+
+		// --- tweaker variables
+		apfDelayMax_mSec = params.apfDelayMax_mSec;
+		apfDelayWeight_Pct = params.apfDelayWeight_Pct;
+		fixeDelayMax_mSec = params.fixeDelayMax_mSec;
+		fixeDelayWeight_Pct = params.fixeDelayWeight_Pct;
+		preDelayTime_mSec = params.preDelayTime_mSec;
+
+		lpf_g = params.lpf_g;
+		kRT = params.kRT;
+
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+
+		wetLevel_dB = params.wetLevel_dB;
+		dryLevel_dB = params.dryLevel_dB;
+		return *this;
+	}
+
+	// --- individual parameters
+	reverbDensity density = reverbDensity::kThick;	///< density setting thick or thin
+
+	// --- tweaking parameters - you may not want to expose these
+	//     in the final plugin!
+	// --- See the book for all the details on how these tweakers work!!
+	double apfDelayMax_mSec = 5.0;					///< APF max delay time
+	double apfDelayWeight_Pct = 100.0;				///< APF max delay weighying
+	double fixeDelayMax_mSec = 50.0;				///< fixed delay max time
+	double fixeDelayWeight_Pct = 100.0;				///< fixed delay max weighying
+
+	// --- direct control parameters
+	double preDelayTime_mSec = 0.0;					///< pre-delay time in mSec
+	double lpf_g = 0.0;								///< LPF g coefficient
+	double kRT = 0.0;								///< reverb time, 0 to 1
+
+	double lowShelf_fc = 0.0;						///< low shelf fc
+	double lowShelfBoostCut_dB = 0.0;				///< low shelf gain
+	double highShelf_fc = 0.0;						///< high shelf fc
+	double highShelfBoostCut_dB = 0.0;				///< high shelf gain
+
+	double wetLevel_dB = -3.0;						///< wet output level in dB
+	double dryLevel_dB = -3.0;						///< dry output level in dB
+};
+
+// --- constants for reverb tank
+const unsigned int NUM_BRANCHES = 4;
+const unsigned int NUM_CHANNELS = 2; // stereo
+
+/**
+\class ReverbTank
+\ingroup FX-Objects
+\brief
+The ReverbTank object implements the cyclic reverb tank in the FX book listed below.
+
+The four branches (nested APF, LPF, delay) are stored as structure-of-arrays. Each branch is fed by the delay
+output of the previous one, which is at least one sample old, so all branches can run side by side: the lines
+are read and written in blocks and the branch math runs in plain loops over the block, with the four branch
+LPFs as interleaved lanes. The pre-delay and the shelving filters also run on blocks.
+
+Audio I/O:
+- Processes mono input to mono OR stereo output.
+
+Control I/F:
+- Use ReverbTankParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class ReverbTank : public IAudioSignalProcessor
+{
+public:
+	ReverbTank() {}		/* C-TOR */
+	~ReverbTank() {}	/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// ---store
+		sampleRate = _sampleRate;
+		samplesPerMSec = sampleRate / 1000.0;
+
+		// ---set up preDelay
+		preDelay.reset(_sampleRate);
+		preDelay.createDelayBuffer(_sampleRate, 100.0);
+
+		// --- 100 mSec for every branch line
+		unsigned int bufferLength = (unsigned int)(100.0*samplesPerMSec) + 1;
+		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
+		{
+			outerAPFBuffers[i].createCircularBuffer(bufferLength, delayMemoryArena);
+			innerAPFBuffers[i].createCircularBuffer(bufferLength, delayMemoryArena);
+			branchDelayBuffers[i].createCircularBuffer(bufferLength, delayMemoryArena);
+			outerAPFBuffers[i].setInterpolate(false);
+			innerAPFBuffers[i].setInterpolate(false);
+			branchDelayBuffers[i].setInterpolate(false);
+
+			lfoModCounter[i] = 0.0;
+			lpfState[i] = 0.0;
+		}
+		for (uint32_t i = 0; i < NUM_CHANNELS; i++)
+		{
+			shelvingFilters[i].reset(_sampleRate);
+		}
+
+		// --- delay times in samples
+		setParameters(parameters);
+
+		return true;
+	}
+
+	/** take all delay lines from an arena (nullptr for the heap) at the next reset( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena)
+	{
+		delayMemoryArena = arena;
+		preDelay.setDelayMemoryArena(arena);
+	}
+
+	/** store all delay lines as float, with double math, at the next reset( ) */
+	void setFloatStorage(bool b)
+	{
+		preDelay.setFloatStorage(b);
+		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
+		{
+			outerAPFBuffers[i].setFloatStorage(b);
+			innerAPFBuffers[i].setFloatStorage(b);
+			branchDelayBuffers[i].setFloatStorage(b);
+		}
+	}
+
+	/** arena bytes for reset(_sampleRate) */
+	static size_t getDelayMemorySize(double _sampleRate, bool floatStorage = false)
+	{
+		unsigned int bufferLength = (unsigned int)(100.0*(_sampleRate / 1000.0)) + 1;
+		return SimpleDelay::getDelayMemorySize(_sampleRate, 100.0, floatStorage) + 3 * NUM_BRANCHES*CircularBuffer<double>::getArenaSize(bufferLength, floatStorage);
+	}
+
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process mono reverb tank */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double yn = 0.0;
+		processAudioBlocks(&xn, nullptr, &yn, nullptr, 1);
+		return yn;
+	}
+
+	/** process stereo reverb tank */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		double xnL = inputFrame[0];
+		double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
+		double ynL = 0.0;
+		double ynR = 0.0;
+
+		processAudioBlocks(&xnL, inputChannels > 1 ? &xnR : nullptr, &ynL, outputChannels == 1 ? nullptr : &ynR, 1);
+
+		outputFrame[0] = (float)ynL;
+		if (outputChannels > 1)
+			outputFrame[1] = (float)ynR;
+
+		return true;
+	}
+
+	/** process the reverb tank in blocks. inputR may be nullptr for mono-in; outputR may be nullptr for mono-out.
+	    Inputs and outputs may be the same buffers. */
+	/**
+	\param inputL LEFT input block
+	\param inputR RIGHT input block or nullptr
+	\param outputL LEFT output block
+	\param outputR RIGHT output block or nullptr
+	\param blockSize number of samples
+	*/
+	void processAudioBlocks(const double* inputL, const double* inputR, double* outputL, double* outputR, unsigned int blockSize)
+	{
+		double preDelayOut[MAX_DELAY_BLOCK];
+		double tankOutL[MAX_DELAY_BLOCK];
+		double tankOutR[MAX_DELAY_BLOCK];
+		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
+		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+
+		// --- single frames skip the block machinery
+		if (blockSize == 1)
+		{
+			double xn = inputR ? 0.5*inputL[0] + 0.5*inputR[0] : inputL[0];
+			double tankL = 0.0;
+			double tankR = 0.0;
+			processBranchesSample(preDelay.processAudioSample(xn), tankL, tankR);
+			tankL = shelvingFilters[0].processAudioSample(tankL);
+			tankR = shelvingFilters[1].processAudioSample(tankR);
+
+			if (!outputR)
+				outputL[0] = dry*inputL[0] + wet*(0.5*tankL + 0.5*tankR);
+			else
+			{
+				outputR[0] = dry*(inputR ? inputR[0] : 0.0) + wet*tankR;
+				outputL[0] = dry*inputL[0] + wet*tankL;
+			}
+			return;
+		}
+
+		// --- branches may not read what they write in the same chunk
+		unsigned int chunk = getMaxChunkLength();
+
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+
+			// --- mono-ized input signal
+			if (inputR)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					preDelayOut[i] = 0.5*inputL[n + i] + 0.5*inputR[n + i];
+			}
+			else
+			{
+				for (unsigned int i = 0; i < length; i++)
+					preDelayOut[i] = inputL[n + i] + 0.0;
+			}
+
+			// --- pre delay output
+			preDelay.processAudioBlock(preDelayOut, preDelayOut, length);
+
+			// --- the four branches, as lanes
+			processBranches(preDelayOut, tankOutL, tankOutR, length);
+
+			// ---  filter
+			shelvingFilters[0].processAudioBlock(tankOutL, tankOutL, length);
+			shelvingFilters[1].processAudioBlock(tankOutR, tankOutR, length);
+
+			// --- sum with dry
+			if (!outputR)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					outputL[n + i] = dry*inputL[n + i] + wet*(0.5*tankOutL[i] + 0.5*tankOutR[i]);
+			}
+			else
+			{
+				// --- RIGHT first, in case the LEFT output is the mono input
+				for (unsigned int i = 0; i < length; i++)
+					outputR[n + i] = dry*(inputR ? inputR[n + i] : 0.0) + wet*tankOutR[i];
+				for (unsigned int i = 0; i < length; i++)
+					outputL[n + i] = dry*inputL[n + i] + wet*tankOutL[i];
+			}
+		}
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ReverbTankParameters custom data structure
+	*/
+	ReverbTankParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ReverbTankParameters custom data structure
+	*/
+	void setParameters(const ReverbTankParameters& params)
+	{
+		// --- do the updates here, the sub-components will only update themselves if
+		//     their parameters changed, so we let those object handle that chore
+		TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
+		filterParams.highShelf_fc = params.highShelf_fc;
+		filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+		filterParams.lowShelf_fc = params.lowShelf_fc;
+		filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+
+		// --- copy to both channels
+		shelvingFilters[0].setParameters(filterParams);
+		shelvingFilters[1].setParameters(filterParams);
+
+		// --- update pre delay
+		SimpleDelayParameters delayParams = preDelay.getParameters();
+		delayParams.delayTime_mSec = params.preDelayTime_mSec;
+		preDelay.setParameters(delayParams);
+
+		// --- global max Delay times
+		double globalAPFMaxDelay = (params.apfDelayWeight_Pct / 100.0)*params.apfDelayMax_mSec;
+		double globalFixedMaxDelay = (params.fixeDelayWeight_Pct / 100.0)*params.fixeDelayMax_mSec;
+
+		int m = 0;
+		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
+		{
+			// --- setup APFs; the outer delay is modulated down from its maximum by up to 0.3 mSec
+			outerAPFDelay_mSec[i] = globalAPFMaxDelay*apfDelayWeight[m++];
+			outerAPFMinDelay_mSec[i] = fmax(0.0, outerAPFDelay_mSec[i] - 0.3);
+			innerAPFDelay_Samples[i] = globalAPFMaxDelay*apfDelayWeight[m++] * samplesPerMSec;
+
+			// --- fixedDelayWeight
+			branchDelay_Samples[i] = globalFixedMaxDelay*fixedDelayWeight[i] * samplesPerMSec;
+
+			// --- the branch structure needs at least one sample in each line
+			outerAPFMinDelay_mSec[i] = fmax(outerAPFMinDelay_mSec[i], 1.0 / fmax(samplesPerMSec, 1.0));
+			outerAPFDelay_mSec[i] = fmax(outerAPFDelay_mSec[i], outerAPFMinDelay_mSec[i]);
+			innerAPFDelay_Samples[i] = fmax(innerAPFDelay_Samples[i], 1.0);
+			branchDelay_Samples[i] = fmax(branchDelay_Samples[i], 1.0);
+		}
+
+		// --- save our copy
+		parameters = params;
+	}
+
+
+private:
+	/** the four branches for one chunk; the lines are read as blocks, the branch math runs over the chunk
+	    for each branch and the branch LPFs run as four interleaved lanes */
+	void processBranches(const double* preDelayOut, double* outL, double* outR, unsigned int length)
+	{
+		double branchOut[NUM_BRANCHES][MAX_DELAY_BLOCK];	// --- branch delay outputs, then LPF outputs
+		double outerWnD[NUM_BRANCHES][MAX_DELAY_BLOCK];		// --- outer APF w(n-D), then outer APF output
+		double innerWnD[NUM_BRANCHES][MAX_DELAY_BLOCK];		// --- inner APF w(n-D), then inner APF output
+		double wn[NUM_BRANCHES][MAX_DELAY_BLOCK];			// --- APF input, then outer APF w(n)
+		double innerWn[NUM_BRANCHES][MAX_DELAY_BLOCK];		// --- inner APF w(n)
+		double modDelay[MAX_DELAY_BLOCK];
+		double kRT = parameters.kRT;
+		double lpf_g = parameters.lpf_g;
+		const double outer_g = 0.5;
+		const double inner_g = -0.5;
+
+		// --- read all lines
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+		{
+			branchDelayBuffers[b].readBlock(branchDelay_Samples[b], branchOut[b], length);
+			innerAPFBuffers[b].readBlock(innerAPFDelay_Samples[b], innerWnD[b], length);
+
+			// --- outer delay: LFO modulated, max-down; see DelayAPF
+			lfoDelays(b, modDelay, length);
+			outerAPFBuffers[b].readBlock(modDelay, outerWnD[b], length);
+		}
+
+		// --- branch inputs: branch b is fed by the delay output of branch b - 1 (the global feedback for branch 0)
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+		{
+			const double* feedback = branchOut[b == 0 ? NUM_BRANCHES - 1 : b - 1];
+			for (unsigned int i = 0; i < length; i++)
+				wn[b][i] = kRT*feedback[i] + preDelayOut[i];
+		}
+
+		// --- nested APFs; no recursion inside a chunk
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+		{
+			for (unsigned int i = 0; i < length; i++)
+			{
+				// --- form w(n) = x(n) + gw(n-D)
+				double outerWn = wn[b][i] + outer_g*outerWnD[b][i];
+
+				// --- inner APF
+				innerWn[b][i] = outerWn + inner_g*innerWnD[b][i];
+				double ynInner = -inner_g*innerWn[b][i] + innerWnD[b][i];
+				checkFloatUnderflow(ynInner);
+
+				// --- form y(n) = -gw(n) + w(n-D)
+				double yn = -outer_g*outerWn + outerWnD[b][i];
+				checkFloatUnderflow(yn);
+
+				wn[b][i] = yn;
+				outerWnD[b][i] = ynInner;
+			}
+		}
+
+		// --- branch LPFs: recursive in time, so the four branches run as interleaved lanes
+		for (unsigned int i = 0; i < length; i++)
+		{
+			for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+			{
+				lpfState[b] = (1.0 - lpf_g)*wn[b][i] + lpf_g*lpfState[b];
+				wn[b][i] = lpfState[b];
+			}
+		}
+
+		// --- write all lines
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+		{
+			outerAPFBuffers[b].writeBlock(outerWnD[b], length);
+			innerAPFBuffers[b].writeBlock(innerWn[b], length);
+			branchDelayBuffers[b].writeBlock(wn[b], length);
+		}
+
+		// --- gather outputs
+		/*
+		There are 25 prime numbers between 1 and 100.
+		They are 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
+
+		we want 16 of them: 23, 29, 31, 37, 41,
+		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
+		*/
+		const double weight = 0.707;
+		memset(outL, 0, length * sizeof(double));
+		memset(outR, 0, length * sizeof(double));
+
+		unsigned int numTaps = parameters.density == reverbDensity::kThick ? 2 : 1;
+		for (unsigned int t = 0; t < numTaps; t++)
+		{
+			for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+			{
+				double sign = b % 2 == 0 ? 1.0 : -1.0;
+				accumulateTap(b, outL, sign*weight, tapPercentL[t][b], length);
+				accumulateTap(b, outR, -sign*weight, tapPercentR[t][b], length);
+			}
+		}
+	}
+
+	/** the four branches for a single sample; same math as processBranches( ) with per-sample line access */
+	void processBranchesSample(double preDelayOut, double& outL, double& outR)
+	{
+		double branchOut[NUM_BRANCHES];
+		double kRT = parameters.kRT;
+		double lpf_g = parameters.lpf_g;
+		const double outer_g = 0.5;
+		const double inner_g = -0.5;
+
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+			branchOut[b] = branchDelayBuffers[b].readBuffer(branchDelay_Samples[b]);
+
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+		{
+			double modDelay = 0.0;
+			lfoDelays(b, &modDelay, 1);
+			double outerWnD = outerAPFBuffers[b].readBuffer(modDelay);
+			double innerWnD = innerAPFBuffers[b].readBuffer(innerAPFDelay_Samples[b]);
+
+			// --- nested APFs
+			double outerWn = kRT*branchOut[b == 0 ? NUM_BRANCHES - 1 : b - 1] + preDelayOut + outer_g*outerWnD;
+			double innerWn = outerWn + inner_g*innerWnD;
+			double ynInner = -inner_g*innerWn + innerWnD;
+			checkFloatUnderflow(ynInner);
+			double yn = -outer_g*outerWn + outerWnD;
+			checkFloatUnderflow(yn);
+
+			// --- LPF
+			lpfState[b] = (1.0 - lpf_g)*yn + lpf_g*lpfState[b];
+
+			outerAPFBuffers[b].writeBuffer(ynInner);
+			innerAPFBuffers[b].writeBuffer(innerWn);
+			branchDelayBuffers[b].writeBuffer(lpfState[b]);
+		}
+
+		// --- gather outputs, see processBranches( )
+		const double weight = 0.707;
+		outL = 0.0;
+		outR = 0.0;
+
+		unsigned int numTaps = parameters.density == reverbDensity::kThick ? 2 : 1;
+		for (unsigned int t = 0; t < numTaps; t++)
+		{
+			for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+			{
+				double sign = b % 2 == 0 ? 1.0 : -1.0;
+				outL += sign*weight*branchDelayBuffers[b].readBuffer((int)((tapPercentL[t][b] / 100.0)*branchDelay_Samples[b]));
+				outR += -sign*weight*branchDelayBuffers[b].readBuffer((int)((tapPercentR[t][b] / 100.0)*branchDelay_Samples[b]));
+			}
+		}
+	}
+
+	/** modulated outer APF delay times (in samples) for branch b, as DelayAPF computes them */
+	void lfoDelays(uint32_t b, double* delays, unsigned int length)
+	{
+		double maxDelay = outerAPFDelay_mSec[b];
+		double minDelay = outerAPFMinDelay_mSec[b];
+		for (unsigned int i = 0; i < length; i++)
+		{
+			// --- triangle LFO, see LFO::renderAudioOutput( )
+			if (lfoModCounter[b] >= 1.0)
+				lfoModCounter[b] -= 1.0;
+			double lfoOutput = 2.0*fabs(unipolarToBipolar(lfoModCounter[b])) - 1.0;
+			lfoModCounter[b] += lfoPhaseInc[b];
+
+			delays[i] = doUnipolarModulationFromMax(bipolarToUnipolar(lfoOutput), minDelay, maxDelay)*samplesPerMSec;
+		}
+	}
+
+	/** add a branch delay tap (read at a percentage of the branch delay) to an output; the branch line has just
+	    been written with length samples, so read as if before each of those writes */
+	void accumulateTap(uint32_t b, double* output, double gain, double delayPercent, unsigned int length)
+	{
+		unsigned int delayInSamples = (unsigned int)((delayPercent / 100.0)*branchDelay_Samples[b]);
+		double tap[MAX_DELAY_BLOCK];
+		branchDelayBuffers[b].readBlock((double)(delayInSamples + length - 1), tap, length);
+		for (unsigned int i = 0; i < length; i++)
+			output[i] += gain*tap[i];
+	}
+
+	/** longest chunk in which no line reads a sample written in the same chunk */
+	unsigned int getMaxChunkLength()
+	{
+		unsigned int length = MAX_DELAY_BLOCK;
+		for (uint32_t b = 0; b < NUM_BRANCHES; b++)
+		{
+			unsigned int outerLength = (unsigned int)(outerAPFMinDelay_mSec[b] * samplesPerMSec);
+			unsigned int innerLength = (unsigned int)innerAPFDelay_Samples[b] + 1;
+			unsigned int branchLength = (unsigned int)branchDelay_Samples[b] + 1;
+			if (outerLength < length) length = outerLength;
+			if (innerLength < length) length = innerLength;
+			if (branchLength < length) length = branchLength;
+		}
+		return length;
+	}
+
+	ReverbTankParameters parameters;				///< object parameters
+
+	SimpleDelay  preDelay;							///< pre delay object
+
+	// --- branch state, structure-of-arrays: one entry per branch
+	CircularBuffer<double> outerAPFBuffers[NUM_BRANCHES];		///< outer APF delay lines
+	CircularBuffer<double> innerAPFBuffers[NUM_BRANCHES];		///< inner (nested) APF delay lines
+	CircularBuffer<double> branchDelayBuffers[NUM_BRANCHES];	///< branch delay lines
+	double outerAPFDelay_mSec[NUM_BRANCHES] = { 0.0 };		///< outer APF maximum delay
+	double outerAPFMinDelay_mSec[NUM_BRANCHES] = { 0.0 };	///< outer APF minimum (modulated) delay
+	double innerAPFDelay_Samples[NUM_BRANCHES] = { 0.0 };	///< inner APF delay
+	double branchDelay_Samples[NUM_BRANCHES] = { 0.0 };		///< branch delay
+	double lpfState[NUM_BRANCHES] = { 0.0 };				///< branch LPF states
+	DelayMemoryArena* delayMemoryArena = nullptr;			///< optional arena for the lines
+
+	// --- outer APF LFOs; like DelayAPF's LFO, these run at 0 Hz and hold the delays at maximum
+	double lfoModCounter[NUM_BRANCHES] = { 0.0 };			///< LFO modulo counters
+	double lfoPhaseInc[NUM_BRANCHES] = { 0.0 };				///< LFO phase increments
+
+	TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
+
+	// --- weighting values to make various and low-correlated APF delay values easily
+	double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
+	double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
+
+	// --- output tap positions (% of branch delay); first row always, second row for kThick
+	double tapPercentL[2][NUM_BRANCHES] = { { 23.0, 41.0, 59.0, 73.0 }, { 31.0, 47.0, 67.0, 83.0 } };	///< LEFT taps
+	double tapPercentR[2][NUM_BRANCHES] = { { 29.0, 43.0, 61.0, 79.0 }, { 37.0, 53.0, 71.0, 89.0 } };	///< RIGHT taps
+
+	double sampleRate = 0.0;		///< current sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond
+};
+
+
+/**
+\enum fdnMixingMatrix
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the feedback matrix in the FDNReverb object; both are lossless
+and are applied with butterflies rather than a full matrix multiply.
+
+- enum class fdnMixingMatrix { kHouseholder, kHadamard };
+
+\version Revision : 1.0
+*/
+enum class fdnMixingMatrix { kHouseholder, kHadamard };
+
+/**
+\struct FDNReverbParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the FDNReverb object.
+
+\version Revision : 1.0
+*/
+struct FDNReverbParameters
+{
+	FDNReverbParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	FDNReverbParameters& operator=(const FDNReverbParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		numDelayLines = params.numDelayLines;
+		mixingMatrix = params.mixingMatrix;
+
+		minDelay_mSec = params.minDelay_mSec;
+		maxDelay_mSec = params.maxDelay_mSec;
+		inputDiffusion = params.inputDiffusion;
+		modRate_Hz = params.modRate_Hz;
+		modDepth_mSec = params.modDepth_mSec;
+
+		preDelayTime_mSec = params.preDelayTime_mSec;
+		reverbTime_Sec = params.reverbTime_Sec;
+		lpf_g = params.lpf_g;
+
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+
+		wetLevel_dB = params.wetLevel_dB;
+		dryLevel_dB = params.dryLevel_dB;
+		return *this;
+	}
+
+	// --- individual parameters
+	unsigned int numDelayLines = 8;								///< 8 or 16 delay lines
+	fdnMixingMatrix mixingMatrix = fdnMixingMatrix::kHadamard;	///< feedback matrix
+
+	// --- tweaking parameters - you may not want to expose these
+	//     in the final plugin!
+	double minDelay_mSec = 29.0;					///< shortest line delay; lines are spread geometrically up to maxDelay_mSec
+	double maxDelay_mSec = 83.0;					///< longest line delay
+	double inputDiffusion = 0.5;					///< g of the series input APFs, 0 = no diffusion
+	double modRate_Hz = 0.5;						///< line modulation rate (spread +/-30% across the lines)
+	double modDepth_mSec = 0.2;						///< line modulation depth, max-down from the line delay
+
+	// --- direct control parameters
+	double preDelayTime_mSec = 0.0;					///< pre-delay time in mSec
+	double reverbTime_Sec = 2.0;					///< RT60 (at DC)
+	double lpf_g = 0.3;								///< damping LPF g coefficient
+
+	double lowShelf_fc = 0.0;						///< low shelf fc
+	double lowShelfBoostCut_dB = 0.0;				///< low shelf gain
+	double highShelf_fc = 0.0;						///< high shelf fc
+	double highShelfBoostCut_dB = 0.0;				///< high shelf gain
+
+	double wetLevel_dB = -3.0;						///< wet output level in dB
+	double dryLevel_dB = -3.0;						///< dry output level in dB
+};
+
+// --- constants for FDN reverb
+const unsigned int MAX_FDN_LINES = 16;
+const unsigned int NUM_FDN_DIFFUSERS = 4;
+const double FDN_MAX_DELAY_MSEC = 200.0;
+
+/**
+\class FDNReverb
+\ingroup FX-Objects
+\brief
+The FDNReverb object implements a feedback delay network reverb with 8 or 16 modulated delay lines, per-line damping
+and a Householder or Hadamard feedback matrix. Compared to the four branch ReverbTank it builds echo density much
+faster for a similar CPU load.
+
+The input is mono-ized, pre-delayed (SimpleDelay) and diffused by four series DelayAPFs, then fed to every line
+with alternating signs. Each line output is scaled for the reverb time, damped by a one-pole LPF (see SimpleLPF),
+tapped for the LEFT (even lines) and RIGHT (odd lines) outputs, mixed and written back. The lines are at least
+minDelay_mSec long, so a whole chunk of every line is read before any of it is written: the lines are stored as
+structure-of-arrays, read and written as blocks, and the matrix butterflies run over whole chunks. The outputs run
+through TwoBandShelvingFilters.
+
+Audio I/O:
+- Processes mono input to mono OR stereo output.
+
+Control I/F:
+- Use FDNReverbParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class FDNReverb : public IAudioSignalProcessor
+{
+public:
+	FDNReverb() {}		/* C-TOR */
+	~FDNReverb() {}		/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// ---store
+		sampleRate = _sampleRate;
+		samplesPerMSec = sampleRate / 1000.0;
+
+		// ---set up preDelay
+		preDelay.reset(_sampleRate);
+		preDelay.createDelayBuffer(_sampleRate, 100.0);
+
+		// --- input diffusers
+		for (uint32_t i = 0; i < NUM_FDN_DIFFUSERS; i++)
+		{
+			diffusers[i].reset(_sampleRate);
+			diffusers[i].createDelayBuffer(_sampleRate, 20.0);
+		}
+
+		// --- lines, with room for the modulation
+		unsigned int bufferLength = (unsigned int)(FDN_MAX_DELAY_MSEC*samplesPerMSec) + 1;
+		for (uint32_t i = 0; i < MAX_FDN_LINES; i++)
+		{
+			lineBuffers[i].createCircularBuffer(bufferLength, delayMemoryArena);
+			lineBuffers[i].setInterpolate(true);
+			lineBuffers[i].setInterpolationType(delayInterpolation::kLinear);
+			lpfState[i] = 0.0;
+
+			modLFOs[i].reset(_sampleRate);
+			OscillatorParameters lfoParams = modLFOs[i].getParameters();
+			lfoParams.waveform = generatorWaveform::kSin;
+			modLFOs[i].setParameters(lfoParams);
+		}
+
+		for (uint32_t i = 0; i < NUM_CHANNELS; i++)
+		{
+			shelvingFilters[i].reset(_sampleRate);
+		}
+
+		// --- delay times in samples
+		setParameters(parameters);
+
+		return true;
+	}
+
+	/** take all delay lines from an arena (nullptr for the heap) at the next reset( ) */
+	void setDelayMemoryArena(DelayMemoryArena* arena)
+	{
+		delayMemoryArena = arena;
+		preDelay.setDelayMemoryArena(arena);
+		for (uint32_t i = 0; i < NUM_FDN_DIFFUSERS; i++)
+			diffusers[i].setDelayMemoryArena(arena);
+	}
+
+	/** store all delay lines as float, with double math, at the next reset( ) */
+	void setFloatStorage(bool b)
+	{
+		preDelay.setFloatStorage(b);
+		for (uint32_t i = 0; i < NUM_FDN_DIFFUSERS; i++)
+			diffusers[i].setFloatStorage(b);
+		for (uint32_t i = 0; i < MAX_FDN_LINES; i++)
+			lineBuffers[i].setFloatStorage(b);
+	}
+
+	/** arena bytes for reset(_sampleRate) */
+	static size_t getDelayMemorySize(double _sampleRate, bool floatStorage = false)
+	{
+		unsigned int bufferLength = (unsigned int)(FDN_MAX_DELAY_MSEC*(_sampleRate / 1000.0)) + 1;
+		return SimpleDelay::getDelayMemorySize(_sampleRate, 100.0, floatStorage) + NUM_FDN_DIFFUSERS*DelayAPF::getDelayMemorySize(_sampleRate, 20.0, floatStorage) +
+			MAX_FDN_LINES*CircularBuffer<double>::getArenaSize(bufferLength, floatStorage);
+	}
+
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process mono reverb */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double yn = 0.0;
+		processAudioBlocks(&xn, nullptr, &yn, nullptr, 1);
+		return yn;
+	}
+
+	/** process stereo reverb */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		double xnL = inputFrame[0];
+		double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
+		double ynL = 0.0;
+		double ynR = 0.0;
+
+		processAudioBlocks(&xnL, inputChannels > 1 ? &xnR : nullptr, &ynL, outputChannels == 1 ? nullptr : &ynR, 1);
+
+		outputFrame[0] = (float)ynL;
+		if (outputChannels > 1)
+			outputFrame[1] = (float)ynR;
+
+		return true;
+	}
+
+	/** process the reverb in blocks. inputR may be nullptr for mono-in; outputR may be nullptr for mono-out.
+	    Inputs and outputs may be the same buffers. */
+	/**
+	\param inputL LEFT input block
+	\param inputR RIGHT input block or nullptr
+	\param outputL LEFT output block
+	\param outputR RIGHT output block or nullptr
+	\param blockSize number of samples
+	*/
+	void processAudioBlocks(const double* inputL, const double* inputR, double* outputL, double* outputR, unsigned int blockSize)
+	{
+		double networkIn[MAX_DELAY_BLOCK];
+		double networkOutL[MAX_DELAY_BLOCK];
+		double networkOutR[MAX_DELAY_BLOCK];
+		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
+		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+
+		// --- lines may not read what they write in the same chunk
+		unsigned int chunk = getMaxChunkLength();
+
+		for (unsigned int n = 0; n < blockSize; n += chunk)
+		{
+			unsigned int length = blockSize - n < chunk ? blockSize - n : chunk;
+
+			// --- mono-ized input signal
+			if (inputR)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					networkIn[i] = 0.5*inputL[n + i] + 0.5*inputR[n + i];
+			}
+			else
+			{
+				for (unsigned int i = 0; i < length; i++)
+					networkIn[i] = inputL[n + i];
+			}
+
+			// --- pre delay and diffusion
+			if (length == 1)
+			{
+				networkIn[0] = preDelay.processAudioSample(networkIn[0]);
+				if (parameters.inputDiffusion != 0.0)
+				{
+					for (uint32_t i = 0; i < NUM_FDN_DIFFUSERS; i++)
+						networkIn[0] = diffusers[i].processAudioSample(networkIn[0]);
+				}
+			}
+			else
+			{
+				preDelay.processAudioBlock(networkIn, networkIn, length);
+				if (parameters.inputDiffusion != 0.0)
+				{
+					for (uint32_t i = 0; i < NUM_FDN_DIFFUSERS; i++)
+						diffusers[i].processAudioBlock(networkIn, networkIn, length);
+				}
+			}
+
+			// --- the network
+			processNetwork(networkIn, networkOutL, networkOutR, length);
+
+			// ---  filter
+			if (length == 1)
+			{
+				networkOutL[0] = shelvingFilters[0].processAudioSample(networkOutL[0]);
+				networkOutR[0] = shelvingFilters[1].processAudioSample(networkOutR[0]);
+			}
+			else
+			{
+				shelvingFilters[0].processAudioBlock(networkOutL, networkOutL, length);
+				shelvingFilters[1].processAudioBlock(networkOutR, networkOutR, length);
+			}
+
+			// --- sum with dry
+			if (!outputR)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					outputL[n + i] = dry*inputL[n + i] + wet*(0.5*networkOutL[i] + 0.5*networkOutR[i]);
+			}
+			else
+			{
+				// --- RIGHT first, in case the LEFT output is the mono input
+				for (unsigned int i = 0; i < length; i++)
+					outputR[n + i] = dry*(inputR ? inputR[n + i] : 0.0) + wet*networkOutR[i];
+				for (unsigned int i = 0; i < length; i++)
+					outputL[n + i] = dry*inputL[n + i] + wet*networkOutL[i];
+			}
+		}
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return FDNReverbParameters custom data structure
+	*/
+	FDNReverbParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param FDNReverbParameters custom data structure
+	*/
+	void setParameters(const FDNReverbParameters& params)
+	{
+		// --- shelving filters, copy to both channels
+		TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
+		filterParams.highShelf_fc = params.highShelf_fc;
+		filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+		filterParams.lowShelf_fc = params.lowShelf_fc;
+		filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		shelvingFilters[0].setParameters(filterParams);
+		shelvingFilters[1].setParameters(filterParams);
+
+		// --- update pre delay
+		SimpleDelayParameters delayParams = preDelay.getParameters();
+		delayParams.delayTime_mSec = params.preDelayTime_mSec;
+		preDelay.setParameters(delayParams);
+
+		// --- diffusers
+		for (uint32_t i = 0; i < NUM_FDN_DIFFUSERS; i++)
+		{
+			DelayAPFParameters apfParams = diffusers[i].getParameters();
+			apfParams.delayTime_mSec = diffuserDelay_mSec[i];
+			apfParams.apf_g = params.inputDiffusion;
+			diffusers[i].setParameters(apfParams);
+		}
+
+		// --- nothing else to do until reset( )
+		parameters = params;
+		if (samplesPerMSec <= 0.0)
+			return;
+
+		numLines = params.numDelayLines >= MAX_FDN_LINES ? MAX_FDN_LINES : 8;
+
+		// --- line lengths: geometric spread, rounded to primes so the lines share no echo periods
+		double maxDelay_mSec = fmin(params.maxDelay_mSec, FDN_MAX_DELAY_MSEC - 1.0);
+		double minDelay_mSec = fmin(fmax(params.minDelay_mSec, 1.0), maxDelay_mSec);
+		modDepth_Samples = fmin(fmax(params.modDepth_mSec, 0.0), 0.5*minDelay_mSec)*samplesPerMSec;
+
+		for (uint32_t i = 0; i < numLines; i++)
+		{
+			double delay_mSec = minDelay_mSec*pow(maxDelay_mSec / minDelay_mSec, (double)i / (double)(numLines - 1));
+			lineDelay_Samples[i] = findNextPrime((unsigned int)(delay_mSec*samplesPerMSec));
+
+			// --- RT60: -60dB after reverbTime_Sec
+			lineGain[i] = params.reverbTime_Sec > 0.0 ? pow(10.0, -3.0*lineDelay_Samples[i] / (params.reverbTime_Sec*sampleRate)) : 0.0;
+
+			// --- modulation rates spread +/-30% across the lines
+			OscillatorParameters lfoParams = modLFOs[i].getParameters();
+			lfoParams.frequency_Hz = params.modRate_Hz*(0.7 + 0.6*(double)i / (double)(numLines - 1));
+			modLFOs[i].setParameters(lfoParams);
+		}
+	}
+
+private:
+	/** the network for one chunk: all lines are read as blocks, damped as interleaved lanes, mixed with
+	    butterflies over whole rows and written back as blocks */
+	void processNetwork(const double* input, double* outL, double* outR, unsigned int length)
+	{
+		double lines[MAX_FDN_LINES][MAX_DELAY_BLOCK];
+		double delays[MAX_DELAY_BLOCK];
+		double lpf_g = parameters.lpf_g;
+
+		// --- read all lines; modulation is max-down from the line delay
+		for (uint32_t k = 0; k < numLines; k++)
+		{
+			if (length == 1)
+			{
+				double delay = lineDelay_Samples[k];
+				if (modDepth_Samples > 0.0)
+					delay -= modDepth_Samples*bipolarToUnipolar(modLFOs[k].renderAudioOutput().normalOutput);
+				lines[k][0] = lineBuffers[k].readBuffer(delay);
+			}
+			else if (modDepth_Samples > 0.0)
+			{
+				modLFOs[k].renderAudioBlock(delays, nullptr, length);
+				for (unsigned int i = 0; i < length; i++)
+					delays[i] = lineDelay_Samples[k] - modDepth_Samples*bipolarToUnipolar(delays[i]);
+				lineBuffers[k].readBlock(delays, lines[k], length);
+			}
+			else
+				lineBuffers[k].readBlock(lineDelay_Samples[k], lines[k], length);
+		}
+
+		// --- decay gains and damping LPFs: recursive in time, so the lines run as interleaved lanes
+		for (unsigned int i = 0; i < length; i++)
+		{
+			for (uint32_t k = 0; k < numLines; k++)
+			{
+				lpfState[k] = (1.0 - lpf_g)*lineGain[k] * lines[k][i] + lpf_g*lpfState[k];
+				lines[k][i] = lpfState[k];
+			}
+		}
+		for (uint32_t k = 0; k < numLines; k++)
+			checkFloatUnderflow(lpfState[k]);
+
+		// --- outputs: even lines LEFT, odd lines RIGHT, with alternating signs
+		double outputScale = 1.0 / sqrt((double)(numLines / 2));
+		for (unsigned int i = 0; i < length; i++)
+		{
+			outL[i] = 0.0;
+			outR[i] = 0.0;
+		}
+		for (uint32_t k = 0; k < numLines; k += 2)
+		{
+			double gain = (k / 2) % 2 == 0 ? outputScale : -outputScale;
+			for (unsigned int i = 0; i < length; i++)
+			{
+				outL[i] += gain*lines[k][i];
+				outR[i] += gain*lines[k + 1][i];
+			}
+		}
+
+		// --- feedback matrix
+		double mixScale = 1.0;
+		if (parameters.mixingMatrix == fdnMixingMatrix::kHadamard)
+		{
+			// --- fast Walsh-Hadamard transform: log2(N) stages of butterflies, normalized at the end
+			for (uint32_t h = 1; h < numLines; h *= 2)
+			{
+				for (uint32_t j = 0; j < numLines; j += 2 * h)
+				{
+					for (uint32_t k = j; k < j + h; k++)
+					{
+						double* a = lines[k];
+						double* b = lines[k + h];
+						for (unsigned int i = 0; i < length; i++)
+						{
+							double sum = a[i] + b[i];
+							b[i] = a[i] - b[i];
+							a[i] = sum;
+						}
+					}
+				}
+			}
+			mixScale = 1.0 / sqrt((double)numLines);
+		}
+		else
+		{
+			// --- Householder reflection: x - (2/N) * sum(x)
+			double sum[MAX_DELAY_BLOCK];
+			for (unsigned int i = 0; i < length; i++)
+				sum[i] = 0.0;
+			for (uint32_t k = 0; k < numLines; k++)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					sum[i] += lines[k][i];
+			}
+			double reflect = 2.0 / numLines;
+			for (uint32_t k = 0; k < numLines; k++)
+			{
+				for (unsigned int i = 0; i < length; i++)
+					lines[k][i] -= reflect*sum[i];
+			}
+		}
+
+		// --- add the input with alternating signs and write all lines
+		for (uint32_t k = 0; k < numLines; k++)
+		{
+			double inputGain = k % 2 == 0 ? 1.0 : -1.0;
+			for (unsigned int i = 0; i < length; i++)
+				lines[k][i] = mixScale*lines[k][i] + inputGain*input[i];
+			lineBuffers[k].writeBlock(lines[k], length);
+		}
+	}
+
+	/** longest chunk in which no line reads a sample written in the same chunk */
+	unsigned int getMaxChunkLength()
+	{
+		unsigned int length = MAX_DELAY_BLOCK;
+		for (uint32_t k = 0; k < numLines; k++)
+		{
+			unsigned int lineLength = (unsigned int)(lineDelay_Samples[k] - modDepth_Samples);
+			if (lineLength < length) length = lineLength;
+		}
+		return length > 0 ? length : 1;
+	}
+
+	/** smallest prime >= value */
+	static double findNextPrime(unsigned int value)
+	{
+		for (unsigned int n = value > 2 ? value : 2; ; n++)
+		{
+			bool isPrime = true;
+			for (unsigned int d = 2; d*d <= n; d++)
+			{
+				if (n % d == 0)
+				{
+					isPrime = false;
+					break;
+				}
+			}
+			if (isPrime)
+				return (double)n;
+		}
+	}
+
+	FDNReverbParameters parameters;					///< object parameters
+
+	SimpleDelay preDelay;							///< pre delay object
+	DelayAPF diffusers[NUM_FDN_DIFFUSERS];			///< series input diffusers
+	double diffuserDelay_mSec[NUM_FDN_DIFFUSERS] = { 4.771, 3.595, 12.73, 9.307 };	///< diffuser delay times
+
+	// --- line state, structure-of-arrays: one entry per line
+	CircularBuffer<double> lineBuffers[MAX_FDN_LINES];		///< delay lines
+	LFO modLFOs[MAX_FDN_LINES];								///< line modulators
+	double lineDelay_Samples[MAX_FDN_LINES] = { 0.0 };		///< line delays
+	double lineGain[MAX_FDN_LINES] = { 0.0 };				///< per-line decay gains for the RT60
+	double lpfState[MAX_FDN_LINES] = { 0.0 };				///< damping LPF states
+	uint32_t numLines = 8;									///< active lines
+	double modDepth_Samples = 0.0;							///< modulation depth
+	DelayMemoryArena* delayMemoryArena = nullptr;			///< optional arena for the lines
+
+	TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
+
+	double sampleRate = 0.0;		///< current sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond
+};
+
+
+/**
+\class PeakLimiter
+\ingroup FX-Objects
+\brief
+The PeakLimiter object implements a simple peak limiter; it is really a simplified and hard-wired
+versio of the DynamicsProcessor
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setThreshold_dB(double _threshold_dB) to adjust the limiter threshold
+- setMakeUpGain_dB(double _makeUpGain_dB) to adjust the makeup gain
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct PhaseShifterParameters
+class PeakLimiter : public IAudioSignalProcessor
 {
-	PhaseShifterParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	PhaseShifterParameters& operator=(const PhaseShifterParameters& params)
+public:
+	PeakLimiter() { setThreshold_dB(-3.0); }
+	~PeakLimiter() {}
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		if (this == &params)
-			return *this;
+		// --- init; true = analog time-constant
+		detector.setSampleRate(_sampleRate);
 
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth_Pct = params.lfoDepth_Pct;
-		intensity_Pct = params.intensity_Pct;
-		quadPhaseLFO = params.quadPhaseLFO;
-		return *this;
+		AudioDetectorParameters detectorParams = detector.getParameters();
+		detectorParams.detect_dB = true;
+		detectorParams.attackTime_mSec = 5.0;
+		detectorParams.releaseTime_mSec = 25.0;
+		detectorParams.clampToUnityMax = false;
+		detectorParams.detectMode = ENVELOPE_DETECT_MODE_PEAK;
+		detector.setParameters(detectorParams);
+
+		return true;
 	}
 
-	// --- individual parameters
-	double lfoRate_Hz = 0.0;	///< phaser LFO rate in Hz
-	double lfoDepth_Pct = 0.0;	///< phaser LFO depth in %
-	double intensity_Pct = 0.0;	///< phaser feedback in %
-	bool quadPhaseLFO = false;	///< quad phase LFO flag
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process audio: implement hard limiter */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
+	}
+
+	/** compute the gain reductino value based on detected value in dB */
+	double computeGain(double detect_dB)
+	{
+		double output_dB = 0.0;
+
+		// --- defaults - you can change these here
+		bool softknee = true;
+		double kneeWidth_dB = 10.0;
+
+		// --- hard knee
+		if (!softknee)
+		{
+			// --- below threshold, unity
+			if (detect_dB <= threshold_dB)
+				output_dB = detect_dB;
+			// --- above threshold, compress
+			else
+				output_dB = threshold_dB;
+		}
+		else
+		{
+			// --- calc gain with knee
+			// --- left side of knee, outside of width, unity gain zone
+			if (2.0*(detect_dB - threshold_dB) < -kneeWidth_dB)
+				output_dB = detect_dB;
+			// --- inside the knee,
+			else if (2.0*(fabs(detect_dB - threshold_dB)) <= kneeWidth_dB)
+				output_dB = detect_dB - pow((detect_dB - threshold_dB + (kneeWidth_dB / 2.0)), 2.0) / (2.0*kneeWidth_dB);
+			// --- right of knee, compression zone
+			else if (2.0*(detect_dB - threshold_dB) > kneeWidth_dB)
+				output_dB = threshold_dB;
+		}
+
+		// --- convert difference between threshold and detected to raw
+		return  pow(10.0, (output_dB - detect_dB) / 20.0);
+	}
+
+	/** adjust threshold in dB */
+	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
+
+	/** adjust makeup gain in dB*/
+	void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; }
+
+protected:
+	AudioDetector detector;		///< the detector object
+	double threshold_dB = 0.0;	///< stored threshold (dB)
+	double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
 };
 
-// --- constants for Phaser
-const unsigned int PHASER_STAGES = 6;
 
-// --- these are the ideal band definitions
-//const double apf0_minF = 16.0;
-//const double apf0_maxF = 1600.0;
-//
-//const double apf1_minF = 33.0;
-//const double apf1_maxF = 3300.0;
-//
-//const double apf2_minF = 48.0;
-//const double apf2_maxF = 4800.0;
-//
-//const double apf3_minF = 98.0;
-//const double apf3_maxF = 9800.0;
-//
-//const double apf4_minF = 160.0;
-//const double apf4_maxF = 16000.0;
-//
-//const double apf5_minF = 260.0;
-//const double apf5_maxF = 20480.0;
+/**
+\enum vaFilterAlgorithm
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the virtual analog filter algorithm
 
-// --- these are the exact values from the National Semiconductor Phaser design
-const double apf0_minF = 32.0;
-const double apf0_maxF = 1500.0;
+- enum class vaFilterAlgorithm { kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS, kSVF_Morph };
 
-const double apf1_minF = 68.0;
-const double apf1_maxF = 3400.0;
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class vaFilterAlgorithm {
+	kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS, kSVF_Morph
+}; // --- you will add more here...
 
-const double apf2_minF = 96.0;
-const double apf2_maxF = 4800.0;
 
-const double apf3_minF = 212.0;
-const double apf3_maxF = 10000.0;
+/**
+\struct ZVAFilterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the ZVAFilter object.
 
-const double apf4_minF = 320.0;
-const double apf4_maxF = 16000.0;
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct ZVAFilterParameters
+{
+	ZVAFilterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	ZVAFilterParameters& operator=(const ZVAFilterParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		filterAlgorithm = params.filterAlgorithm;
+		fc = params.fc;
+		Q = params.Q;
+		filterOutputGain_dB = params.filterOutputGain_dB;
+		enableGainComp = params.enableGainComp;
+		matchAnalogNyquistLPF = params.matchAnalogNyquistLPF;
+		selfOscillate = params.selfOscillate;
+		enableNLP = params.enableNLP;
+		modeMorph = params.modeMorph;
+		return *this;
+	}
+
+	// --- individual parameters
+	vaFilterAlgorithm filterAlgorithm = vaFilterAlgorithm::kSVF_LP;	///< va filter algorithm
+	double fc = 1000.0;						///< va filter fc
+	double Q = 0.707;						///< va filter Q
+	double filterOutputGain_dB = 0.0;		///< va filter gain (normally unused)
+	bool enableGainComp = false;			///< enable gain compensation (see book)
+	bool matchAnalogNyquistLPF = false;		///< match analog gain at Nyquist
+	bool selfOscillate = false;				///< enable selfOscillation
+	bool enableNLP = false;					///< enable non linear processing (use oversampling for best results)
+	double modeMorph = 0.0;					///< kSVF_Morph blend: 0.0 = LP, 0.5 = BP, 1.0 = HP
+};
+
+/**
+\struct ZVAFilterOutput
+\ingroup FX-Objects
+\brief
+Custom output structure for the ZVAFilter object; holds every response from a single state update.
+
+\version Revision : 1.0
+*/
+struct ZVAFilterOutput
+{
+	ZVAFilterOutput() {}
+
+	double lpf = 0.0;	///< low pass output (analog matched if matchAnalogNyquistLPF is set)
+	double hpf = 0.0;	///< high pass output
+	double bpf = 0.0;	///< band pass output (SVF only; 0.0 for 1st order types)
+	double bsf = 0.0;	///< band stop output (SVF only; 0.0 for 1st order types)
+	double apf = 0.0;	///< all pass output
+	double morph = 0.0;	///< LP-BP-HP blend set with ZVAFilterParameters::modeMorph (SVF only)
+};
 
-const double apf5_minF = 636.0;
-const double apf5_maxF = 20480.0;
 
 /**
-\class PhaseShifter
+\class ZVAFilter
 \ingroup FX-Objects
 \brief
-The PhaseShifter object implements a six-stage phaser.
-
+The ZVAFilter object implements multpile Zavalishin VA Filters.
 Audio I/O:
 - Processes mono input to mono output.
 
@@ -3553,4498 +8428,5455 @@ Control I/F:
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class PhaseShifter : public IAudioSignalProcessor
+class ZVAFilter : public IAudioSignalProcessor
 {
 public:
-	PhaseShifter(void) {
-		OscillatorParameters lfoparams = lfo.getParameters();
-		lfoparams.waveform = generatorWaveform::kTriangle;	// kTriangle LFO for phaser
-	//	lfoparams.waveform = generatorWaveform::kSin;		// kTriangle LFO for phaser
-		lfo.setParameters(lfoparams);
+	ZVAFilter() {}		/* C-TOR */
+	~ZVAFilter() {}		/* D-TOR */
 
-		AudioFilterParameters params = apf[0].getParameters();
-		params.algorithm = filterAlgorithm::kAPF1; // can also use 2nd order
-		// params.Q = 0.001; use low Q if using 2nd order APFs
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		integrator_z[0] = 0.0;
+		integrator_z[1] = 0.0;
 
-		for (uint32_t i = 0; i < PHASER_STAGES; i++)
+		// --- new sample rate invalidates coefficients; gains snap to target (no ramp from silence)
+		calculateFilterCoeffs();
+		calculateGainTargets();
+		outputGain = outputGainTarget;
+		inputGainComp = inputGainCompTarget;
+		gainRampCount = 0;
+
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ZVAFilterParameters custom data structure
+	*/
+	ZVAFilterParameters getParameters()
+	{
+		return zvaFilterParameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ZVAFilterParameters custom data structure
+	*/
+	void setParameters(const ZVAFilterParameters& params)
+	{
+		// --- filterAlgorithm is included since alpha differs for 1st order and SVF types;
+		//     fcModulated means the audio-rate fc has overwritten the coefficients
+		bool coeffsChanged = params.fc != zvaFilterParameters.fc ||
+			params.Q != zvaFilterParameters.Q ||
+			params.filterAlgorithm != zvaFilterParameters.filterAlgorithm ||
+			params.selfOscillate != zvaFilterParameters.selfOscillate ||
+			params.matchAnalogNyquistLPF != zvaFilterParameters.matchAnalogNyquistLPF ||
+			fcModulated;
+
+		bool gainChanged = params.filterOutputGain_dB != zvaFilterParameters.filterOutputGain_dB ||
+			params.enableGainComp != zvaFilterParameters.enableGainComp ||
+			params.Q != zvaFilterParameters.Q;
+
+		bool morphChanged = params.modeMorph != zvaFilterParameters.modeMorph;
+
+		zvaFilterParameters = params;
+
+		if (coeffsChanged)
+			calculateFilterCoeffs();
+
+		if (gainChanged)
+			calculateGainTargets();
+
+		if (morphChanged)
+			calculateMorphWeights();
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the VA filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- the gains are only recalculated when their parameters change; ramp towards the new values
+		if (gainRampCount > 0)
+			advanceGainRamp();
+
+		// --- with gain comp enabled, we reduce the input by
+		//     half the gain in dB at resonant peak (inputGainComp is 1.0 otherwise)
+		//     NOTE: you can change that logic in calculateGainTargets( )
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
+
+		xn *= inputGainComp;
+
+		// --- for 1st order filters:
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
 		{
-			apf[i].setParameters(params);
+			// --- create vn node
+			double vn = (xn - integrator_z[0])*alpha;
+
+			// --- form LP output
+			double lpf = ((xn - integrator_z[0])*alpha) + integrator_z[0];
+
+			// double sn = integrator_z[0];
+
+			// --- update memory
+			integrator_z[0] = vn + lpf;
+
+			// --- form the HPF = INPUT = LPF
+			double hpf = xn - lpf;
+
+			// --- form the APF = LPF - HPF
+			double apf = lpf - hpf;
+
+			// --- set the outputs
+			if (filterAlgorithm == vaFilterAlgorithm::kLPF1)
+			{
+				// --- this is a very close match as-is at Nyquist!
+				if (matchAnalogNyquistLPF)
+					return lpf + alpha*hpf;
+				else
+					return lpf;
+			}
+			else if (filterAlgorithm == vaFilterAlgorithm::kHPF1)
+				return hpf;
+			else if (filterAlgorithm == vaFilterAlgorithm::kAPF1)
+				return apf;
+
+			// --- unknown filter
+			return xn;
 		}
-	}	/* C-TOR */
 
-	~PhaseShifter(void) {}	/* D-TOR */
+		// --- form the HP output first
+		double hpf = alpha0*(xn - rho*integrator_z[0] - integrator_z[1]);
 
-public:
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+		// --- BPF Out
+		double bpf = alpha*hpf + integrator_z[0];
+		if (zvaFilterParameters.enableNLP)
+			bpf = softClipWaveShaper(bpf, 1.0);
+
+		// --- LPF Out
+		double lpf = alpha*bpf + integrator_z[1];
+
+		// --- BSF Out
+		double bsf = hpf + lpf;
+
+		// --- finite gain at Nyquist; slight error at VHF
+		double sn = integrator_z[0];
+
+		// update memory
+		integrator_z[0] = alpha*hpf + bpf;
+		integrator_z[1] = alpha*bpf + lpf;
+
+		// return our selected type
+		if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP)
+		{
+			if (matchAnalogNyquistLPF)
+				lpf += analogMatchSigma*(sn);
+			return outputGain*lpf;
+		}
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_HP)
+			return outputGain*hpf;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BP)
+			return outputGain*bpf;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BS)
+			return outputGain*bsf;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_Morph)
+		{
+			if (matchAnalogNyquistLPF)
+				lpf += analogMatchSigma*(sn);
+			return outputGain*(morphLPF*lpf + morphBPF*bpf + morphHPF*hpf);
+		}
+
+		// --- unknown filter
+		return outputGain*lpf;
+	}
+
+	/** process input x(n) through the VA filter and return all of the responses from the one state
+	    update, so mixing or crossfading responses only needs one filter per channel; the filterAlgorithm
+	    parameter only selects between the 1st order and SVF structures here */
+	/**
+	\param xn input
+	\return ZVAFilterOutput structure with the LP, HP, BP, BS, AP and morphed outputs
+	*/
+	ZVAFilterOutput processMultiOutput(double xn)
 	{
-		// --- reset LFO
-		lfo.reset(_sampleRate);
+		if (gainRampCount > 0)
+			advanceGainRamp();
 
-		// --- reset APFs
-		for (uint32_t i = 0; i < PHASER_STAGES; i++){
-			apf[i].reset(_sampleRate);
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		ZVAFilterOutput output;
+
+		xn *= inputGainComp;
+
+		// --- for 1st order filters: only LP, HP and AP exist
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			double vn = (xn - integrator_z[0])*alpha;
+			double lpf = vn + integrator_z[0];
+			integrator_z[0] = vn + lpf;
+
+			output.hpf = xn - lpf;
+			output.apf = lpf - output.hpf;
+			output.lpf = zvaFilterParameters.matchAnalogNyquistLPF ? lpf + alpha*output.hpf : lpf;
+			return output;
 		}
 
-		return true;
+		// --- SVF: same structure as processAudioSample( )
+		double hpf = alpha0*(xn - rho*integrator_z[0] - integrator_z[1]);
+		double bpf = alpha*hpf + integrator_z[0];
+		if (zvaFilterParameters.enableNLP)
+			bpf = softClipWaveShaper(bpf, 1.0);
+		double lpf = alpha*bpf + integrator_z[1];
+		double sn = integrator_z[0];
+
+		integrator_z[0] = alpha*hpf + bpf;
+		integrator_z[1] = alpha*bpf + lpf;
+
+		// --- BSF and APF are sums of the others: (s^2 + 1) and (s^2 - 2Rs + 1)
+		double bsf = hpf + lpf;
+		double apf = bsf - 2.0*dampingR*bpf;
+
+		if (zvaFilterParameters.matchAnalogNyquistLPF)
+			lpf += analogMatchSigma*(sn);
+
+		output.lpf = outputGain*lpf;
+		output.hpf = outputGain*hpf;
+		output.bpf = outputGain*bpf;
+		output.bsf = outputGain*bsf;
+		output.apf = outputGain*apf;
+		output.morph = morphLPF*output.lpf + morphBPF*output.bpf + morphHPF*output.hpf;
+		return output;
 	}
 
-	/** process autio through phaser */
+	/** process input x(n) with an audio-rate cutoff frequency; the coefficients are
+	    updated with fastTan( ) instead of going through setParameters( ) */
 	/**
 	\param xn input
+	\param modulatedFc the cutoff frequency for this sample, in Hz
 	\return the processed sample
 	*/
-	virtual double processAudioSample(double xn)
+	double processModulatedAudioSample(double xn, double modulatedFc)
 	{
-		SignalGenData lfoData = lfo.renderAudioOutput();
+		setModulatedFc(modulatedFc);
+		return processAudioSample(xn);
+	}
 
-		// --- create the bipolar modulator value
-		double lfoValue = lfoData.normalOutput;
-		if (parameters.quadPhaseLFO)
-			lfoValue = lfoData.quadPhaseOutput_pos;
+	/** process a block of samples; fcBuffer holds one cutoff frequency per sample
+	    or may be nullptr to use the parameter fc; input and output may be the same buffer */
+	/**
+	\param input input buffer
+	\param output output buffer
+	\param fcBuffer per-sample cutoff frequencies in Hz, or nullptr
+	\param blockSize number of samples to process
+	*/
+	void processAudioBlock(const double* input, double* output, const double* fcBuffer, unsigned int blockSize)
+	{
+		if (!fcBuffer)
+		{
+			for (unsigned int i = 0; i < blockSize; i++)
+				output[i] = processAudioSample(input[i]);
+			return;
+		}
+
+		for (unsigned int i = 0; i < blockSize; i++)
+			output[i] = processModulatedAudioSample(input[i], fcBuffer[i]);
+	}
+
+	/** set the cutoff frequency for audio-rate modulation without touching the parameter structure */
+	/**
+	\param modulatedFc the new cutoff frequency in Hz
+	*/
+	void setModulatedFc(double modulatedFc)
+	{
+		if (fcModulated && modulatedFc == lastModulatedFc)
+			return;
+
+		lastModulatedFc = modulatedFc;
+		fcModulated = true;
+
+		// --- keep the prewarp argument inside fastTan( )'s accurate range
+		boundValue(modulatedFc, 1.0, 0.48*sampleRate);
+		calculateCoeffsForG(fastTan(kPi*modulatedFc / sampleRate), modulatedFc);
+	}
+
+	/** copy the coefficients from another filter with the same parameters, so linked
+	    channels only calculate the modulated coefficients once */
+	/**
+	\param source the filter that calculated the coefficients
+	*/
+	void copyCoefficients(const ZVAFilter& source)
+	{
+		alpha0 = source.alpha0;
+		alpha = source.alpha;
+		rho = source.rho;
+		dampingR = source.dampingR;
+		analogMatchSigma = source.analogMatchSigma;
+		fcModulated = source.fcModulated;
+		lastModulatedFc = source.lastModulatedFc;
+	}
+
+	/** recalculate the filter coefficients*/
+	void calculateFilterCoeffs()
+	{
+		double fc = zvaFilterParameters.fc;
+
+		// --- normal Zavalishin SVF calculations here
+		//     prewarp the cutoff- these are bilinear-transform filters
+		double wd = kTwoPi*fc;
+		double T = 1.0 / sampleRate;
+		double wa = (2.0 / T)*tan(wd*T / 2.0);
+		double g = wa*T / 2.0;
+
+		calculateCoeffsForG(g, fc);
+		fcModulated = false;
+	}
+
+	/** recalculate the output gain and the gain compensation input scalar; these only depend on
+	    parameters so they live here rather than in processAudioSample( ) */
+	void calculateGainTargets()
+	{
+		outputGainTarget = dB2Raw(zvaFilterParameters.filterOutputGain_dB);
+
+		// --- with gain comp enabled, we reduce the input by half the gain in dB at resonant peak
+		inputGainCompTarget = 1.0;
+		if (zvaFilterParameters.enableGainComp)
+		{
+			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
+			if (peak_dB > 0.0)
+				inputGainCompTarget = dB2Raw(-peak_dB / 2.0);
+		}
+
+		// --- ramp to the new values
+		if (gainRampLength == 0)
+		{
+			outputGain = outputGainTarget;
+			inputGainComp = inputGainCompTarget;
+			gainRampCount = 0;
+			return;
+		}
+
+		outputGainInc = (outputGainTarget - outputGain) / (double)gainRampLength;
+		inputGainCompInc = (inputGainCompTarget - inputGainComp) / (double)gainRampLength;
+		gainRampCount = gainRampLength;
+	}
+
+	/** recalculate the kSVF_Morph blend weights: LP -> BP over [0.0, 0.5] and BP -> HP over [0.5, 1.0] */
+	void calculateMorphWeights()
+	{
+		double morph = zvaFilterParameters.modeMorph;
+		boundValue(morph, 0.0, 1.0);
+
+		if (morph <= 0.5)
+		{
+			morphLPF = 1.0 - 2.0*morph;
+			morphBPF = 2.0*morph;
+			morphHPF = 0.0;
+		}
+		else
+		{
+			morphLPF = 0.0;
+			morphBPF = 2.0 - 2.0*morph;
+			morphHPF = 2.0*morph - 1.0;
+		}
+	}
 
-		double depth = parameters.lfoDepth_Pct / 100.0;
-		double modulatorValue = lfoValue*depth;
+	/** set the length of the linear ramp applied to gain changes; 0 = no smoothing */
+	void setGainRampLength(unsigned int _gainRampLength) { gainRampLength = _gainRampLength; }
 
-		// --- calculate modulated values for each APF; note they have different ranges
-		AudioFilterParameters params = apf[0].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf0_minF, apf0_maxF);
-		apf[0].setParameters(params);
+	/** set beta value, for filters that aggregate 1st order VA sections*/
+	void setBeta(double _beta) { beta = _beta; }
 
-		params = apf[1].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf1_minF, apf1_maxF);
-		apf[1].setParameters(params);
+	/** get beta value,not used in book projects; for future use*/
+	double getBeta() { return beta; }
 
-		params = apf[2].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf2_minF, apf2_maxF);
-		apf[2].setParameters(params);
+protected:
+	ZVAFilterParameters zvaFilterParameters;	///< object parameters
+	double sampleRate = 44100.0;				///< current sample rate
 
-		params = apf[3].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf3_minF, apf3_maxF);
-		apf[3].setParameters(params);
+	// --- state storage
+	double integrator_z[2] = { 0.0, 0.0 };		///< state variables
 
-		params = apf[4].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf4_minF, apf4_maxF);
-		apf[4].setParameters(params);
+	// --- filter coefficients
+	double alpha0 = 0.0;		///< input scalar, correct delay-free loop
+	double alpha = 0.0;			///< alpha is (wcT/2)
+	double rho = 0.0;			///< p = 2R + g (feedback)
 
-		params = apf[5].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf5_minF, apf5_maxF);
-		apf[5].setParameters(params);
+	double beta = 0.0;			///< beta value, not used
 
-		// --- calculate gamma values
-		double gamma1 = apf[5].getG_value();
-		double gamma2 = apf[4].getG_value() * gamma1;
-		double gamma3 = apf[3].getG_value() * gamma2;
-		double gamma4 = apf[2].getG_value() * gamma3;
-		double gamma5 = apf[1].getG_value() * gamma4;
-		double gamma6 = apf[0].getG_value() * gamma5;
+	// --- for analog Nyquist matching
+	double analogMatchSigma = 0.0; ///< analog matching Sigma value (see book)
 
-		// --- set the alpha0 value
-		double K = parameters.intensity_Pct / 100.0;
-		double alpha0 = 1.0 / (1.0 + K*gamma6);
+	double dampingR = 0.0;		///< R = 1/2Q, the analog damping factor (for the APF output)
 
-		// --- create combined feedback
-		double Sn = gamma5*apf[0].getS_value() + gamma4*apf[1].getS_value() + gamma3*apf[2].getS_value() + gamma2*apf[3].getS_value() + gamma1*apf[4].getS_value() + apf[5].getS_value();
+	// --- kSVF_Morph blend weights
+	double morphLPF = 1.0;		///< LP weight
+	double morphBPF = 0.0;		///< BP weight
+	double morphHPF = 0.0;		///< HP weight
 
-		// --- form input to first APF
-		double u = alpha0*(xn + K*Sn);
+	// --- audio-rate fc modulation
+	bool fcModulated = false;		///< true if setModulatedFc( ) has overwritten the coefficients
+	double lastModulatedFc = 0.0;	///< last modulated fc, skips redundant updates
 
-		// --- cascade of APFs (could also nest these in one massive line of code)
-		double APF1 = apf[0].processAudioSample(u);
-		double APF2 = apf[1].processAudioSample(APF1);
-		double APF3 = apf[2].processAudioSample(APF2);
-		double APF4 = apf[3].processAudioSample(APF3);
-		double APF5 = apf[4].processAudioSample(APF4);
-		double APF6 = apf[5].processAudioSample(APF5);
+	// --- gains, recalculated with the parameters and ramped per sample
+	double outputGain = 1.0;			///< current output gain (raw)
+	double outputGainTarget = 1.0;		///< output gain at the end of the ramp
+	double outputGainInc = 0.0;			///< output gain ramp increment
+	double inputGainComp = 1.0;			///< current gain compensation input scalar (raw)
+	double inputGainCompTarget = 1.0;	///< gain compensation at the end of the ramp
+	double inputGainCompInc = 0.0;		///< gain compensation ramp increment
+	unsigned int gainRampLength = 64;	///< length of gain ramps in samples (~1 host block)
+	unsigned int gainRampCount = 0;		///< samples remaining in the current ramp
 
-		// --- sum with -3dB coefficients
-		//	double output = 0.707*xn + 0.707*APF6;
+	/** calculate the coefficients for a prewarped g = tan(wd*T/2) */
+	void calculateCoeffsForG(double g, double fc)
+	{
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
 
-		// --- sum with National Semiconductor design ratio:
-		//	   dry = 0.5, wet = 5.0
-		// double output = 0.5*xn + 5.0*APF6;
-		// double output = 0.25*xn + 2.5*APF6;
-		double output = 0.125*xn + 1.25*APF6;
+		// --- for 1st order filters:
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			// --- calculate alpha
+			alpha = g / (1.0 + g);
+		}
+		else // state variable variety
+		{
+			// --- note R is the traditional analog damping factor zeta
+			double R = zvaFilterParameters.selfOscillate ? 0.0 : 1.0 / (2.0*zvaFilterParameters.Q);
+			dampingR = R;
+			alpha0 = 1.0 / (1.0 + 2.0*R*g + g*g);
+			alpha = g;
+			rho = 2.0*R + g;
 
-		return output;
+			// --- sigma for analog matching version
+			double f_o = (sampleRate / 2.0) / fc;
+			analogMatchSigma = 1.0 / (alpha*f_o*f_o);
+		}
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return PhaseShifterParameters custom data structure
-	*/
-	PhaseShifterParameters getParameters() { return parameters; }
-
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param PhaseShifterParameters custom data structure
-	*/
-	void setParameters(const PhaseShifterParameters& params)
+	/** move the gains one sample along their ramps */
+	void advanceGainRamp()
 	{
-		// --- update LFO rate
-		if (params.lfoRate_Hz != parameters.lfoRate_Hz)
+		if (--gainRampCount == 0)
 		{
-			OscillatorParameters lfoparams = lfo.getParameters();
-			lfoparams.frequency_Hz = params.lfoRate_Hz;
-			lfo.setParameters(lfoparams);
+			// --- land exactly on target
+			outputGain = outputGainTarget;
+			inputGainComp = inputGainCompTarget;
+			return;
 		}
-
-		// --- save new
-		parameters = params;
+		outputGain += outputGainInc;
+		inputGainComp += inputGainCompInc;
 	}
-protected:
-	PhaseShifterParameters parameters;  ///< the object parameters
-	AudioFilter apf[PHASER_STAGES];		///< six APF objects
-	LFO lfo;							///< the one and only LFO
 };
 
 /**
-\struct SimpleLPFParameters
+\enum stereoLinkMode
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set the linked modulation mode of stereo objects; linked modes
+use one modulation source for all channels, driven by the summed (mid) or the largest input.
+
+- enum class stereoLinkMode { kUnlinked, kLinkedSum, kLinkedMax };
+*/
+enum class stereoLinkMode { kUnlinked, kLinkedSum, kLinkedMax };
+
+/**
+\struct EnvelopeFollowerParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the SimpleLPFP object. Used for reverb algorithms in book.
+Custom parameter structure for the EnvelopeFollower object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct SimpleLPFParameters
+struct EnvelopeFollowerParameters
 {
-	SimpleLPFParameters() {}
+	EnvelopeFollowerParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	SimpleLPFParameters& operator=(const SimpleLPFParameters& params)	// need this override for collections to work
+	EnvelopeFollowerParameters& operator=(const EnvelopeFollowerParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		g = params.g;
+		fc = params.fc;
+		Q = params.Q;
+		attackTime_mSec = params.attackTime_mSec;
+		releaseTime_mSec = params.releaseTime_mSec;
+		threshold_dB = params.threshold_dB;
+		sensitivity = params.sensitivity;
+		controlRateDivisor = params.controlRateDivisor;
+		linkMode = params.linkMode;
+
 		return *this;
 	}
 
 	// --- individual parameters
-	double g = 0.0; ///< simple LPF g value
+	double fc = 0.0;				///< filter fc
+	double Q = 0.707;				///< filter Q
+	double attackTime_mSec = 10.0;	///< detector attack time
+	double releaseTime_mSec = 10.0;	///< detector release time
+	double threshold_dB = 0.0;		///< detector threshold in dB
+	double sensitivity = 1.0;		///< detector sensitivity
+	unsigned int controlRateDivisor = 1; ///< detect and modulate every Nth sample, fc is ramped in between (1 = every sample)
+	stereoLinkMode linkMode = stereoLinkMode::kUnlinked; ///< StereoEnvelopeFollower only: shared detector input
 };
 
 /**
-\class SimpleLPF
+\class EnvelopeFollower
 \ingroup FX-Objects
 \brief
-The SimpleLPF object implements a first order one-pole LPF using one coefficient "g" value.
+The EnvelopeFollower object implements a traditional envelope follower effect modulating a LPR fc value
+using the strength of the detected input.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use SimpleLPFParameters structure to get/set object params.
+- Use EnvelopeFollowerParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class SimpleLPF : public IAudioSignalProcessor
+class EnvelopeFollower : public IAudioSignalProcessor
 {
 public:
-	SimpleLPF(void) {}	/* C-TOR */
-	~SimpleLPF(void) {}	/* D-TOR */
+	EnvelopeFollower() {
+		// --- setup the filter
+		ZVAFilterParameters filterParams;
+		filterParams.filterAlgorithm = vaFilterAlgorithm::kSVF_LP;
+		filterParams.fc = 1000.0;
+		filterParams.enableGainComp = true;
+		filterParams.enableNLP = true;
+		filterParams.matchAnalogNyquistLPF = true;
+		filter.setParameters(filterParams);
+
+		// --- setup the detector
+		AudioDetectorParameters adParams;
+		adParams.attackTime_mSec = -1.0;
+		adParams.releaseTime_mSec = -1.0;
+		adParams.detectMode = TLD_AUDIO_DETECT_MODE_RMS;
+		adParams.detect_dB = true;
+		adParams.clampToUnityMax = false;
+		detector.setParameters(adParams);
+
+	}		/* C-TOR */
+	~EnvelopeFollower() {}		/* D-TOR */
 
-public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		state = 0.0;
+		sampleRate = _sampleRate;
+		filter.reset(_sampleRate);
+
+		// --- the detector runs at the control rate
+		detector.reset(sampleRate / getControlRateDivisor());
+		resetControlRate();
 		return true;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return SimpleLPFParameters custom data structure
+	\return EnvelopeFollowerParameters custom data structure
 	*/
-	SimpleLPFParameters getParameters()
-	{
-		return simpleLPFParameters;
-	}
+	EnvelopeFollowerParameters getParameters() { return parameters; }
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param SimpleLPFParameters custom data structure
+	\param EnvelopeFollowerParameters custom data structure
 	*/
-	void setParameters(const SimpleLPFParameters& params)
+	void setParameters(const EnvelopeFollowerParameters& params)
 	{
-		simpleLPFParameters = params;
+		ZVAFilterParameters filterParams = filter.getParameters();
+		AudioDetectorParameters adParams = detector.getParameters();
+
+		if (params.fc != parameters.fc || params.Q != parameters.Q)
+		{
+			filterParams.fc = params.fc;
+			filterParams.Q = params.Q;
+			filter.setParameters(filterParams);
+		}
+		if (params.attackTime_mSec != parameters.attackTime_mSec ||
+			params.releaseTime_mSec != parameters.releaseTime_mSec)
+		{
+			adParams.attackTime_mSec = params.attackTime_mSec;
+			adParams.releaseTime_mSec = params.releaseTime_mSec;
+			detector.setParameters(adParams);
+		}
+		if (params.threshold_dB != parameters.threshold_dB)
+			threshValue = pow(10.0, params.threshold_dB / 20.0);
+
+		bool divisorChanged = params.controlRateDivisor != parameters.controlRateDivisor;
+
+		// --- save
+		parameters = params;
+
+		// --- detector time constants depend on the control rate
+		if (divisorChanged)
+		{
+			detector.reset(sampleRate / getControlRateDivisor());
+			resetControlRate();
+		}
 	}
 
-	/** process simple one pole FB back filter */
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the envelope follower to produce return value y(n) */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		double g = simpleLPFParameters.g;
-		double yn = (1.0 - g)*xn + g*state;
-		state = yn;
-		return yn;
+		// --- update with new modulated frequency and perform the filtering operation
+		return filter.processModulatedAudioSample(xn, renderModulatedFc(xn));
+	}
+
+	/** run the detector and the fc computer on the detector input; at control rate the
+	    detector sees the peak (PEAK mode) or the root mean square (MS and RMS modes, which
+	    square it back) of each control period and the new fc is reached with a linear ramp
+	    across the next period */
+	/**
+	\param detectorInput the input to track (normally the audio input)
+	\return the modulated fc for this sample period
+	*/
+	double renderModulatedFc(double detectorInput)
+	{
+		unsigned int divisor = getControlRateDivisor();
+		if (divisor == 1)
+		{
+			// --- detect the signal
+			double detect_dB = detector.processAudioSample(detectorInput);
+			envelope = pow(10.0, detect_dB / 20.0);
+			modulatedFc = calculateModulatedFc(envelope);
+			return modulatedFc;
+		}
+
+		// --- accumulate what the detect mode measures: the peak, or the sum of squares
+		bool peakDetect = detector.getDetectMode() == TLD_AUDIO_DETECT_MODE_PEAK;
+		if (peakDetect)
+			detectAccumulator = fmax(detectAccumulator, fabs(detectorInput));
+		else
+			detectAccumulator += detectorInput*detectorInput;
+
+		if (++controlCounter >= divisor)
+		{
+			double detectorValue = peakDetect ? detectAccumulator : sqrt(detectAccumulator / divisor);
+			double detect_dB = detector.processAudioSample(detectorValue);
+			envelope = pow(10.0, detect_dB / 20.0);
+			modulatedFcInc = (calculateModulatedFc(envelope) - modulatedFc) / divisor;
+
+			controlCounter = 0;
+			detectAccumulator = 0.0;
+		}
+
+		modulatedFc += modulatedFcInc;
+		return modulatedFc;
+	}
+
+	/** filter one sample at a modulated fc from renderModulatedFc( ) */
+	double processFilterSample(double xn, double fc) { return filter.processModulatedAudioSample(xn, fc); }
+
+	/** filter one sample with the coefficients of another follower's filter (linked operation) */
+	double processLinkedFilterSample(double xn, const EnvelopeFollower& source)
+	{
+		filter.copyCoefficients(source.filter);
+		return filter.processAudioSample(xn);
+	}
+
+	/** process a block of samples; the detected (linear) envelope is written into envelopeBuffer
+	    so that the caller can reuse it to drive other modulation targets; input and output may be the same buffer */
+	/**
+	\param input input buffer
+	\param output output buffer
+	\param blockSize number of samples to process
+	\param envelopeBuffer buffer of blockSize samples to receive the envelope, or nullptr
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize, double* envelopeBuffer = nullptr)
+	{
+		for (unsigned int i = 0; i < blockSize; i++)
+		{
+			output[i] = processAudioSample(input[i]);
+			if (envelopeBuffer)
+				envelopeBuffer[i] = envelope;
+		}
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** get the most recent detected envelope (linear, not dB) */
+	double getEnvelope() { return envelope; }
+
+	/** get the most recent modulated fc in Hz */
+	double getModulatedFc() { return modulatedFc; }
+
+protected:
+	EnvelopeFollowerParameters parameters; ///< object parameters
+
+	// --- 1 filter and 1 detector
+	ZVAFilter filter;		///< filter to modulate
+	AudioDetector detector; ///< detector to track input signal
+
+	double sampleRate = 44100.0;	///< current sample rate
+	double threshValue = 1.0;		///< cooked threshold_dB (raw)
+	double envelope = 0.0;			///< last detected envelope (raw)
+	double modulatedFc = 0.0;		///< current (smoothed) modulated fc
 
-private:
-	SimpleLPFParameters simpleLPFParameters;	///< object parameters
-	double state = 0.0;							///< single state (z^-1) register
-};
+	// --- control rate decimation
+	unsigned int controlCounter = 0;	///< samples accumulated since the last control tick
+	double detectAccumulator = 0.0;		///< peak or sum of squares over the control period
+	double modulatedFcInc = 0.0;		///< per-sample fc ramp increment
 
-/**
-\struct SimpleDelayParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the SimpleDelay object. Used for reverb algorithms in book.
+	/** safe control rate divisor */
+	unsigned int getControlRateDivisor() { return parameters.controlRateDivisor > 1 ? parameters.controlRateDivisor : 1; }
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct SimpleDelayParameters
-{
-	SimpleDelayParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	SimpleDelayParameters& operator=(const SimpleDelayParameters& params)	// need this override for collections to work
+	/** clear the decimation state */
+	void resetControlRate()
 	{
-		if (this == &params)
-			return *this;
-
-		delayTime_mSec = params.delayTime_mSec;
-		interpolate = params.interpolate;
-		delay_Samples = params.delay_Samples;
-		return *this;
+		controlCounter = 0;
+		detectAccumulator = 0.0;
+		modulatedFcInc = 0.0;
+		modulatedFc = parameters.fc;
 	}
 
-	// --- individual parameters
-	double delayTime_mSec = 0.0;	///< delay tine in mSec
-	bool interpolate = false;		///< interpolation flag (diagnostics usually)
+	/** the fc computer: map the linear envelope to the modulated fc */
+	double calculateModulatedFc(double detectValue)
+	{
+		double deltaValue = detectValue - threshValue;
 
-	// --- outbound parameters
-	double delay_Samples = 0.0;		///< current delay in samples; other objects may need to access this information
+		// --- if above the threshold, modulate the filter fc
+		if (deltaValue > 0.0)
+		{
+			// --- best results are with linear values when detector is in dB mode
+			double modulatorValue = (deltaValue * parameters.sensitivity);
+
+			// --- calculate modulated frequency
+			return doUnipolarModulationFromMin(modulatorValue, parameters.fc, kMaxFilterFrequency);
+		}
+
+		return parameters.fc;
+	}
 };
 
 /**
-\class SimpleDelay
+\class StereoEnvelopeFollower
 \ingroup FX-Objects
 \brief
-The SimpleDelay object implements a basic delay line without feedback.
+The StereoEnvelopeFollower object runs an EnvelopeFollower per channel with an optional linked mode:
+one detector tracks the summed or largest input and its modulated fc and filter coefficients are
+shared by both channels, so the modulation cost does not scale with the channel count.
 
 Audio I/O:
-- Processes mono input to mono output.
+- Processes stereo input to stereo output (mono input is processed by the left follower).
 
 Control I/F:
-- Use SimpleDelayParameters structure to get/set object params.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
+- Use EnvelopeFollowerParameters structure to get/set object params; linkMode selects the mode.
 */
-class SimpleDelay : public IAudioSignalProcessor
+class StereoEnvelopeFollower : public IAudioSignalProcessor
 {
 public:
-	SimpleDelay(void) {}	/* C-TOR */
-	~SimpleDelay(void) {}	/* D-TOR */
+	StereoEnvelopeFollower() {}		/* C-TOR */
+	~StereoEnvelopeFollower() {}	/* D-TOR */
 
-public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- if sample rate did not change
-		if (sampleRate == _sampleRate)
-		{
-			// --- just flush buffer and return
-			delayBuffer.flushBuffer();
-			return true;
-		}
-
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffer(_sampleRate, bufferLength_mSec);
-
+		for (unsigned int i = 0; i < NUM_CHANNELS; i++)
+			followers[i].reset(_sampleRate);
 		return true;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return SimpleDelayParameters custom data structure
+	\return EnvelopeFollowerParameters custom data structure
 	*/
-	SimpleDelayParameters getParameters()
-	{
-		return simpleDelayParameters;
-	}
+	EnvelopeFollowerParameters getParameters() { return followers[0].getParameters(); }
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param SimpleDelayParameters custom data structure
+	\param EnvelopeFollowerParameters custom data structure
 	*/
-	void setParameters(const SimpleDelayParameters& params)
+	void setParameters(const EnvelopeFollowerParameters& params)
 	{
-		simpleDelayParameters = params;
-		simpleDelayParameters.delay_Samples = simpleDelayParameters.delayTime_mSec*(samplesPerMSec);
-		delayBuffer.setInterpolate(simpleDelayParameters.interpolate);
+		for (unsigned int i = 0; i < NUM_CHANNELS; i++)
+			followers[i].setParameters(params);
 	}
 
-	/** process MONO audio delay */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- read delay
-		if (simpleDelayParameters.delay_Samples == 0)
-			return xn;
-
-		double yn = delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
-
-		// --- write to delay buffer
-		delayBuffer.writeBuffer(xn);
-
-		// --- done
-		return yn;
-	}
+	/** process mono input through the left follower */
+	virtual double processAudioSample(double xn) { return followers[0].processAudioSample(xn); }
 
-	/** reset members to initialized state */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** return true: this object processes frames */
+	virtual bool canProcessAudioFrame() { return true; }
 
-	/** create a new delay buffer */
-	void createDelayBuffer(double _sampleRate, double _bufferLength_mSec)
+	/** process a stereo frame */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
 	{
-		// --- store for math
-		bufferLength_mSec = _bufferLength_mSec;
-		sampleRate = _sampleRate;
-		samplesPerMSec = sampleRate / 1000.0;
-
-		// --- total buffer length including fractional part
-		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
 
-		// --- create new buffer
-		delayBuffer.createCircularBuffer(bufferLength);
-	}
+		// --- mono in: left follower only, copied to any other outputs
+		if (inputChannels == 1)
+		{
+			outputFrame[0] = (float)followers[0].processAudioSample(inputFrame[0]);
+			for (uint32_t i = 1; i < outputChannels && i < NUM_CHANNELS; i++)
+				outputFrame[i] = outputFrame[0];
+			return true;
+		}
 
-	/** read delay at current location */
-	double readDelay()
-	{
-		// --- simple read
-		return delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
-	}
+		double xnL = inputFrame[0];
+		double xnR = inputFrame[1];
+		double ynL = 0.0;
+		double ynR = 0.0;
 
-	/** read delay at current location */
-	double readDelayAtTime_mSec(double _delay_mSec)
-	{
-		// --- calculate total delay time in samples + fraction
-		double _delay_Samples = _delay_mSec*(samplesPerMSec);
+		stereoLinkMode linkMode = followers[0].getParameters().linkMode;
+		if (linkMode == stereoLinkMode::kUnlinked)
+		{
+			ynL = followers[0].processAudioSample(xnL);
+			ynR = followers[1].processAudioSample(xnR);
+		}
+		else
+		{
+			// --- one detector for both channels; the detector rectifies so the sign does not matter
+			double detectorInput = linkMode == stereoLinkMode::kLinkedSum ? 0.5*(xnL + xnR) : fmax(fabs(xnL), fabs(xnR));
 
-		// --- simple read
-		return delayBuffer.readBuffer(_delay_Samples);
-	}
+			double fc = followers[0].renderModulatedFc(detectorInput);
+			ynL = followers[0].processFilterSample(xnL, fc);
+			ynR = followers[1].processLinkedFilterSample(xnR, followers[0]);
+		}
 
-	/** read delay at a percentage of total length */
-	double readDelayAtPercentage(double delayPercent)
-	{
-		// --- simple read
-		return delayBuffer.readBuffer((delayPercent / 100.0)*simpleDelayParameters.delay_Samples);
-	}
+		outputFrame[0] = (float)ynL;
+		if (outputChannels > 1)
+			outputFrame[1] = (float)ynR;
 
-	/** write a new value into the delay */
-	void writeDelay(double xn)
-	{
-		// --- simple write
-		delayBuffer.writeBuffer(xn);
+		return true;
 	}
 
-private:
-	SimpleDelayParameters simpleDelayParameters; ///< object parameters
+protected:
+	EnvelopeFollower followers[NUM_CHANNELS]; ///< one follower per channel; the left one is the master in linked modes
+};
 
-	double sampleRate = 0.0;		///< sample rate
-	double samplesPerMSec = 0.0;	///< samples per millisecond (for arbitrary access)
-	double bufferLength_mSec = 0.0; ///< total buffer lenth in mSec
-	unsigned int bufferLength = 0;	///< buffer length in samples
+/**
+\enum distortionModel
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the waveshaper model for the Triode objects
 
-	// --- delay buffer of doubles
-	CircularBuffer<double> delayBuffer; ///< circular buffer for delay
-};
+- enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
 
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
 
 /**
-\struct CombFilterParameters
+\struct TriodeClassAParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the CombFilter object. Used for reverb algorithms in book.
+Custom parameter structure for the TriodeClassA object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct CombFilterParameters
+struct TriodeClassAParameters
 {
-	CombFilterParameters() {}
+	TriodeClassAParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	CombFilterParameters& operator=(const CombFilterParameters& params)	// need this override for collections to work
+	TriodeClassAParameters& operator=(const TriodeClassAParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		delayTime_mSec = params.delayTime_mSec;
-		RT60Time_mSec = params.RT60Time_mSec;
-		enableLPF = params.enableLPF;
-		lpf_g = params.lpf_g;
-		interpolate = params.interpolate;
+		waveshaper = params.waveshaper;
+		saturation = params.saturation;
+		asymmetry = params.asymmetry;
+		outputGain = params.outputGain;
+
+		invertOutput = params.invertOutput;
+		enableHPF = params.enableHPF;
+		enableLSF = params.enableLSF;
+
+		hpf_Fc = params.hpf_Fc;
+		lsf_Fshelf = params.lsf_Fshelf;
+		lsf_BoostCut_dB = params.lsf_BoostCut_dB;
+
 		return *this;
 	}
 
 	// --- individual parameters
-	double delayTime_mSec = 0.0;	///< delay time in mSec
-	double RT60Time_mSec = 0.0;		///< RT 60 time ini mSec
-	bool enableLPF = false;			///< enable LPF flag
-	double lpf_g = 0.0;				///< gain value for LPF (if enabled)
-	bool interpolate = false;		///< interpolation flag (diagnostics)
-};
+	distortionModel waveshaper = distortionModel::kSoftClip; ///< waveshaper
+
+	double saturation = 1.0;	///< saturation level
+	double asymmetry = 0.0;		///< asymmetry level
+	double outputGain = 1.0;	///< outputGain level
+
+	bool invertOutput = true;	///< invertOutput - triodes invert output
+	bool enableHPF = true;		///< HPF simulates DC blocking cap on output
+	bool enableLSF = false;		///< LSF simulates shelf due to cathode self biasing
 
+	double hpf_Fc = 1.0;		///< fc of DC blocking cap
+	double lsf_Fshelf = 80.0;	///< shelf fc from self bias cap
+	double lsf_BoostCut_dB = 0.0;///< boost/cut due to cathode self biasing
+};
 
 /**
-\class CombFilter
+\class TriodeClassA
 \ingroup FX-Objects
 \brief
-The CombFilter object implements a comb filter with optional LPF in feedback loop. Used for reverb algorithms in book.
+The TriodeClassA object simulates a triode in class A configuration. This is a very simple and basic simulation
+and a starting point for other designs; it is not intended to be a full-fledged triode simulator.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use CombFilterParameters structure to get/set object params.
+- Use TriodeClassAParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class CombFilter : public IAudioSignalProcessor
+class TriodeClassA : public IAudioSignalProcessor
 {
 public:
-	CombFilter(void) {}		/* C-TOR */
-	~CombFilter(void) {}	/* D-TOR */
+	TriodeClassA() {
+		AudioFilterParameters params;
+		params.algorithm = filterAlgorithm::kHPF1;
+		params.fc = parameters.hpf_Fc;
+		outputHPF.setParameters(params);
+
+		params.algorithm = filterAlgorithm::kLowShelf;
+		params.fc = parameters.lsf_Fshelf;
+		params.boostCut_dB = parameters.lsf_BoostCut_dB;
+		outputLSF.setParameters(params);
+	}		/* C-TOR */
+	~TriodeClassA() {}		/* D-TOR */
 
-public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- flush
-		lpf_state = 0.0;
-
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffer(sampleRate, bufferLength_mSec);
+		outputHPF.reset(_sampleRate);
+		outputLSF.reset(_sampleRate);
 
+		// ---
 		return true;
 	}
 
-	/** process CombFilter */
+	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\param xn input
-	\return the processed sample
+	\return TriodeClassAParameters custom data structure
 	*/
-	virtual double processAudioSample(double xn)
-	{
-		double yn = delay.readDelay();
-		double input = 0.0;
+	TriodeClassAParameters getParameters() { return parameters; }
 
-		// --- form input & write
-		if (combFilterParameters.enableLPF)
-		{
-			// --- apply simple 1st order pole LPF
-			double g2 = lpf_g*(1.0 - comb_g); // see book for equation 11.27 (old book)
-			double filteredSignal = yn + g2*lpf_state;
-			input = xn + comb_g*(filteredSignal);
-			lpf_state = filteredSignal;
-		}
-		else
-		{
-			input = xn + comb_g*yn;
-		}
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param TriodeClassAParameters custom data structure
+	*/
+	void setParameters(const TriodeClassAParameters& params)
+	{
+		parameters = params;
 
-		delay.writeDelay(input);
+		AudioFilterParameters filterParams;
+		filterParams.algorithm = filterAlgorithm::kHPF1;
+		filterParams.fc = parameters.hpf_Fc;
+		outputHPF.setParameters(filterParams);
 
-		// --- done
-		return yn;
+		filterParams.algorithm = filterAlgorithm::kLowShelf;
+		filterParams.fc = parameters.lsf_Fshelf;
+		filterParams.boostCut_dB = parameters.lsf_BoostCut_dB;
+		outputLSF.setParameters(filterParams);
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** get parameters: note use of custom structure for passing param data */
+	/** do the triode simulation to process one input to one output*/
 	/**
-	\return CombFilterParameters custom data structure
+	\param xn input
+	\return the processed sample
 	*/
-	CombFilterParameters getParameters()
+	virtual double processAudioSample(double xn)
 	{
-		return combFilterParameters;
-	}
+		// --- perform waveshaping
+		double output = 0.0;
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param CombFilterParameters custom data structure
-	*/
-	void setParameters(const CombFilterParameters& params)
-	{
-		combFilterParameters = params;
+		if (parameters.waveshaper == distortionModel::kSoftClip)
+			output = softClipWaveShaper(xn, parameters.saturation);
+		else if (parameters.waveshaper == distortionModel::kArcTan)
+			output = atanWaveShaper(xn, parameters.saturation);
+		else if (parameters.waveshaper == distortionModel::kFuzzAsym)
+			output = fuzzExp1WaveShaper(xn, parameters.saturation, parameters.asymmetry);
 
-		// --- update the delay line parameters first
-		SimpleDelayParameters delayParams = delay.getParameters();
-		delayParams.delayTime_mSec = combFilterParameters.delayTime_mSec;
-		delayParams.interpolate = combFilterParameters.interpolate;
-		delay.setParameters(delayParams); // this will set the delay time in samples
+		// --- inversion, normal for plate of class A triode
+		if (parameters.invertOutput)
+			output *= -1.0;
 
-										  // --- calculate g with RT60 time (requires updated delay above^^)
-		double exponent = -3.0*delayParams.delay_Samples*(1.0 / sampleRate);
-		double rt60_mSec = combFilterParameters.RT60Time_mSec / 1000.0; // RT is in mSec!
-		comb_g = pow(10.0, exponent / rt60_mSec);
+		// --- Output (plate) capacitor = HPF, remove DC offset
+		if (parameters.enableHPF)
+			output = outputHPF.processAudioSample(output);
 
-		// --- set LPF g
-		lpf_g = combFilterParameters.lpf_g;
-	}
+		// --- if cathode resistor bypass, will create low shelf
+		if (parameters.enableLSF)
+			output = outputLSF.processAudioSample(output);
 
-	/** create new buffers */
-	void createDelayBuffer(double _sampleRate, double delay_mSec)
-	{
-		sampleRate = _sampleRate;
-		bufferLength_mSec = delay_mSec;
+		// --- final resistor divider/potentiometer
+		output *= parameters.outputGain;
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		delay.createDelayBuffer(_sampleRate, delay_mSec);
+		return output;
 	}
 
-private:
-	CombFilterParameters combFilterParameters; ///< object parameters
-	double sampleRate = 0.0;	///< sample rate
-	double comb_g = 0.0;		///< g value for comb filter (feedback, not %)
-	double bufferLength_mSec = 0.0; ///< total buffer length
-
-	// --- LPF support
-	double lpf_g = 0.0;		///< LPF g value
-	double lpf_state = 0.0; ///< state register for LPF (z^-1)
-
-	// --- delay buffer of doubles
-	SimpleDelay delay;		///< delay for comb filter
+protected:
+	TriodeClassAParameters parameters;	///< object parameters
+	AudioFilter outputHPF;				///< HPF to simulate output DC blocking cap
+	AudioFilter outputLSF;				///< LSF to simulate shelf caused by cathode self-biasing cap
 };
 
+const unsigned int NUM_TUBES = 4;
+
 /**
-\struct DelayAPFParameters
+\struct ClassATubePreParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the DelayAPF object. Used for reverb algorithms in book.
+Custom parameter structure for the ClassATubePre object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct DelayAPFParameters
+struct ClassATubePreParameters
 {
-	DelayAPFParameters() {}
+	ClassATubePreParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	DelayAPFParameters& operator=(const DelayAPFParameters& params)	// need this override for collections to work
+	ClassATubePreParameters& operator=(const ClassATubePreParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		delayTime_mSec = params.delayTime_mSec;
-		apf_g = params.apf_g;
-		enableLPF = params.enableLPF;
-		lpf_g = params.lpf_g;
-		interpolate = params.interpolate;
-		enableLFO = params.enableLFO;
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth = params.lfoDepth;
-		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+		inputLevel_dB = params.inputLevel_dB;
+		saturation = params.saturation;
+		asymmetry = params.asymmetry;
+		outputLevel_dB = params.outputLevel_dB;
+
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+
 		return *this;
 	}
 
 	// --- individual parameters
-	double delayTime_mSec = 0.0;	///< APF delay time
-	double apf_g = 0.0;				///< APF g coefficient
-	bool enableLPF = false;			///< flag to enable LPF in structure
-	double lpf_g = 0.0;				///< LPF g coefficient (if enabled)
-	bool interpolate = false;		///< interpolate flag (diagnostics)
-	bool enableLFO = false;			///< flag to enable LFO
-	double lfoRate_Hz = 0.0;		///< LFO rate in Hz, if enabled
-	double lfoDepth = 0.0;			///< LFO deoth (not in %) if enabled
-	double lfoMaxModulation_mSec = 0.0;	///< LFO maximum modulation time in mSec
+	double inputLevel_dB = 0.0;		///< input level in dB
+	double saturation = 0.0;		///< input level in dB
+	double asymmetry = 0.0;			///< input level in dB
+	double outputLevel_dB = 0.0;	///< input level in dB
+
+	// --- shelving filter params
+	double lowShelf_fc = 0.0;			///< LSF shelf frequency
+	double lowShelfBoostCut_dB = 0.0;	///< LSF shelf gain/cut
+	double highShelf_fc = 0.0;			///< HSF shelf frequency
+	double highShelfBoostCut_dB = 0.0;	///< HSF shelf frequency
 
 };
 
 /**
-\class DelayAPF
+\class ClassATubePre
 \ingroup FX-Objects
 \brief
-The DelayAPF object implements a delaying APF with optional LPF and optional modulated delay time with LFO.
+The ClassATubePre object implements a simple cascade of four (4) triode tube models.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use DelayAPFParameters structure to get/set object params.
+- Use ClassATubePreParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class DelayAPF : public IAudioSignalProcessor
+class ClassATubePre : public IAudioSignalProcessor
 {
 public:
-	DelayAPF(void) {}	/* C-TOR */
-	~DelayAPF(void) {}	/* D-TOR */
+	ClassATubePre() {}		/* C-TOR */
+	~ClassATubePre() {}		/* D-TOR */
 
-public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- reset children
-		modLFO.reset(_sampleRate);
+		TriodeClassAParameters tubeParams = triodes[0].getParameters();
+		tubeParams.invertOutput = true;
+		tubeParams.enableHPF = true; // remove DC offsets
+		tubeParams.outputGain = 1.0;
+		tubeParams.saturation = 1.0;
+		tubeParams.asymmetry = 0.0;
+		tubeParams.enableLSF = true;
+		tubeParams.lsf_Fshelf = 88.0;
+		tubeParams.lsf_BoostCut_dB = -12.0;
+		tubeParams.waveshaper = distortionModel::kFuzzAsym;
 
-		// --- flush
-		lpf_state = 0.0;
+		for (uint32_t i = 0; i < NUM_TUBES; i++)
+		{
+			triodes[i].reset(_sampleRate);
+			triodes[i].setParameters(tubeParams);
+		}
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffer(sampleRate, bufferLength_mSec);
+		shelvingFilter.reset(_sampleRate);
 
 		return true;
 	}
 
-	/** process one input sample through object */
+	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\param xn input
-	\return the processed sample
+	\return ClassATubePreParameters custom data structure
 	*/
-	virtual double processAudioSample(double xn)
-	{
-		SimpleDelayParameters delayParams = delay.getParameters();
-		if (delayParams.delay_Samples == 0)
-			return xn;
-
-		// --- delay line output
-		double wnD = 0.0;
-		double apf_g = delayAPFParameters.apf_g;
-		double lpf_g = delayAPFParameters.lpf_g;
-		double lfoDepth = delayAPFParameters.lfoDepth;
-
-		// --- for modulated APFs
-		if (delayAPFParameters.enableLFO)
-		{
-			SignalGenData lfoOutput = modLFO.renderAudioOutput();
-			double maxDelay = delayParams.delayTime_mSec;
-			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
-			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
-
-			// --- calc max-down modulated value with unipolar converted LFO output
-			//     NOTE: LFO output is scaled by lfoDepth
-			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
-				minDelay, maxDelay);
-
-			// --- read modulated value to get w(n-D);
-			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
-		}
-		else
-			// --- read the delay line to get w(n-D)
-			wnD = delay.readDelay();
-
-		if (delayAPFParameters.enableLPF)
-		{
-			// --- apply simple 1st order pole LPF, overwrite wnD
-			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
-			lpf_state = wnD;
-		}
+	ClassATubePreParameters getParameters() { return parameters; }
 
-		// form w(n) = x(n) + gw(n-D)
-		double wn = xn + apf_g*wnD;
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ClassATubePreParameters custom data structure
+	*/
+	void setParameters(const ClassATubePreParameters& params)
+	{
+		// --- check for re-calc
+		if (params.inputLevel_dB != parameters.inputLevel_dB)
+			inputLevel = pow(10.0, params.inputLevel_dB / 20.0);
+		if (params.outputLevel_dB != parameters.outputLevel_dB)
+			outputLevel = pow(10.0, params.outputLevel_dB / 20.0);
 
-		// form y(n) = -gw(n) + w(n-D)
-		double yn = -apf_g*wn + wnD;
+		// --- store
+		parameters = params;
 
-		// underflow check
-		checkFloatUnderflow(yn);
+		// --- shelving filter update
+		TwoBandShelvingFilterParameters sfParams = shelvingFilter.getParameters();
+		sfParams.lowShelf_fc = parameters.lowShelf_fc;
+		sfParams.lowShelfBoostCut_dB = parameters.lowShelfBoostCut_dB;
+		sfParams.highShelf_fc = parameters.highShelf_fc;
+		sfParams.highShelfBoostCut_dB = parameters.highShelfBoostCut_dB;
+		shelvingFilter.setParameters(sfParams);
 
-		// write delay line
-		delay.writeDelay(wn);
+		// --- triode updates
+		TriodeClassAParameters tubeParams = triodes[0].getParameters();
+		tubeParams.saturation = parameters.saturation;
+		tubeParams.asymmetry = parameters.asymmetry;
 
-		return yn;
+		for (uint32_t i = 0; i < NUM_TUBES; i++)
+			triodes[i].setParameters(tubeParams);
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return DelayAPFParameters custom data structure
-	*/
-	DelayAPFParameters getParameters()
-	{
-		return delayAPFParameters;
-	}
-
-	/** set parameters: note use of custom structure for passing param data */
+	/** process the input through the four tube models in series */
 	/**
-	\param DelayAPFParameters custom data structure
+	\param xn input
+	\return the processed sample
 	*/
-	void setParameters(const DelayAPFParameters& params)
+	virtual double processAudioSample(double xn)
 	{
-		delayAPFParameters = params;
-
-		// --- update delay line
-		SimpleDelayParameters delayParams = delay.getParameters();
-		delayParams.delayTime_mSec = delayAPFParameters.delayTime_mSec;
-		delay.setParameters(delayParams);
-	}
+		double output1 = triodes[0].processAudioSample(xn*inputLevel);
+		double output2 = triodes[1].processAudioSample(output1);
+		double output3 = triodes[2].processAudioSample(output2);
 
-	/** create the delay buffer in mSec */
-	void createDelayBuffer(double _sampleRate, double delay_mSec)
-	{
-		sampleRate = _sampleRate;
-		bufferLength_mSec = delay_mSec;
+		// --- filter stage is between 3 and 4
+		double outputEQ = shelvingFilter.processAudioSample(output3);
+		double output4 = triodes[3].processAudioSample(outputEQ);
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		delay.createDelayBuffer(_sampleRate, delay_mSec);
+		return output4*outputLevel;
 	}
 
 protected:
-	// --- component parameters
-	DelayAPFParameters delayAPFParameters;	///< obeject parameters
-	double sampleRate = 0.0;				///< current sample rate
-	double bufferLength_mSec = 0.0;			///< total buffer length in mSec
-
-	// --- delay buffer of doubles
-	SimpleDelay delay;						///< delay
-
-	// --- optional LFO
-	LFO modLFO;								///< LFO
+	ClassATubePreParameters parameters;		///< object parameters
+	TriodeClassA triodes[NUM_TUBES];		///< array of triode tube objects
+	TwoBandShelvingFilter shelvingFilter;	///< shelving filters
 
-	// --- LPF support
-	double lpf_state = 0.0;					///< LPF state register (z^-1)
+	double inputLevel = 1.0;	///< input level (not in dB)
+	double outputLevel = 1.0;	///< output level (not in dB)
 };
 
 
 /**
-\struct NestedDelayAPFParameters
+\struct BitCrusherParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the NestedDelayAPF object. Used for reverb algorithms in book.
+Custom parameter structure for the BitCrusher object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct NestedDelayAPFParameters
+struct BitCrusherParameters
 {
-	NestedDelayAPFParameters() {}
+	BitCrusherParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	NestedDelayAPFParameters& operator=(const NestedDelayAPFParameters& params)	// need this override for collections to work
+	BitCrusherParameters& operator=(const BitCrusherParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		outerAPFdelayTime_mSec = params.outerAPFdelayTime_mSec;
-		innerAPFdelayTime_mSec = params.innerAPFdelayTime_mSec;
-		outerAPF_g = params.outerAPF_g;
-		innerAPF_g = params.innerAPF_g;
-
-		// --- outer LFO
-		enableLFO = params.enableLFO;
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth = params.lfoDepth;
-		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+		quantizedBitDepth = params.quantizedBitDepth;
 
 		return *this;
 	}
 
-	// --- individual parameters
-	double outerAPFdelayTime_mSec = 0.0;	///< delay time for outer APF
-	double innerAPFdelayTime_mSec = 0.0;	///< delay time for inner APF
-	double outerAPF_g = 0.0;				///< g coefficient for outer APF
-	double innerAPF_g = 0.0;				///< g coefficient for inner APF
-
-	// --- this LFO belongs to the outer APF only
-	bool enableLFO = false;					///< flag to enable the modulated delay
-	double lfoRate_Hz = 0.0;				///< LFO rate in Hz (if enabled)
-	double lfoDepth = 1.0;					///< LFO depth (not in %) (if enabled)
-	double lfoMaxModulation_mSec = 0.0;		///< max modulation time if LFO is enabled
-
+	double quantizedBitDepth = 4.0; ///< bid depth of quantizer
 };
 
 /**
-\class NestedDelayAPF
+\class BitCrusher
 \ingroup FX-Objects
 \brief
-The NestedDelayAPF object implements a pair of nested Delaying APF structures. These are labled the
-outer and inner APFs. The outer APF's LPF and LFO may be optionally enabled. You might want
-to extend this object to enable and use the inner LPF and LFO as well.
+The BitCrusher object implements a quantizing bitcrusher algorithm.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use BiquadParameters structure to get/set object params.
+- Use BitCrusherParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class NestedDelayAPF : public DelayAPF
+class BitCrusher : public IAudioSignalProcessor
 {
 public:
-	NestedDelayAPF(void) { }	/* C-TOR */
-	~NestedDelayAPF(void) { }	/* D-TOR */
+	BitCrusher() {}		/* C-TOR */
+	~BitCrusher() {}		/* D-TOR */
 
-public:
 	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		// --- call base class reset first
-		DelayAPF::reset(_sampleRate);
-
-		// --- then do our stuff
-		nestedAPF.reset(_sampleRate);
-
-		return true;
-	}
-
-	/** process mono audio input */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- delay line output
-		double wnD = 0.0;
-
-		SimpleDelayParameters delayParams = delay.getParameters();
-		if (delayParams.delay_Samples == 0)
-			return xn;
-
-		double apf_g = delayAPFParameters.apf_g;
-		double lpf_g = delayAPFParameters.lpf_g;
-
-		// --- for modulated APFs
-		if (delayAPFParameters.enableLFO)
-		{
-			SignalGenData lfoOutput = modLFO.renderAudioOutput();
-			double maxDelay = delayParams.delayTime_mSec;
-			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
-			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
-			double lfoDepth = delayAPFParameters.lfoDepth;
-
-			// --- calc max-down modulated value with unipolar converted LFO output
-			//     NOTE: LFO output is scaled by lfoDepth
-			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
-				minDelay, maxDelay);
-
-			// --- read modulated value to get w(n-D);
-			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
-		}
-		else
-			// --- read the delay line to get w(n-D)
-			wnD = delay.readDelay();
-
-		if (delayAPFParameters.enableLPF)
-		{
-			// --- apply simple 1st order pole LPF, overwrite wnD
-			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
-			lpf_state = wnD;
-		}
-
-		// --- form w(n) = x(n) + gw(n-D)
-		double wn = xn + apf_g*wnD;
-
-		// --- process wn through inner APF
-		double ynInner = nestedAPF.processAudioSample(wn);
-
-		// --- form y(n) = -gw(n) + w(n-D)
-		double yn = -apf_g*wn + wnD;
-
-		// --- underflow check
-		checkFloatUnderflow(yn);
-
-		// --- write delay line
-		delay.writeDelay(ynInner);
-
-		return yn;
-	}
+	virtual bool reset(double _sampleRate){ return true; }
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return BiquadParameters custom data structure
+	\return BitCrusherParameters custom data structure
 	*/
-	NestedDelayAPFParameters getParameters() { return nestedAPFParameters; }
+	BitCrusherParameters getParameters() { return parameters; }
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param BiquadParameters custom data structure
+	\param BitCrusherParameters custom data structure
 	*/
-	void setParameters(const NestedDelayAPFParameters& params)
+	void setParameters(const BitCrusherParameters& params)
 	{
-		nestedAPFParameters = params;
-
-		DelayAPFParameters outerAPFParameters = DelayAPF::getParameters();
-		DelayAPFParameters innerAPFParameters = nestedAPF.getParameters();
-
-		// --- outer APF
-		outerAPFParameters.apf_g = nestedAPFParameters.outerAPF_g;
-		outerAPFParameters.delayTime_mSec = nestedAPFParameters.outerAPFdelayTime_mSec;
-
-		// --- LFO support
-		outerAPFParameters.enableLFO = nestedAPFParameters.enableLFO;
-		outerAPFParameters.lfoDepth = nestedAPFParameters.lfoDepth;
-		outerAPFParameters.lfoRate_Hz = nestedAPFParameters.lfoRate_Hz;
-		outerAPFParameters.lfoMaxModulation_mSec = nestedAPFParameters.lfoMaxModulation_mSec;
-
-		// --- inner APF
-		innerAPFParameters.apf_g = nestedAPFParameters.innerAPF_g;
-		innerAPFParameters.delayTime_mSec = nestedAPFParameters.innerAPFdelayTime_mSec;
+		// --- calculate and store
+		if (params.quantizedBitDepth != parameters.quantizedBitDepth)
+			QL = 2.0 / (pow(2.0, params.quantizedBitDepth) - 1.0);
 
-		DelayAPF::setParameters(outerAPFParameters);
-		nestedAPF.setParameters(innerAPFParameters);
+		parameters = params;
 	}
 
-	/** createDelayBuffers -- note there are two delay times here for inner and outer APFs*/
-	void createDelayBuffers(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec)
-	{
-		// --- base class
-		DelayAPF::createDelayBuffer(_sampleRate, delay_mSec);
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- then our stuff
-		nestedAPF.createDelayBuffer(_sampleRate, nestedAPFDelay_mSec);
+	/** perform the bitcrushing operation (see FX book for back story and details) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		return QL*(int(xn / QL));
 	}
 
-private:
-	NestedDelayAPFParameters nestedAPFParameters; ///< object parameters
-	DelayAPF nestedAPF;	///< nested APF object
+protected:
+	BitCrusherParameters parameters; ///< object parameters
+	double QL = 1.0;				 ///< the quantization level
 };
 
+
+// ------------------------------------------------------------------ //
+// --- WDF LIBRARY -------------------------------------------------- //
+// ------------------------------------------------------------------ //
+
 /**
-\struct TwoBandShelvingFilterParameters
-\ingroup FX-Objects
+\class IComponentAdaptor
+\ingroup Interfaces
 \brief
-Custom parameter structure for the TwoBandShelvingFilter object. Used for reverb algorithms in book.
+Use this interface for objects in the WDF Ladder Filter library; see book for more information.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct TwoBandShelvingFilterParameters
+class IComponentAdaptor
 {
-	TwoBandShelvingFilterParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	TwoBandShelvingFilterParameters& operator=(const TwoBandShelvingFilterParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+public:
+	virtual ~IComponentAdaptor() {}
 
-		lowShelf_fc = params.lowShelf_fc;
-		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-		highShelf_fc = params.highShelf_fc;
-		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
-		return *this;
-	}
+	/** initialize with source resistor R1 */
+	virtual void initialize(double _R1) {}
 
-	// --- individual parameters
-	double lowShelf_fc = 0.0;			///< fc for low shelf
-	double lowShelfBoostCut_dB = 0.0;	///< low shelf gain
-	double highShelf_fc = 0.0;			///< fc for high shelf
-	double highShelfBoostCut_dB = 0.0;	///< high shelf gain
+	/** initialize all downstream adaptors in the chain */
+	virtual void initializeAdaptorChain() {}
+
+	/** set input value into component port  */
+	virtual void setInput(double _in) {}
+
+	/** get output value from component port  */
+	virtual double getOutput() { return 0.0; }
+
+	// --- for adaptors
+	/** ADAPTOR: set input port 1  */
+	virtual void setInput1(double _in1) = 0;
+
+	/** ADAPTOR: set input port 2  */
+	virtual void setInput2(double _in2) = 0;
+
+	/** ADAPTOR: set input port 3 */
+	virtual void setInput3(double _in3) = 0;
+
+	/** ADAPTOR: get output port 1 value */
+	virtual double getOutput1() = 0;
+
+	/** ADAPTOR: get output port 2 value */
+	virtual double getOutput2() = 0;
+
+	/** ADAPTOR: get output port 3 value */
+	virtual double getOutput3() = 0;
+
+	/** reset the object with new sample rate */
+	virtual void reset(double _sampleRate) {}
+
+	/** get the commponent resistance from the attached object at Port3 */
+	virtual double getComponentResistance() { return 0.0; }
+
+	/** get the commponent conductance from the attached object at Port3 */
+	virtual double getComponentConductance() { return 0.0; }
+
+	/** update the commponent resistance at Port3 */
+	virtual void updateComponentResistance() {}
+
+	/** set an individual component value (may be R, L, or C */
+	virtual void setComponentValue(double _componentValue) { }
+
+	/** set LC combined values */
+	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C) { }
+
+	/** set RL combined values */
+	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L) { }
+
+	/** set RC combined values */
+	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C) { }
+
+	/** get a component value */
+	virtual double getComponentValue() { return 0.0; }
 };
 
+// ------------------------------------------------------------------ //
+// --- WDF COMPONENTS & COMMBO COMPONENTS --------------------------- //
+// ------------------------------------------------------------------ //
 /**
-\class TwoBandShelvingFilter
-\ingroup FX-Objects
+\class WdfResistor
+\ingroup WDF-Objects
 \brief
-The TwoBandShelvingFilter object implements two shelving filters in series in the standard "Bass and Treble" configuration.
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- Use TwoBandShelvingFilterParameters structure to get/set object params.
+The WdfResistor object implements the reflection coefficient and signal flow through
+a WDF simulated resistor.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class TwoBandShelvingFilter : public IAudioSignalProcessor
+class WdfResistor : public IComponentAdaptor
 {
 public:
-	TwoBandShelvingFilter()
+	WdfResistor(double _componentValue) { componentValue = _componentValue; }
+	WdfResistor() { }
+	virtual ~WdfResistor() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
 	{
-		AudioFilterParameters params = lowShelfFilter.getParameters();
-		params.algorithm = filterAlgorithm::kLowShelf;
-		lowShelfFilter.setParameters(params);
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
 
-		params = highShelfFilter.getParameters();
-		params.algorithm = filterAlgorithm::kHiShelf;
-		highShelfFilter.setParameters(params);
-	}		/* C-TOR */
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
 
-	~TwoBandShelvingFilter() {}		/* D-TOR */
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** get the component value */
+	virtual double getComponentValue() { return componentValue; }
+
+	/** set the component value */
+	virtual void setComponentValue(double _componentValue)
 	{
-		lowShelfFilter.reset(_sampleRate);
-		highShelfFilter.reset(_sampleRate);
-		return true;
+		componentValue = _componentValue;
+		updateComponentResistance();
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** change the resistance of component */
+	virtual void updateComponentResistance() { componentResistance = componentValue; }
 
-	/** process a single input through the two filters in series */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- all modes do Full Wave Rectification
-		double filteredSignal = lowShelfFilter.processAudioSample(xn);
-		filteredSignal = highShelfFilter.processAudioSample(filteredSignal);
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate);  zRegister = 0.0; }
 
-		return filteredSignal;
-	}
+	/** per-sample coefficients for table tuning (see WdfLadder); this component has none */
+	static const unsigned int numCoefficients = 0;
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return TwoBandShelvingFilterParameters custom data structure
-	*/
-	TwoBandShelvingFilterParameters getParameters()
-	{
-		return parameters;
-	}
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* /*coeffs*/) {}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param TwoBandShelvingFilterParameters custom data structure
-	*/
-	void setParameters(const TwoBandShelvingFilterParameters& params)
-	{
-		parameters = params;
-		AudioFilterParameters filterParams = lowShelfFilter.getParameters();
-		filterParams.fc = parameters.lowShelf_fc;
-		filterParams.boostCut_dB = parameters.lowShelfBoostCut_dB;
-		lowShelfFilter.setParameters(filterParams);
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* /*coeffs*/) {}
 
-		filterParams = highShelfFilter.getParameters();
-		filterParams.fc = parameters.highShelf_fc;
-		filterParams.boostCut_dB = parameters.highShelfBoostCut_dB;
-		highShelfFilter.setParameters(filterParams);
-	}
+	/** set input value into component; NOTE: resistor is dead-end energy sink so this function does nothing */
+	virtual void setInput(double in) {}
 
-private:
-	TwoBandShelvingFilterParameters parameters; ///< object parameters
-	AudioFilter lowShelfFilter;					///< filter for low shelf
-	AudioFilter highShelfFilter;				///< filter for high shelf
-};
+	/** get output value; NOTE: a WDF resistor produces no reflected output */
+	virtual double getOutput() { return 0.0; }
 
-/**
-\enum reverbDensity
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the density in the reverb object.
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-- enum class reverbDensity { kThick, kSparse };
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister = 0.0;			///< storage register (not used with resistor)
+	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
+	double componentResistance = 0.0;///< simulated resistance
+	double sampleRate = 0.0;		///< sample rate
+};
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class reverbDensity { kThick, kSparse };
 
 /**
-\struct ReverbTankParameters
-\ingroup FX-Objects
+\class WdfCapacitor
+\ingroup WDF-Objects
 \brief
-Custom parameter structure for the ReverbTank object.
+The WdfCapacitor object implements the reflection coefficient and signal flow through
+a WDF simulated capacitor.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct ReverbTankParameters
+class WdfCapacitor : public IComponentAdaptor
 {
-	ReverbTankParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ReverbTankParameters& operator=(const ReverbTankParameters& params)	// need this override for collections to work
+public:
+	WdfCapacitor(double _componentValue) { componentValue = _componentValue; }
+	WdfCapacitor() { }
+	virtual ~WdfCapacitor() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** get the component value */
+	virtual double getComponentValue() { return componentValue; }
+
+	/** set the component value */
+	virtual void setComponentValue(double _componentValue)
+	{
+		componentValue = _componentValue;
+		updateComponentResistance();
+	}
+
+	/** change the resistance of component */
+	virtual void updateComponentResistance()
 	{
-		if (this == &params)
-			return *this;
+		componentResistance = 1.0 / (2.0*componentValue*sampleRate);
+	}
 
-		density = params.density;
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
 
-		// --- tweaker variables
-		apfDelayMax_mSec = params.apfDelayMax_mSec;
-		apfDelayWeight_Pct = params.apfDelayWeight_Pct;
-		fixeDelayMax_mSec = params.fixeDelayMax_mSec;
-		fixeDelayWeight_Pct = params.fixeDelayWeight_Pct;
-		preDelayTime_mSec = params.preDelayTime_mSec;
+	/** per-sample coefficients for table tuning (see WdfLadder); this component has none */
+	static const unsigned int numCoefficients = 0;
 
-		lpf_g = params.lpf_g;
-		kRT = params.kRT;
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* /*coeffs*/) {}
 
-		lowShelf_fc = params.lowShelf_fc;
-		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-		highShelf_fc = params.highShelf_fc;
-		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* /*coeffs*/) {}
 
-		wetLevel_dB = params.wetLevel_dB;
-		dryLevel_dB = params.dryLevel_dB;
-		return *this;
-	}
+	/** set input value into component; NOTE: capacitor sets value into register*/
+	virtual void setInput(double in) { zRegister = in; }
 
-	// --- individual parameters
-	reverbDensity density = reverbDensity::kThick;	///< density setting thick or thin
+	/** get output value; NOTE: capacitor produces reflected output */
+	virtual double getOutput() { return zRegister; }	// z^-1
 
-	// --- tweaking parameters - you may not want to expose these
-	//     in the final plugin!
-	// --- See the book for all the details on how these tweakers work!!
-	double apfDelayMax_mSec = 5.0;					///< APF max delay time
-	double apfDelayWeight_Pct = 100.0;				///< APF max delay weighying
-	double fixeDelayMax_mSec = 50.0;				///< fixed delay max time
-	double fixeDelayWeight_Pct = 100.0;				///< fixed delay max weighying
+	/** get output1 value; only one capacitor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-	// --- direct control parameters
-	double preDelayTime_mSec = 0.0;					///< pre-delay time in mSec
-	double lpf_g = 0.0;								///< LPF g coefficient
-	double kRT = 0.0;								///< reverb time, 0 to 1
+	/** get output2 value; only one capacitor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-	double lowShelf_fc = 0.0;						///< low shelf fc
-	double lowShelfBoostCut_dB = 0.0;				///< low shelf gain
-	double highShelf_fc = 0.0;						///< high shelf fc
-	double highShelfBoostCut_dB = 0.0;				///< high shelf gain
+	/** get output3 value; only one capacitor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-	double wetLevel_dB = -3.0;						///< wet output level in dB
-	double dryLevel_dB = -3.0;						///< dry output level in dB
-};
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-// --- constants for reverb tank
-const unsigned int NUM_BRANCHES = 4;
-const unsigned int NUM_CHANNELS = 2; // stereo
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-/**
-\class ReverbTank
-\ingroup FX-Objects
-\brief
-The ReverbTank object implements the cyclic reverb tank in the FX book listed below.
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
-Audio I/O:
-- Processes mono input to mono OR stereo output.
+protected:
+	double zRegister = 0.0;			///< storage register (not used with resistor)
+	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
+	double componentResistance = 0.0;///< simulated resistance
+	double sampleRate = 0.0;		///< sample rate
+};
 
-Control I/F:
-- Use ReverbTankParameters structure to get/set object params.
+/**
+\class WdfInductor
+\ingroup WDF-Objects
+\brief
+The WdfInductor object implements the reflection coefficient and signal flow through
+a WDF simulated inductor.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ReverbTank : public IAudioSignalProcessor
+class WdfInductor : public IComponentAdaptor
 {
 public:
-	ReverbTank() {}		/* C-TOR */
-	~ReverbTank() {}	/* D-TOR */
+	WdfInductor(double _componentValue) { componentValue = _componentValue; }
+	WdfInductor() { }
+	virtual ~WdfInductor() {}
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
 	{
-		// ---store
 		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
 
-		// ---set up preDelay
-		preDelay.reset(_sampleRate);
-		preDelay.createDelayBuffer(_sampleRate, 100.0);
-
-		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
-		{
-			branchDelays[i].reset(_sampleRate);
-			branchDelays[i].createDelayBuffer(_sampleRate, 100.0);
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
 
-			branchNestedAPFs[i].reset(_sampleRate);
-			branchNestedAPFs[i].createDelayBuffers(_sampleRate, 100.0, 100.0);
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
 
-			branchLPFs[i].reset(_sampleRate);
-		}
-		for (uint32_t i = 0; i < NUM_CHANNELS; i++)
-		{
-			shelvingFilters[i].reset(_sampleRate);
-		}
+	/** get the component value */
+	virtual double getComponentValue() { return componentValue; }
 
-		return true;
+	/** set the component value */
+	virtual void setComponentValue(double _componentValue)
+	{
+		componentValue = _componentValue;
+		updateComponentResistance();
 	}
 
-	/** return true: this object can process frames */
-	virtual bool canProcessAudioFrame() { return true; }
+	/** change the resistance of component R(L) = 2Lfs */
+	virtual void updateComponentResistance(){ componentResistance = 2.0*componentValue*sampleRate;}
 
-	/** process mono reverb tank */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		float inputs[2] = { 0.0, 0.0 };
-		float outputs[2] = { 0.0, 0.0 };
-		processAudioFrame(inputs, outputs, 1, 1);
-		return outputs[0];
-	}
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
 
-	/** process stereo reverb tank */
-	virtual bool processAudioFrame(const float* inputFrame,
-		float* outputFrame,
-		uint32_t inputChannels,
-		uint32_t outputChannels)
-	{
-		// --- global feedback from delay in last branch
-		double globFB = branchDelays[NUM_BRANCHES-1].readDelay();
+	/** per-sample coefficients for table tuning (see WdfLadder); this component has none */
+	static const unsigned int numCoefficients = 0;
 
-		// --- feedback value
-		double fb = parameters.kRT*(globFB);
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* /*coeffs*/) {}
 
-		// --- mono-ized input signal
-		double xnL = inputFrame[0];
-		double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
-		double monoXn = double(1.0 / inputChannels)*xnL + double(1.0 / inputChannels)*xnR;
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* /*coeffs*/) {}
 
-		// --- pre delay output
-		double preDelayOut = preDelay.processAudioSample(monoXn);
+	/** set input value into component; NOTE: inductor sets value into storage register */
+	virtual void setInput(double in) { zRegister = in; }
 
-		// --- input to first branch = preDalay + globFB
-		double input = preDelayOut + fb;
-		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
-		{
-			double apfOut = branchNestedAPFs[i].processAudioSample(input);
-			double lpfOut = branchLPFs[i].processAudioSample(apfOut);
-			double delayOut = parameters.kRT*branchDelays[i].processAudioSample(lpfOut);
-			input = delayOut + preDelayOut;
-		}
-		// --- gather outputs
-		/*
-		There are 25 prime numbers between 1 and 100.
-		They are 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
-		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
+	/** get output value; NOTE: a WDF inductor produces reflected output that is inverted */
+	virtual double getOutput() { return -zRegister; } // -z^-1
 
-		we want 16 of them: 23, 29, 31, 37, 41,
-		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
-		*/
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-		double weight = 0.707;
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-		double outL= 0.0;
-		outL += weight*branchDelays[0].readDelayAtPercentage(23.0);
-		outL -= weight*branchDelays[1].readDelayAtPercentage(41.0);
-		outL += weight*branchDelays[2].readDelayAtPercentage(59.0);
-		outL -= weight*branchDelays[3].readDelayAtPercentage(73.0);
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-		double outR = 0.0;
-		outR -= weight*branchDelays[0].readDelayAtPercentage(29.0);
-		outR += weight*branchDelays[1].readDelayAtPercentage(43.0);
-		outR -= weight*branchDelays[2].readDelayAtPercentage(61.0);
-		outR += weight*branchDelays[3].readDelayAtPercentage(79.0);
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-		if (parameters.density == reverbDensity::kThick)
-		{
-			outL += weight*branchDelays[0].readDelayAtPercentage(31.0);
-			outL -= weight*branchDelays[1].readDelayAtPercentage(47.0);
-			outL += weight*branchDelays[2].readDelayAtPercentage(67.0);
-			outL -= weight*branchDelays[3].readDelayAtPercentage(83.0);
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-			outR -= weight*branchDelays[0].readDelayAtPercentage(37.0);
-			outR += weight*branchDelays[1].readDelayAtPercentage(53.0);
-			outR -= weight*branchDelays[2].readDelayAtPercentage(71.0);
-			outR += weight*branchDelays[3].readDelayAtPercentage(89.0);
-		}
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
-		// ---  filter
-		double tankOutL = shelvingFilters[0].processAudioSample(outL);
-		double tankOutR = shelvingFilters[1].processAudioSample(outR);
+protected:
+	double zRegister = 0.0;			///< storage register (not used with resistor)
+	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
+	double componentResistance = 0.0;///< simulated resistance
+	double sampleRate = 0.0;		///< sample rate
+};
 
-		// --- sum with dry
-		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
-		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
 
-		if (outputChannels == 1)
-			outputFrame[0] = (float)(dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR));
-		else
-		{
-			outputFrame[0] = (float)(dry*xnL + wet*tankOutL);
-			outputFrame[1] = (float)(dry*xnR + wet*tankOutR);
-		}
+/**
+\class WdfSeriesLC
+\ingroup WDF-Objects
+\brief
+The WdfSeriesLC object implements the reflection coefficient and signal flow through
+a WDF simulated series LC pair.
 
-		return true;
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfSeriesLC : public IComponentAdaptor
+{
+public:
+	WdfSeriesLC() {}
+	WdfSeriesLC(double _componentValue_L, double _componentValue_C)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
 	}
+	virtual ~WdfSeriesLC() {}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ReverbTankParameters custom data structure
-	*/
-	ReverbTankParameters getParameters() { return parameters; }
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param ReverbTankParameters custom data structure
-	*/
-	void setParameters(const ReverbTankParameters& params)
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RL = 2.0*componentValue_L*sampleRate;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = RL + (1.0 / RC);
+	}
+
+	/** set both LC components at once */
+	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
+	}
+
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
 	{
-		// --- do the updates here, the sub-components will only update themselves if
-		//     their parameters changed, so we let those object handle that chore
-		TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
-		filterParams.highShelf_fc = params.highShelf_fc;
-		filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
-		filterParams.lowShelf_fc = params.lowShelf_fc;
-		filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
 
-		// --- copy to both channels
-		shelvingFilters[0].setParameters(filterParams);
-		shelvingFilters[1].setParameters(filterParams);
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
 
-		SimpleLPFParameters  lpfParams = branchLPFs[0].getParameters();
-		lpfParams.g = params.lpf_g;
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
 
-		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
-		{
-			branchLPFs[i].setParameters(lpfParams);
-		}
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
 
-		// --- update pre delay
-		SimpleDelayParameters delayParams = preDelay.getParameters();
-		delayParams.delayTime_mSec = params.preDelayTime_mSec;
-		preDelay.setParameters(delayParams);
+	/** per-sample coefficients for table tuning (see WdfLadder): RL, RC */
+	static const unsigned int numCoefficients = 2;
 
-		// --- set apf and delay parameters
-		int m = 0;
-		NestedDelayAPFParameters apfParams = branchNestedAPFs[0].getParameters();
-		delayParams = branchDelays[0].getParameters();
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = RL; coeffs[1] = RC; }
 
-		// --- global max Delay times
-		double globalAPFMaxDelay = (parameters.apfDelayWeight_Pct / 100.0)*parameters.apfDelayMax_mSec;
-		double globalFixedMaxDelay = (parameters.fixeDelayWeight_Pct / 100.0)*parameters.fixeDelayMax_mSec;
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { RL = coeffs[0]; RC = coeffs[1]; }
 
-		// --- lfo
-		apfParams.enableLFO = true;
-		apfParams.lfoMaxModulation_mSec = 0.3;
-		apfParams.lfoDepth = 1.0;
+	/** set input value into component; NOTE: K is calculated here */
+	virtual void setInput(double in)
+	{
+		double YC = 1.0 / RC;
+		double K = (1.0 - RL*YC) / (1.0 + RL*YC);
+		double N1 = K*(in - zRegister_L);
+		zRegister_L = N1 + zRegister_C;
+		zRegister_C = in;
+	}
 
-		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
-		{
-			// --- setup APFs
-			apfParams.outerAPFdelayTime_mSec = globalAPFMaxDelay*apfDelayWeight[m++];
-			apfParams.innerAPFdelayTime_mSec = globalAPFMaxDelay*apfDelayWeight[m++];
-			apfParams.innerAPF_g = -0.5;
-			apfParams.outerAPF_g = 0.5;
-			if (i == 0)
-				apfParams.lfoRate_Hz = 0.15;
-			else if (i == 1)
-				apfParams.lfoRate_Hz = 0.33;
-			else if (i == 2)
-				apfParams.lfoRate_Hz = 0.57;
-			else if (i == 3)
-				apfParams.lfoRate_Hz = 0.73;
+	/** get output value; NOTE: utput is located in zReg_L */
+	virtual double getOutput(){ return zRegister_L; }
 
-			branchNestedAPFs[i].setParameters(apfParams);
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-			// --- fixedDelayWeight
-			delayParams.delayTime_mSec = globalFixedMaxDelay*fixedDelayWeight[i];
-			branchDelays[i].setParameters(delayParams);
-		}
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-		// --- save our copy
-		parameters = params;
-	}
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-private:
-	ReverbTankParameters parameters;				///< object parameters
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-	SimpleDelay  preDelay;							///< pre delay object
-	SimpleDelay  branchDelays[NUM_BRANCHES];		///< branch delay objects
-	NestedDelayAPF branchNestedAPFs[NUM_BRANCHES];	///< nested APFs for each branch
-	SimpleLPF  branchLPFs[NUM_BRANCHES];			///< LPFs in each branch
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
-	TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
 
-	// --- weighting values to make various and low-correlated APF delay values easily
-	double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
-	double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
-	double sampleRate = 0.0;	///< current sample rate
-};
+	double componentValue_L = 0.0; ///< component value L
+	double componentValue_C = 0.0; ///< component value C
 
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
+};
 
 /**
-\class PeakLimiter
-\ingroup FX-Objects
+\class WdfParallelLC
+\ingroup WDF-Objects
 \brief
-The PeakLimiter object implements a simple peak limiter; it is really a simplified and hard-wired
-versio of the DynamicsProcessor
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- setThreshold_dB(double _threshold_dB) to adjust the limiter threshold
-- setMakeUpGain_dB(double _makeUpGain_dB) to adjust the makeup gain
+The WdfParallelLC object implements the reflection coefficient and signal flow through
+a WDF simulated parallel LC pair.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class PeakLimiter : public IAudioSignalProcessor
+class WdfParallelLC : public IComponentAdaptor
 {
 public:
-	PeakLimiter() { setThreshold_dB(-3.0); }
-	~PeakLimiter() {}
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	WdfParallelLC() {}
+	WdfParallelLC(double _componentValue_L, double _componentValue_C)
 	{
-		// --- init; true = analog time-constant
-		detector.setSampleRate(_sampleRate);
-
-		AudioDetectorParameters detectorParams = detector.getParameters();
-		detectorParams.detect_dB = true;
-		detectorParams.attackTime_mSec = 5.0;
-		detectorParams.releaseTime_mSec = 25.0;
-		detectorParams.clampToUnityMax = false;
-		detectorParams.detectMode = ENVELOPE_DETECT_MODE_PEAK;
-		detector.setParameters(detectorParams);
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+	}
+	virtual ~WdfParallelLC() {}
 
-		return true;
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
 
-	/** process audio: implement hard limiter */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
 	{
-		return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
+		RL = 2.0*componentValue_L*sampleRate;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = (RC + 1.0 / RL);
 	}
 
-	/** compute the gain reductino value based on detected value in dB */
-	double computeGain(double detect_dB)
+	/** set both LC components at once */
+	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
 	{
-		double output_dB = 0.0;
-
-		// --- defaults - you can change these here
-		bool softknee = true;
-		double kneeWidth_dB = 10.0;
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
 
-		// --- hard knee
-		if (!softknee)
-		{
-			// --- below threshold, unity
-			if (detect_dB <= threshold_dB)
-				output_dB = detect_dB;
-			// --- above threshold, compress
-			else
-				output_dB = threshold_dB;
-		}
-		else
-		{
-			// --- calc gain with knee
-			// --- left side of knee, outside of width, unity gain zone
-			if (2.0*(detect_dB - threshold_dB) < -kneeWidth_dB)
-				output_dB = detect_dB;
-			// --- inside the knee,
-			else if (2.0*(fabs(detect_dB - threshold_dB)) <= kneeWidth_dB)
-				output_dB = detect_dB - pow((detect_dB - threshold_dB + (kneeWidth_dB / 2.0)), 2.0) / (2.0*kneeWidth_dB);
-			// --- right of knee, compression zone
-			else if (2.0*(detect_dB - threshold_dB) > kneeWidth_dB)
-				output_dB = threshold_dB;
-		}
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
+	}
 
-		// --- convert difference between threshold and detected to raw
-		return  pow(10.0, (output_dB - detect_dB) / 20.0);
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
 	}
 
-	/** adjust threshold in dB */
-	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
 
-	/** adjust makeup gain in dB*/
-	void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; }
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
 
-protected:
-	AudioDetector detector;		///< the detector object
-	double threshold_dB = 0.0;	///< stored threshold (dB)
-	double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
-};
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
 
+	/** per-sample coefficients for table tuning (see WdfLadder): RL, RC */
+	static const unsigned int numCoefficients = 2;
 
-/**
-\enum vaFilterAlgorithm
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the virtual analog filter algorithm
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = RL; coeffs[1] = RC; }
 
-- enum class vaFilterAlgorithm { kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS };
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { RL = coeffs[0]; RC = coeffs[1]; }
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class vaFilterAlgorithm {
-	kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS
-}; // --- you will add more here...
+	/** set input value into component; NOTE: K is calculated here */
+	virtual void setInput(double in)
+	{
+		double YL = 1.0 / RL;
+		double K = (YL*RC - 1.0) / (YL*RC + 1.0);
+		double N1 = K*(in - zRegister_L);
+		zRegister_L = N1 + zRegister_C;
+		zRegister_C = in;
+	}
 
+	/** get output value; NOTE: output is located in -zReg_L */
+	virtual double getOutput(){ return -zRegister_L; }
 
-/**
-\struct ZVAFilterParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the ZVAFilter object.
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct ZVAFilterParameters
-{
-	ZVAFilterParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ZVAFilterParameters& operator=(const ZVAFilterParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-		filterAlgorithm = params.filterAlgorithm;
-		fc = params.fc;
-		Q = params.Q;
-		filterOutputGain_dB = params.filterOutputGain_dB;
-		enableGainComp = params.enableGainComp;
-		matchAnalogNyquistLPF = params.matchAnalogNyquistLPF;
-		selfOscillate = params.selfOscillate;
-		enableNLP = params.enableNLP;
-		return *this;
-	}
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-	// --- individual parameters
-	vaFilterAlgorithm filterAlgorithm = vaFilterAlgorithm::kSVF_LP;	///< va filter algorithm
-	double fc = 1000.0;						///< va filter fc
-	double Q = 0.707;						///< va filter Q
-	double filterOutputGain_dB = 0.0;		///< va filter gain (normally unused)
-	bool enableGainComp = false;			///< enable gain compensation (see book)
-	bool matchAnalogNyquistLPF = false;		///< match analog gain at Nyquist
-	bool selfOscillate = false;				///< enable selfOscillation
-	bool enableNLP = false;					///< enable non linear processing (use oversampling for best results)
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+
+	double componentValue_L = 0.0; ///< component value L
+	double componentValue_C = 0.0; ///< component value C
+
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
 };
 
 
 /**
-\class ZVAFilter
-\ingroup FX-Objects
+\class WdfSeriesRL
+\ingroup WDF-Objects
 \brief
-The ZVAFilter object implements multpile Zavalishin VA Filters.
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- Use BiquadParameters structure to get/set object params.
+The WdfSeriesRL object implements the reflection coefficient and signal flow through
+a WDF simulated series RL pair.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ZVAFilter : public IAudioSignalProcessor
+class WdfSeriesRL : public IComponentAdaptor
 {
 public:
-	ZVAFilter() {}		/* C-TOR */
-	~ZVAFilter() {}		/* D-TOR */
+	WdfSeriesRL() {}
+	WdfSeriesRL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfSeriesRL() {}
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
-		integrator_z[0] = 0.0;
-		integrator_z[1] = 0.0;
+		updateComponentResistance();
+	}
 
-		return true;
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RL = 2.0*componentValue_L*sampleRate;
+		componentResistance = RR + RL;
+		K = RR / componentResistance;
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ZVAFilterParameters custom data structure
-	*/
-	ZVAFilterParameters getParameters()
+	/** set both RL components at once */
+	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
 	{
-		return zvaFilterParameters;
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
 	}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param ZVAFilterParameters custom data structure
-	*/
-	void setParameters(const ZVAFilterParameters& params)
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
 	{
-		if (params.fc != zvaFilterParameters.fc ||
-			params.Q != zvaFilterParameters.Q ||
-			params.selfOscillate != zvaFilterParameters.selfOscillate ||
-			params.matchAnalogNyquistLPF != zvaFilterParameters.matchAnalogNyquistLPF)
-		{
-				zvaFilterParameters = params;
-				calculateFilterCoeffs();
-		}
-		else
-			zvaFilterParameters = params;
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
+	{
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
 
-	/** process input x(n) through the VA filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
+
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** per-sample coefficients for table tuning (see WdfLadder): K */
+	static const unsigned int numCoefficients = 1;
+
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = K; }
+
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { K = coeffs[0]; }
+
+	/** set input value into component */
+	virtual void setInput(double in){ zRegister_L = in; }
+
+	/** get output value; NOTE: see FX book for details */
+	virtual double getOutput()
 	{
-		// --- with gain comp enabled, we reduce the input by
-		//     half the gain in dB at resonant peak
-		//     NOTE: you can change that logic here!
-		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
-		bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
+		double NL = -zRegister_L;
+		double out = NL*(1.0 - K) - K*zRegister_C;
+		zRegister_C = out;
 
-		if (zvaFilterParameters.enableGainComp)
-		{
-			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
-			if (peak_dB > 0.0)
-			{
-				double halfPeak_dBGain = dB2Raw(-peak_dB / 2.0);
-				xn *= halfPeak_dBGain;
-			}
-		}
+		return out;
+	}
 
-		// --- for 1st order filters:
-		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kAPF1)
-		{
-			// --- create vn node
-			double vn = (xn - integrator_z[0])*alpha;
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-			// --- form LP output
-			double lpf = ((xn - integrator_z[0])*alpha) + integrator_z[0];
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-			// double sn = integrator_z[0];
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-			// --- update memory
-			integrator_z[0] = vn + lpf;
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-			// --- form the HPF = INPUT = LPF
-			double hpf = xn - lpf;
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-			// --- form the APF = LPF - HPF
-			double apf = lpf - hpf;
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
-			// --- set the outputs
-			if (filterAlgorithm == vaFilterAlgorithm::kLPF1)
-			{
-				// --- this is a very close match as-is at Nyquist!
-				if (matchAnalogNyquistLPF)
-					return lpf + alpha*hpf;
-				else
-					return lpf;
-			}
-			else if (filterAlgorithm == vaFilterAlgorithm::kHPF1)
-				return hpf;
-			else if (filterAlgorithm == vaFilterAlgorithm::kAPF1)
-				return apf;
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0;///< storage register for C (not used)
+	double K = 0.0;
 
-			// --- unknown filter
-			return xn;
-		}
+	double componentValue_L = 0.0;///< component value L
+	double componentValue_R = 0.0;///< component value R
 
-		// --- form the HP output first
-		double hpf = alpha0*(xn - rho*integrator_z[0] - integrator_z[1]);
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double RR = 0.0; ///< RR value
 
-		// --- BPF Out
-		double bpf = alpha*hpf + integrator_z[0];
-		if (zvaFilterParameters.enableNLP)
-			bpf = softClipWaveShaper(bpf, 1.0);
+	double componentResistance = 0.0; ///< equivalent resistance of pair of componen
+	double sampleRate = 0.0; ///< sample rate
+};
 
-		// --- LPF Out
-		double lpf = alpha*bpf + integrator_z[1];
+/**
+\class WdfParallelRL
+\ingroup WDF-Objects
+\brief
+The WdfParallelRL object implements the reflection coefficient and signal flow through
+a WDF simulated parallel RL pair.
 
-		// --- BSF Out
-		double bsf = hpf + lpf;
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfParallelRL : public IComponentAdaptor
+{
+public:
+	WdfParallelRL() {}
+	WdfParallelRL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfParallelRL() {}
 
-		// --- finite gain at Nyquist; slight error at VHF
-		double sn = integrator_z[0];
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
 
-		// update memory
-		integrator_z[0] = alpha*hpf + bpf;
-		integrator_z[1] = alpha*bpf + lpf;
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RL = 2.0*componentValue_L*sampleRate;
+		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RL));
+		K = componentResistance / RR;
+	}
 
-		double filterOutputGain = pow(10.0, zvaFilterParameters.filterOutputGain_dB / 20.0);
 
-		// return our selected type
-		if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP)
-		{
-			if (matchAnalogNyquistLPF)
-				lpf += analogMatchSigma*(sn);
-			return filterOutputGain*lpf;
-		}
-		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_HP)
-			return filterOutputGain*hpf;
-		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BP)
-			return filterOutputGain*bpf;
-		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BS)
-			return filterOutputGain*bsf;
+	/** set both RL components at once */
+	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
 
-		// --- unknown filter
-		return filterOutputGain*lpf;
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
 	}
 
-	/** recalculate the filter coefficients*/
-	void calculateFilterCoeffs()
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
 	{
-		double fc = zvaFilterParameters.fc;
-		double Q = zvaFilterParameters.Q;
-		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
 
-		// --- normal Zavalishin SVF calculations here
-		//     prewarp the cutoff- these are bilinear-transform filters
-		double wd = kTwoPi*fc;
-		double T = 1.0 / sampleRate;
-		double wa = (2.0 / T)*tan(wd*T / 2.0);
-		double g = wa*T / 2.0;
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
 
-		// --- for 1st order filters:
-		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kAPF1)
-		{
-			// --- calculate alpha
-			alpha = g / (1.0 + g);
-		}
-		else // state variable variety
-		{
-			// --- note R is the traditional analog damping factor zeta
-			double R = zvaFilterParameters.selfOscillate ? 0.0 : 1.0 / (2.0*Q);
-			alpha0 = 1.0 / (1.0 + 2.0*R*g + g*g);
-			alpha = g;
-			rho = 2.0*R + g;
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
 
-			// --- sigma for analog matching version
-			double f_o = (sampleRate / 2.0) / fc;
-			analogMatchSigma = 1.0 / (alpha*f_o*f_o);
-		}
-	}
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
 
-	/** set beta value, for filters that aggregate 1st order VA sections*/
-	void setBeta(double _beta) { beta = _beta; }
+	/** per-sample coefficients for table tuning (see WdfLadder): K */
+	static const unsigned int numCoefficients = 1;
 
-	/** get beta value,not used in book projects; for future use*/
-	double getBeta() { return beta; }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = K; }
 
-protected:
-	ZVAFilterParameters zvaFilterParameters;	///< object parameters
-	double sampleRate = 44100.0;				///< current sample rate
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { K = coeffs[0]; }
 
-	// --- state storage
-	double integrator_z[2];						///< state variables
+	/** set input value into component */
+	virtual void setInput(double in){ zRegister_L = in; }
 
-	// --- filter coefficients
-	double alpha0 = 0.0;		///< input scalar, correct delay-free loop
-	double alpha = 0.0;			///< alpha is (wcT/2)
-	double rho = 0.0;			///< p = 2R + g (feedback)
+	/** get output value; NOTE: see FX book for details */
+	virtual double getOutput()
+	{
+		double NL = -zRegister_L;
+		double out = NL*(1.0 - K) + K*zRegister_C;
+		zRegister_C = out;
+		return out;
+	}
 
-	double beta = 0.0;			///< beta value, not used
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-	// --- for analog Nyquist matching
-	double analogMatchSigma = 0.0; ///< analog matching Sigma value (see book)
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-};
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-/**
-\struct EnvelopeFollowerParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the EnvelopeFollower object.
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct EnvelopeFollowerParameters
-{
-	EnvelopeFollowerParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	EnvelopeFollowerParameters& operator=(const EnvelopeFollowerParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-		fc = params.fc;
-		Q = params.Q;
-		attackTime_mSec = params.attackTime_mSec;
-		releaseTime_mSec = params.releaseTime_mSec;
-		threshold_dB = params.threshold_dB;
-		sensitivity = params.sensitivity;
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
-		return *this;
-	}
+protected:
+	double zRegister_L = 0.0;	///< storage register for L
+	double zRegister_C = 0.0;	///< storage register for L
+	double K = 0.0;				///< K value
 
-	// --- individual parameters
-	double fc = 0.0;				///< filter fc
-	double Q = 0.707;				///< filter Q
-	double attackTime_mSec = 10.0;	///< detector attack time
-	double releaseTime_mSec = 10.0;	///< detector release time
-	double threshold_dB = 0.0;		///< detector threshold in dB
-	double sensitivity = 1.0;		///< detector sensitivity
+	double componentValue_L = 0.0;	///< component value L
+	double componentValue_R = 0.0;	///< component value R
+
+	double RL = 0.0;	///< RL value
+	double RC = 0.0;	///< RC value
+	double RR = 0.0;	///< RR value
+
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
 };
 
 /**
-\class EnvelopeFollower
-\ingroup FX-Objects
+\class WdfSeriesRC
+\ingroup WDF-Objects
 \brief
-The EnvelopeFollower object implements a traditional envelope follower effect modulating a LPR fc value
-using the strength of the detected input.
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- Use EnvelopeFollowerParameters structure to get/set object params.
+The WdfSeriesRC object implements the reflection coefficient and signal flow through
+a WDF simulated series RC pair.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class EnvelopeFollower : public IAudioSignalProcessor
+class WdfSeriesRC : public IComponentAdaptor
 {
 public:
-	EnvelopeFollower() {
-		// --- setup the filter
-		ZVAFilterParameters filterParams;
-		filterParams.filterAlgorithm = vaFilterAlgorithm::kSVF_LP;
-		filterParams.fc = 1000.0;
-		filterParams.enableGainComp = true;
-		filterParams.enableNLP = true;
-		filterParams.matchAnalogNyquistLPF = true;
-		filter.setParameters(filterParams);
-
-		// --- setup the detector
-		AudioDetectorParameters adParams;
-		adParams.attackTime_mSec = -1.0;
-		adParams.releaseTime_mSec = -1.0;
-		adParams.detectMode = TLD_AUDIO_DETECT_MODE_RMS;
-		adParams.detect_dB = true;
-		adParams.clampToUnityMax = false;
-		detector.setParameters(adParams);
-
-	}		/* C-TOR */
-	~EnvelopeFollower() {}		/* D-TOR */
+	WdfSeriesRC() {}
+	WdfSeriesRC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfSeriesRC() {}
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
 	{
-		filter.reset(_sampleRate);
-		detector.reset(_sampleRate);
-		return true;
+		sampleRate = _sampleRate;
+		updateComponentResistance();
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return EnvelopeFollowerParameters custom data structure
-	*/
-	EnvelopeFollowerParameters getParameters() { return parameters; }
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param EnvelopeFollowerParameters custom data structure
-	*/
-	void setParameters(const EnvelopeFollowerParameters& params)
-	{
-		ZVAFilterParameters filterParams = filter.getParameters();
-		AudioDetectorParameters adParams = detector.getParameters();
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
 
-		if (params.fc != parameters.fc || params.Q != parameters.Q)
-		{
-			filterParams.fc = params.fc;
-			filterParams.Q = params.Q;
-			filter.setParameters(filterParams);
-		}
-		if (params.attackTime_mSec != parameters.attackTime_mSec ||
-			params.releaseTime_mSec != parameters.releaseTime_mSec)
-		{
-			adParams.attackTime_mSec = params.attackTime_mSec;
-			adParams.releaseTime_mSec = params.releaseTime_mSec;
-			detector.setParameters(adParams);
-		}
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = RR + RC;
+		K = RR / componentResistance;
+	}
 
-		// --- save
-		parameters = params;
+	/** set both RC components at once */
+	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_R = _componentValue_R;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process input x(n) through the envelope follower to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
 	{
-		// --- calc threshold
-		double threshValue = pow(10.0, parameters.threshold_dB / 20.0);
-
-		// --- detect the signal
-		double detect_dB = detector.processAudioSample(xn);
-		double detectValue = pow(10.0, detect_dB / 20.0);
-		double deltaValue = detectValue - threshValue;
-
-		ZVAFilterParameters filterParams = filter.getParameters();
-		filterParams.fc = parameters.fc;
-
-		// --- if above the threshold, modulate the filter fc
-		if (deltaValue > 0.0)// || delta_dB > 0.0)
-		{
-			// --- fc Computer
-			double modulatorValue = 0.0;
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
 
-			// --- best results are with linear values when detector is in dB mode
-			modulatorValue = (deltaValue * parameters.sensitivity);
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
 
-			// --- calculate modulated frequency
-			filterParams.fc = doUnipolarModulationFromMin(modulatorValue, parameters.fc, kMaxFilterFrequency);
-		}
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
 
-		// --- update with new modulated frequency
-		filter.setParameters(filterParams);
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
 
-		// --- perform the filtering operation
-		return filter.processAudioSample(xn);
-	}
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
 
-protected:
-	EnvelopeFollowerParameters parameters; ///< object parameters
+	/** per-sample coefficients for table tuning (see WdfLadder): K */
+	static const unsigned int numCoefficients = 1;
 
-	// --- 1 filter and 1 detector
-	ZVAFilter filter;		///< filter to modulate
-	AudioDetector detector; ///< detector to track input signal
-};
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = K; }
 
-/**
-\enum distortionModel
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the waveshaper model for the Triode objects
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { K = coeffs[0]; }
 
-- enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
+	/** set input value into component */
+	virtual void setInput(double in){ zRegister_L = in; }
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
+	/** get output value; NOTE: see FX book for details */
+	virtual double getOutput()
+	{
+		double NL = zRegister_L;
+		double out = NL*(1.0 - K) + K*zRegister_C;
+		zRegister_C = out;
+		return out;
+	}
 
-/**
-\struct TriodeClassAParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the TriodeClassA object.
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct TriodeClassAParameters
-{
-	TriodeClassAParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	TriodeClassAParameters& operator=(const TriodeClassAParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-		waveshaper = params.waveshaper;
-		saturation = params.saturation;
-		asymmetry = params.asymmetry;
-		outputGain = params.outputGain;
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-		invertOutput = params.invertOutput;
-		enableHPF = params.enableHPF;
-		enableLSF = params.enableLSF;
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-		hpf_Fc = params.hpf_Fc;
-		lsf_Fshelf = params.lsf_Fshelf;
-		lsf_BoostCut_dB = params.lsf_BoostCut_dB;
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-		return *this;
-	}
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
-	// --- individual parameters
-	distortionModel waveshaper = distortionModel::kSoftClip; ///< waveshaper
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+	double K = 0.0;
 
-	double saturation = 1.0;	///< saturation level
-	double asymmetry = 0.0;		///< asymmetry level
-	double outputGain = 1.0;	///< outputGain level
+	double componentValue_R = 0.0;///< component value R
+	double componentValue_C = 0.0;///< component value C
 
-	bool invertOutput = true;	///< invertOutput - triodes invert output
-	bool enableHPF = true;		///< HPF simulates DC blocking cap on output
-	bool enableLSF = false;		///< LSF simulates shelf due to cathode self biasing
+	double RL = 0.0;	///< RL value
+	double RC = 0.0;	///< RC value
+	double RR = 0.0;	///< RR value
 
-	double hpf_Fc = 1.0;		///< fc of DC blocking cap
-	double lsf_Fshelf = 80.0;	///< shelf fc from self bias cap
-	double lsf_BoostCut_dB = 0.0;///< boost/cut due to cathode self biasing
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
 };
 
 /**
-\class TriodeClassA
-\ingroup FX-Objects
+\class WdfParallelRC
+\ingroup WDF-Objects
 \brief
-The TriodeClassA object simulates a triode in class A configuration. This is a very simple and basic simulation
-and a starting point for other designs; it is not intended to be a full-fledged triode simulator.
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- Use TriodeClassAParameters structure to get/set object params.
+The WdfParallelRC object implements the reflection coefficient and signal flow through
+a WDF simulated parallal RC pair.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class TriodeClassA : public IAudioSignalProcessor
+class WdfParallelRC : public IComponentAdaptor
 {
 public:
-	TriodeClassA() {
-		AudioFilterParameters params;
-		params.algorithm = filterAlgorithm::kHPF1;
-		params.fc = parameters.hpf_Fc;
-		outputHPF.setParameters(params);
+	WdfParallelRC() {}
+	WdfParallelRC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfParallelRC() {}
 
-		params.algorithm = filterAlgorithm::kLowShelf;
-		params.fc = parameters.lsf_Fshelf;
-		params.boostCut_dB = parameters.lsf_BoostCut_dB;
-		outputLSF.setParameters(params);
-	}		/* C-TOR */
-	~TriodeClassA() {}		/* D-TOR */
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
 	{
-		outputHPF.reset(_sampleRate);
-		outputLSF.reset(_sampleRate);
+		RR = componentValue_R;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RC));
+		K = componentResistance / RR;
+	}
 
-		// ---
-		return true;
+	/** set both RC components at once */
+	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_R = _componentValue_R;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return TriodeClassAParameters custom data structure
-	*/
-	TriodeClassAParameters getParameters() { return parameters; }
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
+	{
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param TriodeClassAParameters custom data structure
-	*/
-	void setParameters(const TriodeClassAParameters& params)
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
 	{
-		parameters = params;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
 
-		AudioFilterParameters filterParams;
-		filterParams.algorithm = filterAlgorithm::kHPF1;
-		filterParams.fc = parameters.hpf_Fc;
-		outputHPF.setParameters(filterParams);
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
 
-		filterParams.algorithm = filterAlgorithm::kLowShelf;
-		filterParams.fc = parameters.lsf_Fshelf;
-		filterParams.boostCut_dB = parameters.lsf_BoostCut_dB;
-		outputLSF.setParameters(filterParams);
-	}
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
 
-	/** do the triode simulation to process one input to one output*/
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** per-sample coefficients for table tuning (see WdfLadder): K */
+	static const unsigned int numCoefficients = 1;
+
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = K; }
+
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { K = coeffs[0]; }
+
+	/** set input value into component; */
+	virtual void setInput(double in){ zRegister_L = in; }
+
+	/** get output value; NOTE: output is located in zRegister_C */
+	virtual double getOutput()
 	{
-		// --- perform waveshaping
-		double output = 0.0;
+		double NL = zRegister_L;
+		double out = NL*(1.0 - K) - K*zRegister_C;
+		zRegister_C = out;
+		return out;
+	}
 
-		if (parameters.waveshaper == distortionModel::kSoftClip)
-			output = softClipWaveShaper(xn, parameters.saturation);
-		else if (parameters.waveshaper == distortionModel::kArcTan)
-			output = atanWaveShaper(xn, parameters.saturation);
-		else if (parameters.waveshaper == distortionModel::kFuzzAsym)
-			output = fuzzExp1WaveShaper(xn, parameters.saturation, parameters.asymmetry);
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-		// --- inversion, normal for plate of class A triode
-		if (parameters.invertOutput)
-			output *= -1.0;
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
 
-		// --- Output (plate) capacitor = HPF, remove DC offset
-		if (parameters.enableHPF)
-			output = outputHPF.processAudioSample(output);
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
 
-		// --- if cathode resistor bypass, will create low shelf
-		if (parameters.enableLSF)
-			output = outputLSF.processAudioSample(output);
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
 
-		// --- final resistor divider/potentiometer
-		output *= parameters.outputGain;
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
 
-		return output;
-	}
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
 protected:
-	TriodeClassAParameters parameters;	///< object parameters
-	AudioFilter outputHPF;				///< HPF to simulate output DC blocking cap
-	AudioFilter outputLSF;				///< LSF to simulate shelf caused by cathode self-biasing cap
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+	double K = 0.0;
+
+	double componentValue_C = 0.0;	///< component value C
+	double componentValue_R = 0.0;	///< component value R
+
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double RR = 0.0; ///< RR value
+
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
 };
 
-const unsigned int NUM_TUBES = 4;
+
+// ------------------------------------------------------------------ //
+// --- WDF ADAPTORS ------------------------------------------------- //
+// ------------------------------------------------------------------ //
 
 /**
-\struct ClassATubePreParameters
-\ingroup FX-Objects
+\enum wdfComponent
+\ingroup Constants-Enums
 \brief
-Custom parameter structure for the ClassATubePre object.
+Use this strongly typed enum to easily set the wdfComponent type
+
+- enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct ClassATubePreParameters
-{
-	ClassATubePreParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ClassATubePreParameters& operator=(const ClassATubePreParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
 
-		inputLevel_dB = params.inputLevel_dB;
-		saturation = params.saturation;
-		asymmetry = params.asymmetry;
-		outputLevel_dB = params.outputLevel_dB;
+/**
+\struct WdfComponentInfo
+\ingroup WDF-Objects
+\brief
+Custom structure to hold component information.
 
-		lowShelf_fc = params.lowShelf_fc;
-		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-		highShelf_fc = params.highShelf_fc;
-		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct WdfComponentInfo
+{
+	WdfComponentInfo() { }
 
-		return *this;
+	WdfComponentInfo(wdfComponent _componentType, double value1 = 0.0, double value2 = 0.0)
+	{
+		componentType = _componentType;
+		if (componentType == wdfComponent::R)
+			R = value1;
+		else if (componentType == wdfComponent::L)
+			L = value1;
+		else if (componentType == wdfComponent::C)
+			C = value1;
+		else if (componentType == wdfComponent::seriesLC || componentType == wdfComponent::parallelLC)
+		{
+			L = value1;
+			C = value2;
+		}
+		else if (componentType == wdfComponent::seriesRL || componentType == wdfComponent::parallelRL)
+		{
+			R = value1;
+			L = value2;
+		}
+		else if (componentType == wdfComponent::seriesRC || componentType == wdfComponent::parallelRC)
+		{
+			R = value1;
+			C = value2;
+		}
 	}
 
-	// --- individual parameters
-	double inputLevel_dB = 0.0;		///< input level in dB
-	double saturation = 0.0;		///< input level in dB
-	double asymmetry = 0.0;			///< input level in dB
-	double outputLevel_dB = 0.0;	///< input level in dB
-
-	// --- shelving filter params
-	double lowShelf_fc = 0.0;			///< LSF shelf frequency
-	double lowShelfBoostCut_dB = 0.0;	///< LSF shelf gain/cut
-	double highShelf_fc = 0.0;			///< HSF shelf frequency
-	double highShelfBoostCut_dB = 0.0;	///< HSF shelf frequency
-
+	double R = 0.0; ///< value of R component
+	double L = 0.0;	///< value of L component
+	double C = 0.0;	///< value of C component
+	wdfComponent componentType = wdfComponent::R; ///< selected component type
 };
 
+
 /**
-\class ClassATubePre
-\ingroup FX-Objects
+\class WdfAdaptorBase
+\ingroup WDF-Objects
 \brief
-The ClassATubePre object implements a simple cascade of four (4) triode tube models.
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- Use ClassATubePreParameters structure to get/set object params.
+The WdfAdaptorBase object acts as the base class for all WDF Adaptors; the static members allow
+for simplified connection of components. See the FX book for more details.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ClassATubePre : public IAudioSignalProcessor
+class WdfAdaptorBase : public IComponentAdaptor
 {
 public:
-	ClassATubePre() {}		/* C-TOR */
-	~ClassATubePre() {}		/* D-TOR */
+	WdfAdaptorBase() {}
+	virtual ~WdfAdaptorBase() { if (wdfComponent) delete wdfComponent; }
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	// --- the adaptor owns its component and the ports point into the circuit, so it can not be copied
+	WdfAdaptorBase(const WdfAdaptorBase&) = delete;
+	WdfAdaptorBase& operator=(const WdfAdaptorBase&) = delete;
+
+	/** set the termainal (load) resistance for terminating adaptors */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set the termainal (load) resistance as open circuit for terminating adaptors */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
 	{
-		TriodeClassAParameters tubeParams = triodes[0].getParameters();
-		tubeParams.invertOutput = true;
-		tubeParams.enableHPF = true; // remove DC offsets
-		tubeParams.outputGain = 1.0;
-		tubeParams.saturation = 1.0;
-		tubeParams.asymmetry = 0.0;
-		tubeParams.enableLSF = true;
-		tubeParams.lsf_Fshelf = 88.0;
-		tubeParams.lsf_BoostCut_dB = -12.0;
-		tubeParams.waveshaper = distortionModel::kFuzzAsym;
+		// --- flag overrides value
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
+	}
 
-		for (uint32_t i = 0; i < NUM_TUBES; i++)
+	/** set the input (source) resistance for an input adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** set the component or connected adaptor at port 1; functions is generic and allows extending the functionality of the WDF Library */
+	void setPort1_CompAdaptor(IComponentAdaptor* _port1CompAdaptor) { port1CompAdaptor = _port1CompAdaptor; }
+
+	/** set the component or connected adaptor at port 2; functions is generic and allows extending the functionality of the WDF Library */
+	void setPort2_CompAdaptor(IComponentAdaptor* _port2CompAdaptor) { port2CompAdaptor = _port2CompAdaptor; }
+
+	/** set the component or connected adaptor at port 3; functions is generic and allows extending the functionality of the WDF Library */
+	void setPort3_CompAdaptor(IComponentAdaptor* _port3CompAdaptor) { port3CompAdaptor = _port3CompAdaptor; }
+
+	/** reset the connected component */
+	virtual void reset(double _sampleRate)
+	{
+		if (wdfComponent)
+			wdfComponent->reset(_sampleRate);
+	}
+
+	/** creates a new WDF component and connects it to Port 3 */
+	void setComponent(wdfComponent componentType, double value1 = 0.0, double value2 = 0.0)
+	{
+		// --- createWDF( ) may be called more than once; release the old component
+		if (wdfComponent)
 		{
-			triodes[i].reset(_sampleRate);
-			triodes[i].setParameters(tubeParams);
+			if (port3CompAdaptor == wdfComponent)
+				port3CompAdaptor = nullptr;
+			delete wdfComponent;
+			wdfComponent = nullptr;
 		}
 
-		shelvingFilter.reset(_sampleRate);
-
-		return true;
+		// --- decode and set
+		if (componentType == wdfComponent::R)
+		{
+			wdfComponent = new WdfResistor;
+			wdfComponent->setComponentValue(value1);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::L)
+		{
+			wdfComponent = new WdfInductor;
+			wdfComponent->setComponentValue(value1);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::C)
+		{
+			wdfComponent = new WdfCapacitor;
+			wdfComponent->setComponentValue(value1);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::seriesLC)
+		{
+			wdfComponent = new WdfSeriesLC;
+			wdfComponent->setComponentValue_LC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::parallelLC)
+		{
+			wdfComponent = new WdfParallelLC;
+			wdfComponent->setComponentValue_LC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::seriesRL)
+		{
+			wdfComponent = new WdfSeriesRL;
+			wdfComponent->setComponentValue_RL(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::parallelRL)
+		{
+			wdfComponent = new WdfParallelRL;
+			wdfComponent->setComponentValue_RL(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::seriesRC)
+		{
+			wdfComponent = new WdfSeriesRC;
+			wdfComponent->setComponentValue_RC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::parallelRC)
+		{
+			wdfComponent = new WdfParallelRC;
+			wdfComponent->setComponentValue_RC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ClassATubePreParameters custom data structure
-	*/
-	ClassATubePreParameters getParameters() { return parameters; }
-
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param ClassATubePreParameters custom data structure
-	*/
-	void setParameters(const ClassATubePreParameters& params)
+	/** connect two adapters together upstreamAdaptor --> downstreamAdaptor */
+	static void connectAdaptors(WdfAdaptorBase* upstreamAdaptor, WdfAdaptorBase* downstreamAdaptor)
 	{
-		// --- check for re-calc
-		if (params.inputLevel_dB != parameters.inputLevel_dB)
-			inputLevel = pow(10.0, params.inputLevel_dB / 20.0);
-		if (params.outputLevel_dB != parameters.outputLevel_dB)
-			outputLevel = pow(10.0, params.outputLevel_dB / 20.0);
-
-		// --- store
-		parameters = params;
-
-		// --- shelving filter update
-		TwoBandShelvingFilterParameters sfParams = shelvingFilter.getParameters();
-		sfParams.lowShelf_fc = parameters.lowShelf_fc;
-		sfParams.lowShelfBoostCut_dB = parameters.lowShelfBoostCut_dB;
-		sfParams.highShelf_fc = parameters.highShelf_fc;
-		sfParams.highShelfBoostCut_dB = parameters.highShelfBoostCut_dB;
-		shelvingFilter.setParameters(sfParams);
-
-		// --- triode updates
-		TriodeClassAParameters tubeParams = triodes[0].getParameters();
-		tubeParams.saturation = parameters.saturation;
-		tubeParams.asymmetry = parameters.asymmetry;
+		upstreamAdaptor->setPort2_CompAdaptor(downstreamAdaptor);
+		downstreamAdaptor->setPort1_CompAdaptor(upstreamAdaptor);
+	}
 
-		for (uint32_t i = 0; i < NUM_TUBES; i++)
-			triodes[i].setParameters(tubeParams);
+	/** initialize the chain of adaptors from upstreamAdaptor --> downstreamAdaptor */
+	virtual void initializeAdaptorChain()
+	{
+		initialize(sourceResistance);
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** set value of single-component adaptor */
+	virtual void setComponentValue(double _componentValue)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue(_componentValue);
+	}
 
-	/** process the input through the four tube models in series */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** set LC value of mjulti-component adaptor */
+	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C)
 	{
-		double output1 = triodes[0].processAudioSample(xn*inputLevel);
-		double output2 = triodes[1].processAudioSample(output1);
-		double output3 = triodes[2].processAudioSample(output2);
+		if (wdfComponent)
+			wdfComponent->setComponentValue_LC(componentValue_L, componentValue_C);
+	}
 
-		// --- filter stage is between 3 and 4
-		double outputEQ = shelvingFilter.processAudioSample(output3);
-		double output4 = triodes[3].processAudioSample(outputEQ);
+	/** set RL value of mjulti-component adaptor */
+	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue_RL(componentValue_R, componentValue_L);
+	}
 
-		return output4*outputLevel;
+	/** set RC value of mjulti-component adaptor */
+	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue_RC(componentValue_R, componentValue_C);
 	}
 
-protected:
-	ClassATubePreParameters parameters;		///< object parameters
-	TriodeClassA triodes[NUM_TUBES];		///< array of triode tube objects
-	TwoBandShelvingFilter shelvingFilter;	///< shelving filters
+	/** get adaptor connected at port 1: for extended functionality; not used in WDF ladder filter library */
+	IComponentAdaptor* getPort1_CompAdaptor() { return port1CompAdaptor; }
 
-	double inputLevel = 1.0;	///< input level (not in dB)
-	double outputLevel = 1.0;	///< output level (not in dB)
-};
+	/** get adaptor connected at port 2: for extended functionality; not used in WDF ladder filter library */
+	IComponentAdaptor* getPort2_CompAdaptor() { return port2CompAdaptor; }
 
+	/** get adaptor connected at port 3: for extended functionality; not used in WDF ladder filter library */
+	IComponentAdaptor* getPort3_CompAdaptor() { return port3CompAdaptor; }
 
-/**
-\struct BitCrusherParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the BitCrusher object.
+protected:
+	// --- can in theory connect any port to a component OR adaptor;
+	//     though this library is setup with a convention R3 = component
+	IComponentAdaptor* port1CompAdaptor = nullptr;	///< componant or adaptor connected to port 1
+	IComponentAdaptor* port2CompAdaptor = nullptr;	///< componant or adaptor connected to port 2
+	IComponentAdaptor* port3CompAdaptor = nullptr;	///< componant or adaptor connected to port 3
+	IComponentAdaptor* wdfComponent = nullptr;		///< WDF componant connected to port 3 (default operation)
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct BitCrusherParameters
-{
-	BitCrusherParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	BitCrusherParameters& operator=(const BitCrusherParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+	// --- These hold the input (R1), component (R3) and output (R2) resistances
+	double R1 = 0.0; ///< input port resistance
+	double R2 = 0.0; ///< output port resistance
+	double R3 = 0.0; ///< component resistance
 
-		quantizedBitDepth = params.quantizedBitDepth;
+	// --- these are input variables that are stored;
+	//     not used in this implementation but may be required for extended versions
+	double in1 = 0.0;	///< stored port 1 input;  not used in this implementation but may be required for extended versions
+	double in2 = 0.0;	///< stored port 2 input;  not used in this implementation but may be required for extended versions
+	double in3 = 0.0;	///< stored port 3 input;  not used in this implementation but may be required for extended versions
 
-		return *this;
-	}
+	// --- these are output variables that are stored;
+	//     currently out2 is the only one used as it is y(n) for this library
+	//     out1 and out2 are stored; not used in this implementation but may be required for extended versions
+	double out1 = 0.0;	///< stored port 1 output; not used in this implementation but may be required for extended versions
+	double out2 = 0.0;	///< stored port 2 output; it is y(n) for this library
+	double out3 = 0.0;	///< stored port 3 output; not used in this implementation but may be required for extended versions
 
-	double quantizedBitDepth = 4.0; ///< bid depth of quantizer
+	// --- terminal impedance
+	double terminalResistance = 600.0; ///< value of terminal (load) resistance
+	bool openTerminalResistance = false; ///< flag for open circuit load
+
+	// --- source impedance, OK for this to be set to 0.0 for Rs = 0
+	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
 };
 
 /**
-\class BitCrusher
-\ingroup FX-Objects
+\class WdfSeriesAdaptor
+\ingroup WDF-Objects
 \brief
-The BitCrusher object implements a quantizing bitcrusher algorithm.
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- Use BitCrusherParameters structure to get/set object params.
+The WdfSeriesAdaptor object implements the series reflection-free (non-terminated) adaptor
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class BitCrusher : public IAudioSignalProcessor
+class WdfSeriesAdaptor : public WdfAdaptorBase
 {
 public:
-	BitCrusher() {}		/* C-TOR */
-	~BitCrusher() {}		/* D-TOR */
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate){ return true; }
-
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return BitCrusherParameters custom data structure
-	*/
-	BitCrusherParameters getParameters() { return parameters; }
+	WdfSeriesAdaptor() {}
+	virtual ~WdfSeriesAdaptor() {}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param BitCrusherParameters custom data structure
-	*/
-	void setParameters(const BitCrusherParameters& params)
+	/** get the resistance at port 2; R2 = R1 + component (series)*/
+	virtual double getR2()
 	{
-		// --- calculate and store
-		if (params.quantizedBitDepth != parameters.quantizedBitDepth)
-			QL = 2.0 / (pow(2.0, params.quantizedBitDepth) - 1.0);
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
 
-		parameters = params;
+		R2 = R1 + componentResistance;
+		return R2;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** perform the bitcrushing operation (see FX book for back story and details) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
 	{
-		return QL*(int(xn / QL));
-	}
-
-protected:
-	BitCrusherParameters parameters; ///< object parameters
-	double QL = 1.0;				 ///< the quantization level
-};
-
-
-// ------------------------------------------------------------------ //
-// --- WDF LIBRARY -------------------------------------------------- //
-// ------------------------------------------------------------------ //
-
-/**
-\class IComponentAdaptor
-\ingroup Interfaces
-\brief
-Use this interface for objects in the WDF Ladder Filter library; see book for more information.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class IComponentAdaptor
-{
-public:
-	/** initialize with source resistor R1 */
-	virtual void initialize(double _R1) {}
+		// --- R1 is source resistance for this adaptor
+		R1 = _R1;
 
-	/** initialize all downstream adaptors in the chain */
-	virtual void initializeAdaptorChain() {}
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
 
-	/** set input value into component port  */
-	virtual void setInput(double _in) {}
+		// --- calculate B coeff
+		B = R1 / (R1 + componentResistance);
 
-	/** get output value from component port  */
-	virtual double getOutput() { return 0.0; }
+		// --- init downstream adaptor
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
 
-	// --- for adaptors
-	/** ADAPTOR: set input port 1  */
-	virtual void setInput1(double _in1) = 0;
+		// --- not used in this implementation but saving for extended use
+		R3 = componentResistance;
+	}
 
-	/** ADAPTOR: set input port 2  */
-	virtual void setInput2(double _in2) = 0;
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
 
-	/** ADAPTOR: set input port 3 */
-	virtual void setInput3(double _in3) = 0;
+		// --- read component value
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
 
-	/** ADAPTOR: get output port 1 value */
-	virtual double getOutput1() = 0;
+		// --- form output
+		out2 = -(in1 + N2);
 
-	/** ADAPTOR: get output port 2 value */
-	virtual double getOutput2() = 0;
+		// --- deliver downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->setInput1(out2);
+	}
 
-	/** ADAPTOR: get output port 3 value */
-	virtual double getOutput3() = 0;
+	/** push audio input sample into reflected wave input */
+	virtual void setInput2(double _in2)
+	{
+		// --- save
+		in2 = _in2;
 
-	/** reset the object with new sample rate */
-	virtual void reset(double _sampleRate) {}
+		// --- calc N1
+		N1 = -(in1 - B*(in1 + N2 + in2) + in2);
 
-	/** get the commponent resistance from the attached object at Port3 */
-	virtual double getComponentResistance() { return 0.0; }
+		// --- calc out1
+		out1 = in1 - B*(N2 + in2);
 
-	/** get the commponent conductance from the attached object at Port3 */
-	virtual double getComponentConductance() { return 0.0; }
+		// --- deliver upstream
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
 
-	/** update the commponent resistance at Port3 */
-	virtual void updateComponentResistance() {}
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
 
-	/** set an individual component value (may be R, L, or C */
-	virtual void setComponentValue(double _componentValue) { }
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3){ }
 
-	/** set LC combined values */
-	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C) { }
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
 
-	/** set RL combined values */
-	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L) { }
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
 
-	/** set RC combined values */
-	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C) { }
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
 
-	/** get a component value */
-	virtual double getComponentValue() { return 0.0; }
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double B = 0.0;		///< B coefficient value
 };
 
-// ------------------------------------------------------------------ //
-// --- WDF COMPONENTS & COMMBO COMPONENTS --------------------------- //
-// ------------------------------------------------------------------ //
 /**
-\class WdfResistor
+\class WdfSeriesTerminatedAdaptor
 \ingroup WDF-Objects
 \brief
-The WdfResistor object implements the reflection coefficient and signal flow through
-a WDF simulated resistor.
+The WdfSeriesTerminatedAdaptor object implements the series terminated (non-reflection-free) adaptor
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfResistor : public IComponentAdaptor
+// --- Series terminated adaptor
+class WdfSeriesTerminatedAdaptor : public WdfAdaptorBase
 {
 public:
-	WdfResistor(double _componentValue) { componentValue = _componentValue; }
-	WdfResistor() { }
-	virtual ~WdfResistor() {}
+	WdfSeriesTerminatedAdaptor() {}
+	virtual ~WdfSeriesTerminatedAdaptor() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** get the resistance at port 2; R2 = R1 + component (series)*/
+	virtual double getR2()
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+
+		R2 = R1 + componentResistance;
+		return R2;
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- source impedance
+		R1 = _R1;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
 
-	/** get the component value */
-	virtual double getComponentValue() { return componentValue; }
+		B1 = (2.0*R1) / (R1 + componentResistance + terminalResistance);
+		B3 = (2.0*terminalResistance) / (R1 + componentResistance + terminalResistance);
 
-	/** set the component value */
-	virtual void setComponentValue(double _componentValue)
-	{
-		componentValue = _componentValue;
-		updateComponentResistance();
+		// --- init downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = componentResistance;
 	}
 
-	/** change the resistance of component */
-	virtual void updateComponentResistance() { componentResistance = componentValue; }
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate);  zRegister = 0.0; }
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
 
-	/** set input value into component; NOTE: resistor is dead-end energy sink so this function does nothing */
-	virtual void setInput(double in) {}
+		double N3 = in1 + N2;
 
-	/** get output value; NOTE: a WDF resistor produces no reflected output */
-	virtual double getOutput() { return 0.0; }
+		// --- calc out2 y(n)
+		out2 = -B3*N3;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		// --- form output1
+		out1 = in1 - B1*N3;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- form N1
+		N1 = -(out1 + out2 + N3);
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- deliver upstream to input2
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** push audio input sample into reflected wave input
+	    for terminated adaptor, this is dead end, just store it */
+	virtual void setInput2(double _in2) { in2 = _in2;}
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3) { in3 = _in3;}
 
-protected:
-	double zRegister = 0.0;			///< storage register (not used with resistor)
-	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
-	double componentResistance = 0.0;///< simulated resistance
-	double sampleRate = 0.0;		///< sample rate
-};
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
+
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
+
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
 
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double B1 = 0.0;	///< B1 coefficient value
+	double B3 = 0.0;	///< B3 coefficient value
+};
 
 /**
-\class WdfCapacitor
+\class WdfParallelAdaptor
 \ingroup WDF-Objects
 \brief
-The WdfCapacitor object implements the reflection coefficient and signal flow through
-a WDF simulated capacitor.
+The WdfParallelAdaptor object implements the parallel reflection-free (non-terminated) adaptor
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfCapacitor : public IComponentAdaptor
+class WdfParallelAdaptor : public WdfAdaptorBase
 {
 public:
-	WdfCapacitor(double _componentValue) { componentValue = _componentValue; }
-	WdfCapacitor() { }
-	virtual ~WdfCapacitor() {}
+	WdfParallelAdaptor() {}
+	virtual ~WdfParallelAdaptor() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
+	virtual double getR2()
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+
+		// --- 1 / (sum of admittances)
+		R2 = 1.0 / ((1.0 / R1) + componentConductance);
+		return R2;
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- save R1
+		R1 = _R1;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		double G1 = 1.0 / R1;
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
 
-	/** get the component value */
-	virtual double getComponentValue() { return componentValue; }
+		// --- calculate B coeff
+		A = G1 / (G1 + componentConductance);
 
-	/** set the component value */
-	virtual void setComponentValue(double _componentValue)
-	{
-		componentValue = _componentValue;
-		updateComponentResistance();
+		// --- now, do we init our downstream??
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = 1.0/ componentConductance;
 	}
 
-	/** change the resistance of component */
-	virtual void updateComponentResistance()
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
 	{
-		componentResistance = 1.0 / (2.0*componentValue*sampleRate);
+		// --- save
+		in1 = _in1;
+
+		// --- read component
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
+
+		// --- form output
+		out2 = N2 - A*(-in1 + N2);
+
+		// --- deliver downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->setInput1(out2);
 	}
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
+	/** push audio input sample into reflected wave input*/
+	virtual void setInput2(double _in2)
+	{
+		// --- save
+		in2 = _in2;
 
-	/** set input value into component; NOTE: capacitor sets value into register*/
-	virtual void setInput(double in) { zRegister = in; }
+		// --- calc N1
+		N1 = in2 - A*(-in1 + N2);
 
-	/** get output value; NOTE: capacitor produces reflected output */
-	virtual double getOutput() { return zRegister; }	// z^-1
+		// --- calc out1
+		out1 = -in1 + N2 + N1;
 
-	/** get output1 value; only one capacitor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		// --- deliver upstream
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
 
-	/** get output2 value; only one capacitor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
 
-	/** get output3 value; only one capacitor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3) { }
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
 
-protected:
-	double zRegister = 0.0;			///< storage register (not used with resistor)
-	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
-	double componentResistance = 0.0;///< simulated resistance
-	double sampleRate = 0.0;		///< sample rate
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double A = 0.0;		///< A coefficient value
 };
 
+
 /**
-\class WdfInductor
+\class WdfParallelTerminatedAdaptor
 \ingroup WDF-Objects
 \brief
-The WdfInductor object implements the reflection coefficient and signal flow through
-a WDF simulated inductor.
+The WdfParallelTerminatedAdaptor object implements the parallel  terminated (non-reflection-free) adaptor
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfInductor : public IComponentAdaptor
+class WdfParallelTerminatedAdaptor : public WdfAdaptorBase
 {
 public:
-	WdfInductor(double _componentValue) { componentValue = _componentValue; }
-	WdfInductor() { }
-	virtual ~WdfInductor() {}
+	WdfParallelTerminatedAdaptor() {}
+	virtual ~WdfParallelTerminatedAdaptor() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
+	virtual double getR2()
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+
+		// --- 1 / (sum of admittances)
+		R2 = 1.0 / ((1.0 / R1) + componentConductance);
+		return R2;
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- save R1
+		R1 = _R1;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		double G1 = 1.0 / R1;
+		if (terminalResistance <= 0.0)
+			terminalResistance = 1e-15;
 
-	/** get the component value */
-	virtual double getComponentValue() { return componentValue; }
+		double G2 = 1.0 / terminalResistance;
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
 
-	/** set the component value */
-	virtual void setComponentValue(double _componentValue)
-	{
-		componentValue = _componentValue;
-		updateComponentResistance();
+		A1 = 2.0*G1 / (G1 + componentConductance + G2);
+		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
+
+		// --- init downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = 1.0 / componentConductance;
 	}
 
-	/** change the resistance of component R(L) = 2Lfs */
-	virtual void updateComponentResistance(){ componentResistance = 2.0*componentValue*sampleRate;}
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
 
-	/** set input value into component; NOTE: inductor sets value into storage register */
-	virtual void setInput(double in) { zRegister = in; }
+		// --- form N1
+		N1 = -A1*(-in1 + N2) + N2 - A3*N2;
 
-	/** get output value; NOTE: a WDF inductor produces reflected output that is inverted */
-	virtual double getOutput() { return -zRegister; } // -z^-1
+		// --- form output1
+		out1 = -in1 + N2 + N1;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		// --- deliver upstream to input2
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- calc out2 y(n)
+		out2 = N2 + N1;
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** push audio input sample into reflected wave input; this is a dead end for terminated adaptorsthis is a dead end for terminated adaptors  */
+	virtual void setInput2(double _in2){ in2 = _in2;}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3) { }
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
 
-protected:
-	double zRegister = 0.0;			///< storage register (not used with resistor)
-	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
-	double componentResistance = 0.0;///< simulated resistance
-	double sampleRate = 0.0;		///< sample rate
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
+
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
+
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double A1 = 0.0;	///< A1 coefficient value
+	double A3 = 0.0;	///< A3 coefficient value
 };
 
+// ------------------------------------------------------------------ //
+// --- COMPILE-TIME WDF LADDERS ------------------------------------- //
+// ------------------------------------------------------------------ //
+//
+// --- the adaptor objects above are wired at run time through IComponentAdaptor
+//     pointers; the templates below describe the same ladders as types instead:
+//
+//     WdfLadder< WdfSeriesStage<WdfSeriesRL>, WdfParallelTerminatedStage<WdfCapacitor> >
+//
+//     Each stage stores its component by value and the chain is unrolled by the
+//     compiler, so the per-sample scattering is straight-line code with no virtual
+//     calls or heap components. The math matches the run-time adaptors exactly.
 
 /**
-\class WdfSeriesLC
+\class WdfSeriesStage
 \ingroup WDF-Objects
 \brief
-The WdfSeriesLC object implements the reflection coefficient and signal flow through
-a WDF simulated series LC pair.
+The WdfSeriesStage object is the compile-time version of the WdfSeriesAdaptor; the component
+at port 3 is stored inline.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WdfSeriesLC : public IComponentAdaptor
+template <class Component>
+class WdfSeriesStage
 {
 public:
-	WdfSeriesLC() {}
-	WdfSeriesLC(double _componentValue_L, double _componentValue_C)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-	}
-	virtual ~WdfSeriesLC() {}
-
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
-
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
-
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
-
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RL = 2.0*componentValue_L*sampleRate;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = RL + (1.0 / RC);
-	}
-
-	/** set both LC components at once */
-	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+	/** reset the component */
+	void reset(double _sampleRate) { component.reset(_sampleRate); }
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
-	}
-
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
-	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
-
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
-
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
-
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
-
-	/** set input value into component; NOTE: K is calculated here */
-	virtual void setInput(double in)
+	/** set port 1 resistance and calculate B; returns the port 2 resistance for the next stage */
+	double initialize(double _R1)
 	{
-		double YC = 1.0 / RC;
-		double K = (1.0 - RL*YC) / (1.0 + RL*YC);
-		double N1 = K*(in - zRegister_L);
-		zRegister_L = N1 + zRegister_C;
-		zRegister_C = in;
+		R1 = _R1;
+		double componentResistance = component.getComponentResistance();
+		B = R1 / (R1 + componentResistance);
+		return R1 + componentResistance;
 	}
 
-	/** get output value; NOTE: utput is located in zReg_L */
-	virtual double getOutput(){ return zRegister_L; }
-
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+	/** per-sample coefficients for table tuning: B, then the component's */
+	static const unsigned int numCoefficients = 1 + Component::numCoefficients;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = B; component.storeCoefficients(coeffs + 1); }
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { B = coeffs[0]; component.loadCoefficients(coeffs + 1); }
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** forward wave: port 1 in, port 2 out */
+	inline double forward(double _in1)
+	{
+		in1 = _in1;
+		N2 = component.getOutput();
+		return -(in1 + N2);
+	}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** reflected wave: port 2 in, port 1 out; updates the component state */
+	inline double backward(double in2)
+	{
+		double N1 = -(in1 - B*(in1 + N2 + in2) + in2);
+		double out1 = in1 - B*(N2 + in2);
+		component.setInput(N1);
+		return out1;
+	}
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	Component component;	///< component at port 3, stored inline
 
 protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-
-	double componentValue_L = 0.0; ///< component value L
-	double componentValue_C = 0.0; ///< component value C
-
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	double R1 = 0.0;	///< input port resistance
+	double B = 0.0;		///< B coefficient value
+	double in1 = 0.0;	///< stored port 1 input
+	double N2 = 0.0;	///< node 2 value
 };
 
 /**
-\class WdfParallelLC
+\class WdfParallelStage
 \ingroup WDF-Objects
 \brief
-The WdfParallelLC object implements the reflection coefficient and signal flow through
-a WDF simulated parallel LC pair.
+The WdfParallelStage object is the compile-time version of the WdfParallelAdaptor; the component
+at port 3 is stored inline.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WdfParallelLC : public IComponentAdaptor
+template <class Component>
+class WdfParallelStage
 {
 public:
-	WdfParallelLC() {}
-	WdfParallelLC(double _componentValue_L, double _componentValue_C)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-	}
-	virtual ~WdfParallelLC() {}
+	/** reset the component */
+	void reset(double _sampleRate) { component.reset(_sampleRate); }
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** set port 1 resistance and calculate A; returns the port 2 resistance for the next stage */
+	double initialize(double _R1)
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		R1 = _R1;
+		double G1 = 1.0 / R1;
+		double componentConductance = component.getComponentConductance();
+		A = G1 / (G1 + componentConductance);
+		return 1.0 / ((1.0 / R1) + componentConductance);
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** per-sample coefficients for table tuning: A, then the component's */
+	static const unsigned int numCoefficients = 1 + Component::numCoefficients;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = A; component.storeCoefficients(coeffs + 1); }
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RL = 2.0*componentValue_L*sampleRate;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = (RC + 1.0 / RL);
-	}
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { A = coeffs[0]; component.loadCoefficients(coeffs + 1); }
 
-	/** set both LC components at once */
-	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
+	/** forward wave: port 1 in, port 2 out */
+	inline double forward(double _in1)
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
+		in1 = _in1;
+		N2 = component.getOutput();
+		return N2 - A*(-in1 + N2);
 	}
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
+	/** reflected wave: port 2 in, port 1 out; updates the component state */
+	inline double backward(double in2)
 	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
+		double N1 = in2 - A*(-in1 + N2);
+		double out1 = -in1 + N2 + N1;
+		component.setInput(N1);
+		return out1;
 	}
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
-	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+	Component component;	///< component at port 3, stored inline
 
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
+protected:
+	double R1 = 0.0;	///< input port resistance
+	double A = 0.0;		///< A coefficient value
+	double in1 = 0.0;	///< stored port 1 input
+	double N2 = 0.0;	///< node 2 value
+};
 
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
+/**
+\class WdfSeriesTerminatedStage
+\ingroup WDF-Objects
+\brief
+The WdfSeriesTerminatedStage object is the compile-time version of the WdfSeriesTerminatedAdaptor;
+it must be the last stage of a WdfLadder.
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+\version Revision : 1.0
+*/
+template <class Component>
+class WdfSeriesTerminatedStage
+{
+public:
+	/** reset the component */
+	void reset(double _sampleRate) { component.reset(_sampleRate); }
 
-	/** set input value into component; NOTE: K is calculated here */
-	virtual void setInput(double in)
+	/** set the load resistance */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set port 1 resistance and calculate B1, B3 */
+	void initialize(double _R1)
 	{
-		double YL = 1.0 / RL;
-		double K = (YL*RC - 1.0) / (YL*RC + 1.0);
-		double N1 = K*(in - zRegister_L);
-		zRegister_L = N1 + zRegister_C;
-		zRegister_C = in;
+		R1 = _R1;
+		double componentResistance = component.getComponentResistance();
+		B1 = (2.0*R1) / (R1 + componentResistance + terminalResistance);
+		B3 = (2.0*terminalResistance) / (R1 + componentResistance + terminalResistance);
 	}
 
-	/** get output value; NOTE: output is located in -zReg_L */
-	virtual double getOutput(){ return -zRegister_L; }
-
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+	/** per-sample coefficients for table tuning: B1, B3, then the component's */
+	static const unsigned int numCoefficients = 2 + Component::numCoefficients;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = B1; coeffs[1] = B3; component.storeCoefficients(coeffs + 2); }
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { B1 = coeffs[0]; B3 = coeffs[1]; component.loadCoefficients(coeffs + 2); }
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** port 1 in; calculates y(n) at port 2 and returns the reflected wave at port 1 */
+	inline double scatter(double in1)
+	{
+		double N2 = component.getOutput();
+		double N3 = in1 + N2;
+		out2 = -B3*N3;
+		double out1 = in1 - B1*N3;
+		component.setInput(-(out1 + out2 + N3));
+		return out1;
+	}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** y(n) */
+	double getOutput2() { return out2; }
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	Component component;	///< component at port 3, stored inline
 
 protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-
-	double componentValue_L = 0.0; ///< component value L
-	double componentValue_C = 0.0; ///< component value C
-
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	double R1 = 0.0;	///< input port resistance
+	double B1 = 0.0;	///< B1 coefficient value
+	double B3 = 0.0;	///< B3 coefficient value
+	double out2 = 0.0;	///< port 2 output y(n)
+	double terminalResistance = 600.0; ///< value of terminal (load) resistance
 };
 
-
 /**
-\class WdfSeriesRL
+\class WdfParallelTerminatedStage
 \ingroup WDF-Objects
 \brief
-The WdfSeriesRL object implements the reflection coefficient and signal flow through
-a WDF simulated series RL pair.
+The WdfParallelTerminatedStage object is the compile-time version of the WdfParallelTerminatedAdaptor;
+it must be the last stage of a WdfLadder.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WdfSeriesRL : public IComponentAdaptor
+template <class Component>
+class WdfParallelTerminatedStage
 {
 public:
-	WdfSeriesRL() {}
-	WdfSeriesRL(double _componentValue_R, double _componentValue_L)
+	/** reset the component */
+	void reset(double _sampleRate) { component.reset(_sampleRate); }
+
+	/** set the load resistance */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set an open circuit load */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
+		// --- flag overrides value
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
 	}
-	virtual ~WdfSeriesRL() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** set port 1 resistance and calculate A1, A3 */
+	void initialize(double _R1)
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		R1 = _R1;
+		double G1 = 1.0 / R1;
+		if (terminalResistance <= 0.0)
+			terminalResistance = 1e-15;
+
+		double G2 = 1.0 / terminalResistance;
+		double componentConductance = component.getComponentConductance();
+
+		A1 = 2.0*G1 / (G1 + componentConductance + G2);
+		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** per-sample coefficients for table tuning: A1, A3, then the component's */
+	static const unsigned int numCoefficients = 2 + Component::numCoefficients;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = A1; coeffs[1] = A3; component.storeCoefficients(coeffs + 2); }
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RR = componentValue_R;
-		RL = 2.0*componentValue_L*sampleRate;
-		componentResistance = RR + RL;
-		K = RR / componentResistance;
-	}
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { A1 = coeffs[0]; A3 = coeffs[1]; component.loadCoefficients(coeffs + 2); }
 
-	/** set both RL components at once */
-	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
+	/** port 1 in; calculates y(n) at port 2 and returns the reflected wave at port 1 */
+	inline double scatter(double in1)
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
+		double N2 = component.getOutput();
+		double N1 = -A1*(-in1 + N2) + N2 - A3*N2;
+		out2 = N2 + N1;
+		component.setInput(N1);
+		return -in1 + N2 + N1;
 	}
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
-	}
+	/** y(n) */
+	double getOutput2() { return out2; }
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
-	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
+	Component component;	///< component at port 3, stored inline
 
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
+protected:
+	double R1 = 0.0;	///< input port resistance
+	double A1 = 0.0;	///< A1 coefficient value
+	double A3 = 0.0;	///< A3 coefficient value
+	double out2 = 0.0;	///< port 2 output y(n)
+	double terminalResistance = 600.0; ///< value of terminal (load) resistance
+	bool openTerminalResistance = false; ///< flag for open circuit load
+};
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
+/**
+\class WdfStageChain
+\ingroup WDF-Objects
+\brief
+The WdfStageChain object holds a list of WDF stages and unrolls the scattering through them at
+compile time; the last stage must be terminated. Used by WdfLadder.
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+\version Revision : 1.0
+*/
+template <class... Stages> class WdfStageChain;
 
-	/** set input value into component */
-	virtual void setInput(double in){ zRegister_L = in; }
+template <class Stage>
+class WdfStageChain<Stage>
+{
+public:
+	/** reset the terminated stage */
+	void reset(double _sampleRate) { stage.reset(_sampleRate); }
 
-	/** get output value; NOTE: see FX book for details */
-	virtual double getOutput()
-	{
-		double NL = -zRegister_L;
-		double out = NL*(1.0 - K) - K*zRegister_C;
-		zRegister_C = out;
+	/** initialize the terminated stage */
+	void initialize(double _R1) { stage.initialize(_R1); }
 
-		return out;
-	}
+	/** number of per-sample coefficients in the chain */
+	static const unsigned int numCoefficients = Stage::numCoefficients;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { stage.storeCoefficients(coeffs); }
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { stage.loadCoefficients(coeffs); }
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+	/** push the forward wave into the terminated stage; returns the reflected wave */
+	inline double scatter(double in1) { return stage.scatter(in1); }
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** y(n) */
+	double getOutput2() { return stage.getOutput2(); }
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	Stage stage;	///< terminated stage
+};
+
+template <class Stage, class... Rest>
+class WdfStageChain<Stage, Rest...>
+{
+public:
+	/** reset this stage and all downstream stages */
+	void reset(double _sampleRate) { stage.reset(_sampleRate); next.reset(_sampleRate); }
+
+	/** initialize this stage, then pass its port 2 resistance downstream */
+	void initialize(double _R1) { next.initialize(stage.initialize(_R1)); }
+
+	/** number of per-sample coefficients in the chain */
+	static const unsigned int numCoefficients = Stage::numCoefficients + WdfStageChain<Rest...>::numCoefficients;
+
+	/** store the per-sample coefficients, this stage first */
+	void storeCoefficients(double* coeffs)
+	{
+		stage.storeCoefficients(coeffs);
+		next.storeCoefficients(coeffs + Stage::numCoefficients);
+	}
+
+	/** load the per-sample coefficients, this stage first */
+	void loadCoefficients(const double* coeffs)
+	{
+		stage.loadCoefficients(coeffs);
+		next.loadCoefficients(coeffs + Stage::numCoefficients);
+	}
+
+	/** forward wave through this stage, scatter downstream, then reflect back through this stage */
+	inline double scatter(double in1) { return stage.backward(next.scatter(stage.forward(in1))); }
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** y(n) from the terminated stage */
+	double getOutput2() { return next.getOutput2(); }
 
-protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0;///< storage register for C (not used)
-	double K = 0.0;
+	Stage stage;				///< this stage
+	WdfStageChain<Rest...> next;	///< downstream stages
+};
 
-	double componentValue_L = 0.0;///< component value L
-	double componentValue_R = 0.0;///< component value R
+/**
+\struct WdfStageAt
+\ingroup WDF-Objects
+\brief
+Compile-time lookup of stage I in a WdfStageChain; use WdfLadder::getStage<I>() instead of using this directly.
+*/
+template <unsigned int I, class Chain> struct WdfStageAt;
 
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double RR = 0.0; ///< RR value
+template <class Stage, class... Rest>
+struct WdfStageAt<0, WdfStageChain<Stage, Rest...>>
+{
+	typedef Stage type;
+	static type& get(WdfStageChain<Stage, Rest...>& chain) { return chain.stage; }
+};
 
-	double componentResistance = 0.0; ///< equivalent resistance of pair of componen
-	double sampleRate = 0.0; ///< sample rate
+template <unsigned int I, class Stage, class... Rest>
+struct WdfStageAt<I, WdfStageChain<Stage, Rest...>>
+{
+	typedef typename WdfStageAt<I - 1, WdfStageChain<Rest...>>::type type;
+	static type& get(WdfStageChain<Stage, Rest...>& chain) { return WdfStageAt<I - 1, WdfStageChain<Rest...>>::get(chain.next); }
 };
 
 /**
-\class WdfParallelRL
+\class WdfLadder
 \ingroup WDF-Objects
 \brief
-The WdfParallelRL object implements the reflection coefficient and signal flow through
-a WDF simulated parallel RL pair.
+The WdfLadder object implements a complete WDF ladder described as a list of stage types;
+the first stage is driven by the source and the last stage must be terminated.
+
+Audio I/O:
+- Processes mono input to mono output (the terminated stage's port 2).
+
+Control I/F:
+- getStage<I>().component to set component values, then initializeAdaptorChain()
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WdfParallelRL : public IComponentAdaptor
+template <class... Stages>
+class WdfLadder
 {
 public:
-	WdfParallelRL() {}
-	WdfParallelRL(double _componentValue_R, double _componentValue_L)
+	/** reset the components and initialize the chain */
+	void reset(double _sampleRate)
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
+		chain.reset(_sampleRate);
+		initializeAdaptorChain();
 	}
-	virtual ~WdfParallelRL() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
+	/** set the source resistance seen by the first stage */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** recalculate the port resistances and coefficients; call after changing component values */
+	void initializeAdaptorChain() { chain.initialize(sourceResistance); }
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+	/** number of per-sample coefficients (reflection coefficients and component values) in the ladder */
+	static const unsigned int numCoefficients = WdfStageChain<Stages...>::numCoefficients;
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RR = componentValue_R;
-		RL = 2.0*componentValue_L*sampleRate;
-		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RL));
-		K = componentResistance / RR;
-	}
+	/** store the per-sample coefficients; with loadCoefficients( ) this allows tuning from precalculated tables */
+	void storeCoefficients(double* coeffs) { chain.storeCoefficients(coeffs); }
 
+	/** load per-sample coefficients stored with storeCoefficients( ); replaces initializeAdaptorChain( ) */
+	void loadCoefficients(const double* coeffs) { chain.loadCoefficients(coeffs); }
 
-	/** set both RL components at once */
-	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
+	/** process input x(n) through the ladder to produce return value y(n) */
+	inline double processAudioSample(double xn)
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
+		chain.scatter(xn);
+		return chain.getOutput2();
 	}
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
+	/** access stage I (0 = source end) */
+	template <unsigned int I>
+	typename WdfStageAt<I, WdfStageChain<Stages...>>::type& getStage()
 	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
+		return WdfStageAt<I, WdfStageChain<Stages...>>::get(chain);
 	}
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
-	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
+protected:
+	WdfStageChain<Stages...> chain;	///< the stages
+	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
+};
 
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
+/**
+\class WdfDiodePairRoot
+\ingroup WDF-Objects
+\brief
+The WdfDiodePairRoot object implements an antiparallel diode pair as the nonlinear root (last element)
+of a WdfLadder. The reflected wave is calculated in closed form with the Wright omega function
+(Werner et al., "An Improved and Generalized Diode Clipper Model for Wave Digital Filters", AES 2015)
+so the per-sample cost is fixed: no Newton iterations.
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
+Control I/F:
+- setDiodeParameters(Is, nVt) for saturation current and n x thermal voltage (default 1N4148)
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+\version Revision : 1.0
+*/
+class WdfDiodePairRoot
+{
+public:
+	/** set the diode saturation current and (ideality x thermal) voltage */
+	void setDiodeParameters(double _Is, double _nVt)
+	{
+		Is = _Is;
+		nVt = _nVt;
+		calculateConstants();
+	}
 
-	/** set input value into component */
-	virtual void setInput(double in){ zRegister_L = in; }
+	/** nothing to flush; the root is memoryless */
+	void reset(double /*_sampleRate*/) {}
 
-	/** get output value; NOTE: see FX book for details */
-	virtual double getOutput()
+	/** store the port resistance seen by the diodes */
+	void initialize(double _R1)
 	{
-		double NL = -zRegister_L;
-		double out = NL*(1.0 - K) + K*zRegister_C;
-		zRegister_C = out;
-		return out;
+		R = _R1;
+		calculateConstants();
 	}
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+	/** per-sample coefficients for table tuning: the port resistance */
+	static const unsigned int numCoefficients = 1;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* coeffs) { coeffs[0] = R; }
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* coeffs) { R = coeffs[0]; calculateConstants(); }
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** incident wave in; calculates the diode voltage and returns the reflected wave */
+	inline double scatter(double a)
+	{
+		// --- one diode conducts for each polarity
+		double absA = fabs(a);
+		double b = absA + twoRIs - twoNVt*wrightOmega(logRIsOverNVt + (absA + RIs) / nVt);
+		b = a < 0.0 ? -b : b;
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		out2 = 0.5*(a + b);
+		return b;
+	}
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** the voltage across the diodes */
+	double getOutput2() { return out2; }
 
 protected:
-	double zRegister_L = 0.0;	///< storage register for L
-	double zRegister_C = 0.0;	///< storage register for L
-	double K = 0.0;				///< K value
-
-	double componentValue_L = 0.0;	///< component value L
-	double componentValue_R = 0.0;	///< component value R
+	double Is = 2.52e-9;			///< saturation current
+	double nVt = 1.752*25.85e-3;	///< ideality factor x thermal voltage
+	double R = 1.0;					///< port resistance
+	double out2 = 0.0;				///< diode voltage
 
-	double RL = 0.0;	///< RL value
-	double RC = 0.0;	///< RC value
-	double RR = 0.0;	///< RR value
+	// --- cooked constants
+	double RIs = 0.0;				///< R x Is
+	double twoRIs = 0.0;			///< 2 x R x Is
+	double twoNVt = 0.0;			///< 2 x nVt
+	double logRIsOverNVt = 0.0;		///< log(R x Is / nVt)
 
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	/** cook the constants for the closed form solution */
+	void calculateConstants()
+	{
+		RIs = R*Is;
+		twoRIs = 2.0*RIs;
+		twoNVt = 2.0*nVt;
+		logRIsOverNVt = log(RIs / nVt);
+	}
 };
 
 /**
-\class WdfSeriesRC
+\class WdfTriodeRoot
 \ingroup WDF-Objects
 \brief
-The WdfSeriesRC object implements the reflection coefficient and signal flow through
-a WDF simulated series RC pair.
+The WdfTriodeRoot object implements the plate-cathode path of a triode (Koren model) as the nonlinear root
+(last element) of a WdfLadder; the grid-cathode voltage is a control input set each sample.
+
+The plate voltage is solved offline over a grid of incident wave and grid voltage values when the port
+resistance is set (initializeAdaptorChain) and bilinearly interpolated per sample, so the per-sample cost
+is fixed. Because the table depends on the port resistance, the components upstream should not be
+retuned while running. Grid current is not modelled.
+
+Control I/F:
+- setGridVoltage(vgk) each sample
+- setTubeConstants( ) for the Koren constants (default 12AX7)
+- setWaveRange( ), setGridRange( ) for the table limits; values outside are clamped
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WdfSeriesRC : public IComponentAdaptor
+class WdfTriodeRoot
 {
 public:
-	WdfSeriesRC() {}
-	WdfSeriesRC(double _componentValue_R, double _componentValue_C)
+	/** set the Koren model constants */
+	void setTubeConstants(double _mu, double _Ex, double _Kg1, double _Kp, double _Kvb)
 	{
-		componentValue_C = _componentValue_C;
-		componentValue_R = _componentValue_R;
+		mu = _mu;
+		Ex = _Ex;
+		Kg1 = _Kg1;
+		Kp = _Kp;
+		Kvb = _Kvb;
+		tableValid = false;
 	}
-	virtual ~WdfSeriesRC() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** set the incident wave range covered by the table */
+	void setWaveRange(double _aMin, double _aMax) { aMin = _aMin; aMax = _aMax; tableValid = false; }
+
+	/** set the grid voltage range covered by the table */
+	void setGridRange(double _vgMin, double _vgMax) { vgMin = _vgMin; vgMax = _vgMax; tableValid = false; }
+
+	/** set the grid-cathode voltage for the next sample */
+	void setGridVoltage(double _vgk) { vgk = _vgk; }
+
+	/** nothing to flush; the root is memoryless */
+	void reset(double /*_sampleRate*/) {}
+
+	/** store the port resistance; rebuilds the table when it changes */
+	void initialize(double _R1)
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		if (!tableValid || _R1 != R)
+		{
+			R = _R1;
+			calculateTable();
+		}
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	/** no per-sample coefficients; the table is tied to the port resistance */
+	static const unsigned int numCoefficients = 0;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+	/** store the per-sample coefficients */
+	void storeCoefficients(double* /*coeffs*/) {}
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
+	/** load the per-sample coefficients */
+	void loadCoefficients(const double* /*coeffs*/) {}
+
+	/** incident wave in; looks up the plate voltage and returns the reflected wave */
+	inline double scatter(double a)
 	{
-		RR = componentValue_R;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = RR + RC;
-		K = RR / componentResistance;
+		// --- no plate current for a <= 0
+		if (a <= 0.0)
+		{
+			out2 = a;
+			return a;
+		}
+
+		double x = (a - aMin)*aScale;
+		double y = (vgk - vgMin)*vgScale;
+		x = fmin(fmax(x, 0.0), TRIODE_TABLE_WAVES - 1.000001);
+		y = fmin(fmax(y, 0.0), TRIODE_TABLE_GRID - 1.000001);
+
+		unsigned int i = (unsigned int)x;
+		unsigned int j = (unsigned int)y;
+		double fx = x - i;
+		double fy = y - j;
+
+		const double* row0 = &table[j*TRIODE_TABLE_WAVES + i];
+		const double* row1 = row0 + TRIODE_TABLE_WAVES;
+		double v0 = row0[0] + fx*(row0[1] - row0[0]);
+		double v1 = row1[0] + fx*(row1[1] - row1[0]);
+
+		out2 = v0 + fy*(v1 - v0);
+		return 2.0*out2 - a;
 	}
 
-	/** set both RC components at once */
-	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
+	/** the plate voltage */
+	double getOutput2() { return out2; }
+
+	/** Koren plate current for plate and grid voltages */
+	double getPlateCurrent(double vpk, double _vgk)
 	{
-		componentValue_R = _componentValue_R;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
+		if (vpk <= 0.0)
+			return 0.0;
+
+		double arg = Kp*(1.0 / mu + _vgk / sqrt(Kvb + vpk*vpk));
+		double E1 = (vpk / Kp)*(arg > 30.0 ? arg : log(1.0 + exp(arg)));
+		return E1 > 0.0 ? 2.0*pow(E1, Ex) / Kg1 : 0.0;
 	}
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
+	/** solve (a - v)/Rs = Ip(v, vgk) for the plate voltage v; used offline for the table and DC operating points */
+	double solvePlateVoltage(double a, double Rs, double _vgk, double guess = -1.0)
 	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
+		if (a <= 0.0)
+			return a;
+
+		// --- bracketed Newton: the residual falls monotonically from a/Rs at v = 0
+		double lo = 0.0;
+		double hi = a;
+		double v = (guess > lo && guess < hi) ? guess : 0.5*a;
+
+		for (unsigned int n = 0; n < 60; n++)
+		{
+			double f = (a - v) / Rs - getPlateCurrent(v, _vgk);
+			if (f > 0.0) lo = v; else hi = v;
+
+			double dv = 1.0e-6*(1.0 + v);
+			double df = ((a - v - dv) / Rs - getPlateCurrent(v + dv, _vgk) - f) / dv;
+			double vNext = df < 0.0 ? v - f / df : 0.5*(lo + hi);
+			if (vNext <= lo || vNext >= hi)
+				vNext = 0.5*(lo + hi);
+
+			if (fabs(vNext - v) < 1.0e-9*(1.0 + a))
+				return vNext;
+			v = vNext;
+		}
+		return v;
 	}
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
-	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
+protected:
+	// --- Koren constants (12AX7)
+	double mu = 100.0;	///< amplification factor
+	double Ex = 1.4;	///< exponent
+	double Kg1 = 1060.0;///< Kg1
+	double Kp = 600.0;	///< Kp
+	double Kvb = 300.0;	///< Kvb
+
+	double vgk = 0.0;	///< grid-cathode voltage
+	double R = 1.0;		///< port resistance
+	double out2 = 0.0;	///< plate voltage
+
+	// --- table of plate voltage over [vgk][a]
+	static const unsigned int TRIODE_TABLE_WAVES = 128;	///< incident wave grid points
+	static const unsigned int TRIODE_TABLE_GRID = 64;	///< grid voltage grid points
+	std::unique_ptr<double[]> table = nullptr;			///< plate voltage table
+	bool tableValid = false;	///< table matches R and the constants
+	double aMin = 0.0;			///< lowest incident wave
+	double aMax = 400.0;		///< highest incident wave
+	double vgMin = -6.0;		///< lowest grid voltage
+	double vgMax = 2.0;			///< highest grid voltage
+	double aScale = 1.0;		///< wave to table index
+	double vgScale = 1.0;		///< grid voltage to table index
+
+	/** solve the plate voltage at each grid point; warm-starts from the previous wave value */
+	void calculateTable()
+	{
+		if (!table)
+			table.reset(new double[TRIODE_TABLE_WAVES*TRIODE_TABLE_GRID]);
+
+		aScale = (TRIODE_TABLE_WAVES - 1) / (aMax - aMin);
+		vgScale = (TRIODE_TABLE_GRID - 1) / (vgMax - vgMin);
+
+		for (unsigned int j = 0; j < TRIODE_TABLE_GRID; j++)
+		{
+			double vg = vgMin + j / vgScale;
+			double v = -1.0;
+			for (unsigned int i = 0; i < TRIODE_TABLE_WAVES; i++)
+			{
+				v = solvePlateVoltage(aMin + i / aScale, R, vg, v);
+				table[j*TRIODE_TABLE_WAVES + i] = v;
+			}
+		}
+		tableValid = true;
 	}
+};
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
+// ------------------------------------------------------------------------------ //
+// --- WDF Ladder Filter Design  Examples --------------------------------------- //
+// ------------------------------------------------------------------------------ //
+//
+// --- 3rd order Butterworth LPF designed with Elsie www.TonneSoftware.comm
+//
+/*
+	3rd Order Inductor-Leading LPF
 
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
+	Rs = Rload = 600 ohms
+
+	Series(L1) -> Parallel(C1) -> Series(L2)
+
+	--L1-- | --L2--
+		   C1
+		   |
+
+	fc = 1kHz
+		L1 = 95.49e-3;
+		C1 = 0.5305e-6;
+		L2 = 95.49e-3;
+
+	fc = 10kHz
+		L1 = 9.549e-3;
+		C1 = 0.05305e-6;
+		L2 = 9.549e-3;
+*/
+
+/**
+\class WDFButterLPF3
+\ingroup WDF-Objects
+\brief
+The WDFButterLPF3 object implements a 3rd order Butterworth ladder filter.
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - this object is hard-wired.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WDFButterLPF3 : public IAudioSignalProcessor
+{
+public:
+	WDFButterLPF3(void) { createWDF(); }	/* C-TOR */
+	~WDFButterLPF3(void) {}	/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1.reset(_sampleRate);
+		parallelAdaptor_C1.reset(_sampleRate);
+		seriesTerminatedAdaptor_L2.reset(_sampleRate);
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1.initializeAdaptorChain();
+		return true;
+	}
 
-	/** set input value into component */
-	virtual void setInput(double in){ zRegister_L = in; }
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** get output value; NOTE: see FX book for details */
-	virtual double getOutput()
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		double NL = zRegister_L;
-		double out = NL*(1.0 - K) + K*zRegister_C;
-		zRegister_C = out;
-		return out;
-	}
+		// --- push audio sample into series L1
+		seriesAdaptor_L1.setInput1(xn);
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		// --- output is at terminated L2's output2
+		return seriesTerminatedAdaptor_L2.getOutput2();
+	}
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+	/** create the WDF structure for this object - may be called more than once */
+	void createWDF()
+	{
+		// --- actual component values fc = 1kHz
+		double L1_value = 95.49e-3;		// 95.5 mH
+		double C1_value = 0.5305e-6;	// 0.53 uF
+		double L2_value = 95.49e-3;		// 95.5 mH
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+										// --- set adapter components
+		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_value);
+		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_value);
+		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_value);
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		// --- set source resistance
+		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		// --- set terminal resistance
+		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+	}
 
 protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-	double K = 0.0;
-
-	double componentValue_R = 0.0;///< component value R
-	double componentValue_C = 0.0;///< component value C
-
-	double RL = 0.0;	///< RL value
-	double RC = 0.0;	///< RC value
-	double RR = 0.0;	///< RR value
-
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	// --- three adapters
+	WdfSeriesAdaptor seriesAdaptor_L1;			///< adaptor for L1
+	WdfParallelAdaptor parallelAdaptor_C1;		///< adaptor for C1
+	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
 };
 
 /**
-\class WdfParallelRC
+\class WDFTunableButterLPF3
 \ingroup WDF-Objects
 \brief
-The WdfParallelRC object implements the reflection coefficient and signal flow through
-a WDF simulated parallal RC pair.
+The WDFTunableButterLPF3 object implements a tunable 3rd order Butterworth ladder filter.
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setUsePostWarping(bool b) to enable/disable warping (see book)
+- setFilterFc(double fc_Hz) to set the tunable fc value
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelRC : public IComponentAdaptor
+class WDFTunableButterLPF3 : public IAudioSignalProcessor
 {
 public:
-	WdfParallelRC() {}
-	WdfParallelRC(double _componentValue_R, double _componentValue_C)
-	{
-		componentValue_C = _componentValue_C;
-		componentValue_R = _componentValue_R;
-	}
-	virtual ~WdfParallelRC() {}
+	WDFTunableButterLPF3(void) { createWDF(); }	/* C-TOR */
+	~WDFTunableButterLPF3(void) {}	/* D-TOR */
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
-
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
-
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1.reset(_sampleRate);
+		parallelAdaptor_C1.reset(_sampleRate);
+		seriesTerminatedAdaptor_L2.reset(_sampleRate);
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RR = componentValue_R;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RC));
-		K = componentResistance / RR;
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1.initializeAdaptorChain();
+		return true;
 	}
 
-	/** set both RC components at once */
-	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
-	{
-		componentValue_R = _componentValue_R;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
+		// --- push audio sample into series L1
+		seriesAdaptor_L1.setInput1(xn);
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
-	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
+		// --- output is at terminated L2's output2
+		return seriesTerminatedAdaptor_L2.getOutput2();
 	}
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
-
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
-
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
-
-	/** set input value into component; */
-	virtual void setInput(double in){ zRegister_L = in; }
-
-	/** get output value; NOTE: output is located in zRegister_C */
-	virtual double getOutput()
+	/** create the filter structure; may be called more than once */
+	void createWDF()
 	{
-		double NL = zRegister_L;
-		double out = NL*(1.0 - K) - K*zRegister_C;
-		zRegister_C = out;
-		return out;
-	}
+		// --- create components, init to noramlized values fc = 1Hz
+		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_norm);
+		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_norm);
+		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_norm);
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- set source resistance
+		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- set terminal resistance
+		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+	}
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+	/** parameter setter for warping */
+	void setUsePostWarping(bool b) { useFrequencyWarping = b; }
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** parameter setter for fc */
+	void setFilterFc(double fc_Hz)
+	{
+		if (useFrequencyWarping)
+		{
+			double arg = (kPi*fc_Hz) / sampleRate;
+			fc_Hz = fc_Hz*(tan(arg) / arg);
+		}
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		seriesAdaptor_L1.setComponentValue(L1_norm / fc_Hz);
+		parallelAdaptor_C1.setComponentValue(C1_norm / fc_Hz);
+		seriesTerminatedAdaptor_L2.setComponentValue(L2_norm / fc_Hz);
+	}
 
 protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-	double K = 0.0;
-
-	double componentValue_C = 0.0;	///< component value C
-	double componentValue_R = 0.0;	///< component value R
-
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double RR = 0.0; ///< RR value
-
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
-};
-
-
-// ------------------------------------------------------------------ //
-// --- WDF ADAPTORS ------------------------------------------------- //
-// ------------------------------------------------------------------ //
-
-/**
-\enum wdfComponent
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the wdfComponent type
+	// --- three adapters
+	WdfSeriesAdaptor seriesAdaptor_L1;		///< adaptor for L1
+	WdfParallelAdaptor parallelAdaptor_C1;	///< adaptor for C1
+	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
 
-- enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
+	double L1_norm = 95.493;		// 95.5 mH
+	double C1_norm = 530.516e-6;	// 0.53 uF
+	double L2_norm = 95.493;		// 95.5 mH
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
+	bool useFrequencyWarping = false;	///< flag for freq warping
+	double sampleRate = 1.0;			///< stored sample rate
+};
 
 /**
-\struct WdfComponentInfo
+\class WDFBesselBSF3
 \ingroup WDF-Objects
 \brief
-Custom structure to hold component information.
+The WDFBesselBSF3 object implements a 3rd order Bessel BSF
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - object is hardwired
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct WdfComponentInfo
+class WDFBesselBSF3 : public IAudioSignalProcessor
 {
-	WdfComponentInfo() { }
+public:
+	WDFBesselBSF3(void) { createWDF(); }	/* C-TOR */
+	~WDFBesselBSF3(void) {}	/* D-TOR */
 
-	WdfComponentInfo(wdfComponent _componentType, double value1 = 0.0, double value2 = 0.0)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		componentType = _componentType;
-		if (componentType == wdfComponent::R)
-			R = value1;
-		else if (componentType == wdfComponent::L)
-			L = value1;
-		else if (componentType == wdfComponent::C)
-			C = value1;
-		else if (componentType == wdfComponent::seriesLC || componentType == wdfComponent::parallelLC)
-		{
-			L = value1;
-			C = value2;
-		}
-		else if (componentType == wdfComponent::seriesRL || componentType == wdfComponent::parallelRL)
-		{
-			R = value1;
-			L = value2;
-		}
-		else if (componentType == wdfComponent::seriesRC || componentType == wdfComponent::parallelRC)
-		{
-			R = value1;
-			C = value2;
-		}
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1C1.reset(_sampleRate);
+		parallelAdaptor_L2C2.reset(_sampleRate);
+		seriesTerminatedAdaptor_L3C3.reset(_sampleRate);
+
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1C1.initializeAdaptorChain();
+
+		return true;
 	}
 
-	double R = 0.0; ///< value of R component
-	double L = 0.0;	///< value of L component
-	double C = 0.0;	///< value of C component
-	wdfComponent componentType = wdfComponent::R; ///< selected component type
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_L1C1.setInput1(xn);
+
+		// --- output is at terminated L2's output2
+		return seriesTerminatedAdaptor_L3C3.getOutput2();
+	}
+
+	/** create the WDF structure; may be called more than once*/
+	void createWDF()
+	{
+		// --- set component values
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		seriesAdaptor_L1C1.setComponent(wdfComponent::parallelLC, 16.8327e-3, 0.060193e-6);	/* L, C */
+		parallelAdaptor_L2C2.setComponent(wdfComponent::seriesLC, 49.1978e-3, 0.02059e-6);	/* L, C */
+		seriesTerminatedAdaptor_L3C3.setComponent(wdfComponent::parallelLC, 2.57755e-3, 0.393092e-6);	/* L, C */
+
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesTerminatedAdaptor_L3C3);
+
+		// --- set source resistance
+		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
+
+		// --- set terminal resistance
+		seriesTerminatedAdaptor_L3C3.setTerminalResistance(600.0);
+	}
+
+protected:
+	// --- three adapters
+	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
+	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
+	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L3C3;	///< adaptor for L3 and C3
 };
 
 
 /**
-\class WdfAdaptorBase
+\class WDFConstKBPF6
 \ingroup WDF-Objects
 \brief
-The WdfAdaptorBase object acts as the base class for all WDF Adaptors; the static members allow
-for simplified connection of components. See the FX book for more details.
+The WDFConstKBPF6 object implements a 6th order constant K BPF
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - object is hardwired
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfAdaptorBase : public IComponentAdaptor
+class WDFConstKBPF6 : public IAudioSignalProcessor
 {
 public:
-	WdfAdaptorBase() {}
-	virtual ~WdfAdaptorBase() {}
-
-	/** set the termainal (load) resistance for terminating adaptors */
-	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+	WDFConstKBPF6(void) { createWDF(); }	/* C-TOR */
+	~WDFConstKBPF6(void) {}	/* D-TOR */
 
-	/** set the termainal (load) resistance as open circuit for terminating adaptors */
-	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		// --- flag overrides value
-		openTerminalResistance = _openTerminalResistance;
-		terminalResistance = 1.0e+34; // avoid /0.0
-	}
-
-	/** set the input (source) resistance for an input adaptor */
-	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
-
-	/** set the component or connected adaptor at port 1; functions is generic and allows extending the functionality of the WDF Library */
-	void setPort1_CompAdaptor(IComponentAdaptor* _port1CompAdaptor) { port1CompAdaptor = _port1CompAdaptor; }
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1C1.reset(_sampleRate);
+		parallelAdaptor_L2C2.reset(_sampleRate);
 
-	/** set the component or connected adaptor at port 2; functions is generic and allows extending the functionality of the WDF Library */
-	void setPort2_CompAdaptor(IComponentAdaptor* _port2CompAdaptor) { port2CompAdaptor = _port2CompAdaptor; }
+		seriesAdaptor_L3C3.reset(_sampleRate);
+		parallelAdaptor_L4C4.reset(_sampleRate);
 
-	/** set the component or connected adaptor at port 3; functions is generic and allows extending the functionality of the WDF Library */
-	void setPort3_CompAdaptor(IComponentAdaptor* _port3CompAdaptor) { port3CompAdaptor = _port3CompAdaptor; }
+		seriesAdaptor_L5C5.reset(_sampleRate);
+		parallelTerminatedAdaptor_L6C6.reset(_sampleRate);
 
-	/** reset the connected component */
-	virtual void reset(double _sampleRate)
-	{
-		if (wdfComponent)
-			wdfComponent->reset(_sampleRate);
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1C1.initializeAdaptorChain();
+		return true;
 	}
 
-	/** creates a new WDF component and connects it to Port 3 */
-	void setComponent(wdfComponent componentType, double value1 = 0.0, double value2 = 0.0)
-	{
-		// --- decode and set
-		if (componentType == wdfComponent::R)
-		{
-			wdfComponent = new WdfResistor;
-			wdfComponent->setComponentValue(value1);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::L)
-		{
-			wdfComponent = new WdfInductor;
-			wdfComponent->setComponentValue(value1);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::C)
-		{
-			wdfComponent = new WdfCapacitor;
-			wdfComponent->setComponentValue(value1);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::seriesLC)
-		{
-			wdfComponent = new WdfSeriesLC;
-			wdfComponent->setComponentValue_LC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::parallelLC)
-		{
-			wdfComponent = new WdfParallelLC;
-			wdfComponent->setComponentValue_LC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::seriesRL)
-		{
-			wdfComponent = new WdfSeriesRL;
-			wdfComponent->setComponentValue_RL(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::parallelRL)
-		{
-			wdfComponent = new WdfParallelRL;
-			wdfComponent->setComponentValue_RL(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::seriesRC)
-		{
-			wdfComponent = new WdfSeriesRC;
-			wdfComponent->setComponentValue_RC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::parallelRC)
-		{
-			wdfComponent = new WdfParallelRC;
-			wdfComponent->setComponentValue_RC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-	}
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** connect two adapters together upstreamAdaptor --> downstreamAdaptor */
-	static void connectAdaptors(WdfAdaptorBase* upstreamAdaptor, WdfAdaptorBase* downstreamAdaptor)
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		upstreamAdaptor->setPort2_CompAdaptor(downstreamAdaptor);
-		downstreamAdaptor->setPort1_CompAdaptor(upstreamAdaptor);
-	}
+		// --- push audio sample into series L1
+		seriesAdaptor_L1C1.setInput1(xn);
 
-	/** initialize the chain of adaptors from upstreamAdaptor --> downstreamAdaptor */
-	virtual void initializeAdaptorChain()
-	{
-		initialize(sourceResistance);
-	}
+		// --- output is at terminated L6C6 output2
+		double output = parallelTerminatedAdaptor_L6C6.getOutput2();
 
-	/** set value of single-component adaptor */
-	virtual void setComponentValue(double _componentValue)
-	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue(_componentValue);
+		return output;
 	}
 
-	/** set LC value of mjulti-component adaptor */
-	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C)
+	/** create the WDF structure */
+	void createWDF()
 	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue_LC(componentValue_L, componentValue_C);
-	}
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		seriesAdaptor_L1C1.setComponent(wdfComponent::seriesLC, 47.7465e-3, 0.02122e-6);
+		parallelAdaptor_L2C2.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
 
-	/** set RL value of mjulti-component adaptor */
-	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L)
-	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue_RL(componentValue_R, componentValue_L);
-	}
+		seriesAdaptor_L3C3.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
+		parallelAdaptor_L4C4.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
 
-	/** set RC value of mjulti-component adaptor */
-	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C)
-	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue_RC(componentValue_R, componentValue_C);
-	}
+		seriesAdaptor_L5C5.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
+		parallelTerminatedAdaptor_L6C6.setComponent(wdfComponent::parallelLC, 7.63944e-3, 0.132629e-6);
 
-	/** get adaptor connected at port 1: for extended functionality; not used in WDF ladder filter library */
-	IComponentAdaptor* getPort1_CompAdaptor() { return port1CompAdaptor; }
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesAdaptor_L3C3);
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L3C3, &parallelAdaptor_L4C4);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L4C4, &seriesAdaptor_L5C5);
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L5C5, &parallelTerminatedAdaptor_L6C6);
 
-	/** get adaptor connected at port 2: for extended functionality; not used in WDF ladder filter library */
-	IComponentAdaptor* getPort2_CompAdaptor() { return port2CompAdaptor; }
+		// --- set source resistance
+		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
 
-	/** get adaptor connected at port 3: for extended functionality; not used in WDF ladder filter library */
-	IComponentAdaptor* getPort3_CompAdaptor() { return port3CompAdaptor; }
+		// --- set terminal resistance
+		parallelTerminatedAdaptor_L6C6.setTerminalResistance(600.0);
+	}
 
 protected:
-	// --- can in theory connect any port to a component OR adaptor;
-	//     though this library is setup with a convention R3 = component
-	IComponentAdaptor* port1CompAdaptor = nullptr;	///< componant or adaptor connected to port 1
-	IComponentAdaptor* port2CompAdaptor = nullptr;	///< componant or adaptor connected to port 2
-	IComponentAdaptor* port3CompAdaptor = nullptr;	///< componant or adaptor connected to port 3
-	IComponentAdaptor* wdfComponent = nullptr;		///< WDF componant connected to port 3 (default operation)
+	// --- six adapters
+	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
+	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
 
-	// --- These hold the input (R1), component (R3) and output (R2) resistances
-	double R1 = 0.0; ///< input port resistance
-	double R2 = 0.0; ///< output port resistance
-	double R3 = 0.0; ///< component resistance
+	WdfSeriesAdaptor seriesAdaptor_L3C3;		///< adaptor for L3 and C3
+	WdfParallelAdaptor parallelAdaptor_L4C4;	///< adaptor for L4 and C4
 
-	// --- these are input variables that are stored;
-	//     not used in this implementation but may be required for extended versions
-	double in1 = 0.0;	///< stored port 1 input;  not used in this implementation but may be required for extended versions
-	double in2 = 0.0;	///< stored port 2 input;  not used in this implementation but may be required for extended versions
-	double in3 = 0.0;	///< stored port 3 input;  not used in this implementation but may be required for extended versions
+	WdfSeriesAdaptor seriesAdaptor_L5C5;		///< adaptor for L5 and C5
+	WdfParallelTerminatedAdaptor parallelTerminatedAdaptor_L6C6;///< adaptor for L6 and C6
+};
 
-	// --- these are output variables that are stored;
-	//     currently out2 is the only one used as it is y(n) for this library
-	//     out1 and out2 are stored; not used in this implementation but may be required for extended versions
-	double out1 = 0.0;	///< stored port 1 output; not used in this implementation but may be required for extended versions
-	double out2 = 0.0;	///< stored port 2 output; it is y(n) for this library
-	double out3 = 0.0;	///< stored port 3 output; not used in this implementation but may be required for extended versions
 
-	// --- terminal impedance
-	double terminalResistance = 600.0; ///< value of terminal (load) resistance
-	bool openTerminalResistance = false; ///< flag for open circuit load
+/**
+\struct WDFParameters
+\ingroup WDF-Objects
+\brief
+Custom parameter structure for the WDF filter examples.
 
-	// --- source impedance, OK for this to be set to 0.0 for Rs = 0
-	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct WDFParameters
+{
+	WDFParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	WDFParameters& operator=(const WDFParameters& params)
+	{
+		if (this == &params)
+			return *this;
+
+		fc = params.fc;
+		Q = params.Q;
+		boostCut_dB = params.boostCut_dB;
+		frequencyWarping = params.frequencyWarping;
+		return *this;
+	}
+
+	// --- individual parameters
+	double fc = 100.0;				///< filter fc
+	double Q = 0.707;				///< filter Q
+	double boostCut_dB = 0.0;		///< filter boost or cut in dB
+	bool frequencyWarping = true;	///< enable frequency warping
 };
 
 /**
-\class WdfSeriesAdaptor
+\class WDFIdealRLCLPF
 \ingroup WDF-Objects
 \brief
-The WdfSeriesAdaptor object implements the series reflection-free (non-terminated) adaptor
+The WDFIdealRLCLPF object implements an ideal RLC LPF using the WDF library.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfSeriesAdaptor : public WdfAdaptorBase
+class WDFIdealRLCLPF : public IAudioSignalProcessor
 {
 public:
-	WdfSeriesAdaptor() {}
-	virtual ~WdfSeriesAdaptor() {}
+	WDFIdealRLCLPF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCLPF(void) {}	/* D-TOR */
 
-	/** get the resistance at port 2; R2 = R1 + component (series)*/
-	virtual double getR2()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
-
-		R2 = R1 + componentResistance;
-		return R2;
-	}
+		sampleRate = _sampleRate;
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
-	{
-		// --- R1 is source resistance for this adaptor
-		R1 = _R1;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_RL.reset(_sampleRate);
+		parallelTerminatedAdaptor_C.reset(_sampleRate);
 
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+		// --- intialize the chain of adapters
+		seriesAdaptor_RL.initializeAdaptorChain();
+		return true;
+	}
 
-		// --- calculate B coeff
-		B = R1 / (R1 + componentResistance);
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- init downstream adaptor
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_RL.setInput1(xn);
 
-		// --- not used in this implementation but saving for extended use
-		R3 = componentResistance;
+		// --- output is at terminated L2's output2
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_C.getOutput2();
 	}
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	/** create the WDF structure; may be called more than once */
+	void createWDF()
 	{
-		// --- save
-		in1 = _in1;
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_RL.setComponent(wdfComponent::seriesRL, 2.251131e2, 2.533e-2);
+		parallelTerminatedAdaptor_C.setComponent(wdfComponent::C, 1.0e-6);
 
-		// --- read component value
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RL, &parallelTerminatedAdaptor_C);
 
-		// --- form output
-		out2 = -(in1 + N2);
+		// --- set source resistance
+		seriesAdaptor_RL.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- deliver downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->setInput1(out2);
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_C.setOpenTerminalResistance(true);
 	}
 
-	/** push audio input sample into reflected wave input */
-	virtual void setInput2(double _in2)
-	{
-		// --- save
-		in2 = _in2;
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
 
-		// --- calc N1
-		N1 = -(in1 - B*(in1 + N2 + in2) + in2);
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
+			double fc_Hz = wdfParameters.fc;
 
-		// --- calc out1
-		out1 = in1 - B*(N2 + in2);
+			if (wdfParameters.frequencyWarping)
+			{
+				double arg = (kPi*fc_Hz) / sampleRate;
+				fc_Hz = fc_Hz*(tan(arg) / arg);
+			}
 
-		// --- deliver upstream
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
+			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
+			seriesAdaptor_RL.setComponentValue_RL(resistorValue, inductorValue);
+			seriesAdaptor_RL.initializeAdaptorChain();
+		}
 	}
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3){ }
-
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
+protected:
+	WDFParameters wdfParameters;	///< object parameters
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+	// --- adapters
+	WdfSeriesAdaptor				seriesAdaptor_RL;				///< adaptor for series RL
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_C;	///< adaptopr for parallel C
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+	double sampleRate = 1.0;
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double B = 0.0;		///< B coefficient value
 };
 
-/**
-\class WdfSeriesTerminatedAdaptor
-\ingroup WDF-Objects
-\brief
-The WdfSeriesTerminatedAdaptor object implements the series terminated (non-reflection-free) adaptor
+/**
+\class WDFIdealRLCHPF
+\ingroup WDF-Objects
+\brief
+The WDFIdealRLCHPF object implements an ideal RLC HPF using the WDF library.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-// --- Series terminated adaptor
-class WdfSeriesTerminatedAdaptor : public WdfAdaptorBase
+class WDFIdealRLCHPF : public IAudioSignalProcessor
 {
 public:
-	WdfSeriesTerminatedAdaptor() {}
-	virtual ~WdfSeriesTerminatedAdaptor() {}
+	WDFIdealRLCHPF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCHPF(void) {}	/* D-TOR */
 
-	/** get the resistance at port 2; R2 = R1 + component (series)*/
-	virtual double getR2()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+		sampleRate = _sampleRate;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_RC.reset(_sampleRate);
+		parallelTerminatedAdaptor_L.reset(_sampleRate);
 
-		R2 = R1 + componentResistance;
-		return R2;
+		// --- intialize the chain of adapters
+		seriesAdaptor_RC.initializeAdaptorChain();
+		return true;
 	}
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
-	{
-		// --- source impedance
-		R1 = _R1;
-
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
-
-		B1 = (2.0*R1) / (R1 + componentResistance + terminalResistance);
-		B3 = (2.0*terminalResistance) / (R1 + componentResistance + terminalResistance);
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- init downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_RC.setInput1(xn);
 
-		// --- not used in this implementation but saving for extended use
-		R3 = componentResistance;
+		// --- output is at terminated L2's output2
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_L.getOutput2();
 	}
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	/** create WDF structure; may be called more than once */
+	void createWDF()
 	{
-		// --- save
-		in1 = _in1;
-
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_RC.setComponent(wdfComponent::seriesRC, 2.251131e2, 1.0e-6);
+		parallelTerminatedAdaptor_L.setComponent(wdfComponent::L, 2.533e-2);
 
-		double N3 = in1 + N2;
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RC, &parallelTerminatedAdaptor_L);
 
-		// --- calc out2 y(n)
-		out2 = -B3*N3;
+		// --- set source resistance
+		seriesAdaptor_RC.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- form output1
-		out1 = in1 - B1*N3;
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_L.setOpenTerminalResistance(true);
+	}
 
-		// --- form N1
-		N1 = -(out1 + out2 + N3);
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
 
-		// --- deliver upstream to input2
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
+			double fc_Hz = wdfParameters.fc;
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
-	}
+			if (wdfParameters.frequencyWarping)
+			{
+				double arg = (kPi*fc_Hz) / sampleRate;
+				fc_Hz = fc_Hz*(tan(arg) / arg);
+			}
 
-	/** push audio input sample into reflected wave input
-	    for terminated adaptor, this is dead end, just store it */
-	virtual void setInput2(double _in2) { in2 = _in2;}
+			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
+			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3) { in3 = _in3;}
+			seriesAdaptor_RC.setComponentValue_RC(resistorValue, 1.0e-6);
+			parallelTerminatedAdaptor_L.setComponentValue(inductorValue);
+			seriesAdaptor_RC.initializeAdaptorChain();
+		}
+	}
 
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+protected:
+	WDFParameters wdfParameters;	///< object parameters
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+	// --- three
+	WdfSeriesAdaptor				seriesAdaptor_RC;				///< adaptor for RC
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_L;	///< adaptor for L
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double B1 = 0.0;	///< B1 coefficient value
-	double B3 = 0.0;	///< B3 coefficient value
+	double sampleRate = 1.0;	///< sample rate storage
 };
 
 /**
-\class WdfParallelAdaptor
+\class WDFIdealRLCBPF
 \ingroup WDF-Objects
 \brief
-The WdfParallelAdaptor object implements the parallel reflection-free (non-terminated) adaptor
+The WDFIdealRLCBPF object implements an ideal RLC BPF using the WDF library.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelAdaptor : public WdfAdaptorBase
+class WDFIdealRLCBPF : public IAudioSignalProcessor
 {
 public:
-	WdfParallelAdaptor() {}
-	virtual ~WdfParallelAdaptor() {}
+	WDFIdealRLCBPF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCBPF(void) {}	/* D-TOR */
 
-	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
-	virtual double getR2()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+		sampleRate = _sampleRate;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_LC.reset(_sampleRate);
+		parallelTerminatedAdaptor_R.reset(_sampleRate);
 
-		// --- 1 / (sum of admittances)
-		R2 = 1.0 / ((1.0 / R1) + componentConductance);
-		return R2;
+		// --- intialize the chain of adapters
+		seriesAdaptor_LC.initializeAdaptorChain();
+		return true;
 	}
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
-	{
-		// --- save R1
-		R1 = _R1;
-
-		double G1 = 1.0 / R1;
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
-
-		// --- calculate B coeff
-		A = G1 / (G1 + componentConductance);
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- now, do we init our downstream??
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_LC.setInput1(xn);
 
-		// --- not used in this implementation but saving for extended use
-		R3 = 1.0/ componentConductance;
+		// --- output is at terminated L2's output2
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_R.getOutput2();
 	}
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	/** create the WDF structure*/
+	void createWDF()
 	{
-		// --- save
-		in1 = _in1;
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
+		parallelTerminatedAdaptor_R.setComponent(wdfComponent::R, 2.251131e2);
 
-		// --- read component
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_LC, &parallelTerminatedAdaptor_R);
 
-		// --- form output
-		out2 = N2 - A*(-in1 + N2);
+		// --- set source resistance
+		seriesAdaptor_LC.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- deliver downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->setInput1(out2);
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_R.setOpenTerminalResistance(true);
 	}
 
-	/** push audio input sample into reflected wave input*/
-	virtual void setInput2(double _in2)
-	{
-		// --- save
-		in2 = _in2;
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
 
-		// --- calc N1
-		N1 = in2 - A*(-in1 + N2);
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
+			double fc_Hz = wdfParameters.fc;
 
-		// --- calc out1
-		out1 = -in1 + N2 + N1;
+			if (wdfParameters.frequencyWarping)
+			{
+				double arg = (kPi*fc_Hz) / sampleRate;
+				fc_Hz = fc_Hz*(tan(arg) / arg);
+			}
 
-		// --- deliver upstream
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
+			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
+			seriesAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
+			parallelTerminatedAdaptor_R.setComponentValue(resistorValue);
+			seriesAdaptor_LC.initializeAdaptorChain();
+		}
 	}
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3) { }
-
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
-
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+protected:
+	WDFParameters wdfParameters;	///< object parameters
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+	// --- adapters
+	WdfSeriesAdaptor				seriesAdaptor_LC; ///< adaptor for LC
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_R; ///< adaptor for R
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double A = 0.0;		///< A coefficient value
+	double sampleRate = 1.0;
 };
 
 
 /**
-\class WdfParallelTerminatedAdaptor
+\class WDFIdealRLCBSF
 \ingroup WDF-Objects
 \brief
-The WdfParallelTerminatedAdaptor object implements the parallel  terminated (non-reflection-free) adaptor
+The WDFIdealRLCBSF object implements an ideal RLC BSF using the WDF library.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelTerminatedAdaptor : public WdfAdaptorBase
+class WDFIdealRLCBSF : public IAudioSignalProcessor
 {
 public:
-	WdfParallelTerminatedAdaptor() {}
-	virtual ~WdfParallelTerminatedAdaptor() {}
+	WDFIdealRLCBSF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCBSF(void) {}	/* D-TOR */
 
-	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
-	virtual double getR2()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+		sampleRate = _sampleRate;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_R.reset(_sampleRate);
+		parallelTerminatedAdaptor_LC.reset(_sampleRate);
 
-		// --- 1 / (sum of admittances)
-		R2 = 1.0 / ((1.0 / R1) + componentConductance);
-		return R2;
+		// --- intialize the chain of adapters
+		seriesAdaptor_R.initializeAdaptorChain();
+		return true;
 	}
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		// --- save R1
-		R1 = _R1;
+		// --- push audio sample into series L1
+		seriesAdaptor_R.setInput1(xn);
 
-		double G1 = 1.0 / R1;
-		if (terminalResistance <= 0.0)
-			terminalResistance = 1e-15;
+		// --- output is at terminated L2's output2
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_LC.getOutput2();
+	}
 
-		double G2 = 1.0 / terminalResistance;
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+	/** create WDF structure */
+	void createWDF()
+	{
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_R.setComponent(wdfComponent::R, 2.533e-2);
+		parallelTerminatedAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
 
-		A1 = 2.0*G1 / (G1 + componentConductance + G2);
-		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_R, &parallelTerminatedAdaptor_LC);
 
-		// --- init downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
+		// --- set source resistance
+		seriesAdaptor_R.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- not used in this implementation but saving for extended use
-		R3 = 1.0 / componentConductance;
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_LC.setOpenTerminalResistance(true);
 	}
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
 	{
-		// --- save
-		in1 = _in1;
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
+			double fc_Hz = wdfParameters.fc;
 
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
+			if (wdfParameters.frequencyWarping)
+			{
+				double arg = (kPi*fc_Hz) / sampleRate;
+				fc_Hz = fc_Hz*(tan(arg) / arg);
+			}
 
-		// --- form N1
-		N1 = -A1*(-in1 + N2) + N2 - A3*N2;
+			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
+			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
 
-		// --- form output1
-		out1 = -in1 + N2 + N1;
+			seriesAdaptor_R.setComponentValue(resistorValue);
+			parallelTerminatedAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
+			seriesAdaptor_R.initializeAdaptorChain();
+		}
+	}
 
-		// --- deliver upstream to input2
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+protected:
+	WDFParameters wdfParameters;	///< object parameters
 
-		// --- calc out2 y(n)
-		out2 = N2 + N1;
+	// --- adapters
+	WdfSeriesAdaptor				seriesAdaptor_R; ///< adaptor for series R
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_LC; ///< adaptor for parallel LC
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
-	}
+	double sampleRate = 1.0; ///< sample rate storage
+};
 
-	/** push audio input sample into reflected wave input; this is a dead end for terminated adaptorsthis is a dead end for terminated adaptors  */
-	virtual void setInput2(double _in2){ in2 = _in2;}
+/**
+\class WdfTuningTable
+\ingroup WDF-Objects
+\brief
+The WdfTuningTable object stores WdfLadder coefficient sets over a log-frequency and log-Q grid and
+bilinearly interpolates between them, so a ladder can be retuned without recalculating its component values.
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3) { }
+Interpolating the reflection coefficients is only accurate where they vary slowly over a grid cell; for
+high-Q resonant designs near Nyquist the error rises to about -17dB on a 128 x 32 grid, so use it for
+low-Q or frequency-only designs.
 
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
+\version Revision : 1.0
+*/
+class WdfTuningTable
+{
+public:
+	WdfTuningTable(void) {}		/* C-TOR */
+	~WdfTuningTable(void) {}	/* D-TOR */
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+	/** set up the grid; numQ = 1 makes a frequency-only table. Only reallocates when the size changes. */
+	void initialize(unsigned int _numCoefficients,
+					double fcMin, double fcMax, unsigned int _numFc,
+					double QMin, double QMax, unsigned int _numQ)
+	{
+		// --- clamp the grid first so the allocation matches what the fill loops write
+		unsigned int clampedNumFc = _numFc < 2 ? 2 : _numFc;
+		unsigned int clampedNumQ = _numQ < 1 ? 1 : _numQ;
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+		unsigned int size = _numCoefficients*clampedNumFc*clampedNumQ;
+		if (size != numCoefficients*numFc*numQ || !table)
+			table.reset(new double[size]);
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double A1 = 0.0;	///< A1 coefficient value
-	double A3 = 0.0;	///< A3 coefficient value
-};
+		numCoefficients = _numCoefficients;
+		numFc = clampedNumFc;
+		numQ = clampedNumQ;
 
-// ------------------------------------------------------------------------------ //
-// --- WDF Ladder Filter Design  Examples --------------------------------------- //
-// ------------------------------------------------------------------------------ //
-//
-// --- 3rd order Butterworth LPF designed with Elsie www.TonneSoftware.comm
-//
-/*
-	3rd Order Inductor-Leading LPF
+		logFcMin = log(fcMin);
+		logFcStep = (log(fcMax) - logFcMin) / (numFc - 1);
+		logQMin = log(QMin);
+		logQStep = numQ > 1 ? (log(QMax) - logQMin) / (numQ - 1) : 1.0;
+	}
 
-	Rs = Rload = 600 ohms
+	/** grid frequency at index i */
+	double getGridFc(unsigned int i) { return exp(logFcMin + i*logFcStep); }
 
-	Series(L1) -> Parallel(C1) -> Series(L2)
+	/** grid Q at index j */
+	double getGridQ(unsigned int j) { return exp(logQMin + j*logQStep); }
 
-	--L1-- | --L2--
-		   C1
-		   |
+	/** pointer to the coefficient set at grid point (i, j) */
+	double* getEntry(unsigned int i, unsigned int j) { return &table[(j*numFc + i)*numCoefficients]; }
 
-	fc = 1kHz
-		L1 = 95.49e-3;
-		C1 = 0.5305e-6;
-		L2 = 95.49e-3;
+	/** interpolate the coefficient set for (fc, Q); values outside the grid are clamped to its edges */
+	void interpolate(double fc, double Q, double* coeffs)
+	{
+		unsigned int i = 0;
+		double fracFc = findCell((log(fc) - logFcMin) / logFcStep, numFc, i);
+		const double* c00 = getEntry(i, 0);
+		const double* c10 = c00 + numCoefficients;
 
-	fc = 10kHz
-		L1 = 9.549e-3;
-		C1 = 0.05305e-6;
-		L2 = 9.549e-3;
-*/
+		if (numQ == 1)
+		{
+			for (unsigned int n = 0; n < numCoefficients; n++)
+				coeffs[n] = c00[n] + fracFc*(c10[n] - c00[n]);
+			return;
+		}
+
+		unsigned int j = 0;
+		double fracQ = findCell((log(Q) - logQMin) / logQStep, numQ, j);
+		c00 = getEntry(i, j);
+		c10 = c00 + numCoefficients;
+		const double* c01 = getEntry(i, j + 1);
+		const double* c11 = c01 + numCoefficients;
+
+		for (unsigned int n = 0; n < numCoefficients; n++)
+		{
+			double lowQ = c00[n] + fracFc*(c10[n] - c00[n]);
+			double highQ = c01[n] + fracFc*(c11[n] - c01[n]);
+			coeffs[n] = lowQ + fracQ*(highQ - lowQ);
+		}
+	}
+
+protected:
+	std::unique_ptr<double[]> table = nullptr;	///< [Q][fc][coefficient]
+	unsigned int numCoefficients = 0;	///< coefficients per grid point
+	unsigned int numFc = 0;				///< frequency grid size
+	unsigned int numQ = 0;				///< Q grid size
+	double logFcMin = 0.0;		///< log of the lowest grid frequency
+	double logFcStep = 1.0;		///< log frequency grid step
+	double logQMin = 0.0;		///< log of the lowest grid Q
+	double logQStep = 1.0;		///< log Q grid step
+
+	/** split a fractional grid position into a cell index and a fraction, clamped to the grid */
+	double findCell(double position, unsigned int gridSize, unsigned int& index)
+	{
+		if (position <= 0.0)
+		{
+			index = 0;
+			return 0.0;
+		}
+		if (position >= gridSize - 1)
+		{
+			index = gridSize - 2;
+			return 1.0;
+		}
+		index = (unsigned int)position;
+		return position - index;
+	}
+};
 
 /**
-\class WDFButterLPF3
+\class WDFTunedLadder
 \ingroup WDF-Objects
 \brief
-The WDFButterLPF3 object implements a 3rd order Butterworth ladder filter.
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFTunedLadder object is the base class for WdfLadder filters that are tuned from a
+precalculated WdfTuningTable or, with useTuningTable = false, from the exact design equations.
+
+At reset( ) the derived class's tuneLadder( ) design equations are run once per grid point and the
+resulting port resistances and reflection coefficients are stored; setParameters( ) then only
+interpolates the table and loads the result into the ladder, which makes fc sweeps cheap.
+The output is exact at the grid points; fc and Q outside the grid are clamped to its edges.
+
+Derived objects whose coefficients are too sensitive to Q for the table (the resonant RLC designs) set
+useTuningTable = false; setParameters( ) then runs tuneLadder( ) directly for the exact fc and Q, and no
+table is built.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- none - this object is hard-wired.
+- Use WDFParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFButterLPF3 : public IAudioSignalProcessor
+template <class Ladder>
+class WDFTunedLadder : public IAudioSignalProcessor
 {
 public:
-	WDFButterLPF3(void) { createWDF(); }	/* C-TOR */
-	~WDFButterLPF3(void) {}	/* D-TOR */
+	WDFTunedLadder(void) {}	/* C-TOR */
+	virtual ~WDFTunedLadder(void) {}	/* D-TOR */
 
-	/** reset members to initialized state */
+	/** reset members to initialized state; rebuilds the tuning table if the sample rate changed */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1.reset(_sampleRate);
-		parallelAdaptor_C1.reset(_sampleRate);
-		seriesTerminatedAdaptor_L2.reset(_sampleRate);
+		// --- flush state registers; this also sets the component sample rates
+		ladder.reset(_sampleRate);
 
-		// --- intialize the chain of adapters
-		seriesAdaptor_L1.initializeAdaptorChain();
+		bool sampleRateChanged = _sampleRate != sampleRate;
+		sampleRate = _sampleRate;
+
+		if (useTuningTable && (!tableValid || sampleRateChanged))
+			calculateTuningTable();
+
+		applyTuning();
 		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/** process input x(n) through the WDF ladder to produce return value y(n) */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_L1.setInput1(xn);
+		return outputScale*ladder.processAudioSample(xn);
+	}
 
-		// --- output is at terminated L2's output2
-		return seriesTerminatedAdaptor_L2.getOutput2();
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			bool warpingChanged = _wdfParameters.frequencyWarping != wdfParameters.frequencyWarping;
+			wdfParameters = _wdfParameters;
+
+			// --- the table holds the warped design, so a warping change needs a new table
+			if (warpingChanged && tableValid)
+				calculateTuningTable();
+
+			// --- exact tuning only needs the sample rate
+			if (tableValid || (!useTuningTable && sampleRate > 0.0))
+				applyTuning();
+		}
 	}
 
-	/** create the WDF structure for this object - may be called more than once */
-	void createWDF()
+protected:
+	WDFParameters wdfParameters;	///< object parameters
+	Ladder ladder;					///< the WDF ladder
+	WdfTuningTable tuningTable;		///< precalculated ladder coefficients
+
+	double outputScale = 1.0;	///< output scaling (e.g. -6dB compensation for Rs and Rload)
+	double sampleRate = 0.0;	///< sample rate storage
+	bool tableValid = false;	///< table has been calculated for sampleRate
+	bool useTuningTable = true;	///< false: run tuneLadder( ) on every fc/Q change instead of interpolating
+
+	// --- grid limits; derived objects may change these in their constructors
+	double gridFcMin = 20.0;			///< lowest table frequency
+	double gridFcMax = 20480.0;			///< highest table frequency (also limited to 0.48 x fs)
+	unsigned int gridNumFc = 128;		///< frequency grid points (~1/13 octave spacing)
+	double gridQMin = 0.5;				///< lowest table Q
+	double gridQMax = 20.0;				///< highest table Q
+	unsigned int gridNumQ = 32;			///< Q grid points; 1 for frequency-only designs
+
+	/** the exact design equations: set the component values for fc and Q at sampleRate, then initializeAdaptorChain( ) */
+	virtual void tuneLadder(double fc_Hz, double Q) = 0;
+
+	/** warp fc for the bilinear transform when frequencyWarping is on */
+	double warpFc(double fc_Hz)
 	{
-		// --- actual component values fc = 1kHz
-		double L1_value = 95.49e-3;		// 95.5 mH
-		double C1_value = 0.5305e-6;	// 0.53 uF
-		double L2_value = 95.49e-3;		// 95.5 mH
+		if (wdfParameters.frequencyWarping)
+		{
+			double arg = (kPi*fc_Hz) / sampleRate;
+			fc_Hz = fc_Hz*(tan(arg) / arg);
+		}
+		return fc_Hz;
+	}
 
-										// --- set adapter components
-		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_value);
-		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_value);
-		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_value);
+	/** run the design equations over the grid and store the ladder coefficients */
+	void calculateTuningTable()
+	{
+		double fcMax = fmin(gridFcMax, 0.48*sampleRate);
+		tuningTable.initialize(Ladder::numCoefficients, gridFcMin, fcMax, gridNumFc, gridQMin, gridQMax, gridNumQ);
 
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
+		for (unsigned int j = 0; j < gridNumQ; j++)
+		{
+			for (unsigned int i = 0; i < gridNumFc; i++)
+			{
+				tuneLadder(tuningTable.getGridFc(i), tuningTable.getGridQ(j));
+				ladder.storeCoefficients(tuningTable.getEntry(i, j));
+			}
+		}
+		tableValid = true;
+	}
 
-		// --- set source resistance
-		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+	/** interpolate the table for the current fc and Q and load the ladder, or tune it exactly */
+	void applyTuning()
+	{
+		if (!useTuningTable)
+		{
+			tuneLadder(wdfParameters.fc, wdfParameters.Q);
+			return;
+		}
 
-		// --- set terminal resistance
-		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+		double coeffs[Ladder::numCoefficients];
+		tuningTable.interpolate(wdfParameters.fc, wdfParameters.Q, coeffs);
+		ladder.loadCoefficients(coeffs);
+	}
+};
+
+/**
+\class WDFTunedButterLPF3
+\ingroup WDF-Objects
+\brief
+The WDFTunedButterLPF3 object implements the tunable 3rd order Butterworth ladder filter
+(see WDFTunableButterLPF3) tuned from a precalculated table; Q is ignored.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class WDFTunedButterLPF3 : public WDFTunedLadder<WdfLadder<WdfSeriesStage<WdfInductor>,
+														   WdfParallelStage<WdfCapacitor>,
+														   WdfSeriesTerminatedStage<WdfInductor>>>
+{
+public:
+	WDFTunedButterLPF3(void)	/* C-TOR */
+	{
+		gridNumFc = 256;
+		gridNumQ = 1;
+
+		// --- set source and terminal resistance (Rs = Rload = 600)
+		ladder.setSourceResistance(600.0);
+		ladder.getStage<2>().setTerminalResistance(600.0);
 	}
 
 protected:
-	// --- three adapters
-	WdfSeriesAdaptor seriesAdaptor_L1;			///< adaptor for L1
-	WdfParallelAdaptor parallelAdaptor_C1;		///< adaptor for C1
-	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
+	/** normalized (fc = 1Hz) component values scaled to fc */
+	virtual void tuneLadder(double fc_Hz, double /*Q*/)
+	{
+		fc_Hz = warpFc(fc_Hz);
+		ladder.getStage<0>().component.setComponentValue(L1_norm / fc_Hz);
+		ladder.getStage<1>().component.setComponentValue(C1_norm / fc_Hz);
+		ladder.getStage<2>().component.setComponentValue(L2_norm / fc_Hz);
+		ladder.initializeAdaptorChain();
+	}
+
+	double L1_norm = 95.493;		// 95.5 mH
+	double C1_norm = 530.516e-6;	// 0.53 uF
+	double L2_norm = 95.493;		// 95.5 mH
 };
 
 /**
-\class WDFTunableButterLPF3
+\class WDFTunedIdealRLCLPF
 \ingroup WDF-Objects
 \brief
-The WDFTunableButterLPF3 object implements a tunable 3rd order Butterworth ladder filter.
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFTunedIdealRLCLPF object implements the ideal RLC LPF (see WDFIdealRLCLPF) on the inlined WdfLadder.
+The component values are recalculated on every fc/Q change (useTuningTable = false) because the
+interpolated table is not accurate enough at high Q.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- setUsePostWarping(bool b) to enable/disable warping (see book)
-- setFilterFc(double fc_Hz) to set the tunable fc value
+- Use WDFParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFTunableButterLPF3 : public IAudioSignalProcessor
+class WDFTunedIdealRLCLPF : public WDFTunedLadder<WdfLadder<WdfSeriesStage<WdfSeriesRL>,
+															WdfParallelTerminatedStage<WdfCapacitor>>>
 {
 public:
-	WDFTunableButterLPF3(void) { createWDF(); }	/* C-TOR */
-	~WDFTunableButterLPF3(void) {}	/* D-TOR */
+	WDFTunedIdealRLCLPF(void)	/* C-TOR */
+	{
+		// --- -6dB compensation because of WDF assumption about Rs and Rload
+		outputScale = 0.5;
+		useTuningTable = false;
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+		// --- C held constant at 1e-6; Rs = 0, open ckt termination
+		ladder.getStage<1>().component.setComponentValue(1.0e-6);
+		ladder.setSourceResistance(0.0);
+		ladder.getStage<1>().setOpenTerminalResistance(true);
+	}
+
+protected:
+	/** same design equations as WDFIdealRLCLPF */
+	virtual void tuneLadder(double fc_Hz, double Q)
 	{
-		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1.reset(_sampleRate);
-		parallelAdaptor_C1.reset(_sampleRate);
-		seriesTerminatedAdaptor_L2.reset(_sampleRate);
+		fc_Hz = warpFc(fc_Hz);
+		double wc = 2.0*kPi*fc_Hz;
+		double inductorValue = 1.0 / (1.0e-6 * wc*wc);
+		double resistorValue = (1.0 / Q)*sqrt(inductorValue / 1.0e-6);
 
-		// --- intialize the chain of adapters
-		seriesAdaptor_L1.initializeAdaptorChain();
-		return true;
+		ladder.getStage<0>().component.setComponentValue_RL(resistorValue, inductorValue);
+		ladder.initializeAdaptorChain();
 	}
+};
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+/**
+\class WDFTunedIdealRLCHPF
+\ingroup WDF-Objects
+\brief
+The WDFTunedIdealRLCHPF object implements the ideal RLC HPF (see WDFIdealRLCHPF) on the inlined WdfLadder.
+The component values are recalculated on every fc/Q change (useTuningTable = false) because the
+interpolated table is not accurate enough at high Q.
 
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class WDFTunedIdealRLCHPF : public WDFTunedLadder<WdfLadder<WdfSeriesStage<WdfSeriesRC>,
+															WdfParallelTerminatedStage<WdfInductor>>>
+{
+public:
+	WDFTunedIdealRLCHPF(void)	/* C-TOR */
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_L1.setInput1(xn);
+		// --- -6dB compensation because of WDF assumption about Rs and Rload
+		outputScale = 0.5;
+		useTuningTable = false;
 
-		// --- output is at terminated L2's output2
-		return seriesTerminatedAdaptor_L2.getOutput2();
+		// --- Rs = 0, open ckt termination
+		ladder.setSourceResistance(0.0);
+		ladder.getStage<1>().setOpenTerminalResistance(true);
 	}
 
-	/** create the filter structure; may be called more than once */
-	void createWDF()
+protected:
+	/** same design equations as WDFIdealRLCHPF */
+	virtual void tuneLadder(double fc_Hz, double Q)
 	{
-		// --- create components, init to noramlized values fc = 1Hz
-		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_norm);
-		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_norm);
-		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_norm);
+		fc_Hz = warpFc(fc_Hz);
+		double wc = 2.0*kPi*fc_Hz;
+		double inductorValue = 1.0 / (1.0e-6 * wc*wc);
+		double resistorValue = (1.0 / Q)*sqrt(inductorValue / 1.0e-6);
 
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
+		ladder.getStage<0>().component.setComponentValue_RC(resistorValue, 1.0e-6);
+		ladder.getStage<1>().component.setComponentValue(inductorValue);
+		ladder.initializeAdaptorChain();
+	}
+};
 
-		// --- set source resistance
-		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+/**
+\class WDFTunedIdealRLCBPF
+\ingroup WDF-Objects
+\brief
+The WDFTunedIdealRLCBPF object implements the ideal RLC BPF (see WDFIdealRLCBPF) on the inlined WdfLadder.
+The component values are recalculated on every fc/Q change (useTuningTable = false) because the
+interpolated table is not accurate enough at high Q.
 
-		// --- set terminal resistance
-		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class WDFTunedIdealRLCBPF : public WDFTunedLadder<WdfLadder<WdfSeriesStage<WdfSeriesLC>,
+															WdfParallelTerminatedStage<WdfResistor>>>
+{
+public:
+	WDFTunedIdealRLCBPF(void)	/* C-TOR */
+	{
+		// --- -6dB compensation because of WDF assumption about Rs and Rload
+		outputScale = 0.5;
+		useTuningTable = false;
+
+		// --- Rs = 0, open ckt termination
+		ladder.setSourceResistance(0.0);
+		ladder.getStage<1>().setOpenTerminalResistance(true);
 	}
 
-	/** parameter setter for warping */
-	void setUsePostWarping(bool b) { useFrequencyWarping = b; }
+protected:
+	/** same design equations as WDFIdealRLCBPF */
+	virtual void tuneLadder(double fc_Hz, double Q)
+	{
+		fc_Hz = warpFc(fc_Hz);
+		double wc = 2.0*kPi*fc_Hz;
+		double inductorValue = 1.0 / (1.0e-6 * wc*wc);
+		double resistorValue = (1.0 / Q)*sqrt(inductorValue / 1.0e-6);
 
-	/** parameter setter for fc */
-	void setFilterFc(double fc_Hz)
+		ladder.getStage<0>().component.setComponentValue_LC(inductorValue, 1.0e-6);
+		ladder.getStage<1>().component.setComponentValue(resistorValue);
+		ladder.initializeAdaptorChain();
+	}
+};
+
+/**
+\class WDFTunedIdealRLCBSF
+\ingroup WDF-Objects
+\brief
+The WDFTunedIdealRLCBSF object implements the ideal RLC BSF (see WDFIdealRLCBSF) on the inlined WdfLadder.
+The component values are recalculated on every fc/Q change (useTuningTable = false) because the
+interpolated table is not accurate enough at high Q.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class WDFTunedIdealRLCBSF : public WDFTunedLadder<WdfLadder<WdfSeriesStage<WdfResistor>,
+															WdfParallelTerminatedStage<WdfSeriesLC>>>
+{
+public:
+	WDFTunedIdealRLCBSF(void)	/* C-TOR */
 	{
-		if (useFrequencyWarping)
-		{
-			double arg = (kPi*fc_Hz) / sampleRate;
-			fc_Hz = fc_Hz*(tan(arg) / arg);
-		}
+		// --- -6dB compensation because of WDF assumption about Rs and Rload
+		outputScale = 0.5;
+		useTuningTable = false;
 
-		seriesAdaptor_L1.setComponentValue(L1_norm / fc_Hz);
-		parallelAdaptor_C1.setComponentValue(C1_norm / fc_Hz);
-		seriesTerminatedAdaptor_L2.setComponentValue(L2_norm / fc_Hz);
+		// --- Rs = 0, open ckt termination
+		ladder.setSourceResistance(0.0);
+		ladder.getStage<1>().setOpenTerminalResistance(true);
 	}
 
 protected:
-	// --- three adapters
-	WdfSeriesAdaptor seriesAdaptor_L1;		///< adaptor for L1
-	WdfParallelAdaptor parallelAdaptor_C1;	///< adaptor for C1
-	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
+	/** same design equations as WDFIdealRLCBSF */
+	virtual void tuneLadder(double fc_Hz, double Q)
+	{
+		fc_Hz = warpFc(fc_Hz);
+		double wc = 2.0*kPi*fc_Hz;
+		double inductorValue = 1.0 / (1.0e-6 * wc*wc);
+		double resistorValue = (1.0 / Q)*sqrt(inductorValue / 1.0e-6);
+
+		ladder.getStage<0>().component.setComponentValue(resistorValue);
+		ladder.getStage<1>().component.setComponentValue_LC(inductorValue, 1.0e-6);
+		ladder.initializeAdaptorChain();
+	}
+};
+
+/**
+\enum rlcFilterType
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to select the topology of the WDFIdealRLCFilter object.
+
+- enum class rlcFilterType { kLPF, kHPF, kBPF, kBSF };
+*/
+enum class rlcFilterType { kLPF, kHPF, kBPF, kBSF };
+
+/**
+\struct WDFIdealRLCFilterParameters
+\ingroup WDF-Objects
+\brief
+Custom parameter structure for the WDFIdealRLCFilter object.
+
+\version Revision : 1.0
+*/
+struct WDFIdealRLCFilterParameters
+{
+	WDFIdealRLCFilterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	WDFIdealRLCFilterParameters& operator=(const WDFIdealRLCFilterParameters& params)
+	{
+		if (this == &params)
+			return *this;
 
-	double L1_norm = 95.493;		// 95.5 mH
-	double C1_norm = 530.516e-6;	// 0.53 uF
-	double L2_norm = 95.493;		// 95.5 mH
+		fc = params.fc;
+		Q = params.Q;
+		boostCut_dB = params.boostCut_dB;
+		frequencyWarping = params.frequencyWarping;
+		filterType = params.filterType;
+		crossfadeTime_mSec = params.crossfadeTime_mSec;
+		return *this;
+	}
 
-	bool useFrequencyWarping = false;	///< flag for freq warping
-	double sampleRate = 1.0;			///< stored sample rate
+	// --- individual parameters
+	double fc = 100.0;				///< filter fc
+	double Q = 0.707;				///< filter Q
+	double boostCut_dB = 0.0;		///< filter boost or cut in dB
+	bool frequencyWarping = true;	///< enable frequency warping
+	rlcFilterType filterType = rlcFilterType::kLPF; ///< active topology
+	double crossfadeTime_mSec = 5.0;	///< crossfade length when the topology changes
 };
 
 /**
-\class WDFBesselBSF3
+\class WDFIdealRLCFilter
 \ingroup WDF-Objects
 \brief
-The WDFBesselBSF3 object implements a 3rd order Bessel BSF
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFIdealRLCFilter object wraps the four ideal RLC WDF filters and runs only the selected one.
+
+Only the active topology receives parameter updates and audio; the others are left idle and
+are brought up to date (parameters synced, state flushed) when they are selected. A topology change
+crossfades linearly from the old filter to the new one over crossfadeTime_mSec so that switching
+does not click; both filters run only while the crossfade is in progress. A type selected during a
+crossfade is faded in when the running crossfade has finished, so no filter is ever cut off. The topologies are the
+inlined WDFTunedIdealRLC* filters, which recalculate their component values exactly on each fc/Q change.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- none - object is hardwired
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
+- Use WDFIdealRLCFilterParameters structure to get/set object params.
 */
-class WDFBesselBSF3 : public IAudioSignalProcessor
+class WDFIdealRLCFilter : public IAudioSignalProcessor
 {
 public:
-	WDFBesselBSF3(void) { createWDF(); }	/* C-TOR */
-	~WDFBesselBSF3(void) {}	/* D-TOR */
+	WDFIdealRLCFilter(void) {}	/* C-TOR */
+	~WDFIdealRLCFilter(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1C1.reset(_sampleRate);
-		parallelAdaptor_L2C2.reset(_sampleRate);
-		seriesTerminatedAdaptor_L3C3.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_L1C1.initializeAdaptorChain();
+		sampleRate = _sampleRate;
 
+		// --- flush all topologies so they share the new sample rate; only the active one is synced
+		rlcLPF.reset(_sampleRate);
+		rlcHPF.reset(_sampleRate);
+		rlcBPF.reset(_sampleRate);
+		rlcBSF.reset(_sampleRate);
+		activeType = parameters.filterType;
+		syncFilter(activeType);
+
+		previousType = activeType;
+		crossfadeLength = (unsigned int)(parameters.crossfadeTime_mSec*sampleRate / 1000.0);
+		crossfadeCounter = 0;
 		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/** process input x(n) through the active RLC filter; crossfade from the previous one after a type change */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_L1C1.setInput1(xn);
+		// --- a type selected during the last crossfade is faded in now
+		if (crossfadeCounter == 0 && activeType != parameters.filterType)
+			startCrossfade();
 
-		// --- output is at terminated L2's output2
-		return seriesTerminatedAdaptor_L3C3.getOutput2();
+		double yn = processFilter(activeType, xn);
+
+		if (crossfadeCounter > 0)
+		{
+			// --- linear fade from the old topology to the new one
+			double mix = (double)crossfadeCounter / (double)crossfadeLength;
+			yn = mix*processFilter(previousType, xn) + (1.0 - mix)*yn;
+			crossfadeCounter--;
+		}
+
+		return yn;
 	}
 
-	/** create the WDF structure; may be called more than once*/
-	void createWDF()
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFIdealRLCFilterParameters custom data structure
+	*/
+	WDFIdealRLCFilterParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFIdealRLCFilterParameters custom data structure
+	*/
+	void setParameters(const WDFIdealRLCFilterParameters& _parameters)
 	{
-		// --- set component values
-		// --- fo = 5kHz
-		//     BW = 2kHz or Q = 2.5
-		seriesAdaptor_L1C1.setComponent(wdfComponent::parallelLC, 16.8327e-3, 0.060193e-6);	/* L, C */
-		parallelAdaptor_L2C2.setComponent(wdfComponent::seriesLC, 49.1978e-3, 0.02059e-6);	/* L, C */
-		seriesTerminatedAdaptor_L3C3.setComponent(wdfComponent::parallelLC, 2.57755e-3, 0.393092e-6);	/* L, C */
+		if (_parameters.crossfadeTime_mSec != parameters.crossfadeTime_mSec)
+			crossfadeLength = (unsigned int)(_parameters.crossfadeTime_mSec*sampleRate / 1000.0);
 
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesTerminatedAdaptor_L3C3);
+		parameters = _parameters;
 
-		// --- set source resistance
-		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
+		// --- a new type is faded in now, or after the running crossfade (see processAudioSample( ))
+		if (parameters.filterType != activeType && crossfadeCounter == 0)
+			startCrossfade();
+		else
+			syncFilter(activeType);
 
-		// --- set terminal resistance
-		seriesTerminatedAdaptor_L3C3.setTerminalResistance(600.0);
+		// --- keep the outgoing filter tracking fc and Q while it is still audible
+		if (crossfadeCounter > 0)
+			syncFilter(previousType);
 	}
 
 protected:
-	// --- three adapters
-	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
-	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
-	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L3C3;	///< adaptor for L3 and C3
-};
+	WDFIdealRLCFilterParameters parameters; ///< object parameters
+
+	// --- the four topologies; only the active one (and the outgoing one during a crossfade) is updated
+	WDFTunedIdealRLCLPF rlcLPF; ///< LPF topology
+	WDFTunedIdealRLCHPF rlcHPF; ///< HPF topology
+	WDFTunedIdealRLCBPF rlcBPF; ///< BPF topology
+	WDFTunedIdealRLCBSF rlcBSF; ///< BSF topology
+
+	rlcFilterType activeType = rlcFilterType::kLPF;	///< topology running (or being faded in)
+	rlcFilterType previousType = rlcFilterType::kLPF; ///< topology being faded out
+	unsigned int crossfadeLength = 0;	///< crossfade length in samples
+	unsigned int crossfadeCounter = 0;	///< samples left in the current crossfade
+	double sampleRate = 1.0;			///< sample rate storage
+
+	/** fade from the active topology to the selected one, which starts with a clean state */
+	void startCrossfade()
+	{
+		previousType = activeType;
+		activeType = parameters.filterType;
+		resetFilter(activeType);
+		syncFilter(activeType);
+		crossfadeCounter = crossfadeLength;
+	}
+
+	/** push the current parameters to one topology; the filters only recalculate when the values change */
+	void syncFilter(rlcFilterType type)
+	{
+		WDFParameters wdfParameters;
+		wdfParameters.fc = parameters.fc;
+		wdfParameters.Q = parameters.Q;
+		wdfParameters.boostCut_dB = parameters.boostCut_dB;
+		wdfParameters.frequencyWarping = parameters.frequencyWarping;
+
+		switch (type)
+		{
+			case rlcFilterType::kLPF: rlcLPF.setParameters(wdfParameters); break;
+			case rlcFilterType::kHPF: rlcHPF.setParameters(wdfParameters); break;
+			case rlcFilterType::kBPF: rlcBPF.setParameters(wdfParameters); break;
+			case rlcFilterType::kBSF: rlcBSF.setParameters(wdfParameters); break;
+		}
+	}
+
+	/** flush the state registers of one topology */
+	void resetFilter(rlcFilterType type)
+	{
+		switch (type)
+		{
+			case rlcFilterType::kLPF: rlcLPF.reset(sampleRate); break;
+			case rlcFilterType::kHPF: rlcHPF.reset(sampleRate); break;
+			case rlcFilterType::kBPF: rlcBPF.reset(sampleRate); break;
+			case rlcFilterType::kBSF: rlcBSF.reset(sampleRate); break;
+		}
+	}
 
+	/** run one topology */
+	double processFilter(rlcFilterType type, double xn)
+	{
+		switch (type)
+		{
+			case rlcFilterType::kLPF: return rlcLPF.processAudioSample(xn);
+			case rlcFilterType::kHPF: return rlcHPF.processAudioSample(xn);
+			case rlcFilterType::kBPF: return rlcBPF.processAudioSample(xn);
+			case rlcFilterType::kBSF: return rlcBSF.processAudioSample(xn);
+		}
+		return xn;
+	}
+};
 
 /**
-\class WDFConstKBPF6
+\class WDFButterLPF3Inline
 \ingroup WDF-Objects
 \brief
-The WDFConstKBPF6 object implements a 6th order constant K BPF
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFButterLPF3Inline object implements the WDFButterLPF3 filter as a compile-time WdfLadder;
+the output is identical, without virtual dispatch or heap allocated components.
 
 Audio I/O:
 - Processes mono input to mono output.
@@ -8052,32 +13884,18 @@ Audio I/O:
 Control I/F:
 - none - object is hardwired
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFConstKBPF6 : public IAudioSignalProcessor
+class WDFButterLPF3Inline : public IAudioSignalProcessor
 {
 public:
-	WDFConstKBPF6(void) { createWDF(); }	/* C-TOR */
-	~WDFConstKBPF6(void) {}	/* D-TOR */
+	WDFButterLPF3Inline(void) { createWDF(); }	/* C-TOR */
+	~WDFButterLPF3Inline(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1C1.reset(_sampleRate);
-		parallelAdaptor_L2C2.reset(_sampleRate);
-
-		seriesAdaptor_L3C3.reset(_sampleRate);
-		parallelAdaptor_L4C4.reset(_sampleRate);
-
-		seriesAdaptor_L5C5.reset(_sampleRate);
-		parallelTerminatedAdaptor_L6C6.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_L1C1.initializeAdaptorChain();
+		ladder.reset(_sampleRate);
 		return true;
 	}
 
@@ -8091,217 +13909,100 @@ public:
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_L1C1.setInput1(xn);
-
-		// --- output is at terminated L6C6 output2
-		double output = parallelTerminatedAdaptor_L6C6.getOutput2();
-
-		return output;
+		return ladder.processAudioSample(xn);
 	}
 
-	/** create the WDF structure */
+	/** create the WDF structure for this object - may be called more than once */
 	void createWDF()
 	{
-		// --- fo = 5kHz
-		//     BW = 2kHz or Q = 2.5
-		seriesAdaptor_L1C1.setComponent(wdfComponent::seriesLC, 47.7465e-3, 0.02122e-6);
-		parallelAdaptor_L2C2.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
-
-		seriesAdaptor_L3C3.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
-		parallelAdaptor_L4C4.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
-
-		seriesAdaptor_L5C5.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
-		parallelTerminatedAdaptor_L6C6.setComponent(wdfComponent::parallelLC, 7.63944e-3, 0.132629e-6);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesAdaptor_L3C3);
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L3C3, &parallelAdaptor_L4C4);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L4C4, &seriesAdaptor_L5C5);
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L5C5, &parallelTerminatedAdaptor_L6C6);
-
-		// --- set source resistance
-		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
+		// --- actual component values fc = 1kHz
+		ladder.getStage<0>().component.setComponentValue(95.49e-3);		// L1 = 95.5 mH
+		ladder.getStage<1>().component.setComponentValue(0.5305e-6);	// C1 = 0.53 uF
+		ladder.getStage<2>().component.setComponentValue(95.49e-3);		// L2 = 95.5 mH
 
-		// --- set terminal resistance
-		parallelTerminatedAdaptor_L6C6.setTerminalResistance(600.0);
+		ladder.setSourceResistance(600.0);						// --- Rs = 600
+		ladder.getStage<2>().setTerminalResistance(600.0);		// --- Rload = 600
 	}
 
 protected:
-	// --- six adapters
-	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
-	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
-
-	WdfSeriesAdaptor seriesAdaptor_L3C3;		///< adaptor for L3 and C3
-	WdfParallelAdaptor parallelAdaptor_L4C4;	///< adaptor for L4 and C4
-
-	WdfSeriesAdaptor seriesAdaptor_L5C5;		///< adaptor for L5 and C5
-	WdfParallelTerminatedAdaptor parallelTerminatedAdaptor_L6C6;///< adaptor for L6 and C6
-};
-
-
-/**
-\struct WDFParameters
-\ingroup WDF-Objects
-\brief
-Custom parameter structure for the WDF filter examples.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct WDFParameters
-{
-	WDFParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	WDFParameters& operator=(const WDFParameters& params)
-	{
-		if (this == &params)
-			return *this;
-
-		fc = params.fc;
-		Q = params.Q;
-		boostCut_dB = params.boostCut_dB;
-		frequencyWarping = params.frequencyWarping;
-		return *this;
-	}
-
-	// --- individual parameters
-	double fc = 100.0;				///< filter fc
-	double Q = 0.707;				///< filter Q
-	double boostCut_dB = 0.0;		///< filter boost or cut in dB
-	bool frequencyWarping = true;	///< enable frequency warping
+	// --- Series(L1) -> Parallel(C1) -> Series terminated(L2)
+	WdfLadder<WdfSeriesStage<WdfInductor>,
+			  WdfParallelStage<WdfCapacitor>,
+			  WdfSeriesTerminatedStage<WdfInductor>> ladder; ///< the filter
 };
 
 /**
-\class WDFIdealRLCLPF
+\class WDFConstKBPF6Inline
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCLPF object implements an ideal RLC LPF using the WDF library.
+The WDFConstKBPF6Inline object implements the WDFConstKBPF6 filter as a compile-time WdfLadder;
+the output is identical, without virtual dispatch or heap allocated components.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use WDFParameters structure to get/set object params.
+- none - object is hardwired
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCLPF : public IAudioSignalProcessor
+class WDFConstKBPF6Inline : public IAudioSignalProcessor
 {
 public:
-	WDFIdealRLCLPF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCLPF(void) {}	/* D-TOR */
+	WDFConstKBPF6Inline(void) { createWDF(); }	/* C-TOR */
+	~WDFConstKBPF6Inline(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		sampleRate = _sampleRate;
-
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_RL.reset(_sampleRate);
-		parallelTerminatedAdaptor_C.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_RL.initializeAdaptorChain();
+		ladder.reset(_sampleRate);
 		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- push audio sample into series L1
-		seriesAdaptor_RL.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_C.getOutput2();
-	}
-
-	/** create the WDF structure; may be called more than once */
-	void createWDF()
-	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_RL.setComponent(wdfComponent::seriesRL, 2.251131e2, 2.533e-2);
-		parallelTerminatedAdaptor_C.setComponent(wdfComponent::C, 1.0e-6);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RL, &parallelTerminatedAdaptor_C);
-
-		// --- set source resistance
-		seriesAdaptor_RL.setSourceResistance(0.0); // --- Rs = 600
-
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_C.setOpenTerminalResistance(true);
-	}
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** get parameters: note use of custom structure for passing param data */
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
 	/**
-	\return WDFParameters custom data structure
+	\param xn input
+	\return the processed sample
 	*/
-	WDFParameters getParameters() { return wdfParameters; }
+	virtual double processAudioSample(double xn)
+	{
+		return ladder.processAudioSample(xn);
+	}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param WDFParameters custom data structure
-	*/
-	void setParameters(const WDFParameters& _wdfParameters)
+	/** create the WDF structure */
+	void createWDF()
 	{
-		if (_wdfParameters.fc != wdfParameters.fc ||
-			_wdfParameters.Q != wdfParameters.Q ||
-			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
-			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
-		{
-			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		ladder.getStage<0>().component.setComponentValue_LC(47.7465e-3, 0.02122e-6);
+		ladder.getStage<1>().component.setComponentValue_LC(3.81972e-3, 0.265258e-6);
 
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
+		ladder.getStage<2>().component.setComponentValue_LC(95.493e-3, 0.01061e-6);
+		ladder.getStage<3>().component.setComponentValue_LC(3.81972e-3, 0.265258e-6);
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
+		ladder.getStage<4>().component.setComponentValue_LC(95.493e-3, 0.01061e-6);
+		ladder.getStage<5>().component.setComponentValue_LC(7.63944e-3, 0.132629e-6);
 
-			seriesAdaptor_RL.setComponentValue_RL(resistorValue, inductorValue);
-			seriesAdaptor_RL.initializeAdaptorChain();
-		}
+		ladder.setSourceResistance(600.0);						// Ro = 600
+		ladder.getStage<5>().setTerminalResistance(600.0);
 	}
 
 protected:
-	WDFParameters wdfParameters;	///< object parameters
-
-	// --- adapters
-	WdfSeriesAdaptor				seriesAdaptor_RL;				///< adaptor for series RL
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_C;	///< adaptopr for parallel C
-
-	double sampleRate = 1.0;
-
+	// --- three series LC / parallel LC sections
+	WdfLadder<WdfSeriesStage<WdfSeriesLC>, WdfParallelStage<WdfParallelLC>,
+			  WdfSeriesStage<WdfSeriesLC>, WdfParallelStage<WdfParallelLC>,
+			  WdfSeriesStage<WdfSeriesLC>, WdfParallelTerminatedStage<WdfParallelLC>> ladder; ///< the filter
 };
 
 /**
-\class WDFIdealRLCHPF
+\class WDFIdealRLCLPFInline
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCHPF object implements an ideal RLC HPF using the WDF library.
+The WDFIdealRLCLPFInline object implements the WDFIdealRLCLPF filter as a compile-time WdfLadder;
+the output is identical, without virtual dispatch or heap allocated components.
 
 Audio I/O:
 - Processes mono input to mono output.
@@ -8309,27 +14010,19 @@ Audio I/O:
 Control I/F:
 - Use WDFParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCHPF : public IAudioSignalProcessor
+class WDFIdealRLCLPFInline : public IAudioSignalProcessor
 {
 public:
-	WDFIdealRLCHPF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCHPF(void) {}	/* D-TOR */
+	WDFIdealRLCLPFInline(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCLPFInline(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_RC.reset(_sampleRate);
-		parallelTerminatedAdaptor_L.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_RC.initializeAdaptorChain();
+		ladder.reset(_sampleRate);
 		return true;
 	}
 
@@ -8343,34 +14036,21 @@ public:
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_RC.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
+		// --- note compensation scaling by -6dB = 0.5
 		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_L.getOutput2();
+		return 0.5*ladder.processAudioSample(xn);
 	}
 
-	/** create WDF structure; may be called more than once */
+	/** create the WDF structure; may be called more than once */
 	void createWDF()
 	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
+		// --- initial values for fc = 1kHz Q = 0.707
 		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_RC.setComponent(wdfComponent::seriesRC, 2.251131e2, 1.0e-6);
-		parallelTerminatedAdaptor_L.setComponent(wdfComponent::L, 2.533e-2);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RC, &parallelTerminatedAdaptor_L);
+		ladder.getStage<0>().component.setComponentValue_RL(2.251131e2, 2.533e-2);
+		ladder.getStage<1>().component.setComponentValue(1.0e-6);
 
-		// --- set source resistance
-		seriesAdaptor_RC.setSourceResistance(0.0); // --- Rs = 600
-
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_L.setOpenTerminalResistance(true);
+		ladder.setSourceResistance(0.0);					// --- Rs = 0
+		ladder.getStage<1>().setOpenTerminalResistance(true);	// --- open ckt termination
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
@@ -8402,269 +14082,304 @@ public:
 			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
 			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
 
-			seriesAdaptor_RC.setComponentValue_RC(resistorValue, 1.0e-6);
-			parallelTerminatedAdaptor_L.setComponentValue(inductorValue);
-			seriesAdaptor_RC.initializeAdaptorChain();
+			ladder.getStage<0>().component.setComponentValue_RL(resistorValue, inductorValue);
+			ladder.initializeAdaptorChain();
 		}
 	}
 
-
 protected:
 	WDFParameters wdfParameters;	///< object parameters
 
-	// --- three
-	WdfSeriesAdaptor				seriesAdaptor_RC;				///< adaptor for RC
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_L;	///< adaptor for L
+	// --- Series(RL) -> Parallel terminated(C)
+	WdfLadder<WdfSeriesStage<WdfSeriesRL>,
+			  WdfParallelTerminatedStage<WdfCapacitor>> ladder; ///< the filter
 
 	double sampleRate = 1.0;	///< sample rate storage
 };
 
 /**
-\class WDFIdealRLCBPF
+\struct WDFDiodeClipperParameters
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCBPF object implements an ideal RLC BPF using the WDF library.
+Custom parameter structure for the WDFDiodeClipper object.
+
+\version Revision : 1.0
+*/
+struct WDFDiodeClipperParameters
+{
+	WDFDiodeClipperParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	WDFDiodeClipperParameters& operator=(const WDFDiodeClipperParameters& params)
+	{
+		if (this == &params)
+			return *this;
+
+		fc = params.fc;
+		inputGain_dB = params.inputGain_dB;
+		outputGain_dB = params.outputGain_dB;
+		return *this;
+	}
+
+	// --- individual parameters
+	double fc = 10000.0;		///< RC lowpass corner (small signal)
+	double inputGain_dB = 0.0;	///< drive into the clipper
+	double outputGain_dB = 0.0;	///< output level
+};
+
+/**
+\class WDFDiodeClipper
+\ingroup WDF-Objects
+\brief
+The WDFDiodeClipper object implements the classic R - C || diode pair clipping stage as a WDF with the
+diode pair at the root, solved in closed form (see WdfDiodePairRoot); the output is the diode voltage,
+which is unity gain for small signals and clips softly at about +/-0.7V.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use WDFParameters structure to get/set object params.
+- Use WDFDiodeClipperParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCBPF : public IAudioSignalProcessor
+class WDFDiodeClipper : public IAudioSignalProcessor
 {
 public:
-	WDFIdealRLCBPF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCBPF(void) {}	/* D-TOR */
+	WDFDiodeClipper(void)	/* C-TOR */
+	{
+		// --- R = 2.2k is the source resistance; C sets the corner
+		ladder.setSourceResistance(resistorValue);
+		setCapacitor();
+	}
+	~WDFDiodeClipper(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_LC.reset(_sampleRate);
-		parallelTerminatedAdaptor_R.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_LC.initializeAdaptorChain();
+		ladder.reset(_sampleRate);
 		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/** process input x(n) through the clipper to produce return value y(n) */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_LC.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_R.getOutput2();
-	}
-
-	/** create the WDF structure*/
-	void createWDF()
-	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
-		parallelTerminatedAdaptor_R.setComponent(wdfComponent::R, 2.251131e2);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_LC, &parallelTerminatedAdaptor_R);
-
-		// --- set source resistance
-		seriesAdaptor_LC.setSourceResistance(0.0); // --- Rs = 600
-
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_R.setOpenTerminalResistance(true);
+		return outputGain*ladder.processAudioSample(inputGain*xn);
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return WDFParameters custom data structure
+	\return WDFDiodeClipperParameters custom data structure
 	*/
-	WDFParameters getParameters() { return wdfParameters; }
+	WDFDiodeClipperParameters getParameters() { return parameters; }
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param WDFParameters custom data structure
+	\param WDFDiodeClipperParameters custom data structure
 	*/
-	void setParameters(const WDFParameters& _wdfParameters)
+	void setParameters(const WDFDiodeClipperParameters& params)
 	{
-		if (_wdfParameters.fc != wdfParameters.fc ||
-			_wdfParameters.Q != wdfParameters.Q ||
-			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
-			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
-		{
-			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
-
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
+		bool fcChanged = params.fc != parameters.fc;
+		parameters = params;
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
+		inputGain = dB2Raw(parameters.inputGain_dB);
+		outputGain = dB2Raw(parameters.outputGain_dB);
 
-			seriesAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
-			parallelTerminatedAdaptor_R.setComponentValue(resistorValue);
-			seriesAdaptor_LC.initializeAdaptorChain();
+		if (fcChanged)
+		{
+			setCapacitor();
+			ladder.initializeAdaptorChain();
 		}
 	}
 
 protected:
-	WDFParameters wdfParameters;	///< object parameters
+	WDFDiodeClipperParameters parameters;	///< object parameters
 
-	// --- adapters
-	WdfSeriesAdaptor				seriesAdaptor_LC; ///< adaptor for LC
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_R; ///< adaptor for R
+	// --- Rs -> Parallel(C) -> diode pair
+	WdfLadder<WdfParallelStage<WdfCapacitor>, WdfDiodePairRoot> ladder; ///< the circuit
 
-	double sampleRate = 1.0;
+	double resistorValue = 2.2e3;	///< series resistor
+	double inputGain = 1.0;			///< cooked input gain
+	double outputGain = 1.0;		///< cooked output gain
+
+	/** C from fc = 1/(2 pi R C) */
+	void setCapacitor()
+	{
+		ladder.getStage<0>().component.setComponentValue(1.0 / (kTwoPi*resistorValue*parameters.fc));
+	}
 };
 
+/**
+\struct WDFTriodeClassAParameters
+\ingroup WDF-Objects
+\brief
+Custom parameter structure for the WDFTriodeClassA object.
+
+\version Revision : 1.0
+*/
+struct WDFTriodeClassAParameters
+{
+	WDFTriodeClassAParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	WDFTriodeClassAParameters& operator=(const WDFTriodeClassAParameters& params)
+	{
+		if (this == &params)
+			return *this;
+
+		inputGain_dB = params.inputGain_dB;
+		outputGain_dB = params.outputGain_dB;
+		gridBias_V = params.gridBias_V;
+		hpf_Fc = params.hpf_Fc;
+		return *this;
+	}
+
+	// --- individual parameters
+	double inputGain_dB = 0.0;	///< drive: 1.0 in = 1V peak at the grid
+	double outputGain_dB = 0.0;	///< output level
+	double gridBias_V = -1.5;	///< grid-cathode bias (more negative = colder, more asymmetric)
+	double hpf_Fc = 5.0;		///< fc of DC blocking cap
+};
 
 /**
-\class WDFIdealRLCBSF
+\class WDFTriodeClassA
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCBSF object implements an ideal RLC BSF using the WDF library.
+The WDFTriodeClassA object implements a common cathode 12AX7 stage as a WDF: B+ (250V) through the
+100k plate resistor with a plate capacitance to ground, and the triode plate at the root (see WdfTriodeRoot).
+The input drives the grid; the plate swing is normalized to unity small signal gain (non-inverting) at
+the current bias and DC blocked, so large inputs compress and clip asymmetrically like the real stage.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use WDFParameters structure to get/set object params.
+- Use WDFTriodeClassAParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCBSF : public IAudioSignalProcessor
+class WDFTriodeClassA : public IAudioSignalProcessor
 {
 public:
-	WDFIdealRLCBSF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCBSF(void) {}	/* D-TOR */
+	WDFTriodeClassA(void)	/* C-TOR */
+	{
+		ladder.setSourceResistance(plateResistor);
+		ladder.getStage<0>().component.setComponentValue(plateCapacitor);
+		ladder.getStage<1>().setWaveRange(0.0, 1.25*supplyVoltage);
 
-	/** reset members to initialized state */
+		AudioFilterParameters params;
+		params.algorithm = filterAlgorithm::kHPF1;
+		params.fc = parameters.hpf_Fc;
+		outputHPF.setParameters(params);
+	}
+	~WDFTriodeClassA(void) {}	/* D-TOR */
+
+	/** reset members to initialized state; builds the triode table */
 	virtual bool reset(double _sampleRate)
 	{
-		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_R.reset(_sampleRate);
-		parallelTerminatedAdaptor_LC.reset(_sampleRate);
+		ladder.reset(_sampleRate);
+		outputHPF.reset(_sampleRate);
+		calculateOperatingPoint();
+
+		// --- let the plate capacitor charge to the operating point
+		WdfTriodeRoot& triode = ladder.getStage<1>();
+		triode.setGridVoltage(parameters.gridBias_V);
+		for (unsigned int n = 0; n < (unsigned int)(0.01*_sampleRate); n++)
+			ladder.processAudioSample(supplyVoltage);
 
-		// --- intialize the chain of adapters
-		seriesAdaptor_R.initializeAdaptorChain();
 		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/** process input x(n) through the triode stage to produce return value y(n) */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_R.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_LC.getOutput2();
-	}
-
-	/** create WDF structure */
-	void createWDF()
-	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_R.setComponent(wdfComponent::R, 2.533e-2);
-		parallelTerminatedAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
+		ladder.getStage<1>().setGridVoltage(parameters.gridBias_V + inputGain*xn);
+		double plateVoltage = ladder.processAudioSample(supplyVoltage);
 
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_R, &parallelTerminatedAdaptor_LC);
+		// --- plate swing around the operating point, normalized to unity gain
+		double output = (plateVoltage - quiescentPlateVoltage)*gainNormalizer;
 
-		// --- set source resistance
-		seriesAdaptor_R.setSourceResistance(0.0); // --- Rs = 600
+		// --- Output (plate) capacitor = HPF, remove DC offset
+		output = outputHPF.processAudioSample(output);
 
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_LC.setOpenTerminalResistance(true);
+		return outputGain*output;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return WDFParameters custom data structure
+	\return WDFTriodeClassAParameters custom data structure
 	*/
-	WDFParameters getParameters() { return wdfParameters; }
+	WDFTriodeClassAParameters getParameters() { return parameters; }
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param WDFParameters custom data structure
+	\param WDFTriodeClassAParameters custom data structure
 	*/
-	void setParameters(const WDFParameters& _wdfParameters)
+	void setParameters(const WDFTriodeClassAParameters& params)
 	{
-		if (_wdfParameters.fc != wdfParameters.fc ||
-			_wdfParameters.Q != wdfParameters.Q ||
-			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
-			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		bool biasChanged = params.gridBias_V != parameters.gridBias_V;
+		if (params.hpf_Fc != parameters.hpf_Fc)
 		{
-			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
-
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
+			AudioFilterParameters filterParams = outputHPF.getParameters();
+			filterParams.fc = params.hpf_Fc;
+			outputHPF.setParameters(filterParams);
+		}
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
+		parameters = params;
+		inputGain = dB2Raw(parameters.inputGain_dB);
+		outputGain = dB2Raw(parameters.outputGain_dB);
 
-			seriesAdaptor_R.setComponentValue(resistorValue);
-			parallelTerminatedAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
-			seriesAdaptor_R.initializeAdaptorChain();
-		}
+		if (biasChanged)
+			calculateOperatingPoint();
 	}
 
 protected:
-	WDFParameters wdfParameters;	///< object parameters
+	WDFTriodeClassAParameters parameters;	///< object parameters
 
-	// --- adapters
-	WdfSeriesAdaptor				seriesAdaptor_R; ///< adaptor for series R
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_LC; ///< adaptor for parallel LC
+	// --- B+ -> Rp -> Parallel(C plate) -> triode plate
+	WdfLadder<WdfParallelStage<WdfCapacitor>, WdfTriodeRoot> ladder; ///< the circuit
+	AudioFilter outputHPF;	///< HPF to simulate output DC blocking cap
 
-	double sampleRate = 1.0; ///< sample rate storage
+	double supplyVoltage = 250.0;	///< B+
+	double plateResistor = 100.0e3;	///< Rp
+	double plateCapacitor = 150.0e-12; ///< plate capacitance to ground (treble roll-off)
+
+	double inputGain = 1.0;				///< cooked input gain
+	double outputGain = 1.0;			///< cooked output gain
+	double quiescentPlateVoltage = 0.0;	///< plate voltage at the bias point
+	double gainNormalizer = 1.0;		///< 1 / small signal gain at the bias point
+
+	/** DC plate voltage and small signal gain at the grid bias (the plate capacitor is open at DC) */
+	void calculateOperatingPoint()
+	{
+		WdfTriodeRoot& triode = ladder.getStage<1>();
+		double vg = parameters.gridBias_V;
+		double dv = 0.01;
+
+		quiescentPlateVoltage = triode.solvePlateVoltage(supplyVoltage, plateResistor, vg);
+		double vHigh = triode.solvePlateVoltage(supplyVoltage, plateResistor, vg + dv, quiescentPlateVoltage);
+		double vLow = triode.solvePlateVoltage(supplyVoltage, plateResistor, vg - dv, quiescentPlateVoltage);
+		double gain = (vHigh - vLow) / (2.0*dv);
+
+		gainNormalizer = gain != 0.0 ? 1.0 / gain : 1.0;
+	}
 };
 
 
 // ------------------------------------------------------------------ //
-// --- OBJECTS REQUIRING FFTW --------------------------------------- //
+// --- FFT OBJECTS (FFTW or the built-in FFTKernel) ----------------- //
 // ------------------------------------------------------------------ //
 
 /**
@@ -8738,18 +14453,25 @@ inline std::unique_ptr<double[]> makeWindow(unsigned int windowLength, unsigned
 	return windowBuffer;
 }
 
-// --- FFTW --- to enable, add the statement #define HAVE_FFTW 1 to the top of the file
+// --- FFTW --- to use it, add the statement #define HAVE_FFTW 1 to the top of the file (or define it for the project);
+//     otherwise the objects below run on the built-in FFTKernel, which provides the FFTW calls they use
 #ifdef HAVE_FFTW
 #include "fftw3.h"
+#else
+#include "fftkernel.h"
+#endif
 
 /**
 \class FastFFT
 \ingroup FFTW-Objects
 \brief
 The FastFFT provides a simple wrapper for the FFTW FFT operation - it is ultra-thin and simple to use.
+Without FFTW (HAVE_FFTW not defined) it runs on the built-in FFTKernel.
 
 Audio I/O:
 - processes mono inputs into FFT outputs.
+- real inputs can use doRealFFT( ) and doRealInverseFFT( ), which work on the N/2 + 1 bin half spectrum
+  at about half the cost of the complex transforms.
 
 Control I/F:
 - none.
@@ -8780,9 +14502,18 @@ public:
 	/** do the IFFT and return real and imaginary arrays */
 	fftw_complex* doInverseFFT(double* inputReal, double* inputImag);
 
+	/** do the FFT of a real input and return the half spectrum (getSpectrumLength( ) bins) */
+	fftw_complex* doRealFFT(double* input);
+
+	/** do the IFFT of a half spectrum and return the real output (unscaled, as FFTW) */
+	double* doRealInverseFFT(fftw_complex* halfSpectrum);
+
 	/** get the current FFT length */
 	unsigned int getFrameLength() { return frameLength; }
 
+	/** get the number of half spectrum bins, N/2 + 1 */
+	unsigned int getSpectrumLength() { return frameLength / 2 + 1; }
+
 protected:
 	// --- setup FFTW
 	fftw_complex*	fft_input = nullptr;		///< array for FFT input
@@ -8792,6 +14523,14 @@ protected:
 	fftw_plan       plan_forward = nullptr;		///< FFTW plan for FFT
 	fftw_plan		plan_backward = nullptr;	///< FFTW plan for IFFT
 
+	// --- real transforms, half spectrum
+	double*			real_input = nullptr;		///< array for real FFT input
+	fftw_complex*	half_result = nullptr;		///< array for real FFT output (N/2 + 1 bins)
+	fftw_complex*	half_input = nullptr;		///< array for real IFFT input (N/2 + 1 bins)
+	double*			real_result = nullptr;		///< array for real IFFT output
+	fftw_plan		plan_real_forward = nullptr;	///< FFTW plan for real FFT
+	fftw_plan		plan_real_backward = nullptr;	///< FFTW plan for real IFFT
+
 	double* windowBuffer = nullptr;				///< buffer for window (naked)
 	double windowGainCorrection = 1.0;			///< window gain correction
 	windowType window = windowType::kHannWindow; ///< window type
@@ -8807,6 +14546,9 @@ The PhaseVocoder provides a basic phase vocoder that is initialized to N = 4096
 75% overlap; the de-facto standard for PSM algorithms. The analysis and sythesis
 hop sizes are identical.
 
+The input is real, so the vocoder uses real-to-complex and complex-to-real transforms: the FFT data is
+the half spectrum, bins 0 ... N/2 (getSpectrumLength( ) bins), and the IFFT data is real.
+
 Audio I/O:
 - processes mono input into mono output.
 
@@ -8844,11 +14586,11 @@ public:
 	/** increment the FFT counter and do the FFT if it is ready */
 	bool advanceAndCheckFFT();
 
-	/** get FFT data for manipulation (yes, naked pointer so you can manipulate) */
+	/** get FFT data for manipulation (yes, naked pointer so you can manipulate); half spectrum of getSpectrumLength( ) bins */
 	fftw_complex* getFFTData() { return fft_result; }
 
-	/** get IFFT data for manipulation (yes, naked pointer so you can manipulate) */
-	fftw_complex* getIFFTData() { return ifft_result; }
+	/** get IFFT data for manipulation (yes, naked pointer so you can manipulate); frameLength real values */
+	double* getIFFTData() { return ifft_result; }
 
 	/** do the inverse FFT (optional; will be called automatically if not used) */
 	void doInverseFFT();
@@ -8859,6 +14601,9 @@ public:
 	/** get current FFT length */
 	unsigned int getFrameLength() { return frameLength; }
 
+	/** get the number of half spectrum bins in the FFT data, N/2 + 1 */
+	unsigned int getSpectrumLength() { return frameLength / 2 + 1; }
+
 	/** get current hop size ha = hs */
 	unsigned int getHopSize() { return hopSize; }
 
@@ -8868,13 +14613,13 @@ public:
 	/** set the vocoder for overlap add only without hop-size */
 	// --- for fast convolution and other overlap-add algorithms
 	//     that are not hop-size dependent
-	void setOverlapAddOnly(bool b){ bool overlapAddOnly = b; }
+	void setOverlapAddOnly(bool b){ overlapAddOnly = b; }
 
 protected:
-	// --- setup FFTW
-	fftw_complex*	fft_input = nullptr;		///< array for FFT input
-	fftw_complex*	fft_result = nullptr;		///< array for FFT output
-	fftw_complex*	ifft_result = nullptr;		///< array for IFFT output
+	// --- setup FFTW: real-to-complex and complex-to-real
+	double*			fft_input = nullptr;		///< array for FFT input (real)
+	fftw_complex*	fft_result = nullptr;		///< array for FFT output (half spectrum)
+	double*			ifft_result = nullptr;		///< array for IFFT output (real)
 	fftw_plan       plan_forward = nullptr;		///< FFTW plan for FFT
 	fftw_plan		plan_backward = nullptr;	///< FFTW plan for IFFT
 
@@ -8924,7 +14669,8 @@ protected:
 \brief
 The FastConvolver provides a fast convolver - the user supplies the filter IR and the object
 snapshots the FFT of that filter IR. Input audio is fast-convovled with the filter FFT using
-complex multiplication and zero-padding.
+complex multiplication and zero-padding. Both the signal and the filter are real, so only the half
+spectra (filterImpulseLength + 1 bins) are stored and multiplied.
 
 Audio I/O:
 - processes mono input into mono output.
@@ -8973,11 +14719,11 @@ public:
 		filterIR = new double[filterImpulseLength * 2];
 		memset(&filterIR[0], 0, filterImpulseLength * 2 * sizeof(double));
 
-		// --- allocate the filter FFT arrays
+		// --- allocate the filter FFT arrays: half spectrum of the 2N point FFT
 		if(filterFFT)
 			fftw_free(filterFFT);
 
-		 filterFFT = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * filterImpulseLength * 2);
+		 filterFFT = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * (filterImpulseLength + 1));
 
 		 // --- reset
 		 inputCount = 0;
@@ -8991,14 +14737,13 @@ public:
 		memset(&filterIR[0], 0, filterImpulseLength * 2 * sizeof(double));
 
 		// --- copy over first half; filterIR len = filterImpulseLength * 2
-		int m = 0;
 		for (unsigned int i = 0; i < filterImpulseLength; i++)
 		{
 			filterIR[i] = irBuffer[i];
 		}
 
-		// --- take FFT of the h(n)
-		fftw_complex* fftOfFilter = filterFastFFT.doFFT(&filterIR[0]);
+		// --- take FFT of the h(n); real, so the half spectrum is all we need
+		fftw_complex* fftOfFilter = filterFastFFT.doRealFFT(&filterIR[0]);
 
 		// --- copy the FFT into our local buffer for storage; also
 		//     we never want to hold a pointer to a FFT output
@@ -9006,76 +14751,556 @@ public:
 		//     could replace with memcpy( )
 		for (uint32_t i = 0; i < 2; i++)
 		{
-			for (unsigned int j = 0; j < filterImpulseLength * 2; j++)
+			for (unsigned int j = 0; j < filterImpulseLength + 1; j++)
 			{
 				filterFFT[j][i] = fftOfFilter[j][i];
 			}
 		}
 	}
 
-	/** process an input sample through convolver */
-	double processAudioSample(double input)
+	/** process an input sample through convolver */
+	double processAudioSample(double input)
+	{
+		bool fftReady = false;
+		double output = 0.0;
+
+		if (inputCount == filterImpulseLength)
+		{
+			fftReady = vocoder.addZeroPad(filterImpulseLength);
+
+			if (fftReady) // should happen on time
+			{
+				// --- multiply our filter IR with the vocoder FFT
+				fftw_complex* signalFFT = vocoder.getFFTData();
+				if (signalFFT)
+				{
+					// --- complex multiply with FFT of IR; half spectra, filterImpulseLength + 1 bins
+					for (unsigned int i = 0; i < filterImpulseLength + 1; i++)
+					{
+						// --- get real/imag parts of each FFT
+						ComplexNumber signal(signalFFT[i][0], signalFFT[i][1]);
+						ComplexNumber filter(filterFFT[i][0], filterFFT[i][1]);
+
+						// --- use complex multiply function; this convolves in the time domain
+						ComplexNumber product = complexMultiply(signal, filter);
+
+						// --- overwrite the FFT bins
+						signalFFT[i][0] = product.real;
+						signalFFT[i][1] = product.imag;
+					}
+				}
+			}
+
+			// --- reset counter
+			inputCount = 0;
+		}
+
+		// --- process next sample
+		output = vocoder.processAudioSample(input, fftReady);
+		inputCount++;
+
+		return output;
+	}
+
+	/** get current frame length */
+	unsigned int getFrameLength() { return vocoder.getFrameLength(); }
+
+	/** get current IR length*/
+	unsigned int getFilterIRLength() { return filterImpulseLength; }
+
+protected:
+	PhaseVocoder vocoder;				///< vocoder object
+	FastFFT filterFastFFT;				///< FastFFT object
+	fftw_complex* filterFFT = nullptr;	///< filterFFT output arrays
+	double* filterIR = nullptr;			///< filter IR
+	unsigned int inputCount = 0;		///< input sample counter
+	unsigned int filterImpulseLength = 0;///< IR length
+};
+
+/** default partition size (and latency) of the PartitionedConvolver */
+const unsigned int DEFAULT_CONVOLVER_PARTITION = 64;
+
+/**
+\class PartitionedConvolver
+\ingroup FFTW-Objects
+\brief
+The PartitionedConvolver implements uniformly partitioned overlap-save convolution (UPOLS) for long IRs
+(cabinets, rooms). The IR is cut into partitions of B samples and the FFT (2B points, real) of each
+partition is stored once. Every B input samples, the newest 2B samples of input are transformed and pushed
+into a frequency-domain delay line (FDL) of the last P input spectra; the output block is the IFFT of
+the sum of FDL[p] x H[p], of which the last B samples are kept (overlap-save).
+
+- latency is B samples (getLatencyInSamples( )), independent of the IR length
+- every block does the same work: one FFT, P half spectrum complex multiply-adds and one IFFT,
+  so the CPU load is spread evenly instead of landing in one spike per IR length
+- set B to the host block size, or the smallest block size you expect
+
+It is a drop-in for the other convolvers: init( ) / setImpulseResponse( ) as ImpulseConvolver (which has
+no latency) and initialize( ) / setFilterIR( ) as FastConvolver (which has a latency of the IR length).
+
+Audio I/O:
+- Processes mono input to mono output, per sample or in blocks.
+
+Control I/F:
+- setPartitionSize( ), init( ) and setImpulseResponse( ) allocate when sizes change, so they are not realtime safe;
+  setImpulseResponse( ) with an unchanged length only transforms the new IR.
+
+\version Revision : 1.0
+*/
+class PartitionedConvolver : public IAudioSignalProcessor
+{
+public:
+	PartitionedConvolver() {}		/* C-TOR */
+	~PartitionedConvolver() {
+		destroyFFTW();
+	}	/* D-TOR */
+
+	/** reset members to initialized state: flushes the signal history and the FDL; the IR is kept */
+	virtual bool reset(double _sampleRate);
+
+	/** process one input; the output is delayed by getLatencyInSamples( ) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		if (numPartitions == 0)
+			return 0.0;
+
+		double yn = outputBlock[inputCount];
+		fft_input[partitionSize + inputCount] = xn;
+
+		if (++inputCount == partitionSize)
+		{
+			processPartition();
+			inputCount = 0;
+		}
+		return yn;
+	}
+
+	/** process a block of MONO audio; same output as processAudioSample( ) per sample.
+		input and output may be the same buffer. */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		if (numPartitions == 0)
+		{
+			memset(output, 0, blockSize * sizeof(double));
+			return;
+		}
+
+		for (unsigned int n = 0; n < blockSize;)
+		{
+			unsigned int length = std::min(blockSize - n, partitionSize - inputCount);
+
+			// --- take the input before writing the output, in case they are the same buffer
+			memcpy(&fft_input[partitionSize + inputCount], &input[n], length * sizeof(double));
+			memcpy(&output[n], &outputBlock[inputCount], length * sizeof(double));
+
+			inputCount += length;
+			n += length;
+			if (inputCount == partitionSize)
+			{
+				processPartition();
+				inputCount = 0;
+			}
+		}
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** set the partition size B (power of 2), which is also the latency; re-partitions the current IR */
+	void setPartitionSize(unsigned int _partitionSize);
+
+	/** get the partition size B */
+	unsigned int getPartitionSize() { return partitionSize; }
+
+	/** get the latency, which is the partition size */
+	unsigned int getLatencyInSamples() { return partitionSize; }
+
+	/** create the buffers for an IR length and clear the IR (as ImpulseConvolver) */
+	void init(unsigned int _irLength);
+
+	/** set the impulse response (as ImpulseConvolver); re-creates the buffers if the length changed */
+	void setImpulseResponse(double* irArray, unsigned int _irLength);
+
+	/** create the buffers for an IR length and clear the IR (as FastConvolver) */
+	void initialize(unsigned int _filterImpulseLength) { init(_filterImpulseLength); }
+
+	/** set the impulse response, which MUST be getFilterIRLength( ) long (as FastConvolver) */
+	void setFilterIR(double* irBuffer) { setImpulseResponse(irBuffer, irLength); }
+
+	/** get the IR length */
+	unsigned int getFilterIRLength() { return irLength; }
+
+	/** get the number of partitions P */
+	unsigned int getNumPartitions() { return numPartitions; }
+
+	/** process exactly one partition of B samples with no added latency: the output is the convolution over the
+		same B samples; for callers that only feed whole partitions (ConvolverTailSegment), do not mix with the
+		sample and block functions */
+	/**
+	\param input B input samples
+	\param output B output samples
+	*/
+	void processPartitionBlock(const double* input, double* output)
+	{
+		if (numPartitions == 0)
+		{
+			memset(output, 0, partitionSize * sizeof(double));
+			return;
+		}
+
+		memcpy(&fft_input[partitionSize], input, partitionSize * sizeof(double));
+		processPartition();
+		memcpy(output, &outputBlock[0], partitionSize * sizeof(double));
+	}
+
+protected:
+	/** destroy FFTW objects and plans */
+	void destroyFFTW();
+
+	/** FFT the newest 2B inputs into the FDL, multiply-add the FDL with the IR spectra and IFFT the next output block */
+	void processPartition();
+
+	/** transform the stored IR into the partition spectra */
+	void transformIR();
+
+	// --- FFTW: 2B real points <-> B + 1 bins
+	double*			fft_input = nullptr;		///< sliding input window: [previous block | current block]
+	fftw_complex*	fft_result = nullptr;		///< input spectrum
+	fftw_complex*	ifft_input = nullptr;		///< accumulated output spectrum
+	double*			ifft_result = nullptr;		///< output of the IFFT; the last B points are the output block
+	fftw_plan		plan_forward = nullptr;		///< FFTW plan for FFT
+	fftw_plan		plan_backward = nullptr;	///< FFTW plan for IFFT
+
+	// --- partition spectra and FDL: split real/imag, numPartitions rows of binStride
+	std::unique_ptr<double[]> irReal = nullptr;		///< IR partition spectra, real (scaled by 1/2B)
+	std::unique_ptr<double[]> irImag = nullptr;		///< IR partition spectra, imag (scaled by 1/2B)
+	std::unique_ptr<double[]> fdlReal = nullptr;	///< frequency-domain delay line, real
+	std::unique_ptr<double[]> fdlImag = nullptr;	///< frequency-domain delay line, imag
+	std::unique_ptr<double[]> accReal = nullptr;	///< spectrum accumulator, real
+	std::unique_ptr<double[]> accImag = nullptr;	///< spectrum accumulator, imag
+	std::unique_ptr<double[]> outputBlock = nullptr;///< B samples of output being played out
+	std::unique_ptr<double[]> impulseResponse = nullptr; ///< copy of the IR, for re-partitioning
+
+	unsigned int partitionSize = DEFAULT_CONVOLVER_PARTITION;	///< B
+	unsigned int binCount = DEFAULT_CONVOLVER_PARTITION + 1;	///< B + 1 bins per spectrum
+	unsigned int binStride = DEFAULT_CONVOLVER_PARTITION + 4;	///< row stride of the spectra, padded to 4
+	unsigned int numPartitions = 0;		///< P
+	unsigned int irLength = 0;			///< IR length
+	unsigned int fdlIndex = 0;			///< FDL row with the newest input spectrum
+	unsigned int inputCount = 0;		///< input samples in the current block
+};
+
+/** largest tail partition of the NonUniformConvolver */
+const unsigned int MAX_CONVOLVER_PARTITION = 8192;
+
+/** max number of tail segments of the NonUniformConvolver */
+const unsigned int MAX_CONVOLVER_SEGMENTS = 12;
+
+/** input/output block slots per tail segment: the worker may fall this many blocks minus one behind */
+const unsigned int CONVOLVER_SEGMENT_SLOTS = 4;
+
+/** times per block period an idle tail segment worker checks for a new block */
+const unsigned int CONVOLVER_WORKER_POLLS = 16;
+
+/** default largest host buffer for the NonUniformConvolver, see setMaxHostBlockSize( ) */
+const unsigned int DEFAULT_CONVOLVER_HOST_BLOCK = 2048;
+
+/**
+\class ConvolverTailSegment
+\ingroup FFTW-Objects
+\brief
+The ConvolverTailSegment runs one uniformly partitioned segment of a NonUniformConvolver on its own worker thread.
+
+The audio thread collects B samples, hands the block to the worker and plays the result of the block before it,
+which the worker had one whole block period to compute. The segment output is therefore delayed by 2B samples
+(one block to collect, one block of deadline). Hand-off is lock-free through two block counters; the audio thread
+never waits or signals, and plays silence (and counts a missed deadline) if the worker has not finished in time.
+The idle worker polls for new blocks CONVOLVER_WORKER_POLLS times per block period.
+
+The deadline only holds if B samples always span at least one host buffer period of wall-clock time, i.e. when
+B is at least twice the host buffer size (or the host buffer size, if it never varies); the NonUniformConvolver
+runs smaller segments inline.
+
+Audio I/O:
+- Processes mono input to mono output; the block function adds into the output.
+
+Control I/F:
+- initialize( ) stops the worker and reset( ) restarts it, so they are not realtime safe.
+
+\version Revision : 1.0
+*/
+class ConvolverTailSegment
+{
+public:
+	ConvolverTailSegment() {}		/* C-TOR */
+	~ConvolverTailSegment() {
+		stopWorker();
+	}	/* D-TOR */
+
+	/** set up the segment: partition size B, its piece of the IR and threaded or inline processing */
+	void initialize(unsigned int _partitionSize, double* irArray, unsigned int irLength, bool _useWorker);
+
+	/** flush the history and restart the worker; the sample rate is used for the deadline usage */
+	void reset(double _sampleRate);
+
+	/** stop and join the worker thread */
+	void stopWorker();
+
+	/** process one input; the output is delayed by 2B */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	double processAudioSample(double xn)
+	{
+		double yn = playBlock[sampleCount];
+		writeBlock[sampleCount] = xn;
+
+		if (++sampleCount == partitionSize)
+			submitBlock();
+		return yn;
+	}
+
+	/** process a block and ADD the segment output into output; input and output may NOT be the same buffer */
+	/**
+	\param input input block
+	\param output output block to accumulate into
+	\param blockSize number of samples
+	*/
+	void accumulateAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		for (unsigned int n = 0; n < blockSize;)
+		{
+			unsigned int length = std::min(blockSize - n, partitionSize - sampleCount);
+			memcpy(&writeBlock[sampleCount], &input[n], length * sizeof(double));
+			for (unsigned int i = 0; i < length; i++)
+				output[n + i] += playBlock[sampleCount + i];
+
+			sampleCount += length;
+			n += length;
+			if (sampleCount == partitionSize)
+				submitBlock();
+		}
+	}
+
+	/** get the partition size B */
+	unsigned int getPartitionSize() { return partitionSize; }
+
+	/** true if the segment runs on its worker thread */
+	bool getUseWorker() { return useWorker; }
+
+	/** get the number of blocks that missed their deadline (or were dropped) since reset( ) */
+	unsigned int getMissedDeadlines() { return missedDeadlines.load(std::memory_order_relaxed); }
+
+	/** get the worst worker compute time as a fraction of the block period (1.0 = the deadline) */
+	double getWorstDeadlineUsage() { return worstDeadlineUsage.load(std::memory_order_relaxed); }
+
+protected:
+	/** hand the collected block to the worker (or process it inline) and pick the block to play */
+	void submitBlock();
+
+	/** worker thread: process submitted blocks in order */
+	void workerLoop();
+
+	/** start the worker thread */
+	void startWorker();
+
+	/** input slot of a block */
+	double* getInputSlot(unsigned int block) { return &inputSlots[(block % CONVOLVER_SEGMENT_SLOTS) * partitionSize]; }
+
+	/** output slot of a block */
+	double* getOutputSlot(unsigned int block) { return &outputSlots[(block % CONVOLVER_SEGMENT_SLOTS) * partitionSize]; }
+
+	PartitionedConvolver convolver;		///< the uniformly partitioned convolution of this segment
+	std::unique_ptr<double[]> inputSlots = nullptr;	///< CONVOLVER_SEGMENT_SLOTS input blocks
+	std::unique_ptr<double[]> outputSlots = nullptr;///< CONVOLVER_SEGMENT_SLOTS output blocks
+	std::unique_ptr<double[]> zeroBlock = nullptr;	///< silence, played on a missed deadline
+	double* writeBlock = nullptr;		///< input slot being filled by the audio thread
+	const double* playBlock = nullptr;	///< output block being played by the audio thread
+	unsigned int partitionSize = 0;		///< B
+	unsigned int sampleCount = 0;		///< samples in the current block
+	double blockPeriod = 0.0;			///< B / fs in seconds
+	double pollPeriod = 0.001;			///< idle worker poll interval in seconds
+
+	// --- hand-off; only the audio thread writes submittedBlocks, only the worker writes completedBlocks
+	std::atomic<unsigned int> submittedBlocks{ 0 };	///< blocks handed to the worker
+	std::atomic<unsigned int> completedBlocks{ 0 };	///< blocks finished by the worker
+	std::atomic<unsigned int> missedDeadlines{ 0 };	///< late or dropped blocks
+	std::atomic<double> worstDeadlineUsage{ 0.0 };	///< worst compute time / block period
+
+	bool useWorker = true;				///< false: process inline on the audio thread
+	std::atomic<bool> workerRunning{ false };	///< worker run flag
+	std::thread worker;					///< the worker thread
+};
+
+/**
+\class NonUniformConvolver
+\ingroup FFTW-Objects
+\brief
+The NonUniformConvolver implements non-uniformly partitioned convolution for very long IRs (multi-second reverbs).
+A short head, in partitions of B samples, runs on the audio thread with a PartitionedConvolver; the rest of the IR
+is cut into tail segments whose partition size doubles, up to MAX_CONVOLVER_PARTITION, and each tail segment runs
+on its own worker thread (ConvolverTailSegment).
+
+A segment of partition size Bk has a delay of 2Bk, so it starts at IR offset 2Bk - B to line up with the head:
+- head: 3 partitions of B, IR [0, 3B)
+- segment k (Bk = 2^k B): 2 partitions of Bk, IR [2Bk - B, 4Bk - B)
+- the last segment (MAX_CONVOLVER_PARTITION) takes the rest of the IR
+
+A worker has one block period Bk to finish a block, but the host hands over a whole buffer at once: a segment
+with Bk smaller than the host buffer would submit several blocks per callback and need each result immediately,
+and with Bk equal to it a short buffer followed by a full one leaves the worker almost no time. So only segments
+with Bk >= 2 x setMaxHostBlockSize( ) run on worker threads, which then always get at least one host buffer period;
+the smaller ones run inline on the audio thread with the same output. The latency is B; the audio thread does the head, the inline segments and
+copies, whatever the IR length. Workers that miss their deadline are counted (getMissedDeadlines( )) and their
+block is played silent; getWorstDeadlineUsage( ) shows how close the workers come. For offline rendering,
+setUseWorkerThreads(false) processes the whole tail inline with the same output.
+
+Audio I/O:
+- Processes mono input to mono output, per sample or in blocks.
+
+Control I/F:
+- setImpulseResponse( ), setHeadPartitionSize( ), setMaxHostBlockSize( ), setUseWorkerThreads( ) and reset( )
+  stop and start threads, so they are not realtime safe.
+
+\version Revision : 1.0
+*/
+class NonUniformConvolver : public IAudioSignalProcessor
+{
+public:
+	NonUniformConvolver() {}		/* C-TOR */
+	~NonUniformConvolver() {}		/* D-TOR */
+
+	/** reset members to initialized state: flushes all history and restarts the workers; the IR is kept */
+	virtual bool reset(double _sampleRate);
+
+	/** process one input; the output is delayed by getLatencyInSamples( ) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double yn = headConvolver.processAudioSample(xn);
+		for (unsigned int i = 0; i < numTailSegments; i++)
+			yn += tailSegments[i].processAudioSample(xn);
+		return yn;
+	}
+
+	/** process a block of MONO audio; same output as processAudioSample( ) per sample.
+		input and output may be the same buffer. */
+	/**
+	\param input input block
+	\param output output block
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, unsigned int blockSize)
 	{
-		bool fftReady = false;
-		double output = 0.0;
+		if (!inputBlock)
+		{
+			memset(output, 0, blockSize * sizeof(double));
+			return;
+		}
 
-		if (inputCount == filterImpulseLength)
+		for (unsigned int n = 0; n < blockSize;)
 		{
-			fftReady = vocoder.addZeroPad(filterImpulseLength);
+			unsigned int length = std::min(blockSize - n, headPartitionSize);
+
+			// --- keep the input; the head may write over it
+			memcpy(&inputBlock[0], &input[n], length * sizeof(double));
+			headConvolver.processAudioBlock(&inputBlock[0], &output[n], length);
+			for (unsigned int i = 0; i < numTailSegments; i++)
+				tailSegments[i].accumulateAudioBlock(&inputBlock[0], &output[n], length);
+			n += length;
+		}
+	}
 
-			if (fftReady) // should happen on time
-			{
-				// --- multiply our filter IR with the vocoder FFT
-				fftw_complex* signalFFT = vocoder.getFFTData();
-				if (signalFFT)
-				{
-					unsigned int fff = vocoder.getFrameLength();
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-					// --- complex multiply with FFT of IR
-					for (unsigned int i = 0; i < filterImpulseLength * 2; i++)
-					{
-						// --- get real/imag parts of each FFT
-						ComplexNumber signal(signalFFT[i][0], signalFFT[i][1]);
-						ComplexNumber filter(filterFFT[i][0], filterFFT[i][1]);
+	/** set the IR and lay out the head and tail segments */
+	void setImpulseResponse(double* irArray, unsigned int _irLength);
 
-						// --- use complex multiply function; this convolves in the time domain
-						ComplexNumber product = complexMultiply(signal, filter);
+	/** set the head partition size B (power of 2), which is also the latency; re-partitions the current IR */
+	void setHeadPartitionSize(unsigned int _headPartitionSize);
 
-						// --- overwrite the FFT bins
-						signalFFT[i][0] = product.real;
-						signalFFT[i][1] = product.imag;
-					}
-				}
-			}
+	/** get the head partition size B */
+	unsigned int getHeadPartitionSize() { return headPartitionSize; }
 
-			// --- reset counter
-			inputCount = 0;
-		}
+	/** set the largest host buffer (or processAudioSample( ) calls per callback); re-partitions the current IR */
+	void setMaxHostBlockSize(unsigned int _maxHostBlockSize);
 
-		// --- process next sample
-		output = vocoder.processAudioSample(input, fftReady);
-		inputCount++;
+	/** get the largest host buffer */
+	unsigned int getMaxHostBlockSize() { return maxHostBlockSize; }
 
-		return output;
+	/** run the tail on worker threads (default) or inline on the audio thread (offline rendering) */
+	void setUseWorkerThreads(bool _useWorkerThreads);
+
+	/** get the latency, which is the head partition size */
+	unsigned int getLatencyInSamples() { return headPartitionSize; }
+
+	/** get the IR length */
+	unsigned int getIRLength() { return irLength; }
+
+	/** get the number of tail segments */
+	unsigned int getNumTailSegments() { return numTailSegments; }
+
+	/** get the number of tail segments running on worker threads */
+	unsigned int getNumWorkerThreads()
+	{
+		unsigned int threads = 0;
+		for (unsigned int i = 0; i < numTailSegments; i++)
+			threads += tailSegments[i].getUseWorker() ? 1 : 0;
+		return threads;
 	}
 
-	/** get current frame length */
-	unsigned int getFrameLength() { return vocoder.getFrameLength(); }
+	/** get the number of tail blocks, over all segments, that missed their deadline since reset( ) */
+	unsigned int getMissedDeadlines()
+	{
+		unsigned int missed = 0;
+		for (unsigned int i = 0; i < numTailSegments; i++)
+			missed += tailSegments[i].getMissedDeadlines();
+		return missed;
+	}
 
-	/** get current IR length*/
-	unsigned int getFilterIRLength() { return filterImpulseLength; }
+	/** get the worst worker compute time as a fraction of its block period, over all segments */
+	double getWorstDeadlineUsage()
+	{
+		double usage = 0.0;
+		for (unsigned int i = 0; i < numTailSegments; i++)
+			usage = std::max(usage, tailSegments[i].getWorstDeadlineUsage());
+		return usage;
+	}
 
 protected:
-	PhaseVocoder vocoder;				///< vocoder object
-	FastFFT filterFastFFT;				///< FastFFT object
-	fftw_complex* filterFFT = nullptr;	///< filterFFT output arrays
-	double* filterIR = nullptr;			///< filter IR
-	unsigned int inputCount = 0;		///< input sample counter
-	unsigned int filterImpulseLength = 0;///< IR length
+	/** cut the stored IR into the head and tail segments */
+	void partitionIR();
+
+	PartitionedConvolver headConvolver;		///< the head, on the audio thread
+	ConvolverTailSegment tailSegments[MAX_CONVOLVER_SEGMENTS];	///< the tail, on worker threads or inline
+	unsigned int numTailSegments = 0;		///< tail segments in use
+
+	std::unique_ptr<double[]> impulseResponse = nullptr;	///< copy of the IR, for re-partitioning
+	std::unique_ptr<double[]> inputBlock = nullptr;			///< input copy for in-place blocks
+	unsigned int irLength = 0;				///< IR length
+	unsigned int headPartitionSize = DEFAULT_CONVOLVER_PARTITION;	///< B
+	unsigned int maxHostBlockSize = DEFAULT_CONVOLVER_HOST_BLOCK;	///< segments with Bk below twice this run inline
+	bool useWorkerThreads = true;			///< tail on worker threads
+	double sampleRate = 0.0;				///< for the deadline usage
 };
 
 // --- PSM Vocoder
 const unsigned int PSM_FFT_LEN = 4096;
+const unsigned int PSM_SPECTRUM_LEN = PSM_FFT_LEN / 2 + 1;	///< half spectrum bins of the PSM FFT
 
 /**
 \struct BinData
@@ -9199,12 +15424,12 @@ public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		memset(&phi[0], 0, sizeof(double)*PSM_FFT_LEN);
-		memset(&psi[0], 0, sizeof(double)* PSM_FFT_LEN);
+		memset(&phi[0], 0, sizeof(double)*PSM_SPECTRUM_LEN);
+		memset(&psi[0], 0, sizeof(double)* PSM_SPECTRUM_LEN);
 		if(outputBuff)
 			memset(outputBuff, 0, sizeof(double)*outputBufferLength);
 
-		for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+		for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 		{
 			binData[i].reset();
 			binDataPrevious[i].reset();
@@ -9262,13 +15487,13 @@ public:
 
 		int delta = -1;
 		int previousPeak = -1;
-		for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+		for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 		{
 			if (peakBinsPrevious[i] < 0)
 				break;
 
 			int dist = abs(peakIndex - peakBinsPrevious[i]);
-			if (dist > PSM_FFT_LEN/4)
+			if (dist > (int)(PSM_FFT_LEN/4))
 				break;
 
 			if (i == 0)
@@ -9294,7 +15519,7 @@ public:
 		// --- find local maxima in 4-sample window
 		double localWindow[4] = { 0.0, 0.0, 0.0, 0.0 };
 		int m = 0;
-		for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+		for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 		{
 			if (i == 0)
 			{
@@ -9310,14 +15535,14 @@ public:
 				localWindow[2] = binData[i + 1].magnitude;
 				localWindow[3] = binData[i + 2].magnitude;
 			}
-			else  if (i == PSM_FFT_LEN - 1)
+			else  if (i == PSM_SPECTRUM_LEN - 1)
 			{
 				localWindow[0] = binData[i - 2].magnitude;
 				localWindow[1] = binData[i - 1].magnitude;
 				localWindow[2] = 0.0;
 				localWindow[3] = 0.0;
 			}
-			else  if (i == PSM_FFT_LEN - 2)
+			else  if (i == PSM_SPECTRUM_LEN - 2)
 			{
 				localWindow[0] = binData[i - 2].magnitude;
 				localWindow[1] = binData[i - 1].magnitude;
@@ -9360,13 +15585,13 @@ public:
 
 			if (nextPeak >= 0)
 			{
-				for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+				for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 				{
-					if (i <= bossPeakBin)
+					if ((int)i <= bossPeakBin)
 					{
 						binData[i].localPeakBin = bossPeakBin;
 					}
-					else if (i < midBoundary)
+					else if ((int)i < midBoundary)
 					{
 						binData[i].localPeakBin = bossPeakBin;
 					}
@@ -9377,7 +15602,7 @@ public:
 						if (nextPeak > bossPeakBin)
 							midBoundary = (nextPeak - (double)bossPeakBin) / 2.0 + bossPeakBin;
 						else // nextPeak == -1
-							midBoundary = PSM_FFT_LEN;
+							midBoundary = PSM_SPECTRUM_LEN;
 
 						binData[i].localPeakBin = bossPeakBin;
 					}
@@ -9408,7 +15633,7 @@ public:
 			if (parameters.enablePeakPhaseLocking)
 			{
 				// --- get the magnitudes for searching
-				for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+				for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 				{
 					binData[i].reset();
 					peakBins[i] = -1;
@@ -9425,9 +15650,8 @@ public:
 				// --- now propagate phases accordingly
 				//
 				//     FIRST: set PSI angles of bosses
-				for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+				for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 				{
-					double mag_k = binData[i].magnitude;
 					double phi_k = binData[i].phi;
 
 					// --- horizontal phase propagation
@@ -9463,7 +15687,7 @@ public:
 				}
 
 				// --- now set non-peaks
-				for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+				for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 				{
 					if (!binData[i].isPeak)
 					{
@@ -9481,7 +15705,7 @@ public:
 					}
 				}
 
-				for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+				for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 				{
 					double mag_k = binData[i].magnitude;
 
@@ -9498,7 +15722,7 @@ public:
 
 			else // ---> old school
 			{
-				for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
+				for (uint32_t i = 0; i < PSM_SPECTRUM_LEN; i++)
 				{
 					double mag_k = getMagnitude(fftData[i][0], fftData[i][1]);
 					double phi_k = getPhase(fftData[i][0], fftData[i][1]);
@@ -9531,13 +15755,8 @@ public:
 			// --- manually so the IFFT (OPTIONAL)
 			vocoder.doInverseFFT();
 
-			// --- can get the iFFT buffers
-			fftw_complex* inv_fftData = vocoder.getIFFTData();
-
-			// --- make copy (can speed this up)
-			double ifft[PSM_FFT_LEN] = { 0.0 };
-			for (uint32_t i = 0; i < PSM_FFT_LEN; i++)
-				ifft[i] = inv_fftData[i][0];
+			// --- can get the iFFT buffers; the output is real so no copy is needed
+			double* ifft = vocoder.getIFFTData();
 
 			// --- resample the audio as if it were stretched
 			resample(&ifft[0], outputBuff, PSM_FFT_LEN, outputBufferLength, interpolation::kLinear, windowCorrection, windowBuff);
@@ -9581,15 +15800,15 @@ protected:
 	// --- FFT is 4096 with 75% overlap
 	const double hs = PSM_FFT_LEN / 4;	///< hs = N/4 --- 75% overlap
 	double ha = PSM_FFT_LEN / 4;		///< ha = N/4 --- 75% overlap
-	double phi[PSM_FFT_LEN] = { 0.0 };	///< array of phase values for classic algorithm
-	double psi[PSM_FFT_LEN] = { 0.0 };	///< array of phase correction values for classic algorithm
+	double phi[PSM_SPECTRUM_LEN] = { 0.0 };	///< array of phase values for classic algorithm
+	double psi[PSM_SPECTRUM_LEN] = { 0.0 };	///< array of phase correction values for classic algorithm
 
 	// --- for peak-locking
-	BinData binData[PSM_FFT_LEN];			///< array of BinData structures for current FFT frame
-	BinData binDataPrevious[PSM_FFT_LEN];	///< array of BinData structures for previous FFT frame
+	BinData binData[PSM_SPECTRUM_LEN];			///< array of BinData structures for current FFT frame
+	BinData binDataPrevious[PSM_SPECTRUM_LEN];	///< array of BinData structures for previous FFT frame
 
-	int peakBins[PSM_FFT_LEN] = { -1 };		///< array of current peak bin index values (-1 = not peak)
-	int peakBinsPrevious[PSM_FFT_LEN] = { -1 }; ///< array of previous peak bin index values (-1 = not peak)
+	int peakBins[PSM_SPECTRUM_LEN] = { -1 };		///< array of current peak bin index values (-1 = not peak)
+	int peakBinsPrevious[PSM_SPECTRUM_LEN] = { -1 }; ///< array of previous peak bin index values (-1 = not peak)
 
 	double* windowBuff = nullptr;			///< buffer for window
 	double* outputBuff = nullptr;			///< buffer for resampled output
@@ -9606,15 +15825,15 @@ protected:
 \brief
 Use this strongly typed enum to easily set up or down sampling ratios.
 
-- enum class rateConversionRatio { k2x, k4x };
+- enum class rateConversionRatio { k2x, k4x, k8x, k16x };
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-enum class rateConversionRatio { k2x, k4x };
-const unsigned int maxSamplingRatio = 4;
+enum class rateConversionRatio { k2x, k4x, k8x, k16x };
+const unsigned int maxSamplingRatio = 16;
 
 /**
 @countForRatio
@@ -9629,8 +15848,12 @@ inline unsigned int countForRatio(rateConversionRatio ratio)
 {
 	if (ratio == rateConversionRatio::k2x)
 		return 2;
-	else if (ratio == rateConversionRatio::k4x || ratio == rateConversionRatio::k4x)
+	else if (ratio == rateConversionRatio::k4x)
 		return 4;
+	else if (ratio == rateConversionRatio::k8x)
+		return 8;
+	else if (ratio == rateConversionRatio::k16x)
+		return 16;
 
 	return 0;
 }
@@ -9743,6 +15966,278 @@ inline double** decomposeFilter(double* filterIR, unsigned int FIRLength, unsign
 	return polyFilterSet;
 }
 
+/** stopband attenuation of the designed anti-aliasing filters, in dB */
+const double ANTI_ALIAS_STOPBAND_DB = 100.0;
+
+/** attenuation the Kaiser window and the minimum length are computed for: Kaiser's estimates are about 0.5 dB off
+    and the sidelobe peak wanders with the length, so 1 dB over ANTI_ALIAS_STOPBAND_DB */
+const double ANTI_ALIAS_DESIGN_DB = ANTI_ALIAS_STOPBAND_DB + 1.0;
+
+/** transition band of the designed anti-aliasing filters as a fraction of the low-rate Nyquist frequency, centered
+    on it: the passband ends at 0.9 and the stopband starts at 1.1 x Nyquist (for the minimum length) */
+const double ANTI_ALIAS_TRANSITION = 0.2;
+
+/**
+@designAntiAliasFilter
+\ingroup FX-Functions
+
+@brief designs a Kaiser windowed sinc anti-aliasing LPF for any up or down sampling ratio. The design is
+normalized to the high rate, so it serves every sample rate.
+
+The cutoff is the Nyquist frequency of the low rate, 1/(2 x ratio) at the high rate, and the result is a Nyquist
+(M-th band) filter: the first FIRLength - 1 taps are centered on tap c = (FIRLength - 2)/2, the center tap is
+exactly 1/ratio and every ratio-th tap on either side of it is exactly zero; the last tap is zero padding. For 2x
+this is a half-band filter. In a polyphase decomposition the branch holding the center tap is a pure delay.
+
+The response is -6 dB at the low-rate Nyquist frequency, with the transition band centered on it. Its width
+shrinks with the length, so ANTI_ALIAS_STOPBAND_DB is only reached from 1.1 x Nyquist (and the passband is flat to
+0.9 x Nyquist) when FIRLength is at least getMinAntiAliasFilterLength(ratio); shorter filters have a wider
+transition and less attenuation.
+
+\param filterIR - array of FIRLength taps to fill
+\param FIRLength - length of the filter (even, a multiple of ratio)
+\param ratio - up or down sampling ratio
+*/
+inline void designAntiAliasFilter(double* filterIR, unsigned int FIRLength, unsigned int ratio)
+{
+	memset(filterIR, 0, FIRLength * sizeof(double));
+	if (FIRLength < 2 || ratio == 0) return;
+
+	// --- Kaiser's beta for the stopband attenuation
+	double beta = 0.1102*(ANTI_ALIAS_DESIGN_DB - 8.7);
+	unsigned int center = (FIRLength - 2) / 2;
+	if (center == 0)
+	{
+		filterIR[0] = 1.0 / ratio;
+		return;
+	}
+
+	for (unsigned int k = 0; k <= 2 * center; k++)
+	{
+		int offset = (int)k - (int)center;
+		if (offset % (int)ratio == 0)
+		{
+			filterIR[k] = offset == 0 ? 1.0 / ratio : 0.0;
+			continue;
+		}
+
+		double x = kPi*offset / ratio;
+		double r = (double)offset / center;
+		filterIR[k] = (sin(x) / (x*ratio))*besselI0(beta*sqrt(1.0 - r*r)) / besselI0(beta);
+	}
+}
+
+/**
+@getMinAntiAliasFilterLength
+\ingroup FX-Functions
+
+@brief the shortest designAntiAliasFilter( ) length that reaches ANTI_ALIAS_STOPBAND_DB with a transition band of
+ANTI_ALIAS_TRANSITION x the low-rate Nyquist frequency, from Kaiser's formula: N - 1 = (A - 7.95)/(2.285 dw),
+where dw = ANTI_ALIAS_TRANSITION x pi/ratio and A = ANTI_ALIAS_DESIGN_DB; plus the zero padding tap, rounded up
+to a multiple of ratio. This is 132 taps for 2x, 264 for 4x, 528 for 8x and 1040 for 16x.
+
+\param ratio - up or down sampling ratio
+\return the minimum filter length
+*/
+inline unsigned int getMinAntiAliasFilterLength(unsigned int ratio)
+{
+	if (ratio < 2) return 2;
+
+	double transition = ANTI_ALIAS_TRANSITION*kPi / ratio;
+	unsigned int length = (unsigned int)ceil((ANTI_ALIAS_DESIGN_DB - 7.95) / (2.285*transition)) + 2;
+	return ((length + ratio - 1) / ratio) * ratio;
+}
+
+/** designs kept by the AntiAliasFilterCache; the oldest is replaced when it is full */
+const unsigned int ANTI_ALIAS_CACHE_SIZE = 16;
+
+/**
+\class AntiAliasFilterCache
+\ingroup FX-Objects
+\brief
+The AntiAliasFilterCache object holds the anti-aliasing filters designed with designAntiAliasFilter( ), keyed by
+length and ratio, so that every Interpolator and Decimator in the process shares one design.
+
+The cache is shared; use getInstance( ) to access it. It is thread safe, but not realtime safe (it locks and may
+allocate), so use it from initialization code only.
+
+\version Revision : 1.0
+*/
+class AntiAliasFilterCache
+{
+public:
+	/** the shared cache */
+	static AntiAliasFilterCache& getInstance()
+	{
+		static AntiAliasFilterCache cache;
+		return cache;
+	}
+
+	/** copy the design for FIRLength and ratio into filterIR, designing it on first use */
+	/**
+	\param filterIR array of FIRLength taps to fill
+	\param FIRLength length of the filter
+	\param ratio up or down sampling ratio
+	*/
+	void getFilterIR(double* filterIR, unsigned int FIRLength, unsigned int ratio)
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		for (unsigned int i = 0; i < ANTI_ALIAS_CACHE_SIZE; i++)
+		{
+			if (designs[i].filterIR && designs[i].FIRLength == FIRLength && designs[i].ratio == ratio)
+			{
+				memcpy(filterIR, &designs[i].filterIR[0], FIRLength * sizeof(double));
+				return;
+			}
+		}
+
+		// --- design into the next slot
+		FilterDesign& design = designs[nextDesign];
+		nextDesign = (nextDesign + 1) % ANTI_ALIAS_CACHE_SIZE;
+
+		design.FIRLength = FIRLength;
+		design.ratio = ratio;
+		design.filterIR.reset(new double[FIRLength]);
+		designAntiAliasFilter(&design.filterIR[0], FIRLength, ratio);
+		memcpy(filterIR, &design.filterIR[0], FIRLength * sizeof(double));
+	}
+
+private:
+	AntiAliasFilterCache() {}		/* C-TOR */
+
+	/** one cached design */
+	struct FilterDesign
+	{
+		unsigned int FIRLength = 0;		///< filter length
+		unsigned int ratio = 0;			///< up or down sampling ratio
+		std::unique_ptr<double[]> filterIR = nullptr;	///< the taps
+	};
+
+	FilterDesign designs[ANTI_ALIAS_CACHE_SIZE];	///< the designs
+	unsigned int nextDesign = 0;		///< slot for the next design
+	std::mutex cacheMutex;				///< guards the designs
+};
+
+/**
+@getAntiAliasFilterIR
+\ingroup FX-Functions
+
+@brief fills filterIR with the built-in filters.h table for this length, ratio and sample rate or, if there is
+none, with a design from the AntiAliasFilterCache
+
+\param filterIR - array of FIRLength taps to fill
+\param FIRLength - lenght of FIR
+\param ratio - the conversinon ratio
+\param sampleRate - the sample rate
+\return the delay of the filter center in samples at the high rate: (FIRLength - 1)/2 for the built-in tables,
+(FIRLength - 2)/2 for the designs
+*/
+inline double getAntiAliasFilterIR(double* filterIR, unsigned int FIRLength, rateConversionRatio ratio, unsigned int sampleRate)
+{
+	double* filterTable = getFilterIRTable(FIRLength, ratio, sampleRate);
+	if (filterTable)
+	{
+		memcpy(filterIR, filterTable, FIRLength * sizeof(double));
+		return (FIRLength - 1.0) / 2.0;
+	}
+
+	AntiAliasFilterCache::getInstance().getFilterIR(filterIR, FIRLength, countForRatio(ratio));
+	return FIRLength < 2 ? 0.0 : (FIRLength - 2) / 2;
+}
+
+/**
+@getAntiAliasFilterLength
+\ingroup FX-Functions
+
+@brief the filter length the Interpolator and Decimator use: the requested length if filters.h has a built-in
+table for it, otherwise at least getMinAntiAliasFilterLength( ) for the designed filter, as a multiple of the ratio
+
+\param FIRLength - the requested length
+\param ratio - the conversinon ratio
+\param sampleRate - the sample rate
+\return the length to use
+*/
+inline unsigned int getAntiAliasFilterLength(unsigned int FIRLength, rateConversionRatio ratio, unsigned int sampleRate)
+{
+	if (getFilterIRTable(FIRLength, ratio, sampleRate))
+		return FIRLength;
+
+	unsigned int count = countForRatio(ratio);
+	unsigned int length = ((FIRLength + count - 1) / count) * count;
+	return std::max(length, getMinAntiAliasFilterLength(count));
+}
+
+/**
+@findSingleTap
+\ingroup FX-Functions
+
+@brief finds the only non-zero tap of a polyphase branch; in a Nyquist (e.g. half-band) design the branch holding
+the center tap has no other taps, so it is a pure delay and its zero taps need not be computed
+
+\param filterIR - the branch IR
+\param length - the branch length
+\return the index of the only non-zero tap, or -1 if there are more or none
+*/
+inline int findSingleTap(const double* filterIR, unsigned int length)
+{
+	int tap = -1;
+	for (unsigned int i = 0; i < length; i++)
+	{
+		if (filterIR[i] == 0.0)
+			continue;
+		if (tap >= 0)
+			return -1;
+		tap = i;
+	}
+	return tap;
+}
+
+/**
+\class PolyphaseDelayBranch
+\ingroup FX-Objects
+\brief
+The PolyphaseDelayBranch object runs a polyphase branch that has one non-zero tap (see findSingleTap( )) as a
+delay and a gain, instead of a FIR over its zero taps.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none.
+
+\version Revision : 1.0
+*/
+class PolyphaseDelayBranch
+{
+public:
+	PolyphaseDelayBranch() {}		/* C-TOR */
+	~PolyphaseDelayBranch() {}		/* D-TOR */
+
+	/** set the tap; flushes the delay */
+	/**
+	\param _delay index of the non-zero tap, which is its delay in samples
+	\param _gain the tap value
+	*/
+	void initialize(unsigned int _delay, double _gain)
+	{
+		delay = _delay;
+		gain = _gain;
+		buffer.createCircularBuffer(delay + 1);
+	}
+
+	/** process one input; same output as the branch FIR */
+	double processAudioSample(double xn)
+	{
+		buffer.writeBuffer(xn);
+		return gain*buffer.readBuffer((int)delay);
+	}
+
+protected:
+	CircularBuffer<double> buffer;	///< the delay line
+	unsigned int delay = 0;			///< delay in samples
+	double gain = 0.0;				///< the non-zero tap
+};
+
 /**
 \struct InterpolatorOutput
 \ingroup FFTW-Objects
@@ -9757,7 +16252,7 @@ Custom output structure for interpolator; it holds an arry of interpolated outpu
 struct InterpolatorOutput
 {
 	InterpolatorOutput() {}
-	double audioData[maxSamplingRatio] = { 0.0, 0.0, 0.0, 0.0 };	///< array of interpolated output samples
+	double audioData[maxSamplingRatio] = { 0.0 };	///< array of interpolated output samples
 	unsigned int count = maxSamplingRatio;			///< number of samples in output array
 };
 
@@ -9768,8 +16263,14 @@ struct InterpolatorOutput
 \brief
 The Interpolator object implements a sample rate interpolator. One input sample yields N output samples.
 
+The polyphase branches run as direct form FIRKernels (vectorized dot products, no FFT blocks), so the only
+latency is the group delay of the anti-aliasing filter, reported by getLatencyInSamples( ).
+
+The filter is the built-in filters.h table where there is one (44.1 and 48 kHz at 2x and 4x); other rates and
+ratios use a Nyquist design from the AntiAliasFilterCache, whose center tap branch runs as a PolyphaseDelayBranch.
+
 Audio I/O:
-- Processes mono input to interpoalted (multi-sample) output.
+- Processes mono input to interpoalted (multi-sample) output, per sample or in blocks.
 
 Control I/F:
 - none.
@@ -9787,7 +16288,7 @@ public:
 
 	/** setup the sample rate interpolator */
 	/**
-	\param _FIRLength the interpolator's anti-aliasing filter length
+	\param _FIRLength the interpolator's anti-aliasing filter length; raised if needed, see getAntiAliasFilterLength( )
 	\param _ratio the conversion ratio (see rateConversionRatio)
 	\param _sampleRate the actual sample rate
 	\param _polyphase flag to enable polyphase decomposition
@@ -9796,34 +16297,44 @@ public:
 	{
 		polyphase = _polyphase;
 		sampleRate = _sampleRate;
-		FIRLength = _FIRLength;
 		ratio = _ratio;
+		FIRLength = getAntiAliasFilterLength(_FIRLength, ratio, sampleRate);
 		unsigned int count = countForRatio(ratio);
 		unsigned int subBandLength = FIRLength / count;
+		delayBranchIndex = -1;
 
 		// --- straight SRC, no polyphase
-		convolver.initialize(FIRLength);
+		kernel.createKernel(FIRLength);
 
-		// --- set filterIR from built-in set - user can always override this!
-		double* filterTable = getFilterIRTable(FIRLength, ratio, sampleRate);
-		if (!filterTable) return;
-		convolver.setFilterIR(filterTable);
+		// --- set filterIR from built-in set or the designs - user can always override this!
+		std::unique_ptr<double[]> filterIR(new double[FIRLength]);
+		filterDelay = getAntiAliasFilterIR(&filterIR[0], FIRLength, ratio, sampleRate);
+		kernel.setCoefficients(&filterIR[0]);
 
 		if (!polyphase) return;
 
 		// --- decompose filter
-		double** polyPhaseFilters = decomposeFilter(filterTable, FIRLength, count);
+		double** polyPhaseFilters = decomposeFilter(&filterIR[0], FIRLength, count);
 		if (!polyPhaseFilters)
 		{
 			polyphase = false;
 			return;
 		}
 
-		// --- set the individual polyphase filter IRs on the convolvers
+		// --- set the individual polyphase filter IRs on the kernels; a single tap branch is a delay
 		for (unsigned int i = 0; i < count; i++)
 		{
-			polyPhaseConvolvers[i].initialize(subBandLength);
-			polyPhaseConvolvers[i].setFilterIR(polyPhaseFilters[i]);
+			int tap = findSingleTap(polyPhaseFilters[i], subBandLength);
+			if (tap >= 0 && delayBranchIndex < 0)
+			{
+				delayBranchIndex = i;
+				delayBranch.initialize(tap, polyPhaseFilters[i][tap]);
+			}
+			else
+			{
+				polyPhaseKernels[i].createKernel(subBandLength);
+				polyPhaseKernels[i].setCoefficients(polyPhaseFilters[i]);
+			}
 			delete[] polyPhaseFilters[i];
 		}
 
@@ -9838,34 +16349,64 @@ public:
 		// --- setup output
 		InterpolatorOutput output;
 		output.count = count;
+		interpolateSample(xn, &output.audioData[0], count);
+		return output;
+	}
+
+	/** interpolate a block: blockSize inputs yield blockSize x ratio outputs; input and output must not overlap */
+	/**
+	\param input input block
+	\param output output block, blockSize x ratio samples
+	\param blockSize number of input samples
+	*/
+	void interpolateAudioBlock(const double* input, double* output, unsigned int blockSize)
+	{
+		unsigned int count = countForRatio(ratio);
+		for (unsigned int n = 0; n < blockSize; n++)
+			interpolateSample(input[n], &output[n*count], count);
+	}
+
+	/** the latency at the input sample rate: the group delay of the linear phase filter ((N - 1)/2 at the output
+	    rate for the built-in tables, (N - 2)/2 for the designs), so it may be fractional */
+	double getLatencyInSamples()
+	{
+		return filterDelay / countForRatio(ratio);
+	}
 
+protected:
+	/** interpolate one input into count outputs */
+	void interpolateSample(double xn, double* output, unsigned int count)
+	{
 		// --- interpolators need the amp correction
 		double ampCorrection = double(count);
 
 		// --- polyphase uses "backwards" indexing for interpolator; see book
-		int m = count-1;
-		for (unsigned int i = 0; i < count; i++)
+		int m = count - 1;
+		for (unsigned int i = 0; i < count; i++, m--)
 		{
 			if (!polyphase)
-				output.audioData[i] = i == 0 ? ampCorrection*convolver.processAudioSample(xn) : ampCorrection*convolver.processAudioSample(0.0);
+				output[i] = i == 0 ? ampCorrection*kernel.processAudioSample(xn) : ampCorrection*kernel.processAudioSample(0.0);
+			else if (m == delayBranchIndex)
+				output[i] = ampCorrection*delayBranch.processAudioSample(xn);
 			else
-				output.audioData[i] = ampCorrection*polyPhaseConvolvers[m--].processAudioSample(xn);
+				output[i] = ampCorrection*polyPhaseKernels[m].processAudioSample(xn);
 		}
-		return output;
 	}
 
-protected:
 	// --- for straight, non-polyphase
-	FastConvolver convolver; ///< the convolver
+	FIRKernel<double> kernel; ///< the full length filter
 
 	// --- we save these for future expansion, currently only sparsely used
 	unsigned int sampleRate = 44100;	///< sample rate
 	unsigned int FIRLength = 256;		///< FIR length
 	rateConversionRatio ratio = rateConversionRatio::k2x; ///< conversion ration
+	double filterDelay = 127.5;			///< delay of the filter center, in samples at the output rate
 
-	// --- polyphase: 4x is max right now
+	// --- polyphase: 16x is max right now
 	bool polyphase = true;									///< enable polyphase decomposition
-	FastConvolver polyPhaseConvolvers[maxSamplingRatio];	///< a set of sub-band convolvers for polyphase operation
+	FIRKernel<double> polyPhaseKernels[maxSamplingRatio];	///< a set of sub-band filters for polyphase operation
+	int delayBranchIndex = -1;			///< the branch run by delayBranch, or -1
+	PolyphaseDelayBranch delayBranch;	///< the center tap branch of a Nyquist design
 };
 
 /**
@@ -9882,7 +16423,7 @@ Custom input structure for DecimatorInput; it holds an arry of input samples tha
 struct DecimatorInput
 {
 	DecimatorInput() {}
-	double audioData[maxSamplingRatio] = { 0.0, 0.0, 0.0, 0.0 };	///< input array of samples to be decimated
+	double audioData[maxSamplingRatio] = { 0.0 };	///< input array of samples to be decimated
 	unsigned int count = maxSamplingRatio;			///< count of samples in input array
 };
 
@@ -9893,8 +16434,16 @@ struct DecimatorInput
 The Decimator object implements a sample rate decimator. Ana array of M input samples is decimated
 to one output sample.
 
+In polyphase mode the full length filter is evaluated only once per output (the sum of the polyphase branches),
+as one vectorized dot product over the FIRKernel history. The only latency is the group delay of the anti-aliasing
+filter, reported by getLatencyInSamples( ).
+
+The filter is the built-in filters.h table where there is one (44.1 and 48 kHz at 2x and 4x); other rates and
+ratios use a Nyquist design from the AntiAliasFilterCache. Its center tap branch is a pure delay, so in polyphase
+mode the branches run separately and that branch's zero taps are skipped (half of all taps for a 2x half-band).
+
 Audio I/O:
-- Processes mono input to interpoalted (multi-sample) output.
+- Processes mono input to interpoalted (multi-sample) output, per sample or in blocks.
 
 Control I/F:
 - none.
@@ -9912,7 +16461,7 @@ public:
 
 	/** setup the sample rate decimator */
 	/**
-	\param _FIRLength the decimator's anti-aliasing filter length
+	\param _FIRLength the decimator's anti-aliasing filter length; raised if needed, see getAntiAliasFilterLength( )
 	\param _ratio the conversion ratio (see rateConversionRatio)
 	\param _sampleRate the actual sample rate
 	\param _polyphase flag to enable polyphase decomposition
@@ -9921,71 +16470,120 @@ public:
 	{
 		polyphase = _polyphase;
 		sampleRate = _sampleRate;
-		FIRLength = _FIRLength;
 		ratio = _ratio;
+		FIRLength = getAntiAliasFilterLength(_FIRLength, ratio, sampleRate);
+
 		unsigned int count = countForRatio(ratio);
 		unsigned int subBandLength = FIRLength / count;
+		delayBranchIndex = -1;
 
-		// --- straight SRC, no polyphase
-		convolver.initialize(FIRLength);
+		// --- the full length filter serves both modes
+		kernel.createKernel(FIRLength);
 
-		// --- set filterIR from built-in set - user can always override this!
-		double* filterTable = getFilterIRTable(FIRLength, ratio, sampleRate);
-		if (!filterTable) return;
-		convolver.setFilterIR(filterTable);
+		// --- set filterIR from built-in set or the designs - user can always override this!
+		std::unique_ptr<double[]> filterIR(new double[FIRLength]);
+		filterDelay = getAntiAliasFilterIR(&filterIR[0], FIRLength, ratio, sampleRate);
+		kernel.setCoefficients(&filterIR[0]);
 
 		if (!polyphase) return;
 
-		// --- decompose filter
-		double** polyPhaseFilters = decomposeFilter(filterTable, FIRLength, count);
-		if (!polyPhaseFilters)
+		// --- a Nyquist design has a single tap branch: run the branches separately and skip its zero taps
+		double** polyPhaseFilters = decomposeFilter(&filterIR[0], FIRLength, count);
+		for (unsigned int i = 0; i < count; i++)
 		{
-			polyphase = false;
-			return;
+			int tap = findSingleTap(polyPhaseFilters[i], subBandLength);
+			if (tap >= 0 && delayBranchIndex < 0)
+			{
+				delayBranchIndex = i;
+				delayBranch.initialize(tap, polyPhaseFilters[i][tap]);
+			}
 		}
 
-		// --- set the individual polyphase filter IRs on the convolvers
 		for (unsigned int i = 0; i < count; i++)
 		{
-			polyPhaseConvolvers[i].initialize(subBandLength);
-			polyPhaseConvolvers[i].setFilterIR(polyPhaseFilters[i]);
+			if (delayBranchIndex >= 0 && (int)i != delayBranchIndex)
+			{
+				polyPhaseKernels[i].createKernel(subBandLength);
+				polyPhaseKernels[i].setCoefficients(polyPhaseFilters[i]);
+			}
 			delete[] polyPhaseFilters[i];
 		}
-
 		delete[] polyPhaseFilters;
 	}
 
 	/** decimate audio input samples into one outut sample (return value) */
 	inline double decimateAudio(DecimatorInput data)
+	{
+		return decimateSamples(&data.audioData[0], countForRatio(ratio));
+	}
+
+	/** decimate a block: blockSize x ratio inputs yield blockSize outputs; input and output may be the same buffer */
+	/**
+	\param input input block, blockSize x ratio samples
+	\param output output block
+	\param blockSize number of output samples
+	*/
+	void decimateAudioBlock(const double* input, double* output, unsigned int blockSize)
 	{
 		unsigned int count = countForRatio(ratio);
+		for (unsigned int n = 0; n < blockSize; n++)
+			output[n] = decimateSamples(&input[n*count], count);
+	}
 
-		// --- setup output
-		double output = 0.0;
+	/** the latency at the output sample rate: the group delay of the linear phase filter ((N - 1)/2 at the input
+	    rate for the built-in tables, (N - 2)/2 for the designs), so it may be fractional; an interpolator plus a
+	    decimator with the same filter add up to twice that */
+	double getLatencyInSamples()
+	{
+		return filterDelay / countForRatio(ratio);
+	}
 
-		// --- polyphase uses "forwards" indexing for decimator; see book
-		for (unsigned int i = 0; i < count; i++)
+protected:
+	/** decimate count inputs into one output */
+	double decimateSamples(const double* input, unsigned int count)
+	{
+		// --- overwrites output; only the last output is saved
+		if (!polyphase)
 		{
-			if (!polyphase) // overwrites output; only the last output is saved
-				output = convolver.processAudioSample(data.audioData[i]);
-			else
-				output += polyPhaseConvolvers[i].processAudioSample(data.audioData[i]);
+			double output = 0.0;
+			for (unsigned int i = 0; i < count; i++)
+				output = kernel.processAudioSample(input[i]);
+			return output;
 		}
-		return output;
+
+		// --- polyphase, Nyquist design: branch i filters input i; the center tap branch is a delay
+		if (delayBranchIndex >= 0)
+		{
+			double output = 0.0;
+			for (unsigned int i = 0; i < count; i++)
+			{
+				if ((int)i == delayBranchIndex)
+					output += delayBranch.processAudioSample(input[i]);
+				else
+					output += polyPhaseKernels[i].processAudioSample(input[i]);
+			}
+			return output;
+		}
+
+		// --- polyphase: the sum of the branches is the full filter output at the last input; see book
+		for (unsigned int i = 0; i < count; i++)
+			kernel.pushSample(input[i]);
+
+		return kernel.getOutput();
 	}
 
-protected:
-	// --- for straight, non-polyphase
-	FastConvolver convolver;		 ///< fast convolver
+	// --- the anti-aliasing filter
+	FIRKernel<double> kernel;		 ///< full length filter
+	FIRKernel<double> polyPhaseKernels[maxSamplingRatio];	///< the branches of a Nyquist design
+	int delayBranchIndex = -1;			///< the branch run by delayBranch, or -1 for the full length filter
+	PolyphaseDelayBranch delayBranch;	///< the center tap branch of a Nyquist design
+	double filterDelay = 127.5;			///< delay of the filter center, in samples at the input rate
 
 	// --- we save these for future expansion, currently only sparsely used
 	unsigned int sampleRate = 44100;	///< sample rate
 	unsigned int FIRLength = 256;		///< FIR length
 	rateConversionRatio ratio = rateConversionRatio::k2x; ///< conversion ration
 
-	// --- polyphase: 4x is max right now
-	bool polyphase = true;									///< enable polyphase decomposition
-	FastConvolver polyPhaseConvolvers[maxSamplingRatio];	///< a set of sub-band convolvers for polyphase operation
+	// --- polyphase: 16x is max right now
+	bool polyphase = true;									///< evaluate the filter only once per output
 };
-
-#endif
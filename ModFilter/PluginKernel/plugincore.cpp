@@ -55,18 +55,17 @@ PluginCore::PluginCore()
 
 void PluginCore::updateParameters()
 {
-	EnvelopeFollowerParameters params = envFollowers[0].getParameters();
+	EnvelopeFollowerParameters params = envFollower.getParameters();
 	params.fc = filterFc_Hz;
 	params.Q = filterQ;
 	params.attackTime_mSec = attackTime_mSec;
 	params.releaseTime_mSec = releaseTime_mSec;
 	params.threshold_dB = threshold_dB;
 	params.sensitivity = sensitivity;
+	params.controlRateDivisor = ENV_CONTROL_RATE_DIVISOR;
+	params.linkMode = ENV_LINK_MODE;
 
-    for (auto& envFollower : envFollowers)
-    {
-	    envFollower.setParameters(params);
-    }
+	envFollower.setParameters(params);
 }
 
 
@@ -88,10 +87,7 @@ bool PluginCore::reset(ResetInfo& resetInfo)
     audioProcDescriptor.bitDepth = resetInfo.bitDepth;
 
 	// --- Reset the filters
-    for (auto& envFollower : envFollowers)
-    {
-	    envFollower.reset(resetInfo.sampleRate);
-    }
+	envFollower.reset(resetInfo.sampleRate);
     // --- other reset inits
     return PluginBase::reset(resetInfo);
 }
@@ -201,18 +197,11 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 		return true;	/// processed
 	}
 
-    // --- FX Plugin:
-	for (unsigned int i = 0; i < NUM_CHANNELS; i++)
-    {
-	    // --- Read input
-		double xn = processFrameInfo.audioInputFrame[i];
-
-		// --- Process the audio to produce output
-		double yn = envFollowers[i].processAudioSample(xn);
-
-		// --- Write output
-		processFrameInfo.audioOutputFrame[i] = yn;
-    }
+    // --- FX Plugin: both channels in one frame so the detector can be linked
+	envFollower.processAudioFrame(processFrameInfo.audioInputFrame,
+								  processFrameInfo.audioOutputFrame,
+								  processFrameInfo.numAudioInChannels,
+								  processFrameInfo.numAudioOutChannels);
 
 
     return true; /// processed
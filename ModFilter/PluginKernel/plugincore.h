@@ -129,7 +129,9 @@ public:
 	// --- END USER VARIABLES AND FUNCTIONS -------------------------------------- //
 
 protected:
-	EnvelopeFollower envFollowers[NUM_CHANNELS];
+	StereoEnvelopeFollower envFollower;
+	unsigned int const ENV_CONTROL_RATE_DIVISOR = 1; // --- detect & modulate every sample; N > 1 trades accuracy for CPU
+	stereoLinkMode const ENV_LINK_MODE = stereoLinkMode::kUnlinked; // --- one detector per channel, as before; linked modes are opt-in
 	void updateParameters();
 
 private:
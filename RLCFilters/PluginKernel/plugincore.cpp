@@ -56,20 +56,16 @@ PluginCore::PluginCore()
 void PluginCore::updateParameters()
 {
 	// --- all objects share  same params, so get first
-	WDFParameters params = rlcLPF[0].getParameters();
+	WDFIdealRLCFilterParameters params = rlcFilter[0].getParameters();
 
 	// --- update with our GUI parameter variables
 	params.fc = filterFc_Hz;
 	params.Q = filterQ;
+	params.filterType = convertIntToEnum(filterType, rlcFilterType);
 
-	// --- apply to all filters
+	// --- apply to all filters; only the selected topology is recalculated
 	for (unsigned int i = 0; i < NUM_CHANNELS; i++)
-	{
-		rlcLPF[i].setParameters(params);
-		rlcHPF[i].setParameters(params);
-		rlcBPF[i].setParameters(params);
-		rlcBSF[i].setParameters(params);
-	}
+		rlcFilter[i].setParameters(params);
 }
 
 /**
@@ -92,10 +88,7 @@ bool PluginCore::reset(ResetInfo& resetInfo)
     // --- other reset inits
 	for (unsigned int i = 0; i < NUM_CHANNELS; i++)
 	{
-		rlcLPF[i].reset(resetInfo.sampleRate);
-		rlcHPF[i].reset(resetInfo.sampleRate);
-		rlcBPF[i].reset(resetInfo.sampleRate);
-		rlcBSF[i].reset(resetInfo.sampleRate);
+		rlcFilter[i].reset(resetInfo.sampleRate);
 	}
 	
     return PluginBase::reset(resetInfo);
@@ -214,19 +207,8 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 	{
 		const double xn = processFrameInfo.audioInputFrame[i];
 
-		double yn;
-
-		// --- choose filter to process
-		if (compareIntToEnum(filterType, filterTypeEnum::RLC_LPF))
-			yn = rlcLPF[i].processAudioSample(xn);
-		else if (compareIntToEnum(filterType, filterTypeEnum::RLC_HPF))
-			yn = rlcHPF[i].processAudioSample(xn);
-		else if (compareIntToEnum(filterType, filterTypeEnum::RLC_BPF))
-			yn = rlcBPF[i].processAudioSample(xn);
-		else if (compareIntToEnum(filterType, filterTypeEnum::RLC_BSF))
-			yn = rlcBSF[i].processAudioSample(xn);
-		else
-			return false; // Should never occur
+		// --- the filter object runs the selected topology (and crossfades on a change)
+		double yn = rlcFilter[i].processAudioSample(xn);
 
 		// --- write output
 		processFrameInfo.audioOutputFrame[i] = yn;
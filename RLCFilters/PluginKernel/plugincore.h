@@ -126,10 +126,7 @@ public:
 	// --- END USER VARIABLES AND FUNCTIONS -------------------------------------- //
 
 protected:
-	WDFIdealRLCLPF rlcLPF[NUM_CHANNELS];
-	WDFIdealRLCHPF rlcHPF[NUM_CHANNELS];
-	WDFIdealRLCBPF rlcBPF[NUM_CHANNELS];
-	WDFIdealRLCBSF rlcBSF[NUM_CHANNELS];
+	WDFIdealRLCFilter rlcFilter[NUM_CHANNELS];
 	void updateParameters();	
 
 private:
@@ -168,7 +168,6 @@ void WaveView::draw(CDrawContext* pContext)
     }
 }
 
-#ifdef HAVE_FFTW
 /**
 \brief SpectrumView constructor
 
@@ -423,8 +422,6 @@ void SpectrumView::draw(CDrawContext* pContext)
     }
 }
 
-#endif
-
 /**
 \brief CustomKnobView constructor
 
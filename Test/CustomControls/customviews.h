@@ -99,9 +99,12 @@ private:
 
 };
 
+// --- FFTW if HAVE_FFTW is defined, otherwise the built-in FFTKernel
 #ifdef HAVE_FFTW
-// --- FFTW (REQUIRED)
 #include "fftw3.h"
+#else
+#include "../PluginObjects/fftkernel.h"
+#endif
 
 /**
 \enum spectrumViewWindowType
@@ -285,7 +288,6 @@ private:
     moodycamel::ReaderWriterQueue<double*,2>* fftMagBuffersReady = nullptr; ///< example of queuing system (yes I know it is overkill here)
     moodycamel::ReaderWriterQueue<double*,2>* fftMagBuffersEmpty = nullptr; ///< example of queuing system (yes I know it is overkill here)
 };
-#endif // defined FFTW
 
 
 // --- custom view example
@@ -0,0 +1,205 @@
+// -----------------------------------------------------------------------------
+//    fft_benchmark.cpp
+//
+//    Times the built-in FFTKernel (complex) and FFTRealKernel (real-to-complex)
+//    transforms for 256 ... 8192 points, and checks them against a direct DFT
+//    at 256 points and by an inverse round trip above that. When HAVE_FFTW is defined (see CMakeLists.txt) the same
+//    sizes are also run through FFTW plans made with FFTW_MEASURE, and the
+//    kernel outputs are checked against FFTW's at every size. The timings are
+//    reported only: they depend on the machine, so the test fails only when a
+//    transform is wrong.
+// -----------------------------------------------------------------------------
+#ifdef HAVE_FFTW
+#include "fftw3.h"
+#endif
+#include "fftkernel.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+const unsigned int MIN_LOG2 = 8;		// --- 256 points
+const unsigned int MAX_LOG2 = 13;		// --- 8192 points
+const unsigned int NUM_RUNS = 5;		// --- best of NUM_RUNS is reported
+const double SAMPLES_PER_RUN = 4.0e6;	// --- transforms per run = SAMPLES_PER_RUN / N
+const double MAX_RELATIVE_ERROR = 1e-12;
+
+// --- deterministic white noise in [-1, 1]
+static double noise(uint32_t& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return (double)seed / 2147483648.0 - 1.0;
+}
+
+// --- best time of NUM_RUNS in ns per transform
+template <class Transform>
+static double timeTransform(unsigned int length, Transform transform)
+{
+	unsigned int count = (unsigned int)(SAMPLES_PER_RUN / length);
+	double best = 1.0e30;
+	for (unsigned int run = 0; run < NUM_RUNS; run++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < count; i++)
+			transform();
+		auto stop = std::chrono::steady_clock::now();
+		best = fmin(best, std::chrono::duration<double, std::nano>(stop - start).count() / count);
+	}
+	return best;
+}
+
+// --- max |a - b| over max |b|
+static double relativeError(const double* aReal, const double* aImag, const double* bReal, const double* bImag, unsigned int length)
+{
+	double maxError = 0.0;
+	double maxValue = 0.0;
+	for (unsigned int k = 0; k < length; k++)
+	{
+		maxError = fmax(maxError, fmax(fabs(aReal[k] - bReal[k]), fabs(aImag[k] - bImag[k])));
+		maxValue = fmax(maxValue, fmax(fabs(bReal[k]), fabs(bImag[k])));
+	}
+	return maxValue > 0.0 ? maxError / maxValue : maxError;
+}
+
+// --- forward DFT by definition, in long double
+static void directDFT(const double* inReal, const double* inImag, double* outReal, double* outImag, unsigned int length)
+{
+	const long double pi = 3.14159265358979323846264338327950288L;
+	for (unsigned int k = 0; k < length; k++)
+	{
+		long double sumReal = 0.0L;
+		long double sumImag = 0.0L;
+		for (unsigned int n = 0; n < length; n++)
+		{
+			long double arg = -2.0L*pi*(long double)((unsigned long long)n*k % length) / length;
+			sumReal += inReal[n] * cosl(arg) - inImag[n] * sinl(arg);
+			sumImag += inReal[n] * sinl(arg) + inImag[n] * cosl(arg);
+		}
+		outReal[k] = (double)sumReal;
+		outImag[k] = (double)sumImag;
+	}
+}
+
+static bool benchmark(unsigned int length)
+{
+	uint32_t seed = 12345 + length;
+	std::vector<double> inReal(length), inImag(length);
+	for (unsigned int n = 0; n < length; n++)
+	{
+		inReal[n] = noise(seed);
+		inImag[n] = noise(seed);
+	}
+	std::vector<double> zeros(length, 0.0);
+
+	// --- complex kernel
+	FFTKernel kernel;
+	kernel.initialize(length);
+	std::vector<double> outReal(length), outImag(length);
+	double complexTime = timeTransform(length, [&]() { kernel.transform(&inReal[0], &inImag[0], &outReal[0], &outImag[0], -1); });
+
+	// --- real kernel
+	FFTRealKernel realKernel;
+	realKernel.initialize(length);
+	unsigned int bins = realKernel.getSpectrumLength();
+	std::vector<double> halfReal(bins), halfImag(bins);
+	double realTime = timeTransform(length, [&]() { realKernel.realForward(&inReal[0], &halfReal[0], &halfImag[0]); });
+
+	// --- reference: a direct DFT at the smallest size (it is O(N^2)), FFTW at every size when available
+	std::vector<double> refReal(length), refImag(length), refHalfReal(length), refHalfImag(length);
+	bool haveReference = false;
+	if (length == 1u << MIN_LOG2)
+	{
+		directDFT(&inReal[0], &inImag[0], &refReal[0], &refImag[0], length);
+		directDFT(&inReal[0], &zeros[0], &refHalfReal[0], &refHalfImag[0], length);
+		haveReference = true;
+	}
+
+#ifdef HAVE_FFTW
+	fftw_complex* fftwIn = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*length);
+	fftw_complex* fftwOut = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*length);
+	double* fftwRealIn = (double*)fftw_malloc(sizeof(double)*length);
+	fftw_complex* fftwHalfOut = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*bins);
+
+	// --- FFTW_MEASURE overwrites the arrays, so plan first and fill afterwards
+	fftw_plan complexPlan = fftw_plan_dft_1d(length, fftwIn, fftwOut, FFTW_FORWARD, FFTW_MEASURE);
+	fftw_plan realPlan = fftw_plan_dft_r2c_1d(length, fftwRealIn, fftwHalfOut, FFTW_MEASURE);
+	for (unsigned int n = 0; n < length; n++)
+	{
+		fftwIn[n][0] = inReal[n];
+		fftwIn[n][1] = inImag[n];
+		fftwRealIn[n] = inReal[n];
+	}
+
+	double fftwComplexTime = timeTransform(length, [&]() { fftw_execute(complexPlan); });
+	double fftwRealTime = timeTransform(length, [&]() { fftw_execute(realPlan); });
+
+	for (unsigned int k = 0; k < length; k++)
+	{
+		refReal[k] = fftwOut[k][0];
+		refImag[k] = fftwOut[k][1];
+	}
+	for (unsigned int k = 0; k < bins; k++)
+	{
+		refHalfReal[k] = fftwHalfOut[k][0];
+		refHalfImag[k] = fftwHalfOut[k][1];
+	}
+	haveReference = true;
+
+	fftw_destroy_plan(complexPlan);
+	fftw_destroy_plan(realPlan);
+	fftw_free(fftwIn);
+	fftw_free(fftwOut);
+	fftw_free(fftwRealIn);
+	fftw_free(fftwHalfOut);
+#endif
+
+	bool pass = true;
+	char check[64] = "";
+	if (haveReference)
+	{
+		double complexError = relativeError(&outReal[0], &outImag[0], &refReal[0], &refImag[0], length);
+		double realError = relativeError(&halfReal[0], &halfImag[0], &refHalfReal[0], &refHalfImag[0], bins);
+		pass = complexError < MAX_RELATIVE_ERROR && realError < MAX_RELATIVE_ERROR;
+		snprintf(check, sizeof(check), "error %.2g / %.2g  %s", complexError, realError, pass ? "ok" : "FAIL");
+	}
+	else
+	{
+		// --- no reference: the inverse transforms must return N times the input
+		std::vector<double> backReal(length), backImag(length), back(length);
+		kernel.transform(&outReal[0], &outImag[0], &backReal[0], &backImag[0], 1);
+		realKernel.realInverse(&halfReal[0], &halfImag[0], &back[0]);
+		for (unsigned int n = 0; n < length; n++)
+		{
+			backReal[n] /= length;
+			backImag[n] /= length;
+			back[n] /= length;
+		}
+
+		double complexError = relativeError(&backReal[0], &backImag[0], &inReal[0], &inImag[0], length);
+		double realError = relativeError(&back[0], &zeros[0], &inReal[0], &zeros[0], length);
+		pass = complexError < MAX_RELATIVE_ERROR && realError < MAX_RELATIVE_ERROR;
+		snprintf(check, sizeof(check), "round trip %.2g / %.2g  %s", complexError, realError, pass ? "ok" : "FAIL");
+	}
+
+#ifdef HAVE_FFTW
+	printf("%5u  complex %9.0f ns (fftw %9.0f, %5.2fx)  real %9.0f ns (fftw %9.0f, %5.2fx)  %s\n", length,
+		complexTime, fftwComplexTime, complexTime / fftwComplexTime, realTime, fftwRealTime, realTime / fftwRealTime, check);
+#else
+	printf("%5u  complex %9.0f ns  real %9.0f ns  %s\n", length, complexTime, realTime, check);
+#endif
+	return pass;
+}
+
+int main()
+{
+#ifdef HAVE_FFTW
+	printf("FFTKernel vs FFTW (FFTW_MEASURE), ns per forward transform; ratio > 1 means FFTW is faster\n");
+#else
+	printf("FFTKernel, ns per forward transform (build with FFTW found to compare against it)\n");
+#endif
+
+	bool pass = true;
+	for (unsigned int log2Length = MIN_LOG2; log2Length <= MAX_LOG2; log2Length++)
+		pass &= benchmark(1u << log2Length);
+
+	return pass ? 0 : 1;
+}
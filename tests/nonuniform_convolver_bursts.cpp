@@ -0,0 +1,139 @@
+// -----------------------------------------------------------------------------
+//    nonuniform_convolver_bursts.cpp
+//
+//    Drives the NonUniformConvolver like a host does: whole buffers at once,
+//    at least one buffer period of wall-clock time apart. The threaded output must
+//    match the inline (offline) output exactly, for host buffers smaller and
+//    larger than the head and tail partitions, and the inline output must match
+//    direct convolution at a latency of B over the whole run, which reaches into
+//    the last (MAX_CONVOLVER_PARTITION) tail segment.
+//
+//    Missed deadlines depend on the machine's load, so they are reported only;
+//    run with --strict-timing to fail on any missed deadline as well.
+// -----------------------------------------------------------------------------
+#include "fxobjects.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+const double SAMPLE_RATE = 48000.0;
+const unsigned int HEAD_PARTITION = 64;
+const unsigned int IR_LENGTH = 72000;		// --- 1.5 seconds: segments from 2B up to MAX_CONVOLVER_PARTITION
+const unsigned int NUM_SAMPLES = 48000;		// --- 1 second per host buffer size, paced in real time
+const unsigned int DIRECT_CHECK_STRIDE = 7;	// --- direct convolution is O(n^2): check every 7th output sample
+
+// --- deterministic white noise in [-1, 1]
+static double noise(uint32_t& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return (double)seed / 2147483648.0 - 1.0;
+}
+
+static void initConvolver(NonUniformConvolver& convolver, std::vector<double>& ir, bool useWorkerThreads, unsigned int maxHostBlockSize)
+{
+	convolver.setHeadPartitionSize(HEAD_PARTITION);
+	convolver.setUseWorkerThreads(useWorkerThreads);
+	convolver.setMaxHostBlockSize(maxHostBlockSize);
+	convolver.setImpulseResponse(&ir[0], IR_LENGTH);
+	convolver.reset(SAMPLE_RATE);
+}
+
+// --- process the input in host buffers of blockSizes[0], blockSizes[1], ... (cycled), each callback at least one
+//     buffer period after the previous one; a late wake-up delays the rest rather than bunching callbacks together
+static void processInBursts(NonUniformConvolver& convolver, const std::vector<double>& input, std::vector<double>& output,
+	const std::vector<unsigned int>& blockSizes, bool perSample)
+{
+	unsigned int n = 0;
+	for (unsigned int k = 0; n < NUM_SAMPLES; k++)
+	{
+		unsigned int length = std::min(blockSizes[k % blockSizes.size()], NUM_SAMPLES - n);
+		auto callback = std::chrono::steady_clock::now();
+
+		if (perSample)
+		{
+			for (unsigned int i = 0; i < length; i++)
+				output[n + i] = convolver.processAudioSample(input[n + i]);
+		}
+		else
+			convolver.processAudioBlock(&input[n], &output[n], length);
+		n += length;
+
+		// --- wait for the next host callback
+		std::this_thread::sleep_until(callback + std::chrono::duration<double>(length / SAMPLE_RATE));
+	}
+}
+
+static bool testBursts(const char* name, std::vector<double>& ir, const std::vector<double>& input, const std::vector<double>& reference,
+	const std::vector<unsigned int>& blockSizes, bool strictTiming, bool perSample = false)
+{
+	unsigned int maxBlock = *std::max_element(blockSizes.begin(), blockSizes.end());
+	NonUniformConvolver convolver;
+	initConvolver(convolver, ir, true, maxBlock);
+
+	std::vector<double> output(NUM_SAMPLES, 0.0);
+	processInBursts(convolver, input, output, blockSizes, perSample);
+
+	double maxError = 0.0;
+	for (unsigned int n = 0; n < NUM_SAMPLES; n++)
+		maxError = fmax(maxError, fabs(output[n] - reference[n]));
+
+	bool pass = maxError < 1e-12 && convolver.getNumWorkerThreads() > 0;
+	if (strictTiming)
+		pass &= convolver.getMissedDeadlines() == 0;
+
+	printf("%-28s threads %u/%u  missed %4u  worst usage %5.2f  max error %.3g  %s\n", name,
+		convolver.getNumWorkerThreads(), convolver.getNumTailSegments(), convolver.getMissedDeadlines(),
+		convolver.getWorstDeadlineUsage(), maxError, pass ? "ok" : "FAIL");
+	return pass;
+}
+
+int main(int argc, char* argv[])
+{
+	bool strictTiming = argc > 1 && strcmp(argv[1], "--strict-timing") == 0;
+
+	// --- decaying noise IR and a noise burst input
+	uint32_t seed = 12345;
+	std::vector<double> ir(IR_LENGTH);
+	for (unsigned int n = 0; n < IR_LENGTH; n++)
+		ir[n] = noise(seed) * exp(-3.0 * n / IR_LENGTH);
+
+	std::vector<double> input(NUM_SAMPLES, 0.0);
+	for (unsigned int n = 0; n < NUM_SAMPLES / 4; n++)
+		input[n] = 0.5 * noise(seed);
+
+	// --- reference: the whole tail inline
+	NonUniformConvolver inlineConvolver;
+	initConvolver(inlineConvolver, ir, false, DEFAULT_CONVOLVER_HOST_BLOCK);
+	std::vector<double> reference(NUM_SAMPLES, 0.0);
+	inlineConvolver.processAudioBlock(&input[0], &reference[0], NUM_SAMPLES);
+
+	// --- the inline result is direct convolution delayed by B; with B = 64 the last segment starts at
+	//     IR sample 16320, so checking all NUM_SAMPLES outputs covers every segment
+	double directError = 0.0;
+	for (unsigned int n = HEAD_PARTITION; n < NUM_SAMPLES; n += DIRECT_CHECK_STRIDE)
+	{
+		double yn = 0.0;
+		for (unsigned int k = 0; k <= n - HEAD_PARTITION; k++)
+			yn += ir[k] * input[n - HEAD_PARTITION - k];
+		directError = fmax(directError, fabs(yn - reference[n]));
+	}
+	bool pass = directError < 1e-9;
+	printf("%-28s max error %.3g  %s\n", "inline vs direct", directError, pass ? "ok" : "FAIL");
+
+	// --- host buffers below, at and above the head and tail partition sizes
+	const unsigned int hostBlocks[] = { 32, 64, 128, 256, 512, 1024 };
+	for (unsigned int hostBlock : hostBlocks)
+	{
+		char name[64];
+		snprintf(name, sizeof(name), "threaded, %u sample buffers", hostBlock);
+		pass &= testBursts(name, ir, input, reference, { hostBlock }, strictTiming);
+	}
+
+	// --- variable buffer sizes up to the max, and a host calling processAudioSample( ) per buffer
+	pass &= testBursts("threaded, variable buffers", ir, input, reference, { 512, 100, 17, 512, 300 }, strictTiming);
+	pass &= testBursts("threaded, per sample, 512", ir, input, reference, { 512 }, strictTiming, true);
+
+	return pass ? 0 : 1;
+}
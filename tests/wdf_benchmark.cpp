@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------------------
+//    wdf_benchmark.cpp
+//
+//    Times the compile-time WdfLadder filters (WDF*Inline) against the
+//    original virtual-adaptor WDF objects they replace, on the same noise
+//    input, and checks that each pair produces identical output. The RLC
+//    pair is also timed with an fc sweep so the component recalculation is
+//    included. The timings are reported only: they depend on the machine,
+//    so the test fails only when the outputs differ.
+// -----------------------------------------------------------------------------
+#include "fxobjects.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+const double SAMPLE_RATE = 48000.0;
+const unsigned int NUM_SAMPLES = 480000;	// --- 10 seconds
+const unsigned int NUM_RUNS = 5;			// --- best of NUM_RUNS is reported
+const unsigned int SWEEP_INTERVAL = 32;		// --- samples between fc updates in the sweep runs
+
+// --- test input: white noise from a fixed-seed LCG
+static std::vector<double> makeNoise(unsigned int length)
+{
+	std::vector<double> noise(length);
+	unsigned int seed = 12345;
+	for (unsigned int n = 0; n < length; n++)
+	{
+		seed = seed * 1664525 + 1013904223;
+		noise[n] = (seed >> 8) / 16777216.0 - 0.5;
+	}
+	return noise;
+}
+
+// --- fc for the sweep runs: 100 Hz to 10 kHz and back, once per second
+static double sweepFc(unsigned int n)
+{
+	double phase = (double)(n % 48000) / 48000.0;
+	double tri = phase < 0.5 ? 2.0 * phase : 2.0 - 2.0 * phase;
+	return 100.0 * pow(100.0, tri);
+}
+
+// --- run the input through a filter, best time of NUM_RUNS in ns/sample
+template <class Filter>
+static double timeFilter(Filter& filter, const std::vector<double>& input, std::vector<double>& output, bool sweep)
+{
+	double best = 1.0e30;
+	for (unsigned int run = 0; run < NUM_RUNS; run++)
+	{
+		filter.reset(SAMPLE_RATE);
+		WDFParameters params;
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int n = 0; n < input.size(); n++)
+		{
+			if (sweep && n % SWEEP_INTERVAL == 0)
+			{
+				params.fc = sweepFc(n);
+				filter.setParameters(params);
+			}
+			output[n] = filter.processAudioSample(input[n]);
+		}
+		auto stop = std::chrono::steady_clock::now();
+		best = fmin(best, std::chrono::duration<double, std::nano>(stop - start).count() / input.size());
+	}
+	return best;
+}
+
+// --- no-op parameter setter for the hardwired filters
+template <class Filter>
+struct Hardwired : public Filter
+{
+	void setParameters(const WDFParameters&) {}
+};
+
+template <class Original, class Inline>
+static bool benchmark(const char* name, const std::vector<double>& input, bool sweep)
+{
+	Original original;
+	Inline inlined;
+	std::vector<double> originalOut(input.size());
+	std::vector<double> inlineOut(input.size());
+
+	double originalTime = timeFilter(original, input, originalOut, sweep);
+	double inlineTime = timeFilter(inlined, input, inlineOut, sweep);
+
+	double maxDiff = 0.0;
+	for (unsigned int n = 0; n < input.size(); n++)
+		maxDiff = fmax(maxDiff, fabs(originalOut[n] - inlineOut[n]));
+
+	bool pass = maxDiff == 0.0;
+	printf("%-24s original %7.2f ns/sample  inline %7.2f ns/sample  speedup %5.2fx  max diff %g  %s\n",
+		name, originalTime, inlineTime, originalTime / inlineTime, maxDiff, pass ? "ok" : "FAIL");
+	return pass;
+}
+
+int main()
+{
+	std::vector<double> input = makeNoise(NUM_SAMPLES);
+	bool pass = true;
+
+	pass &= benchmark<Hardwired<WDFButterLPF3>, Hardwired<WDFButterLPF3Inline>>("WDFButterLPF3", input, false);
+	pass &= benchmark<Hardwired<WDFConstKBPF6>, Hardwired<WDFConstKBPF6Inline>>("WDFConstKBPF6", input, false);
+	pass &= benchmark<WDFIdealRLCLPF, WDFIdealRLCLPFInline>("WDFIdealRLCLPF", input, false);
+	pass &= benchmark<WDFIdealRLCLPF, WDFIdealRLCLPFInline>("WDFIdealRLCLPF fc sweep", input, true);
+
+	return pass ? 0 : 1;
+}